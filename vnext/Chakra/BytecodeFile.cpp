@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "BytecodeFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+// A temporary file this old belongs to a writer that stopped before it renamed the file.
+constexpr std::chrono::minutes staleTempFileAge{10};
+
+FILE *openForWriting(const std::filesystem::path &fileName) noexcept {
+#ifdef _WIN32
+  FILE *file = nullptr;
+  return _wfopen_s(&file, fileName.c_str(), L"wb") == 0 ? file : nullptr;
+#else
+  return fopen(fileName.c_str(), "wb");
+#endif
+}
+
+// Makes sure that the file content is on disk before the file is renamed.
+bool flushToDisk(FILE *file) noexcept {
+  if (fflush(file) != 0) {
+    return false;
+  }
+
+#ifdef _WIN32
+  return _commit(_fileno(file)) == 0;
+#else
+  return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool writeFile(
+    const std::filesystem::path &fileName,
+    const BytecodeFileHeader &header,
+    const uint8_t *bytecode,
+    size_t size) noexcept {
+  std::unique_ptr<FILE, decltype(&fclose)> file{openForWriting(fileName), &fclose};
+  return file && fwrite(&header, sizeof(header), 1, file.get()) == 1 &&
+      (size == 0 || fwrite(bytecode, size, 1, file.get()) == 1) && flushToDisk(file.get());
+}
+
+// Deletes the stale temporary files of fileName. Newer ones may belong to writers that are still running.
+void removeStaleTempFiles(const std::filesystem::path &fileName) noexcept {
+  std::filesystem::path::string_type tempFilePrefix = fileName.filename().native();
+  tempFilePrefix += std::filesystem::path{".tmp"}.native();
+  const std::filesystem::path directory = fileName.has_parent_path() ? fileName.parent_path() : ".";
+  const auto now = std::filesystem::file_time_type::clock::now();
+
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it{directory, ec}, end; !ec && it != end; it.increment(ec)) {
+    if (it->path().filename().native().compare(0, tempFilePrefix.size(), tempFilePrefix) != 0) {
+      continue;
+    }
+
+    std::error_code fileEc;
+    const auto lastWriteTime = it->last_write_time(fileEc);
+    if (!fileEc && now - lastWriteTime > staleTempFileAge) {
+      std::filesystem::remove(it->path(), fileEc);
+    }
+  }
+}
+
+} // namespace
+
+uint64_t computeBytecodeChecksum(const uint8_t *bytecode, size_t size) noexcept {
+  // FNV-1a over 64-bit words, folding the high bits down after each step.
+  // Reading words keeps the check cheap for the multi-megabyte files of large bundles.
+  constexpr uint64_t prime = 1099511628211ull;
+  uint64_t hash = 14695981039346656037ull;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytecode + i, sizeof(word));
+    hash = (hash ^ word) * prime;
+    hash ^= hash >> 32;
+  }
+
+  for (; i < size; ++i) {
+    hash = (hash ^ bytecode[i]) * prime;
+  }
+
+  return hash ^ size;
+}
+
+bool publishBytecodeFile(
+    const std::filesystem::path &fileName,
+    BytecodeFileHeader header,
+    const uint8_t *bytecode,
+    size_t size) noexcept {
+  header.bytecodeSize = size;
+  header.bytecodeChecksum = computeBytecodeChecksum(bytecode, size);
+
+  try {
+    removeStaleTempFiles(fileName);
+
+    // Each writer has its own temporary file, so that concurrent writers do not mix their content.
+    std::filesystem::path tempFileName = fileName;
+    tempFileName += ".tmp" + std::to_string(std::random_device{}());
+
+    std::error_code ec;
+    if (!writeFile(tempFileName, header, bytecode, size)) {
+      std::filesystem::remove(tempFileName, ec);
+      return false;
+    }
+
+    std::filesystem::rename(tempFileName, fileName, ec);
+    if (ec) {
+      std::filesystem::remove(tempFileName, ec);
+      return false;
+    }
+
+    return true;
+  } catch (const std::exception &) {
+    return false;
+  }
+}
+
+bool isValidBytecodeFile(const uint8_t *fileData, size_t fileSize, const BytecodeFileHeader &expectedHeader) noexcept {
+  if (!fileData || fileSize < sizeof(BytecodeFileHeader)) {
+    return false;
+  }
+
+  BytecodeFileHeader header;
+  std::memcpy(&header, fileData, sizeof(header));
+  if (header.formatVersion != expectedHeader.formatVersion || header.bundleVersion != expectedHeader.bundleVersion ||
+      std::memcmp(header.engineVersion, expectedHeader.engineVersion, sizeof(header.engineVersion)) != 0) {
+    return false;
+  }
+
+  const uint8_t *bytecode = fileData + sizeof(header);
+  const size_t bytecodeSize = fileSize - sizeof(header);
+  return header.bytecodeSize == bytecodeSize &&
+      header.bytecodeChecksum == computeBytecodeChecksum(bytecode, bytecodeSize);
+}
+
+} // namespace react
+} // namespace facebook
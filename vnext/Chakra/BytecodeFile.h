@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace facebook {
+namespace react {
+
+// A bytecode cache file is a BytecodeFileHeader followed by the bytecode.
+// The versions identify the format, bundle and engine the bytecode was
+// generated for. The bytecode size and checksum let a reader reject a file
+// that was truncated or damaged after it was written.
+struct BytecodeFileHeader {
+  static constexpr uint64_t s_formatVersion = 3;
+
+  uint64_t formatVersion{s_formatVersion};
+  uint64_t bundleVersion{0};
+  uint32_t engineVersion[4]{};
+  uint64_t bytecodeSize{0};
+  uint64_t bytecodeChecksum{0};
+};
+
+static_assert(sizeof(BytecodeFileHeader) == 48, "The bytecode file format depends on the header layout.");
+
+uint64_t computeBytecodeChecksum(const uint8_t *bytecode, size_t size) noexcept;
+
+// Writes the header and bytecode to a temporary file next to fileName, flushes
+// it to disk and renames it to fileName. Readers see either the previous file
+// or the complete new one, even if the process stops in the middle. The size
+// and checksum of the header are set from the bytecode.
+// Temporary files that earlier writers left next to fileName are deleted once
+// they are older than a few minutes.
+// Returns false if the file could not be published.
+bool publishBytecodeFile(
+    const std::filesystem::path &fileName,
+    BytecodeFileHeader header,
+    const uint8_t *bytecode,
+    size_t size) noexcept;
+
+// Returns true if the file content starts with a header that has the expected
+// format, bundle and engine versions, followed by bytecode that matches the
+// size and checksum of the header.
+bool isValidBytecodeFile(const uint8_t *fileData, size_t fileSize, const BytecodeFileHeader &expectedHeader) noexcept;
+
+} // namespace react
+} // namespace facebook
@@ -31,6 +31,7 @@
 #include "ChakraTracing.h"
 #include "ChakraUtils.h"
 
+#include <Executors/JsonParser.h>
 #include <MemoryTracker.h>
 
 namespace facebook {
@@ -573,7 +574,7 @@ void ChakraExecutor::callNativeModules(ChakraValue &&value) {
   SystraceSection s("ChakraExecutor::callNativeModules");
   try {
     auto calls = value.toJSONString();
-    m_delegate->callNativeModules(*this, folly::parseJson(calls), true);
+    m_delegate->callNativeModules(*this, Microsoft::React::ParseJson(calls), true);
   } catch (...) {
     std::string message = "Error in callNativeModules()";
     try {
@@ -657,7 +658,7 @@ void *ChakraExecutor::getJavaScriptContext() {
 
 void ChakraExecutor::flushQueueImmediate(ChakraValue &&queue) {
   auto queueStr = queue.toJSONString();
-  m_delegate->callNativeModules(*this, folly::parseJson(queueStr), false);
+  m_delegate->callNativeModules(*this, Microsoft::React::ParseJson(queueStr), false);
 }
 
 void ChakraExecutor::loadModule(uint32_t bundleId, uint32_t moduleId) {
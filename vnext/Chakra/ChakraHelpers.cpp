@@ -3,9 +3,11 @@
 
 #include "pch.h"
 
+#include "BytecodeFile.h"
 #include "ChakraHelpers.h"
 #include "ChakraUtils.h"
 #include "ChakraValue.h"
+#include "MemoryMappedBuffer.h"
 #include "Unicode.h"
 
 #ifdef WITH_FBSYSTRACE
@@ -20,13 +22,11 @@
 
 #include <windows.h>
 #include <algorithm>
-#include <cstdio>
 #include <cstdlib>
 #include <future>
 #include <memory>
 #include <string>
 #include <thread>
-#include <type_traits>
 
 namespace facebook {
 namespace react {
@@ -34,17 +34,6 @@ namespace react {
 #if !defined(USE_EDGEMODE_JSRT)
 namespace {
 
-template <class T>
-size_t fwrite(T *p, size_t count, FILE *file) noexcept {
-  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable to be serialized into a file");
-  return fwrite(p, sizeof(*p), count, file);
-}
-
-template <class T>
-bool fwrite(const T &val, FILE *file) noexcept {
-  return fwrite(&val, 1, file) == 1;
-}
-
 #if !defined(CHAKRACORE_UWP)
 struct FileVersionInfoResource {
   uint16_t len;
@@ -100,13 +89,11 @@ class ChakraVersionInfo {
     return true;
   }
 
-  bool operator==(const ChakraVersionInfo &rhs) const noexcept {
-    return (m_fileVersionMS == rhs.m_fileVersionMS) && (m_fileVersionLS == rhs.m_fileVersionLS) &&
-        (m_productVersionMS == rhs.m_productVersionMS) && (m_productVersionLS == rhs.m_productVersionLS);
-  }
-
-  bool operator!=(const ChakraVersionInfo &rhs) const noexcept {
-    return !(*this == rhs);
+  void copyTo(uint32_t (&version)[4]) const noexcept {
+    version[0] = m_fileVersionMS;
+    version[1] = m_fileVersionLS;
+    version[2] = m_productVersionMS;
+    version[3] = m_productVersionLS;
   }
 
  private:
@@ -116,48 +103,23 @@ class ChakraVersionInfo {
   uint32_t m_productVersionLS;
 };
 
-class BytecodePrefix {
- public:
-  static std::pair<bool, BytecodePrefix> getBytecodePrefix(uint64_t bundleVersion) noexcept {
-    std::pair<bool, BytecodePrefix> result{false, BytecodePrefix{bundleVersion}};
-    result.first = result.second.m_chakraVersionInfo.initialize();
-    return result;
-  }
-
-  bool operator==(const BytecodePrefix &rhs) const noexcept {
-    return (m_bytecodeFileFormatVersion == rhs.m_bytecodeFileFormatVersion) &&
-        (m_bundleVersion == rhs.m_bundleVersion) && (m_chakraVersionInfo == rhs.m_chakraVersionInfo);
+// Returns false if the version of the engine cannot be read.
+bool getBytecodeFileHeader(uint64_t bundleVersion, BytecodeFileHeader &header) noexcept {
+  ChakraVersionInfo chakraVersionInfo;
+  if (!chakraVersionInfo.initialize()) {
+    return false;
   }
 
-  bool operator!=(const BytecodePrefix &rhs) const noexcept {
-    return !(*this == rhs);
-  }
-
- private:
-  uint64_t m_bytecodeFileFormatVersion;
-  uint64_t m_bundleVersion;
-  ChakraVersionInfo m_chakraVersionInfo;
-
-  static constexpr uint32_t s_bytecodeFileFormatVersion = 2;
-
-  BytecodePrefix(uint64_t bundleVersion) noexcept
-      : m_bytecodeFileFormatVersion{s_bytecodeFileFormatVersion},
-        m_bundleVersion{bundleVersion},
-        m_chakraVersionInfo{} {}
-};
+  header = BytecodeFileHeader{};
+  header.bundleVersion = bundleVersion;
+  chakraVersionInfo.copyTo(header.engineVersion);
+  return true;
+}
 
 void serializeBytecodeToFileCore(
     const std::shared_ptr<const JSBigString> &script,
-    const BytecodePrefix &bytecodePrefix,
+    const BytecodeFileHeader &header,
     const std::string &bytecodeFileName) {
-  FILE *bytecodeFilePtr;
-  // bytecode is a binary representation, so we need to pass in the "b" flag to
-  // fopen_s
-  if (_wfopen_s(&bytecodeFilePtr, Microsoft::Common::Unicode::Utf8ToUtf16(bytecodeFileName).c_str(), L"wb")) {
-    return;
-  }
-  std::unique_ptr<FILE, decltype(&fclose)> bytecodeFilePtrWrapper(bytecodeFilePtr, fclose);
-
   const std::wstring scriptUTF16 = Microsoft::Common::Unicode::Utf8ToUtf16(script->c_str(), script->size());
 
   unsigned int bytecodeSize = 0;
@@ -170,48 +132,69 @@ void serializeBytecodeToFileCore(
     return;
   }
 
-  constexpr size_t bytecodePrefixSize = sizeof(bytecodePrefix);
-  uint8_t zeroArray[sizeof(bytecodePrefix)]{};
+  // The file is replaced atomically, so a crash while writing never leaves a torn file behind.
+  publishBytecodeFile(
+      Microsoft::Common::Unicode::Utf8ToUtf16(bytecodeFileName), header, bytecode.get(), bytecodeSize);
+}
 
-  if (fwrite(zeroArray, bytecodePrefixSize, bytecodeFilePtrWrapper.get()) != bytecodePrefixSize ||
-      fwrite(bytecode.get(), bytecodeSize, bytecodeFilePtrWrapper.get()) != bytecodeSize ||
-      fflush(bytecodeFilePtrWrapper.get())) {
-    return;
+#if !defined(WINRT)
+// Exposes the bytecode in a memory mapped file without copying it. The engine
+// reads the bytecode straight from the page cache, and the mapping lives as
+// long as the array buffer that the engine creates for it.
+class MemoryMappedBytecode : public JSBigString {
+ public:
+  explicit MemoryMappedBytecode(std::shared_ptr<facebook::jsi::Buffer> &&fileBuffer) noexcept
+      : m_fileBuffer{std::move(fileBuffer)} {}
+
+  bool isAscii() const override {
+    return false;
   }
 
-  fseek(bytecodeFilePtrWrapper.get(), 0, SEEK_SET);
-  if (!fwrite(bytecodePrefix, bytecodeFilePtrWrapper.get()) || fflush(bytecodeFilePtrWrapper.get())) {
-    return;
+  const char *c_str() const override {
+    return reinterpret_cast<const char *>(m_fileBuffer->data()) + sizeof(BytecodeFileHeader);
   }
-}
 
-std::unique_ptr<JSBigString> tryGetBytecode(const BytecodePrefix &bytecodePrefix, const std::string &bytecodeFileName) {
-  auto bytecodeBigStringPtr =
-      std::make_unique<FileMappingBigString>(bytecodeFileName, static_cast<uint32_t>(sizeof(BytecodePrefix)));
+  size_t size() const override {
+    return m_fileBuffer->size() - sizeof(BytecodeFileHeader);
+  }
 
-  if (!bytecodeBigStringPtr->file_data() || bytecodeBigStringPtr->file_size() < sizeof(bytecodePrefix) ||
-      *reinterpret_cast<const BytecodePrefix *>(bytecodeBigStringPtr->file_data()) != bytecodePrefix) {
+ private:
+  std::shared_ptr<facebook::jsi::Buffer> m_fileBuffer;
+};
+
+std::unique_ptr<JSBigString> tryGetBytecode(const BytecodeFileHeader &header, const std::string &bytecodeFileName) {
+  const std::wstring bytecodeFileNameUTF16 = Microsoft::Common::Unicode::Utf8ToUtf16(bytecodeFileName);
+  std::shared_ptr<facebook::jsi::Buffer> fileBuffer;
+  try {
+    fileBuffer = Microsoft::JSI::MakeMemoryMappedBuffer(bytecodeFileNameUTF16.c_str());
+  } catch (const facebook::jsi::JSINativeException &) {
+    // The file does not exist yet, or it is empty.
     return nullptr;
   }
 
-  return bytecodeBigStringPtr;
+  if (!isValidBytecodeFile(fileBuffer->data(), fileBuffer->size(), header)) {
+    return nullptr;
+  }
+
+  return std::make_unique<MemoryMappedBytecode>(std::move(fileBuffer));
 }
+#endif
 
 void serializeBytecodeToFile(
     const std::shared_ptr<const JSBigString> &script,
-    const BytecodePrefix &bytecodePrefix,
+    const BytecodeFileHeader &header,
     std::string &&bytecodeFileName,
     bool async) {
   std::future<void> bytecodeSerializationFuture = std::async(
       std::launch::async,
       [](const std::shared_ptr<const JSBigString> &script,
-         const BytecodePrefix &bytecodePrefix,
+         const BytecodeFileHeader &header,
          const std::string &bytecodeFileName) {
         MinimalChakraRuntime chakraRuntime(false /* multithreaded */);
-        serializeBytecodeToFileCore(script, bytecodePrefix, bytecodeFileName);
+        serializeBytecodeToFileCore(script, header, bytecodeFileName);
       },
       script,
-      bytecodePrefix,
+      header,
       std::move(bytecodeFileName));
 
   if (!async) {
@@ -410,16 +393,15 @@ JsValueRef evaluateScriptWithBytecode(
   // code right now.
   return evaluateScript(std::move(script), scriptFileName);
 #else
-  auto bytecodePrefixOptional = BytecodePrefix::getBytecodePrefix(scriptVersion);
-  if (!bytecodePrefixOptional.first) {
+  BytecodeFileHeader bytecodeFileHeader;
+  if (!getBytecodeFileHeader(scriptVersion, bytecodeFileHeader)) {
     return evaluateScript(std::move(script), scriptFileName);
   }
 
-  auto &bytecodePrefix = bytecodePrefixOptional.second;
-  std::unique_ptr<const JSBigString> bytecode = tryGetBytecode(bytecodePrefix, bytecodeFileName);
+  std::unique_ptr<const JSBigString> bytecode = tryGetBytecode(bytecodeFileHeader, bytecodeFileName);
   if (!bytecode) {
     std::shared_ptr<const JSBigString> sharedScript(script.release());
-    serializeBytecodeToFile(sharedScript, bytecodePrefix, std::move(bytecodeFileName), asyncBytecodeGeneration);
+    serializeBytecodeToFile(sharedScript, bytecodeFileHeader, std::move(bytecodeFileName), asyncBytecodeGeneration);
     ReactMarker::logMarker(ReactMarker::JS_BUNDLE_STRING_CONVERT_START);
     JsValueRefUniquePtr jsScript = jsArrayBufferFromBigString(sharedScript);
     ReactMarker::logMarker(ReactMarker::JS_BUNDLE_STRING_CONVERT_STOP);
@@ -442,12 +424,12 @@ JsValueRef evaluateScriptWithBytecode(
       scriptFileName,
       &value);
 
-  // Currently, when the existing bundle.bytecode is incompatible with the
-  // ChakraCore.dll used, we do not update it. This is because we memory mapped
-  // bundle.bytecode into a JsExternalArrayBuffer, whose lifetime is controlled
-  // by the JS engine. Hence we cannot remove/rename/modify bytecode.bundle
-  // until the JS garbage collector deletes the corresponding
-  // JsExternalArrayBuffer.
+  // Currently, when the existing bundle.bytecode passes its checksum but is
+  // still rejected by the ChakraCore.dll used, we do not update it. This is
+  // because we memory mapped bundle.bytecode into a JsExternalArrayBuffer,
+  // whose lifetime is controlled by the JS engine. Hence we cannot
+  // remove/rename/modify bytecode.bundle until the JS garbage collector deletes
+  // the corresponding JsExternalArrayBuffer.
   if (result == JsErrorBadSerializedScript) {
     JsGetAndClearException(&exn);
     return evaluateScript(jsScript.get(), scriptFileName);
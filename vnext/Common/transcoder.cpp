@@ -0,0 +1,375 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Transcoder.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define TRANSCODER_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 is used only when we can compile its intrinsics without changing the target
+// architecture of the whole translation unit. We check for it at runtime.
+#if (defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))) || defined(__AVX2__)
+#define TRANSCODER_USE_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+#define TRANSCODER_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Microsoft::Common::Unicode {
+
+namespace {
+
+//=============================================================================
+// ASCII runs
+//
+// Each of the following functions converts the longest prefix of whole blocks
+// that contain only ASCII characters and returns the number of code units it
+// converted. The caller converts the remaining tail.
+//=============================================================================
+
+#if !TRANSCODER_USE_SSE2 && !TRANSCODER_USE_NEON
+
+size_t WidenAsciiScalar(const char *src, size_t len, char16_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, src + i, sizeof(word));
+    if (word & 0x8080808080808080ull) {
+      break;
+    }
+
+    for (size_t j = 0; j < 8; ++j) {
+      dst[i + j] = static_cast<char16_t>(static_cast<uint8_t>(src[i + j]));
+    }
+  }
+
+  return i;
+}
+
+size_t NarrowAsciiScalar(const char16_t *src, size_t len, char *dst) noexcept {
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    uint64_t word;
+    std::memcpy(&word, src + i, sizeof(word));
+    if (word & 0xFF80FF80FF80FF80ull) {
+      break;
+    }
+
+    for (size_t j = 0; j < 4; ++j) {
+      dst[i + j] = static_cast<char>(src[i + j]);
+    }
+  }
+
+  return i;
+}
+
+#endif // !TRANSCODER_USE_SSE2 && !TRANSCODER_USE_NEON
+
+#if TRANSCODER_USE_SSE2
+
+size_t WidenAsciiSse2(const char *src, size_t len, char16_t *dst) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (_mm_movemask_epi8(bytes) != 0) {
+      break;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpackhi_epi8(bytes, zero));
+  }
+
+  return i;
+}
+
+size_t NarrowAsciiSse2(const char16_t *src, size_t len, char *dst) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+    __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), nonAsciiMask);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(nonAscii, zero)) != 0xFFFF) {
+      break;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(low, high));
+  }
+
+  return i;
+}
+
+#endif // TRANSCODER_USE_SSE2
+
+#if TRANSCODER_USE_AVX2
+
+bool HasAvx2() noexcept {
+#if defined(_MSC_VER)
+  static const bool hasAvx2 = []() noexcept {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+      return false;
+    }
+
+    // AVX2 needs the OS to save the YMM registers on context switches.
+    __cpuid(info, 1);
+    constexpr int osxsaveBit = 1 << 27;
+    constexpr int avxBit = 1 << 28;
+    if ((info[2] & osxsaveBit) == 0 || (info[2] & avxBit) == 0 || (_xgetbv(0) & 0x6) != 0x6) {
+      return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    constexpr int avx2Bit = 1 << 5;
+    return (info[1] & avx2Bit) != 0;
+  }();
+
+  return hasAvx2;
+#else
+  // The whole binary is compiled for AVX2.
+  return true;
+#endif
+}
+
+size_t WidenAsciiAvx2(const char *src, size_t len, char16_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    if (_mm256_movemask_epi8(bytes) != 0) {
+      break;
+    }
+
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(dst + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+  }
+
+  return i;
+}
+
+size_t NarrowAsciiAvx2(const char16_t *src, size_t len, char *dst) noexcept {
+  const __m256i nonAsciiMask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 16));
+    if (!_mm256_testz_si256(_mm256_or_si256(low, high), nonAsciiMask)) {
+      break;
+    }
+
+    // _mm256_packus_epi16 packs each 128-bit lane separately: restore the order of the 64-bit quarters.
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), packed);
+  }
+
+  return i;
+}
+
+#endif // TRANSCODER_USE_AVX2
+
+#if TRANSCODER_USE_NEON
+
+size_t WidenAsciiNeon(const char *src, size_t len, char16_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t *>(src + i));
+    if (vmaxvq_u8(bytes) >= 0x80) {
+      break;
+    }
+
+    vst1q_u16(reinterpret_cast<uint16_t *>(dst + i), vmovl_u8(vget_low_u8(bytes)));
+    vst1q_u16(reinterpret_cast<uint16_t *>(dst + i + 8), vmovl_high_u8(bytes));
+  }
+
+  return i;
+}
+
+size_t NarrowAsciiNeon(const char16_t *src, size_t len, char *dst) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    uint16x8_t low = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i));
+    uint16x8_t high = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i + 8));
+    if (vmaxvq_u16(vorrq_u16(low, high)) >= 0x80) {
+      break;
+    }
+
+    vst1q_u8(reinterpret_cast<uint8_t *>(dst + i), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+  }
+
+  return i;
+}
+
+#endif // TRANSCODER_USE_NEON
+
+size_t WidenAscii(const char *src, size_t len, char16_t *dst) noexcept {
+#if TRANSCODER_USE_AVX2
+  if (HasAvx2()) {
+    size_t converted = WidenAsciiAvx2(src, len, dst);
+    return converted + WidenAsciiSse2(src + converted, len - converted, dst + converted);
+  }
+#endif
+#if TRANSCODER_USE_SSE2
+  return WidenAsciiSse2(src, len, dst);
+#elif TRANSCODER_USE_NEON
+  return WidenAsciiNeon(src, len, dst);
+#else
+  return WidenAsciiScalar(src, len, dst);
+#endif
+}
+
+size_t NarrowAscii(const char16_t *src, size_t len, char *dst) noexcept {
+#if TRANSCODER_USE_AVX2
+  if (HasAvx2()) {
+    size_t converted = NarrowAsciiAvx2(src, len, dst);
+    return converted + NarrowAsciiSse2(src + converted, len - converted, dst + converted);
+  }
+#endif
+#if TRANSCODER_USE_SSE2
+  return NarrowAsciiSse2(src, len, dst);
+#elif TRANSCODER_USE_NEON
+  return NarrowAsciiNeon(src, len, dst);
+#else
+  return NarrowAsciiScalar(src, len, dst);
+#endif
+}
+
+bool IsContinuation(uint8_t byte) noexcept {
+  return (byte & 0xC0) == 0x80;
+}
+
+} // namespace
+
+bool TryUtf8ToUtf16(const char *utf8, size_t utf8Len, char16_t *utf16, size_t &utf16Len) noexcept {
+  const uint8_t *src = reinterpret_cast<const uint8_t *>(utf8);
+  size_t in = 0;
+  size_t out = 0;
+
+  while (in < utf8Len) {
+    uint8_t lead = src[in];
+    if (lead < 0x80) {
+      size_t converted = WidenAscii(utf8 + in, utf8Len - in, utf16 + out);
+      in += converted;
+      out += converted;
+
+      // Finish the ASCII run that did not fill a whole block.
+      while (in < utf8Len && src[in] < 0x80) {
+        utf16[out++] = static_cast<char16_t>(src[in++]);
+      }
+
+      continue;
+    }
+
+    // The ranges of valid second bytes follow the "Well-Formed UTF-8 Byte Sequences"
+    // table of the Unicode Standard. They exclude overlong forms, surrogates, and
+    // code points above U+10FFFF.
+    if (lead >= 0xC2 && lead <= 0xDF) {
+      if (in + 1 >= utf8Len || !IsContinuation(src[in + 1])) {
+        return false;
+      }
+
+      utf16[out++] = static_cast<char16_t>(((lead & 0x1F) << 6) | (src[in + 1] & 0x3F));
+      in += 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      if (in + 2 >= utf8Len) {
+        return false;
+      }
+
+      uint8_t second = src[in + 1];
+      uint8_t minSecond = (lead == 0xE0) ? 0xA0 : 0x80;
+      uint8_t maxSecond = (lead == 0xED) ? 0x9F : 0xBF;
+      if (second < minSecond || second > maxSecond || !IsContinuation(src[in + 2])) {
+        return false;
+      }
+
+      utf16[out++] = static_cast<char16_t>(((lead & 0x0F) << 12) | ((second & 0x3F) << 6) | (src[in + 2] & 0x3F));
+      in += 3;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      if (in + 3 >= utf8Len) {
+        return false;
+      }
+
+      uint8_t second = src[in + 1];
+      uint8_t minSecond = (lead == 0xF0) ? 0x90 : 0x80;
+      uint8_t maxSecond = (lead == 0xF4) ? 0x8F : 0xBF;
+      if (second < minSecond || second > maxSecond || !IsContinuation(src[in + 2]) || !IsContinuation(src[in + 3])) {
+        return false;
+      }
+
+      uint32_t codePoint = ((lead & 0x07) << 18) | ((second & 0x3F) << 12) | ((src[in + 2] & 0x3F) << 6) |
+          (src[in + 3] & 0x3F);
+      codePoint -= 0x10000;
+      utf16[out++] = static_cast<char16_t>(0xD800 | (codePoint >> 10));
+      utf16[out++] = static_cast<char16_t>(0xDC00 | (codePoint & 0x3FF));
+      in += 4;
+    } else {
+      return false;
+    }
+  }
+
+  utf16Len = out;
+  return true;
+}
+
+bool TryUtf16ToUtf8(const char16_t *utf16, size_t utf16Len, char *utf8, size_t &utf8Len) noexcept {
+  size_t in = 0;
+  size_t out = 0;
+
+  while (in < utf16Len) {
+    char16_t unit = utf16[in];
+    if (unit < 0x80) {
+      size_t converted = NarrowAscii(utf16 + in, utf16Len - in, utf8 + out);
+      in += converted;
+      out += converted;
+
+      // Finish the ASCII run that did not fill a whole block.
+      while (in < utf16Len && utf16[in] < 0x80) {
+        utf8[out++] = static_cast<char>(utf16[in++]);
+      }
+
+      continue;
+    }
+
+    if (unit < 0x800) {
+      utf8[out++] = static_cast<char>(0xC0 | (unit >> 6));
+      utf8[out++] = static_cast<char>(0x80 | (unit & 0x3F));
+      in += 1;
+    } else if (unit < 0xD800 || unit > 0xDFFF) {
+      utf8[out++] = static_cast<char>(0xE0 | (unit >> 12));
+      utf8[out++] = static_cast<char>(0x80 | ((unit >> 6) & 0x3F));
+      utf8[out++] = static_cast<char>(0x80 | (unit & 0x3F));
+      in += 1;
+    } else {
+      // Only a high surrogate followed by a low surrogate is well-formed.
+      if (unit > 0xDBFF || in + 1 >= utf16Len || utf16[in + 1] < 0xDC00 || utf16[in + 1] > 0xDFFF) {
+        return false;
+      }
+
+      uint32_t codePoint = 0x10000 + (((unit & 0x3FF) << 10) | (utf16[in + 1] & 0x3FF));
+      utf8[out++] = static_cast<char>(0xF0 | (codePoint >> 18));
+      utf8[out++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      utf8[out++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      utf8[out++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+      in += 2;
+    }
+  }
+
+  utf8Len = out;
+  return true;
+}
+
+} // namespace Microsoft::Common::Unicode
@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#include <cstddef>
+
+namespace Microsoft::Common::Unicode {
+
+// Portable UTF-8 <-> UTF-16 transcoders used by the fast path of the functions
+// in Unicode.h. They use SSE2/AVX2 on x86 and x64, NEON on ARM64, and a scalar
+// word-at-a-time loop elsewhere to convert runs of ASCII characters.
+//
+// The transcoders only accept well-formed input. They do not replace invalid
+// sequences with U+FFFD: they return false instead, and the caller must fall
+// back to a conversion that implements the replacement rules. The content of
+// the output buffer is unspecified when they return false.
+//
+// The output buffer must have room for the worst case:
+//   - MaxUtf16Length(utf8Len) UTF-16 code units for TryUtf8ToUtf16, and
+//   - MaxUtf8Length(utf16Len) UTF-8 code units for TryUtf16ToUtf8.
+// On success the number of code units written is returned in the last
+// parameter.
+//
+constexpr size_t MaxUtf16Length(size_t utf8Len) noexcept {
+  // Each UTF-8 code unit produces at most one UTF-16 code unit.
+  return utf8Len;
+}
+
+constexpr size_t MaxUtf8Length(size_t utf16Len) noexcept {
+  // Each UTF-16 code unit produces at most three UTF-8 code units.
+  // Surrogate pairs produce four UTF-8 code units from two UTF-16 code units.
+  return utf16Len * 3;
+}
+
+bool TryUtf8ToUtf16(const char *utf8, size_t utf8Len, char16_t *utf16, size_t &utf16Len) noexcept;
+bool TryUtf16ToUtf8(const char16_t *utf16, size_t utf16Len, char *utf8, size_t &utf8Len) noexcept;
+
+} // namespace Microsoft::Common::Unicode
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "Unicode.h"
+#include "Transcoder.h"
 #include "Utilities.h"
 
 #include "windows.h"
@@ -11,10 +12,60 @@
 #include <cassert>
 #include <cstring>
 #include <exception>
+#include <limits>
 #include <string>
+#include <type_traits>
 
 namespace Microsoft::Common::Unicode {
 
+namespace {
+
+// Inputs up to this many code units are transcoded into a stack buffer, so the
+// result string is allocated once with its exact length.
+constexpr size_t StackBufferLength = 256;
+
+// Tries to convert well-formed input with the transcoders from Transcoder.h.
+// Returns false if the input is ill-formed, in which case the caller falls back
+// to the Windows API to apply its U+FFFD replacement rules.
+template <typename TResult, typename TSource, typename TTranscoder>
+bool TryFastConvert(
+    const TSource *source,
+    size_t sourceLen,
+    size_t maxResultLen,
+    TTranscoder transcoder,
+    TResult &result) {
+  using TUnit = typename TResult::value_type;
+  using TTranscodedUnit = std::conditional_t<sizeof(TUnit) == sizeof(char16_t), char16_t, char>;
+
+  size_t resultLen = 0;
+  if (maxResultLen <= StackBufferLength) {
+    TTranscodedUnit buffer[StackBufferLength];
+    if (!transcoder(source, sourceLen, buffer, resultLen)) {
+      return false;
+    }
+
+    result.assign(reinterpret_cast<const TUnit *>(buffer), resultLen);
+    return true;
+  }
+
+  result.resize(maxResultLen);
+  if (!transcoder(source, sourceLen, reinterpret_cast<TTranscodedUnit *>(&result[0]), resultLen)) {
+    result.clear();
+    return false;
+  }
+
+  result.resize(resultLen);
+
+  // Do not keep up to three times the memory we need for long-lived strings.
+  if (result.capacity() / 2 > resultLen) {
+    result.shrink_to_fit();
+  }
+
+  return true;
+}
+
+} // namespace
+
 // The implementations of the following functions heavily reference the MSDN
 // article at https://msdn.microsoft.com/en-us/magazine/mt763237.aspx.
 
@@ -32,6 +83,10 @@ std::wstring Utf8ToUtf16(const char *utf8, size_t utf8Len) {
     throw std::overflow_error("Length of input string to Utf8ToUtf16() must fit into an int.");
   }
 
+  if (TryFastConvert(utf8, utf8Len, MaxUtf16Length(utf8Len), TryUtf8ToUtf16, utf16)) {
+    return utf16;
+  }
+
   const int utf8Length = static_cast<int>(utf8Len);
 
   // We do not specify MB_ERR_INVALID_CHARS here, which means that invalid UTF-8
@@ -113,6 +168,17 @@ std::string Utf16ToUtf8(const wchar_t *utf16, size_t utf16Len) {
     throw std::overflow_error("Length of input string to Utf16ToUtf8() must fit into an int.");
   }
 
+  // MaxUtf8Length must not overflow size_t on 32-bit platforms.
+  if (utf16Len <= (std::numeric_limits<size_t>::max)() / 3 &&
+      TryFastConvert(
+          Utilities::CheckedReinterpretCast<const char16_t *>(utf16),
+          utf16Len,
+          MaxUtf8Length(utf16Len),
+          TryUtf16ToUtf8,
+          utf8)) {
+    return utf8;
+  }
+
   const int utf16Length = static_cast<int>(utf16Len);
 
   // We do not specify WC_ERR_INVALID_CHARS here, which means that invalid
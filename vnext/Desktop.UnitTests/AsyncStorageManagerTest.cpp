@@ -3,8 +3,13 @@
 
 #include <cstdlib>
 #include <ctime>
+#include <future>
 #include <iostream>
 
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#endif
+
 #include <CppUnitTest.h>
 #include "AsyncStorageTestClass.h"
 
@@ -44,6 +49,18 @@ void storeCallbackArgAndNotify(vector<folly::dynamic> args) {
   cv.notify_one();
 }
 
+folly::dynamic makeSetArgs(const vector<tuple<string, string>> &keyValuePairs) {
+  folly::dynamic jsSetArgs = folly::dynamic::array;
+  jsSetArgs.push_back(FollyDynamicConverter::tupleStringVectorAsRetVal(keyValuePairs));
+  return jsSetArgs;
+}
+
+folly::dynamic makeKeyArgs(const vector<string> &keys) {
+  folly::dynamic jsKeyArgs = folly::dynamic::array;
+  jsKeyArgs.push_back(FollyDynamicConverter::stringVectorAsRetVal(keys));
+  return jsKeyArgs;
+}
+
 void throwLastErrorMessage() {
   char errorMessageBuffer[1025] = {0};
   FormatMessageA(
@@ -237,6 +254,134 @@ TEST_CLASS (AsyncStorageManagerTest) {
 
     lock.unlock();
   }
+
+  TEST_METHOD(AsyncStorageManagerTest_BatchedRequestsKeepOrder) {
+    AsyncStorageManager kvManager(this->m_storageFileName);
+    std::unique_lock<std::recursive_mutex> lock(m);
+    kvManager.executeKVOperation(
+        AsyncStorageManager::AsyncStorageOperation::clear,
+        FollyDynamicConverter::stringVectorAsRetVal(emptyStringVector),
+        storeCallbackArgAndNotify);
+    cv.wait(lock);
+
+    Assert::IsTrue(returnedValues[0] == dynamicNULL);
+
+    // Each callback records its request index and result.
+    vector<size_t> callbackOrder;
+    vector<vector<folly::dynamic>> results(7);
+    auto makeCallback = [&callbackOrder, &results](size_t index) {
+      return [&callbackOrder, &results, index](vector<folly::dynamic> args) {
+        std::lock_guard<std::recursive_mutex> lock(m);
+        callbackOrder.push_back(index);
+        results[index] = std::move(args);
+        cv.notify_one();
+      };
+    };
+
+    // Writes always run on the consumer thread. The callback of the first write blocks the consumer
+    // until the gate opens, so that the following requests are queued behind each other. The reads
+    // among them go through the queue too, and must see the writes issued before them.
+    // Only this callback blocks, because reads without pending writes run their callbacks on this thread.
+    using Operation = AsyncStorageManager::AsyncStorageOperation;
+    std::promise<void> consumerBlocked;
+    std::promise<void> gate;
+    kvManager.executeKVOperation(
+        Operation::multiSet,
+        makeSetArgs({make_tuple(SAMPLE_KEY_2, "0")}),
+        [&consumerBlocked, gateOpened = gate.get_future().share(), recordResult = makeCallback(0)](
+            vector<folly::dynamic> args) {
+          consumerBlocked.set_value();
+          gateOpened.wait();
+          recordResult(std::move(args));
+        });
+    consumerBlocked.get_future().wait();
+
+    kvManager.executeKVOperation(Operation::multiSet, makeSetArgs({make_tuple(SAMPLE_KEY_1, "1")}), makeCallback(1));
+    kvManager.executeKVOperation(Operation::multiGet, makeKeyArgs({SAMPLE_KEY_1}), makeCallback(2));
+    kvManager.executeKVOperation(Operation::multiSet, makeSetArgs({make_tuple(SAMPLE_KEY_1, "2")}), makeCallback(3));
+    kvManager.executeKVOperation(Operation::multiGet, makeKeyArgs({SAMPLE_KEY_1}), makeCallback(4));
+    kvManager.executeKVOperation(Operation::multiRemove, makeKeyArgs({SAMPLE_KEY_1}), makeCallback(5));
+    kvManager.executeKVOperation(Operation::multiGet, makeKeyArgs({SAMPLE_KEY_1}), makeCallback(6));
+    gate.set_value();
+    cv.wait(lock, [&callbackOrder, &results]() { return callbackOrder.size() == results.size(); });
+
+    Assert::IsTrue(callbackOrder == vector<size_t>{0, 1, 2, 3, 4, 5, 6});
+    for (const auto &result : results) {
+      Assert::IsTrue(result[0] == dynamicNULL);
+    }
+
+    auto getValues = [](const vector<folly::dynamic> &result) {
+      folly::dynamic jsReturnValues = folly::dynamic::array;
+      jsReturnValues.push_back(result[1]);
+      return FollyDynamicConverter::jsArgAsTupleStringVector(jsReturnValues);
+    };
+
+    Assert::IsTrue(getValues(results[2]) == vector<tuple<string, string>>{make_tuple(SAMPLE_KEY_1, "1")});
+    Assert::IsTrue(getValues(results[4]) == vector<tuple<string, string>>{make_tuple(SAMPLE_KEY_1, "2")});
+    Assert::IsTrue(getValues(results[6]).empty());
+
+    // All writes of the batch are saved to the storage file.
+    lock.unlock();
+    {
+      AsyncStorageManager reloadedKVManager(this->m_storageFileName);
+      reloadedKVManager.executeKVOperation(
+          Operation::getAllKeys,
+          FollyDynamicConverter::stringVectorAsRetVal(emptyStringVector),
+          storeCallbackArgAndNotify);
+      Assert::IsTrue(returnedValues[0] == dynamicNULL);
+      folly::dynamic jsAllKeys = folly::dynamic::array;
+      jsAllKeys.push_back(returnedValues[1]);
+      Assert::IsTrue(FollyDynamicConverter::jsArgAsStringVector(jsAllKeys) == vector<string>{SAMPLE_KEY_2});
+    }
+  }
+
+#ifdef PERF_TESTS
+  TEST_METHOD(AsyncStorageManagerTest_MeasureSmallWrites) {
+    AsyncStorageManager kvManager(this->m_storageFileName);
+    std::unique_lock<std::recursive_mutex> lock(m);
+    kvManager.executeKVOperation(
+        AsyncStorageManager::AsyncStorageOperation::clear,
+        FollyDynamicConverter::stringVectorAsRetVal(emptyStringVector),
+        storeCallbackArgAndNotify);
+    cv.wait(lock);
+
+    constexpr size_t writeCount = 10000;
+    size_t completedCount = 0;
+    size_t errorCount = 0;
+    auto callback = [&completedCount, &errorCount](vector<folly::dynamic> args) {
+      std::lock_guard<std::recursive_mutex> lock(m);
+      errorCount += args[0] == dynamicNULL ? 0 : 1;
+      ++completedCount;
+      cv.notify_one();
+    };
+
+    const LONGLONG writeTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (size_t i = 0; i < writeCount; ++i) {
+        const std::string postFix = std::to_string(i);
+        kvManager.executeKVOperation(
+            AsyncStorageManager::AsyncStorageOperation::multiSet,
+            makeSetArgs({make_tuple(SAMPLE_KEY_1 + postFix, SAMPLE_VAL_1 + postFix)}),
+            callback);
+      }
+
+      cv.wait(lock, [&completedCount]() { return completedCount == writeCount; });
+    });
+    Assert::AreEqual(size_t{0}, errorCount);
+    Logger::WriteMessage(
+        Mso::UnitTests::FormatPerfResult("AsyncStorageManagerTest_MeasureSmallWrites", "", writeCount, writeTicks)
+            .c_str());
+
+    kvManager.executeKVOperation(
+        AsyncStorageManager::AsyncStorageOperation::getAllKeys,
+        FollyDynamicConverter::stringVectorAsRetVal(emptyStringVector),
+        storeCallbackArgAndNotify);
+    folly::dynamic jsAllKeys = folly::dynamic::array;
+    jsAllKeys.push_back(returnedValues[1]);
+    Assert::AreEqual(writeCount, FollyDynamicConverter::jsArgAsStringVector(jsAllKeys).size());
+
+    lock.unlock();
+  }
+#endif // PERF_TESTS
 };
 
 } // namespace Microsoft::React::Test
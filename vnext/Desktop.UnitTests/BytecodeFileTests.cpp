@@ -0,0 +1,199 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <CppUnitTest.h>
+
+#include "../Chakra/BytecodeFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using facebook::react::BytecodeFileHeader;
+using facebook::react::isValidBytecodeFile;
+using facebook::react::publishBytecodeFile;
+using Microsoft::VisualStudio::CppUnitTestFramework::Assert;
+
+namespace {
+
+std::vector<uint8_t> ReadFile(const std::filesystem::path &fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  Assert::IsTrue(bool(file));
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void WriteFile(const std::filesystem::path &fileName, const uint8_t *data, size_t size) {
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(data), size);
+  Assert::IsTrue(bool(file));
+}
+
+bool IsValid(const std::vector<uint8_t> &fileContent, const BytecodeFileHeader &expectedHeader) {
+  return isValidBytecodeFile(fileContent.data(), fileContent.size(), expectedHeader);
+}
+
+} // namespace
+
+namespace Microsoft::React::Test {
+
+TEST_CLASS (BytecodeFileTests) {
+ private:
+  std::filesystem::path m_directory;
+  std::filesystem::path m_fileName;
+  BytecodeFileHeader m_header;
+  std::vector<uint8_t> m_bytecode;
+
+  size_t FileCount() const {
+    return std::distance(std::filesystem::directory_iterator{m_directory}, std::filesystem::directory_iterator{});
+  }
+
+ public:
+  BytecodeFileTests() {
+    m_directory = std::filesystem::temp_directory_path() /
+        ("BytecodeFileTests" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(m_directory);
+    m_fileName = m_directory / "bundle.bytecode";
+
+    m_header.bundleVersion = 42;
+    m_header.engineVersion[0] = 1;
+    m_header.engineVersion[3] = 11;
+    for (size_t i = 0; i < 1000; ++i) {
+      m_bytecode.push_back(static_cast<uint8_t>(i * 7));
+    }
+  }
+
+  ~BytecodeFileTests() {
+    std::error_code ec;
+    std::filesystem::remove_all(m_directory, ec);
+  }
+
+  TEST_METHOD(PublishedFileIsValid) {
+    Assert::IsTrue(publishBytecodeFile(m_fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+
+    auto fileContent = ReadFile(m_fileName);
+    Assert::AreEqual(sizeof(BytecodeFileHeader) + m_bytecode.size(), fileContent.size());
+    Assert::IsTrue(IsValid(fileContent, m_header));
+    Assert::IsTrue(std::equal(m_bytecode.begin(), m_bytecode.end(), fileContent.begin() + sizeof(BytecodeFileHeader)));
+
+    // The temporary file has been renamed.
+    Assert::AreEqual(size_t{1}, FileCount());
+  }
+
+  TEST_METHOD(PublishReplacesExistingFile) {
+    Assert::IsTrue(publishBytecodeFile(m_fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+
+    std::vector<uint8_t> newBytecode(m_bytecode.rbegin(), m_bytecode.rend());
+    BytecodeFileHeader newHeader = m_header;
+    newHeader.bundleVersion = 43;
+    Assert::IsTrue(publishBytecodeFile(m_fileName, newHeader, newBytecode.data(), newBytecode.size()));
+
+    auto fileContent = ReadFile(m_fileName);
+    Assert::IsTrue(IsValid(fileContent, newHeader));
+    Assert::IsFalse(IsValid(fileContent, m_header));
+    Assert::AreEqual(size_t{1}, FileCount());
+  }
+
+  TEST_METHOD(TornWriteIsRejected) {
+    Assert::IsTrue(publishBytecodeFile(m_fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+    auto fileContent = ReadFile(m_fileName);
+
+    // A write that stops anywhere before the end leaves a file that is not used.
+    const size_t headerSize = sizeof(BytecodeFileHeader);
+    for (size_t size : {size_t{0}, headerSize / 2, headerSize, fileContent.size() - 1}) {
+      std::vector<uint8_t> tornContent(fileContent.begin(), fileContent.begin() + size);
+      Assert::IsFalse(IsValid(tornContent, m_header));
+    }
+
+    // So does a write that reached the end before the header was updated.
+    std::vector<uint8_t> zeroHeaderContent = fileContent;
+    std::fill(zeroHeaderContent.begin(), zeroHeaderContent.begin() + sizeof(BytecodeFileHeader), uint8_t{0});
+    Assert::IsFalse(IsValid(zeroHeaderContent, m_header));
+  }
+
+  TEST_METHOD(LeftoverTemporaryFileDoesNotAffectPublishedFile) {
+    Assert::IsTrue(publishBytecodeFile(m_fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+    auto fileContent = ReadFile(m_fileName);
+
+    // A process stopped while it wrote a newer version leaves a partial temporary file.
+    auto tempFileName = m_fileName;
+    tempFileName += ".tmp1234";
+    WriteFile(tempFileName, fileContent.data(), fileContent.size() / 2);
+    Assert::IsTrue(IsValid(ReadFile(m_fileName), m_header));
+
+    // The next writer still publishes its file.
+    Assert::IsTrue(publishBytecodeFile(m_fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+    Assert::IsTrue(ReadFile(m_fileName) == fileContent);
+  }
+
+  TEST_METHOD(PublishDeletesStaleTemporaryFiles) {
+    auto makeTempFile = [this](const char *name, std::chrono::minutes age) {
+      auto tempFileName = m_directory / name;
+      WriteFile(tempFileName, m_bytecode.data(), m_bytecode.size() / 2);
+      std::filesystem::last_write_time(tempFileName, std::filesystem::file_time_type::clock::now() - age);
+      return tempFileName;
+    };
+
+    // Writers that stopped long ago left two files, and a running writer has a recent one.
+    auto staleFileName1 = makeTempFile("bundle.bytecode.tmp1234", std::chrono::minutes{60});
+    auto staleFileName2 = makeTempFile("bundle.bytecode.tmp5678", std::chrono::minutes{24 * 60});
+    auto recentFileName = makeTempFile("bundle.bytecode.tmp9012", std::chrono::minutes{0});
+    auto otherFileName = makeTempFile("other.bytecode.tmp3456", std::chrono::minutes{60});
+
+    Assert::IsTrue(publishBytecodeFile(m_fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+    Assert::IsTrue(IsValid(ReadFile(m_fileName), m_header));
+    Assert::IsFalse(std::filesystem::exists(staleFileName1));
+    Assert::IsFalse(std::filesystem::exists(staleFileName2));
+    Assert::IsTrue(std::filesystem::exists(recentFileName));
+    Assert::IsTrue(std::filesystem::exists(otherFileName));
+    Assert::AreEqual(size_t{3}, FileCount());
+  }
+
+  TEST_METHOD(FailedPublishLeavesNoFile) {
+    auto fileName = m_directory / "missing" / "bundle.bytecode";
+    Assert::IsFalse(publishBytecodeFile(fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+    Assert::IsFalse(std::filesystem::exists(fileName));
+    Assert::AreEqual(size_t{0}, FileCount());
+  }
+
+  TEST_METHOD(ChecksumMismatchIsRejected) {
+    Assert::IsTrue(publishBytecodeFile(m_fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+    auto fileContent = ReadFile(m_fileName);
+
+    // Each changed bit of the bytecode is detected.
+    for (size_t i = sizeof(BytecodeFileHeader); i < fileContent.size(); i += 97) {
+      for (uint8_t bit = 1; bit != 0; bit <<= 1) {
+        auto damagedContent = fileContent;
+        damagedContent[i] ^= bit;
+        Assert::IsFalse(IsValid(damagedContent, m_header));
+      }
+    }
+
+    // So is bytecode that was zeroed out.
+    auto zeroedContent = fileContent;
+    std::fill(zeroedContent.begin() + sizeof(BytecodeFileHeader), zeroedContent.end(), uint8_t{0});
+    Assert::IsFalse(IsValid(zeroedContent, m_header));
+  }
+
+  TEST_METHOD(VersionMismatchIsRejected) {
+    Assert::IsTrue(publishBytecodeFile(m_fileName, m_header, m_bytecode.data(), m_bytecode.size()));
+    auto fileContent = ReadFile(m_fileName);
+
+    BytecodeFileHeader expectedHeader = m_header;
+    expectedHeader.formatVersion = 2;
+    Assert::IsFalse(IsValid(fileContent, expectedHeader));
+
+    expectedHeader = m_header;
+    expectedHeader.bundleVersion = 41;
+    Assert::IsFalse(IsValid(fileContent, expectedHeader));
+
+    expectedHeader = m_header;
+    expectedHeader.engineVersion[3] = 12;
+    Assert::IsFalse(IsValid(fileContent, expectedHeader));
+  }
+};
+
+} // namespace Microsoft::React::Test
@@ -45,8 +45,10 @@ TEST_CLASS (BytecodeUnitTests) {
   static constexpr const uint64_t bundleVersionIndex = sizeof(uint64_t) /* size of bytecodeFileFormatVersion */;
   static constexpr const uint64_t ChakraVersionInfoIndex =
       bundleVersionIndex + sizeof(uint64_t) /* size of bundleVersion */;
-  static constexpr const uint64_t bytecodeIndex =
+  static constexpr const uint64_t bytecodeSizeIndex =
       ChakraVersionInfoIndex + 4 * sizeof(uint32_t) /* size of ChakraVersionInfo */;
+  static constexpr const uint64_t bytecodeIndex = bytecodeSizeIndex + sizeof(uint64_t) /* size of bytecodeSize */ +
+      sizeof(uint64_t) /* size of bytecodeChecksum */;
 
   static constexpr const uint64_t scirptVersion = 42;
   static constexpr int testScriptResult = 6;
@@ -243,9 +245,9 @@ TEST_CLASS (BytecodeUnitTests) {
           bytecodeFile.write(&correctBytecode[0], ChakraVersionInfoIndex);
 
           bytecodeFile.write(
-              reinterpret_cast<const char *>(&wrongChakraVersionInfo[0]), bytecodeIndex - ChakraVersionInfoIndex);
+              reinterpret_cast<const char *>(&wrongChakraVersionInfo[0]), bytecodeSizeIndex - ChakraVersionInfoIndex);
 
-          bytecodeFile.write(&correctBytecode[bytecodeIndex], correctBytecode.size() - bytecodeIndex);
+          bytecodeFile.write(&correctBytecode[bytecodeSizeIndex], correctBytecode.size() - bytecodeSizeIndex);
 
           Assert::IsTrue(bool(bytecodeFile));
           bytecodeFile.close();
@@ -260,12 +262,12 @@ TEST_CLASS (BytecodeUnitTests) {
               corruptBytecodeFile.begin() + bytecodeFileFormatVersionIndex));
           Assert::IsFalse(std::equal(
               correctBytecodeFile.begin() + ChakraVersionInfoIndex,
-              correctBytecodeFile.begin() + bytecodeIndex,
+              correctBytecodeFile.begin() + bytecodeSizeIndex,
               corruptBytecodeFile.begin() + ChakraVersionInfoIndex));
           Assert::IsTrue(std::equal(
-              corruptBytecodeFile.begin() + bytecodeIndex,
+              corruptBytecodeFile.begin() + bytecodeSizeIndex,
               corruptBytecodeFile.end(),
-              correctBytecodeFile.begin() + bytecodeIndex));
+              correctBytecodeFile.begin() + bytecodeSizeIndex));
         },
         /* postUpdateCheck*/
         [this](const std::vector<char> &currentBytecodeFile, const std::vector<char> &correctBytecodeFile) {
@@ -324,11 +326,10 @@ TEST_CLASS (BytecodeUnitTests) {
         },
         /* postUpdateCheck*/
         [this](const std::vector<char> &currentBytecodeFile, const std::vector<char> &correctBytecodeFile) {
-          ExecuteBytecodeWithFallback();
-          // We don't do anything here because we currently do not
-          // regenerate bytecode when the bytecode itself (not its prefix)
-          // is corrupt. See comments in evaluateScriptWithBytecode for
-          // more details as for why.
+          // The bytecode does not match the checksum in its prefix, so it is
+          // regenerated before it reaches the engine.
+          Assert::IsTrue(currentBytecodeFile == correctBytecodeFile);
+          ExecuteBytecodeWithoutFallback();
         });
   }
 };
@@ -0,0 +1,269 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <CppUnitTest.h>
+
+#include <CxxMessageQueue.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <Windows.h>
+#include <folly/AtomicIntrusiveLinkedList.h>
+#include <motifCpp/perfTest.h>
+#include <algorithm>
+#include <string>
+#endif
+
+using namespace facebook::react;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Microsoft::React::Test {
+
+namespace {
+
+// Runs a CxxMessageQueue on its own thread.
+struct MessageQueueRunner {
+  MessageQueueRunner() : Queue{std::make_shared<CxxMessageQueue>()}, Thread{CxxMessageQueue::getRunLoop(Queue)} {}
+
+  ~MessageQueueRunner() {
+    Queue->quitSynchronous();
+    Thread.join();
+  }
+
+  void runOnQueue(std::function<void()> &&func) {
+    Queue->runOnQueue(std::move(func));
+  }
+
+  void runOnQueueSync(std::function<void()> &&func) {
+    Queue->runOnQueueSync(std::move(func));
+  }
+
+  std::shared_ptr<CxxMessageQueue> Queue;
+  std::thread Thread;
+};
+
+#ifdef PERF_TESTS
+
+// The CxxMessageQueue design before the task ring: each post allocates a task
+// and pushes it to a folly::AtomicIntrusiveLinkedList.
+class IntrusiveListMessageQueue {
+ public:
+  ~IntrusiveListMessageQueue() {
+    m_stopped = true;
+    m_pending.set();
+    m_thread.join();
+    m_queue.sweep([](Task *task) { delete task; });
+  }
+
+  void runOnQueue(std::function<void()> &&func) {
+    if (m_queue.insertHead(new Task{std::move(func)})) {
+      m_pending.set();
+    }
+  }
+
+  void runOnQueueSync(std::function<void()> &&func) {
+    detail::EventFlag done;
+    runOnQueue([&]() {
+      func();
+      done.set();
+    });
+    done.wait();
+  }
+
+ private:
+  struct Task {
+    std::function<void()> func;
+    folly::AtomicIntrusiveLinkedListHook<Task> hook;
+  };
+
+  void run() {
+    while (!m_stopped) {
+      m_queue.sweep([](Task *task) {
+        std::unique_ptr<Task> owned{task};
+        owned->func();
+      });
+      m_pending.wait();
+    }
+  }
+
+  folly::AtomicIntrusiveLinkedList<Task, &Task::hook> m_queue;
+  std::atomic_bool m_stopped{false};
+  detail::BinarySemaphore m_pending;
+  std::thread m_thread{[this]() { run(); }}; // It must be the last member.
+};
+
+LONGLONG QueryPerformanceCount() {
+  LARGE_INTEGER count{0};
+  QueryPerformanceCounter(&count);
+  return count.QuadPart;
+}
+
+struct PostTimes {
+  size_t postCount;
+  LONGLONG postTicks;
+  LONGLONG p99LatencyTicks;
+};
+
+// Posts tasks from producerCount threads, and measures the time to post them
+// and the 99th percentile of the time from a post to the start of its task.
+template <class TQueue>
+PostTimes MeasurePosts(TQueue &queue, size_t producerCount) {
+  constexpr size_t postCount = 200000;
+  const size_t postsPerProducer = postCount / producerCount;
+  std::vector<LONGLONG> latencies;
+  latencies.reserve(postCount);
+
+  std::vector<std::thread> producers;
+  const LONGLONG start = QueryPerformanceCount();
+  for (size_t producer = 0; producer < producerCount; ++producer) {
+    producers.emplace_back([&queue, &latencies, postsPerProducer]() {
+      for (size_t i = 0; i < postsPerProducer; ++i) {
+        queue.runOnQueue([&latencies, postTime = QueryPerformanceCount()]() {
+          latencies.push_back(QueryPerformanceCount() - postTime);
+        });
+      }
+    });
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+
+  const LONGLONG postTicks = QueryPerformanceCount() - start;
+  queue.runOnQueueSync([]() {});
+
+  Assert::AreEqual(postsPerProducer * producerCount, latencies.size());
+  auto p99 = latencies.begin() + latencies.size() * 99 / 100;
+  std::nth_element(latencies.begin(), p99, latencies.end());
+  return PostTimes{latencies.size(), postTicks, *p99};
+}
+
+#endif // PERF_TESTS
+
+} // namespace
+
+TEST_CLASS (CxxMessageQueueTest) {
+  TEST_METHOD(CxxMessageQueue_KeepsPostOrderOfEachProducer) {
+    // Each producer posts more tasks than the ring holds, so some of them go
+    // through the overflow list.
+    constexpr int producerCount = 4;
+    constexpr int postCount = 5000;
+    MessageQueueRunner runner;
+    std::vector<int> lastPosts(producerCount, -1);
+    bool isInOrder = true;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < producerCount; ++producer) {
+      producers.emplace_back([&, producer]() {
+        for (int i = 0; i < postCount; ++i) {
+          runner.runOnQueue([&, producer, i]() {
+            isInOrder = isInOrder && lastPosts[producer] == i - 1;
+            lastPosts[producer] = i;
+          });
+        }
+      });
+    }
+
+    for (auto &producer : producers) {
+      producer.join();
+    }
+
+    runner.runOnQueueSync([]() {});
+    Assert::IsTrue(isInOrder);
+    for (int lastPost : lastPosts) {
+      Assert::AreEqual(postCount - 1, lastPost);
+    }
+  }
+
+  TEST_METHOD(CxxMessageQueue_KeepsPostOrderThroughOverflow) {
+    // The first task blocks the queue thread, so the producer fills the ring and
+    // posts the rest to the overflow list. It keeps posting while the queue
+    // drains, and a second thread posts too, so the queue switches between the
+    // ring and the overflow list while slots are being claimed.
+    constexpr int blockedPostCount = 1000;
+    constexpr int postCount = 20000;
+    MessageQueueRunner runner;
+    detail::EventFlag unblocked;
+    int lastPost = -1;
+    bool isInOrder = true;
+
+    runner.runOnQueue([&]() { unblocked.wait(); });
+    const auto post = [&](int i) {
+      runner.runOnQueue([&, i]() {
+        isInOrder = isInOrder && lastPost == i - 1;
+        lastPost = i;
+      });
+    };
+
+    for (int i = 0; i < blockedPostCount; ++i) {
+      post(i);
+    }
+
+    std::atomic_bool producing{true};
+    std::thread otherProducer{[&]() {
+      while (producing) {
+        runner.runOnQueue([]() {});
+      }
+    }};
+
+    unblocked.set();
+    for (int i = blockedPostCount; i < postCount; ++i) {
+      post(i);
+    }
+
+    producing = false;
+    otherProducer.join();
+    runner.runOnQueueSync([]() {});
+    Assert::IsTrue(isInOrder);
+    Assert::AreEqual(postCount - 1, lastPost);
+  }
+
+  TEST_METHOD(CxxMessageQueue_RunsDelayedTasksInStartTimeOrder) {
+    MessageQueueRunner runner;
+    std::vector<int> order;
+    detail::EventFlag done;
+
+    // Posting from the queue thread makes all delayed tasks wait in the timer heap.
+    runner.runOnQueueSync([&]() {
+      runner.Queue->runOnQueueDelayed([&]() { order.push_back(40); }, 40);
+      runner.Queue->runOnQueueDelayed([&]() { order.push_back(10); }, 10);
+      runner.Queue->runOnQueueDelayed([&]() { order.push_back(30); }, 30);
+      runner.Queue->runOnQueueDelayed([&]() { order.push_back(11); }, 10);
+      runner.Queue->runOnQueueDelayed([&]() { order.push_back(20); }, 20);
+      runner.Queue->runOnQueueDelayed([&]() { done.set(); }, 50);
+      runner.Queue->runOnQueue([&]() { order.push_back(0); });
+    });
+
+    Assert::IsTrue(done.wait_until(std::chrono::steady_clock::now() + std::chrono::seconds(10)));
+    Assert::IsTrue(order == std::vector<int>{0, 10, 11, 20, 30, 40});
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(CxxMessageQueue_MeasurePosts) {
+    for (size_t producerCount : {1, 4, 16}) {
+      {
+        MessageQueueRunner runner;
+        LogPostTimes("CxxMessageQueue_MeasurePosts ring", producerCount, MeasurePosts(runner, producerCount));
+      }
+      {
+        IntrusiveListMessageQueue queue;
+        LogPostTimes("CxxMessageQueue_MeasurePosts intrusive list", producerCount, MeasurePosts(queue, producerCount));
+      }
+    }
+  }
+
+  static void LogPostTimes(const char *testName, size_t producerCount, const PostTimes &times) {
+    const auto p99LatencyNs = static_cast<int64_t>(Mso::UnitTests::PerfTicksToSeconds(times.p99LatencyTicks) * 1e9);
+    const std::string parameters =
+        "producers=" + std::to_string(producerCount) + "; p99=" + std::to_string(p99LatencyNs) + " ns";
+    Logger::WriteMessage(
+        Mso::UnitTests::FormatPerfResult(testName, parameters, times.postCount, times.postTicks).c_str());
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace Microsoft::React::Test
@@ -0,0 +1,355 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <CppUnitTest.h>
+
+#include <ImageCache.h>
+#include <Test/HttpServer.h>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace http = boost::beast::http;
+
+namespace Microsoft::React::Test {
+
+namespace {
+
+constexpr uint16_t ServerPort = 5558;
+constexpr char ServerUri[] = "http://localhost:5558";
+
+// Sends a GET request to the test server with a Boost.Beast client.
+ImageHttpResponse FetchFromServer(const std::string &uri, const ImageHttpHeaders &headers) {
+  boost::asio::io_context context;
+  boost::asio::ip::tcp::resolver resolver{context};
+  boost::beast::tcp_stream stream{context};
+  stream.connect(resolver.resolve("localhost", std::to_string(ServerPort)));
+
+  http::request<http::empty_body> request{http::verb::get, uri.substr(std::size(ServerUri) - 1), 11};
+  request.set(http::field::host, "localhost");
+  for (const auto &[name, value] : headers) {
+    request.set(name, value);
+  }
+
+  http::write(stream, request);
+  boost::beast::flat_buffer buffer;
+  http::response<http::string_body> response;
+  http::read(stream, buffer, response);
+
+  ImageHttpResponse result;
+  result.StatusCode = response.result_int();
+  for (const auto &field : response) {
+    std::string name{field.name_string()};
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char ch) {
+      return static_cast<char>(std::tolower(ch));
+    });
+    result.Headers[name] = std::string{field.value()};
+  }
+
+  result.Body = std::move(response.body());
+  boost::system::error_code ec;
+  stream.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+  return result;
+}
+
+// An image server that counts requests and answers If-None-Match with 304 when the ETag matches.
+struct ImageServer {
+  ImageServer(std::string cacheControl, std::chrono::milliseconds responseDelay = {})
+      : m_server{std::make_shared<HttpServer>("127.0.0.1", ServerPort)} {
+    m_server->SetOnGet([this, cacheControl, responseDelay](const http::request<http::string_body> &request) {
+      ++RequestCount;
+      std::this_thread::sleep_for(responseDelay);
+
+      http::response<http::dynamic_body> response{http::status::ok, request.version()};
+      response.set(http::field::cache_control, cacheControl);
+      response.set(http::field::etag, "\"v1\"");
+      if (request[http::field::if_none_match] == "\"v1\"") {
+        ++NotModifiedCount;
+        response.result(http::status::not_modified);
+      } else {
+        // Each path has its own image, except that the copy of an image has the same content.
+        std::string target{request.target()};
+        response.body() = CreateStringResponseBody("image:" + target.substr(0, target.find("-copy")));
+      }
+
+      response.prepare_payload();
+      return response;
+    });
+    m_server->Start();
+  }
+
+  ~ImageServer() {
+    m_server->Stop();
+  }
+
+  std::atomic<int> RequestCount{0};
+  std::atomic<int> NotModifiedCount{0};
+
+ private:
+  std::shared_ptr<HttpServer> m_server;
+};
+
+// A clock that only moves when a test advances it.
+struct TestClock {
+  std::chrono::system_clock::time_point Now{std::chrono::system_clock::now()};
+
+  std::function<std::chrono::system_clock::time_point()> Function() {
+    return [this]() { return Now; };
+  }
+};
+
+std::filesystem::path MakeTempDirectory() {
+  auto path = std::filesystem::temp_directory_path() /
+      ("ImageCacheTest" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+  std::filesystem::create_directories(path);
+  return path;
+}
+
+std::string ImageUri(const char *path) {
+  return std::string{ServerUri} + path;
+}
+
+// Returns true if any file in the directory contains the text.
+bool DirectoryContains(const std::filesystem::path &directory, const std::string &text) {
+  for (const auto &file : std::filesystem::directory_iterator{directory}) {
+    std::ifstream stream{file.path(), std::ios::binary};
+    std::ostringstream content;
+    content << stream.rdbuf();
+    if (content.str().find(text) != std::string::npos) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+size_t FileCount(const std::filesystem::path &directory) {
+  return static_cast<size_t>(
+      std::distance(std::filesystem::directory_iterator{directory}, std::filesystem::directory_iterator{}));
+}
+
+} // namespace
+
+TEST_CLASS (ImageCacheTest) {
+  TEST_METHOD(ImageCache_CoalescesConcurrentRequests) {
+    ImageServer server{"max-age=60", std::chrono::milliseconds{200}};
+    ImageCache cache{&FetchFromServer, {}};
+
+    std::vector<std::shared_ptr<const std::string>> images(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < images.size(); ++i) {
+      threads.emplace_back([&cache, &images, i]() { images[i] = cache.Get(ImageUri("/avatar.png"), {}); });
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    Assert::AreEqual(1, server.RequestCount.load());
+    for (const auto &image : images) {
+      Assert::IsTrue(image != nullptr);
+      Assert::AreEqual(std::string{"image:/avatar.png"}, *image);
+    }
+  }
+
+  TEST_METHOD(ImageCache_RevalidatesStaleImagesWithETag) {
+    ImageServer server{"max-age=60"};
+    TestClock clock;
+    ImageCacheOptions options;
+    options.Now = clock.Function();
+    ImageCache cache{&FetchFromServer, std::move(options)};
+
+    auto image = cache.Get(ImageUri("/avatar.png"), {});
+    Assert::IsTrue(cache.Get(ImageUri("/avatar.png"), {}) == image);
+    Assert::AreEqual(1, server.RequestCount.load());
+
+    // After max-age the server confirms that the cached image is still valid.
+    clock.Now += std::chrono::seconds{61};
+    Assert::IsTrue(cache.Get(ImageUri("/avatar.png"), {}) == image);
+    Assert::AreEqual(2, server.RequestCount.load());
+    Assert::AreEqual(1, server.NotModifiedCount.load());
+
+    // The 304 response starts a new max-age period.
+    Assert::IsTrue(cache.Get(ImageUri("/avatar.png"), {}) == image);
+    Assert::AreEqual(2, server.RequestCount.load());
+  }
+
+  TEST_METHOD(ImageCache_HonorsNoStoreAndNoCache) {
+    {
+      ImageServer server{"no-store"};
+      ImageCache cache{&FetchFromServer, {}};
+      cache.Get(ImageUri("/avatar.png"), {});
+      cache.Get(ImageUri("/avatar.png"), {});
+      Assert::AreEqual(2, server.RequestCount.load());
+      Assert::AreEqual(0, server.NotModifiedCount.load());
+    }
+    {
+      ImageServer server{"no-cache"};
+      ImageCache cache{&FetchFromServer, {}};
+      cache.Get(ImageUri("/avatar.png"), {});
+      Assert::AreEqual(std::string{"image:/avatar.png"}, *cache.Get(ImageUri("/avatar.png"), {}));
+      Assert::AreEqual(2, server.RequestCount.load());
+      Assert::AreEqual(1, server.NotModifiedCount.load());
+    }
+  }
+
+  TEST_METHOD(ImageCache_KeysIncludeHeaders) {
+    ImageServer server{"max-age=60"};
+    ImageCache cache{&FetchFromServer, {}};
+    cache.Get(ImageUri("/avatar.png"), {{"x-size", "small"}});
+    cache.Get(ImageUri("/avatar.png"), {{"x-size", "large"}});
+    cache.Get(ImageUri("/avatar.png"), {{"x-size", "small"}});
+    Assert::AreEqual(2, server.RequestCount.load());
+  }
+
+  TEST_METHOD(ImageCache_ReadsDiskCacheAfterRestart) {
+    ImageServer server{"max-age=60"};
+    const auto directory = MakeTempDirectory();
+    for (int run = 0; run < 2; ++run) {
+      ImageCacheOptions options;
+      options.DiskCachePath = directory;
+      ImageCache cache{&FetchFromServer, std::move(options)};
+      Assert::AreEqual(std::string{"image:/avatar.png"}, *cache.Get(ImageUri("/avatar.png"), {}));
+      Assert::AreEqual(std::string{"image:/avatar.png"}, *cache.Get(ImageUri("/avatar.png-copy"), {}));
+    }
+
+    Assert::AreEqual(2, server.RequestCount.load());
+
+    // Both URIs refer to one content file.
+    size_t contentFileCount = 0;
+    for (const auto &file : std::filesystem::directory_iterator{directory}) {
+      contentFileCount += file.path().extension() == ".content" ? 1 : 0;
+    }
+
+    Assert::AreEqual(size_t{1}, contentFileCount);
+    std::filesystem::remove_all(directory);
+  }
+
+  TEST_METHOD(ImageCache_KeepsCredentialedResponsesOffDisk) {
+    const auto directory = MakeTempDirectory();
+    const ImageHttpHeaders headers{{"authorization", "Bearer secret-token"}};
+    {
+      ImageServer server{"max-age=60"};
+      ImageCacheOptions options;
+      options.DiskCachePath = directory;
+      ImageCache cache{&FetchFromServer, std::move(options)};
+      Assert::AreEqual(std::string{"image:/avatar.png"}, *cache.Get(ImageUri("/avatar.png"), headers));
+      Assert::AreEqual(size_t{0}, FileCount(directory));
+    }
+    {
+      // A public response is cached on disk, but the credentials are not written.
+      ImageServer server{"public, max-age=60"};
+      ImageCacheOptions options;
+      options.DiskCachePath = directory;
+      ImageCache cache{&FetchFromServer, std::move(options)};
+      Assert::AreEqual(std::string{"image:/avatar.png"}, *cache.Get(ImageUri("/avatar.png"), headers));
+      Assert::AreEqual(size_t{2}, FileCount(directory));
+      Assert::IsFalse(DirectoryContains(directory, "secret-token"));
+      Assert::IsFalse(DirectoryContains(directory, "localhost:5558/avatar.png"));
+    }
+
+    std::filesystem::remove_all(directory);
+  }
+
+  TEST_METHOD(ImageDiskCache_PrunesLeastRecentlyUsed) {
+    const auto directory = MakeTempDirectory();
+    auto makeEntry = [](char ch) {
+      return ImageCacheEntry{std::make_shared<const std::string>(1000, ch), "\"v1\"", std::chrono::system_clock::now()};
+    };
+
+    // The file times must differ to order the entries.
+    auto waitForFileTime = []() { std::this_thread::sleep_for(std::chrono::milliseconds{20}); };
+
+    // Each entry takes its 1000 byte content file and a small index file.
+    ImageDiskCache cache{directory, 3500};
+    cache.Write("a", makeEntry('a'));
+    waitForFileTime();
+    cache.Write("b", makeEntry('b'));
+    waitForFileTime();
+    cache.Write("c", makeEntry('c'));
+    waitForFileTime();
+    std::ofstream{directory / "orphan.content"} << "orphan";
+    std::ofstream{directory / "interrupted.index.tmp7"} << "interrupted";
+    Assert::IsTrue(cache.Read("a").has_value());
+    waitForFileTime();
+
+    // The fourth entry goes over the budget, and the cache keeps the two most recently used entries.
+    cache.Write("d", makeEntry('d'));
+    Assert::IsTrue(cache.Read("a").has_value());
+    Assert::IsFalse(cache.Read("b").has_value());
+    Assert::IsFalse(cache.Read("c").has_value());
+    Assert::IsTrue(cache.Read("d").has_value());
+    Assert::AreEqual(size_t{4}, FileCount(directory));
+    std::filesystem::remove_all(directory);
+  }
+
+  TEST_METHOD(ImageDiskCache_RejectsTruncatedContent) {
+    const auto directory = MakeTempDirectory();
+    ImageDiskCache cache{directory, 10000};
+    const std::string body(1000, 'a');
+    cache.Write("a", ImageCacheEntry{std::make_shared<const std::string>(body), {}, std::chrono::system_clock::now()});
+    Assert::IsTrue(cache.Read("a").has_value());
+
+    std::ofstream{directory / (ImageDiskCache::ContentHash(body) + ".content"), std::ios::binary} << "aaa";
+    Assert::IsFalse(cache.Read("a").has_value());
+    std::filesystem::remove_all(directory);
+  }
+
+  TEST_METHOD(ImageDiskCache_NamesContentBySha256) {
+    Assert::AreEqual(
+        std::string{"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        ImageDiskCache::ContentHash("abc"));
+    Assert::AreEqual(
+        std::string{"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        ImageDiskCache::ContentHash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+  }
+
+  TEST_METHOD(ImageMemoryCache_EvictsLeastRecentlyUsed) {
+    auto makeEntry = [](size_t size) {
+      return ImageCacheEntry{std::make_shared<const std::string>(size, 'x'), {}, {}};
+    };
+
+    ImageMemoryCache cache{100};
+    cache.Put("a", makeEntry(40));
+    cache.Put("b", makeEntry(40));
+    Assert::IsTrue(cache.Get("a").has_value());
+
+    cache.Put("c", makeEntry(40));
+    Assert::IsTrue(cache.Get("a").has_value());
+    Assert::IsFalse(cache.Get("b").has_value());
+    Assert::IsTrue(cache.Get("c").has_value());
+    Assert::AreEqual(size_t{80}, cache.ByteSize());
+
+    // An image over the budget is not kept.
+    cache.Put("d", makeEntry(101));
+    Assert::IsFalse(cache.Get("d").has_value());
+    Assert::AreEqual(size_t{80}, cache.ByteSize());
+  }
+
+  TEST_METHOD(ImageCachePolicy_ParsesCacheControl) {
+    auto policy = ImageCachePolicy::FromHeaders({{"cache-control", "public, Max-Age=120"}, {"etag", "\"v2\""}});
+    Assert::IsFalse(policy.NoStore);
+    Assert::IsFalse(policy.NoCache);
+    Assert::IsTrue(policy.Public);
+    Assert::IsTrue(policy.MaxAge == std::chrono::seconds{120});
+    Assert::AreEqual(std::string{"\"v2\""}, policy.ETag);
+
+    policy = ImageCachePolicy::FromHeaders({{"cache-control", "no-cache, no-store, max-age=abc"}});
+    Assert::IsTrue(policy.NoStore);
+    Assert::IsTrue(policy.NoCache);
+    Assert::IsFalse(policy.Public);
+    Assert::IsFalse(policy.MaxAge.has_value());
+  }
+};
+
+} // namespace Microsoft::React::Test
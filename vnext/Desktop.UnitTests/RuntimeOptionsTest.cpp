@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <CppUnitTest.h>
+#include <RuntimeOptions.h>
+
+// Windows API
+#include <Windows.h>
+
+// Standard library includes
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#endif
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using std::string;
+
+namespace Microsoft::React::Test {
+
+TEST_CLASS (RuntimeOptionsTest) {
+  TEST_METHOD(RuntimeOptionsTest_RegisterReturnsSameId) {
+    auto id = RegisterRuntimeOption("RuntimeOptionsTest.Register");
+    Assert::AreNotEqual(InvalidRuntimeOptionId, id);
+    Assert::AreEqual(id, RegisterRuntimeOption("RuntimeOptionsTest.Register"));
+    Assert::AreNotEqual(id, RegisterRuntimeOption("RuntimeOptionsTest.Register2"));
+  }
+
+  TEST_METHOD(RuntimeOptionsTest_DefaultValues) {
+    auto id = RegisterRuntimeOption("RuntimeOptionsTest.Default");
+    Assert::IsFalse(GetRuntimeOptionBool(id));
+    Assert::AreEqual(0, GetRuntimeOptionInt(id));
+    Assert::IsFalse(GetRuntimeOptionBool("RuntimeOptionsTest.NeverSet"));
+    Assert::AreEqual(0, GetRuntimeOptionInt("RuntimeOptionsTest.NeverSet"));
+    Assert::IsFalse(GetRuntimeOptionBool(InvalidRuntimeOptionId));
+    Assert::AreEqual(0, GetRuntimeOptionInt(InvalidRuntimeOptionId));
+  }
+
+  TEST_METHOD(RuntimeOptionsTest_StringAndIdApisShareValues) {
+    SetRuntimeOptionBool("RuntimeOptionsTest.Shared", true);
+    auto id = RegisterRuntimeOption("RuntimeOptionsTest.Shared");
+    Assert::IsTrue(GetRuntimeOptionBool(id));
+
+    SetRuntimeOptionInt(id, 42);
+    Assert::AreEqual(42, GetRuntimeOptionInt("RuntimeOptionsTest.Shared"));
+    Assert::IsFalse(GetRuntimeOptionBool("RuntimeOptionsTest.Shared"));
+
+    SetRuntimeOptionBool(id, true);
+    Assert::AreEqual(1, GetRuntimeOptionInt("RuntimeOptionsTest.Shared"));
+  }
+
+  TEST_METHOD(RuntimeOptionsTest_TableGrows) {
+    // More options than fit into one chunk of the option table keep their values.
+    const int32_t optionCount = 2500;
+    for (int32_t i = 0; i < optionCount; ++i)
+      SetRuntimeOptionInt("RuntimeOptionsTest.Grow" + std::to_string(i), i + 1);
+
+    for (int32_t i = 0; i < optionCount; ++i) {
+      const string name = "RuntimeOptionsTest.Grow" + std::to_string(i);
+      Assert::AreEqual(i + 1, GetRuntimeOptionInt(name));
+      auto id = RegisterRuntimeOption(name);
+      Assert::AreNotEqual(InvalidRuntimeOptionId, id);
+      Assert::AreEqual(i + 1, GetRuntimeOptionInt(id));
+    }
+  }
+
+  TEST_METHOD(RuntimeOptionsTest_InvalidIdIgnoresWrites) {
+    SetRuntimeOptionInt(InvalidRuntimeOptionId, 7);
+    Assert::AreEqual(0, GetRuntimeOptionInt(InvalidRuntimeOptionId));
+  }
+
+#ifdef PERF_TESTS
+
+  static const uint32_t readerCount = 16;
+  static const uint32_t iterations = 10000000;
+
+  template <typename TRead>
+  static LONGLONG TimeContendedReads(TRead && read) {
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> start{false};
+    std::vector<std::thread> readers;
+
+    for (uint32_t i = 0; i < readerCount; ++i) {
+      readers.emplace_back([&]() {
+        ++ready;
+        while (!start)
+          std::this_thread::yield();
+
+        int32_t sum = 0;
+        for (uint32_t j = 0; j < iterations; ++j)
+          sum += read();
+
+        Assert::AreEqual(static_cast<int32_t>(iterations), sum);
+      });
+    }
+
+    while (ready < readerCount)
+      std::this_thread::yield();
+
+    return Mso::UnitTests::MeasurePerfTicks([&]() {
+      start = true;
+      for (auto &reader : readers)
+        reader.join();
+    });
+  }
+
+  TEST_METHOD(RuntimeOptionsTest_ContendedStringReads) {
+    SetRuntimeOptionBool("RuntimeOptionsTest.PerfString", true);
+    string name{"RuntimeOptionsTest.PerfString"};
+
+    const LONGLONG ticks = TimeContendedReads([&name]() { return GetRuntimeOptionBool(name) ? 1 : 0; });
+    const string parameters = "threads=" + std::to_string(readerCount);
+    Logger::WriteMessage(
+        Mso::UnitTests::FormatPerfResult("ContendedStringReads", parameters, iterations, ticks).c_str());
+  }
+
+  TEST_METHOD(RuntimeOptionsTest_ContendedIdReads) {
+    auto id = RegisterRuntimeOption("RuntimeOptionsTest.PerfId");
+    SetRuntimeOptionBool(id, true);
+
+    const LONGLONG ticks = TimeContendedReads([id]() { return GetRuntimeOptionBool(id) ? 1 : 0; });
+    const string parameters = "threads=" + std::to_string(readerCount);
+    Logger::WriteMessage(Mso::UnitTests::FormatPerfResult("ContendedIdReads", parameters, iterations, ticks).c_str());
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace Microsoft::React::Test
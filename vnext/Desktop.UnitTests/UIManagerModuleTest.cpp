@@ -4,7 +4,16 @@
 #include <CppUnitTest.h>
 
 #include <EmptyUIManagerModule.h>
+#include <INativeUIManager.h>
+#include <Modules/UIManagerModule.h>
+#include <ShadowNode.h>
 #include <ViewManager.h>
+#include <algorithm>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#include <cstring>
+#endif
 
 using namespace facebook::react;
 using namespace Microsoft::React::Test;
@@ -12,6 +21,184 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace Microsoft::React::Test {
 
+namespace {
+
+// Keeps the children of its native view.
+struct RecordingShadowNode : ShadowNode {
+  void onDropViewInstance() override {}
+  void removeAllChildren() override {
+    ViewChildren.clear();
+  }
+  void AddView(ShadowNode &child, int64_t index) override {
+    ViewChildren.insert(ViewChildren.begin() + static_cast<size_t>(index), child.m_tag);
+  }
+  void RemoveChildAt(int64_t indexToRemove) override {
+    ViewChildren.erase(ViewChildren.begin() + static_cast<size_t>(indexToRemove));
+  }
+  void createView() override {}
+
+  std::vector<int64_t> ViewChildren;
+};
+
+class RecordingViewManager : public IViewManager {
+ public:
+  RecordingViewManager(const char *name) : m_name{name} {}
+
+  const char *GetName() const override {
+    return m_name;
+  }
+  folly::dynamic GetExportedViewConstants() const override {
+    return folly::dynamic::object();
+  }
+  folly::dynamic GetCommands() const override {
+    return folly::dynamic::object();
+  }
+  folly::dynamic GetNativeProps() const override {
+    return folly::dynamic::object();
+  }
+  ShadowNode *createShadow() const override {
+    return new RecordingShadowNode();
+  }
+  void destroyShadow(ShadowNode *node) const override {
+    delete node;
+  }
+  folly::dynamic GetConstants() const override {
+    return folly::dynamic::object();
+  }
+  folly::dynamic GetExportedCustomBubblingEventTypeConstants() const override {
+    return folly::dynamic::object();
+  }
+  folly::dynamic GetExportedCustomDirectEventTypeConstants() const override {
+    return folly::dynamic::object();
+  }
+
+ private:
+  const char *m_name;
+};
+
+// Keeps the layout children of the views, like the Yoga nodes of NativeUIManager.
+class RecordingNativeUIManager : public INativeUIManager {
+ public:
+  void destroy() override {}
+  ShadowNode *createRootShadowNode(IReactRootView * /*rootView*/) override {
+    return new RecordingShadowNode();
+  }
+  void configureNextLayoutAnimation(
+      folly::dynamic && /*config*/,
+      facebook::xplat::module::CxxModule::Callback /*success*/,
+      facebook::xplat::module::CxxModule::Callback /*error*/) override {}
+  // The registry destroys the root shadow node through its view manager.
+  void destroyRootShadowNode(ShadowNode *) override {}
+  void removeRootView(ShadowNode & /*rootNode*/) override {}
+  void setHost(INativeUIManagerHost * /*host*/) override {}
+  INativeUIManagerHost *getHost() override {
+    return nullptr;
+  }
+  void AddRootView(ShadowNode & /*shadowNode*/, IReactRootView * /*pReactRootView*/) override {}
+  void CreateView(ShadowNode & /*shadowNode*/, folly::dynamic /*props*/) override {}
+  void AddView(ShadowNode &parentShadowNode, ShadowNode &childShadowNode, uint64_t index) override {
+    auto &children = LayoutChildren[parentShadowNode.m_tag];
+    children.insert(children.begin() + static_cast<size_t>(index), childShadowNode.m_tag);
+  }
+  void SpliceChildren(ShadowNode &parentShadowNode, const ChildrenSplice &splice) override {
+    auto &children = LayoutChildren[parentShadowNode.m_tag];
+    const auto isChanged = [&splice](int64_t tag) {
+      const auto hasTag = [tag](const ChildAtIndex &child) { return child.Node->m_tag == tag; };
+      return std::any_of(splice.Removed.begin(), splice.Removed.end(), hasTag) ||
+          std::any_of(splice.Added.begin(), splice.Added.end(), hasTag);
+    };
+    children.erase(std::remove_if(children.begin(), children.end(), isChanged), children.end());
+    for (const auto &added : splice.Added) {
+      children.insert(children.begin() + static_cast<size_t>(added.Index), added.Node->m_tag);
+    }
+
+    ++SpliceCount;
+  }
+  void RemoveView(ShadowNode &shadowNode, bool /*removeChildren*/) override {
+    LayoutChildren.erase(shadowNode.m_tag);
+  }
+  void ReplaceView(ShadowNode & /*shadowNode*/) override {}
+  void UpdateView(ShadowNode & /*shadowNode*/, folly::dynamic /*props*/) override {}
+  void onBatchComplete() override {}
+  void ensureInBatch() override {}
+  void measure(
+      ShadowNode & /*shadowNode*/,
+      ShadowNode & /*shadowRoot*/,
+      facebook::xplat::module::CxxModule::Callback /*callback*/) override {}
+  void measureInWindow(ShadowNode & /*shadowNode*/, facebook::xplat::module::CxxModule::Callback /*callback*/)
+      override {}
+  void measureLayout(
+      ShadowNode & /*shadowNode*/,
+      ShadowNode & /*ancestorShadowNode*/,
+      facebook::xplat::module::CxxModule::Callback /*errorCallback*/,
+      facebook::xplat::module::CxxModule::Callback /*callback*/) override {}
+  void focus(int64_t /*reactTag*/) override {}
+  void blur(int64_t /*reactTag*/) override {}
+  void findSubviewIn(
+      ShadowNode & /*shadowNode*/,
+      float /*x*/,
+      float /*y*/,
+      facebook::xplat::module::CxxModule::Callback /*callback*/) override {}
+
+  std::map<int64_t, std::vector<int64_t>> LayoutChildren;
+  size_t SpliceCount{0};
+};
+
+constexpr int64_t RootTag = 1;
+constexpr int64_t ListTag = 2;
+
+// A UIManager with a root view that has a list view.
+struct ListUIManager {
+  ListUIManager() {
+    std::vector<std::unique_ptr<IViewManager>> viewManagers;
+    viewManagers.push_back(std::make_unique<RecordingViewManager>("ROOT"));
+    viewManagers.push_back(std::make_unique<RecordingViewManager>("RCTView"));
+    Manager = std::make_unique<UIManager>(std::move(viewManagers), &NativeManager);
+    Manager->RegisterRootView(nullptr, RootTag, 0, 0);
+    CreateView(ListTag);
+    Manager->setChildren(RootTag, folly::dynamic::array(ListTag));
+  }
+
+  void CreateView(int64_t tag) {
+    Manager->createView(tag, "RCTView", RootTag, nullptr);
+  }
+
+  ShadowNode &List() {
+    return Manager->GetShadowNodeForTag(ListTag);
+  }
+
+  std::vector<int64_t> &ListViewChildren() {
+    return static_cast<RecordingShadowNode &>(List()).ViewChildren;
+  }
+
+  RecordingNativeUIManager NativeManager;
+  std::unique_ptr<UIManager> Manager;
+};
+
+// A UIManager with a root view and view managers for classCount class names.
+struct ManyClassesUIManager {
+  ManyClassesUIManager(size_t classCount) {
+    std::vector<std::unique_ptr<IViewManager>> viewManagers;
+    viewManagers.push_back(std::make_unique<RecordingViewManager>("ROOT"));
+    for (size_t i = 0; i < classCount; ++i) {
+      ClassNames.push_back("RCTClass" + std::to_string(i));
+    }
+
+    for (const auto &className : ClassNames) {
+      viewManagers.push_back(std::make_unique<RecordingViewManager>(className.c_str()));
+    }
+
+    Manager = std::make_unique<UIManager>(std::move(viewManagers), &NativeManager);
+    Manager->RegisterRootView(nullptr, RootTag, 0, 0);
+  }
+
+  std::vector<std::string> ClassNames;
+  RecordingNativeUIManager NativeManager;
+  std::unique_ptr<UIManager> Manager;
+};
+
+} // namespace
+
 TEST_CLASS (UIManagerModuleTests) {
  protected:
   std::unique_ptr<EmptyUIManager> m_emptyUIManager;
@@ -90,4 +277,181 @@ TEST_CLASS (UIManagerModuleTests) {
   }
 };
 
+TEST_CLASS (UIManagerManageChildrenTests) {
+  TEST_METHOD(UIManagerManageChildren_MovesAddsAndRemoves) {
+    ListUIManager ui;
+    for (int64_t tag : {10, 11, 12, 13, 14, 20}) {
+      ui.CreateView(tag);
+    }
+
+    ui.Manager->setChildren(ListTag, folly::dynamic::array(10, 11, 12, 13, 14));
+
+    // Moves 14 to the front, removes 11 and adds 20 at index 2.
+    folly::dynamic moveFrom = folly::dynamic::array(4);
+    folly::dynamic moveTo = folly::dynamic::array(0);
+    folly::dynamic addChildTags = folly::dynamic::array(20);
+    folly::dynamic addAtIndices = folly::dynamic::array(2);
+    folly::dynamic removeFrom = folly::dynamic::array(1);
+    ui.Manager->manageChildren(ListTag, moveFrom, moveTo, addChildTags, addAtIndices, removeFrom);
+
+    const std::vector<int64_t> expected{14, 10, 20, 12, 13};
+    Assert::IsTrue(expected == ui.List().m_children);
+    Assert::IsTrue(expected == ui.ListViewChildren());
+    Assert::IsTrue(expected == ui.NativeManager.LayoutChildren[ListTag]);
+    Assert::AreEqual(static_cast<size_t>(1), ui.NativeManager.SpliceCount);
+
+    Assert::AreEqual(ListTag, ui.Manager->GetShadowNodeForTag(14).m_parent);
+    Assert::AreEqual(ListTag, ui.Manager->GetShadowNodeForTag(20).m_parent);
+    Assert::IsNull(ui.Manager->FindShadowNodeForTag(11));
+  }
+
+  TEST_METHOD(UIManagerManageChildren_AcceptsNullArrays) {
+    ListUIManager ui;
+    ui.CreateView(10);
+
+    folly::dynamic none = nullptr;
+    folly::dynamic addChildTags = folly::dynamic::array(10);
+    folly::dynamic addAtIndices = folly::dynamic::array(0);
+    ui.Manager->manageChildren(ListTag, none, none, addChildTags, addAtIndices, none);
+
+    Assert::IsTrue(std::vector<int64_t>{10} == ui.List().m_children);
+    Assert::IsTrue(std::vector<int64_t>{10} == ui.ListViewChildren());
+  }
+
+  TEST_METHOD(UIManagerManageChildren_RemovesAllSubviews) {
+    ListUIManager ui;
+    for (int64_t tag : {10, 11, 12}) {
+      ui.CreateView(tag);
+    }
+
+    ui.Manager->setChildren(ListTag, folly::dynamic::array(10, 11, 12));
+    ui.Manager->removeSubviewsFromContainerWithID(ListTag);
+
+    Assert::IsTrue(ui.List().m_children.empty());
+    Assert::IsTrue(ui.ListViewChildren().empty());
+    Assert::IsTrue(ui.NativeManager.LayoutChildren[ListTag].empty());
+    Assert::IsNull(ui.Manager->FindShadowNodeForTag(10));
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(UIManagerManageChildren_TimeFlatListScroll) {
+    // Replays the manageChildren calls of a FlatList scrolled down by one
+    // batch of 10 rows per call: the list keeps a window of 200 rows, drops
+    // the 10 rows that leave the window at the top, and adds 10 new rows at
+    // the bottom.
+    constexpr int64_t windowSize = 200;
+    constexpr int64_t batchSize = 10;
+    constexpr int callCount = 2000;
+    ListUIManager ui;
+    int64_t nextTag = 1000;
+    folly::dynamic initialChildren = folly::dynamic::array();
+    for (int64_t i = 0; i < windowSize; ++i) {
+      ui.CreateView(nextTag);
+      initialChildren.push_back(nextTag++);
+    }
+
+    ui.Manager->setChildren(ListTag, std::move(initialChildren));
+
+    folly::dynamic none = nullptr;
+    folly::dynamic removeFrom = folly::dynamic::array();
+    folly::dynamic addAtIndices = folly::dynamic::array();
+    for (int64_t i = 0; i < batchSize; ++i) {
+      removeFrom.push_back(i);
+      addAtIndices.push_back(windowSize - batchSize + i);
+    }
+
+    Mso::UnitTests::PerfTimer manageChildrenTimer;
+    for (int call = 0; call < callCount; ++call) {
+      folly::dynamic addChildTags = folly::dynamic::array();
+      for (int64_t i = 0; i < batchSize; ++i) {
+        ui.CreateView(nextTag);
+        addChildTags.push_back(nextTag++);
+      }
+
+      manageChildrenTimer.Start();
+      ui.Manager->manageChildren(ListTag, none, none, addChildTags, addAtIndices, removeFrom);
+      manageChildrenTimer.Stop();
+    }
+
+    Assert::AreEqual(static_cast<size_t>(windowSize), ui.List().m_children.size());
+    Assert::AreEqual(nextTag - 1, ui.List().m_children.back());
+
+    const std::string parameters = "window=" + std::to_string(windowSize) + "; batch=" + std::to_string(batchSize);
+    const std::string result = Mso::UnitTests::FormatPerfResult(
+        "UIManagerManageChildren_TimeFlatListScroll", parameters, callCount, manageChildrenTimer.Ticks());
+    Logger::WriteMessage(result.c_str());
+  }
+
+#endif // PERF_TESTS
+};
+
+TEST_CLASS (UIManagerCreateViewTests) {
+  TEST_METHOD(UIManagerCreateView_UsesViewManagerOfClassName) {
+    ManyClassesUIManager ui{40};
+    for (int64_t tag = 10; tag < 50; ++tag) {
+      ui.Manager->createView(tag, std::string{ui.ClassNames[static_cast<size_t>(tag) % 40]}, RootTag, nullptr);
+    }
+
+    for (int64_t tag = 10; tag < 50; ++tag) {
+      auto &node = ui.Manager->GetShadowNodeForTag(tag);
+      Assert::AreEqual(ui.ClassNames[static_cast<size_t>(tag) % 40], node.m_className);
+      Assert::AreEqual(node.m_className.c_str(), node.m_viewManager->GetName());
+    }
+
+    Assert::AreEqual("ROOT", ui.Manager->GetShadowNodeForTag(RootTag).m_viewManager->GetName());
+    Assert::IsTrue(ui.Manager->getConstantsForViewManager("RCTClass7").isObject());
+    Assert::IsTrue(ui.Manager->getConstantsForViewManager("RCTUnknown").isNull());
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(UIManagerCreateView_TimeManyClassNames) {
+    constexpr size_t classCount = 40;
+    constexpr int64_t viewCount = 100000;
+    ManyClassesUIManager ui{classCount};
+    std::vector<std::string> classNames;
+    classNames.reserve(viewCount);
+    for (int64_t i = 0; i < viewCount; ++i) {
+      classNames.push_back(ui.ClassNames[static_cast<size_t>(i * 7) % classCount]);
+    }
+
+    const LONGLONG createViewTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int64_t i = 0; i < viewCount; ++i) {
+        ui.Manager->createView(1000 + i, std::move(classNames[static_cast<size_t>(i)]), RootTag, nullptr);
+      }
+    });
+
+    // The string compare scan that GetViewManager did before the name index.
+    std::vector<const char *> managerNames{"ROOT"};
+    for (const auto &className : ui.ClassNames) {
+      managerNames.push_back(className.c_str());
+    }
+
+    size_t scanCount = 0;
+    const LONGLONG scanTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int64_t i = 0; i < viewCount; ++i) {
+        const auto &className = ui.ClassNames[static_cast<size_t>(i * 7) % classCount];
+        for (auto name : managerNames) {
+          if (!strcmp(name, className.c_str())) {
+            ++scanCount;
+            break;
+          }
+        }
+      }
+    });
+
+    Assert::AreEqual(static_cast<size_t>(viewCount), scanCount);
+    const std::string parameters = "classes=" + std::to_string(classCount);
+    const std::string createViewResult = Mso::UnitTests::FormatPerfResult(
+        "UIManagerCreateView_TimeManyClassNames createView", parameters, viewCount, createViewTicks);
+    Logger::WriteMessage(createViewResult.c_str());
+    const std::string scanResult = Mso::UnitTests::FormatPerfResult(
+        "UIManagerCreateView_TimeManyClassNames linear scan lookup", parameters, viewCount, scanTicks);
+    Logger::WriteMessage(scanResult.c_str());
+  }
+
+#endif // PERF_TESTS
+};
+
 } // namespace Microsoft::React::Test
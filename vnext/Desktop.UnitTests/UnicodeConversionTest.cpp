@@ -2,13 +2,25 @@
 // Licensed under the MIT License.
 
 #include <CppUnitTest.h>
+#include <Windows.h>
+#include <random>
 #include <string>
+#include "Transcoder.h"
 #include "Unicode.h"
 #include "UnicodeTestStrings.h"
 
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#endif
+
+using Microsoft::Common::Unicode::MaxUtf16Length;
+using Microsoft::Common::Unicode::MaxUtf8Length;
+using Microsoft::Common::Unicode::TryUtf16ToUtf8;
+using Microsoft::Common::Unicode::TryUtf8ToUtf16;
 using Microsoft::Common::Unicode::Utf16ToUtf8;
 using Microsoft::Common::Unicode::Utf8ToUtf16;
 using Microsoft::VisualStudio::CppUnitTestFramework::Assert;
+using Microsoft::VisualStudio::CppUnitTestFramework::Logger;
 
 namespace Microsoft::React::Test {
 
@@ -99,7 +111,218 @@ TEST_CLASS (UnicodeConversionTest) {
     }
   }
 
+  TEST_METHOD(TranscoderAcceptsWellFormedInput) {
+    // Long enough to go through the vectorized ASCII path on both sides of the
+    // multi-byte sequences.
+    std::string ascii(100, 'a');
+    std::string utf8 = ascii + "\xc3\xa9" + ascii + "\xe2\x82\xac" + ascii + "\xf0\x9f\x98\x80" + ascii;
+    std::u16string utf16 = std::u16string(100, u'a') + u"\x00e9" + std::u16string(100, u'a') + u"\x20ac" +
+        std::u16string(100, u'a') + u"\xd83d\xde00" + std::u16string(100, u'a');
+
+    std::u16string utf16Result(MaxUtf16Length(utf8.length()), u'\0');
+    size_t utf16Length = 0;
+    Assert::IsTrue(TryUtf8ToUtf16(utf8.data(), utf8.length(), &utf16Result[0], utf16Length));
+    utf16Result.resize(utf16Length);
+    Assert::IsTrue(utf16Result == utf16);
+
+    std::string utf8Result(MaxUtf8Length(utf16.length()), '\0');
+    size_t utf8Length = 0;
+    Assert::IsTrue(TryUtf16ToUtf8(utf16.data(), utf16.length(), &utf8Result[0], utf8Length));
+    utf8Result.resize(utf8Length);
+    Assert::IsTrue(utf8Result == utf8);
+  }
+
+  TEST_METHOD(TranscoderRejectsIllFormedInput) {
+    char16_t utf16[8];
+    size_t length = 0;
+
+    Assert::IsFalse(TryUtf8ToUtf16("\xcc\x22\x3c", 3, utf16, length)); // Missing continuation byte
+    Assert::IsFalse(TryUtf8ToUtf16("\xc0\xaf", 2, utf16, length)); // Overlong encoding
+    Assert::IsFalse(TryUtf8ToUtf16("\xed\xa3\xa9", 3, utf16, length)); // Encoded surrogate
+    Assert::IsFalse(TryUtf8ToUtf16("\xf4\x90\x80\x80", 4, utf16, length)); // Above U+10FFFF
+    Assert::IsFalse(TryUtf8ToUtf16("\xe2\x82", 2, utf16, length)); // Truncated sequence
+
+    char utf8[16];
+    Assert::IsFalse(TryUtf16ToUtf8(u"\xd801\x0022", 2, utf8, length)); // High surrogate without low surrogate
+    Assert::IsFalse(TryUtf16ToUtf8(u"\xdc00\xd800", 2, utf8, length)); // Low surrogate first
+    Assert::IsFalse(TryUtf16ToUtf8(u"a\xd800", 2, utf8, length)); // Truncated surrogate pair
+  }
+
+  // Converts random sequences of valid code points and compares the result with
+  // the Windows API, which the conversion functions used before the fast path.
+  TEST_METHOD(FuzzValidCodePoints) {
+    std::mt19937 random{FuzzSeed};
+
+    for (uint32_t i = 0; i < FuzzIterations; ++i) {
+      std::wstring utf16 = RandomValidUtf16(random);
+      std::string utf8 = Utf16ToUtf8(utf16);
+
+      Assert::IsTrue(utf8 == Win32Utf16ToUtf8(utf16));
+      Assert::IsTrue(Utf8ToUtf16(utf8) == utf16);
+    }
+  }
+
+  // Random bytes are mostly ill-formed UTF-8. The result must match the U+FFFD
+  // replacement rules of the Windows API whether or not the fast path accepts them.
+  TEST_METHOD(FuzzRandomUtf8Bytes) {
+    std::mt19937 random{FuzzSeed};
+    std::uniform_int_distribution<size_t> lengths{0, 300};
+    std::uniform_int_distribution<int> bytes{0, 0xFF};
+
+    for (uint32_t i = 0; i < FuzzIterations; ++i) {
+      std::string utf8(lengths(random), '\0');
+      for (auto &c : utf8) {
+        // Favor ASCII so that multi-byte sequences are surrounded by ASCII runs.
+        int byte = bytes(random);
+        c = static_cast<char>(byte < 0xC0 ? byte & 0x7F : byte);
+      }
+
+      Assert::IsTrue(Utf8ToUtf16(utf8) == Win32Utf8ToUtf16(utf8));
+    }
+  }
+
+  // Random UTF-16 code units include unpaired surrogates.
+  TEST_METHOD(FuzzRandomUtf16Units) {
+    std::mt19937 random{FuzzSeed};
+    std::uniform_int_distribution<size_t> lengths{0, 300};
+    std::uniform_int_distribution<int> units{0, 0xFFFF};
+
+    for (uint32_t i = 0; i < FuzzIterations; ++i) {
+      std::wstring utf16(lengths(random), L'\0');
+      for (auto &c : utf16) {
+        int unit = units(random);
+        c = static_cast<wchar_t>(unit < 0xC000 ? unit & 0x7F : unit);
+      }
+
+      Assert::IsTrue(Utf16ToUtf8(utf16) == Win32Utf16ToUtf8(utf16));
+    }
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TimeUtf8ToUtf16Ascii) {
+    TimeConversions("TimeUtf8ToUtf16Ascii", std::string(PerfStringLength, 'a'), [](const std::string &s) {
+      return Utf8ToUtf16(s).length();
+    });
+  }
+
+  TEST_METHOD(TimeWin32Utf8ToUtf16Ascii) {
+    TimeConversions("TimeWin32Utf8ToUtf16Ascii", std::string(PerfStringLength, 'a'), [](const std::string &s) {
+      return Win32Utf8ToUtf16(s).length();
+    });
+  }
+
+  TEST_METHOD(TimeUtf16ToUtf8Ascii) {
+    TimeConversions("TimeUtf16ToUtf8Ascii", std::wstring(PerfStringLength, L'a'), [](const std::wstring &s) {
+      return Utf16ToUtf8(s).length();
+    });
+  }
+
+  TEST_METHOD(TimeWin32Utf16ToUtf8Ascii) {
+    TimeConversions("TimeWin32Utf16ToUtf8Ascii", std::wstring(PerfStringLength, L'a'), [](const std::wstring &s) {
+      return Win32Utf16ToUtf8(s).length();
+    });
+  }
+
+  TEST_METHOD(TimeUtf8ToUtf16Mixed) {
+    std::mt19937 random{FuzzSeed};
+    TimeConversions("TimeUtf8ToUtf16Mixed", Utf16ToUtf8(RandomValidUtf16(random)), [](const std::string &s) {
+      return Utf8ToUtf16(s).length();
+    });
+  }
+
+  TEST_METHOD(TimeUtf16ToUtf8Mixed) {
+    std::mt19937 random{FuzzSeed};
+    TimeConversions("TimeUtf16ToUtf8Mixed", RandomValidUtf16(random), [](const std::wstring &s) {
+      return Utf16ToUtf8(s).length();
+    });
+  }
+
+  template <typename TString, typename TConvert>
+  static void TimeConversions(const char *testName, const TString &input, TConvert &&convert) {
+    size_t total = 0;
+    const LONGLONG ticks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (uint32_t i = 0; i < PerfIterations; ++i) {
+        total += convert(input);
+      }
+    });
+
+    Assert::IsTrue(total > 0);
+    const std::string parameters = "len=" + std::to_string(input.length());
+    Logger::WriteMessage(Mso::UnitTests::FormatPerfResult(testName, parameters, PerfIterations, ticks).c_str());
+  }
+
+  static constexpr uint32_t PerfIterations = 10000;
+  static constexpr size_t PerfStringLength = 64 * 1024;
+
+#endif // PERF_TESTS
+
  private:
+  static std::wstring RandomValidUtf16(std::mt19937 & random) {
+    std::uniform_int_distribution<size_t> lengths{0, 300};
+    std::uniform_int_distribution<int> kinds{0, 4};
+    std::uniform_int_distribution<uint32_t> codePoints{0, 0x10FFFF};
+
+    std::wstring utf16;
+    for (size_t length = lengths(random); utf16.length() < length;) {
+      uint32_t codePoint = codePoints(random);
+      switch (kinds(random)) {
+        case 0:
+        case 1:
+          codePoint &= 0x7F;
+          break;
+        case 2:
+          codePoint = 0x80 + codePoint % (0x800 - 0x80);
+          break;
+        case 3:
+          codePoint = 0x800 + codePoint % (0x10000 - 0x800);
+          if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+            codePoint -= 0x800;
+          }
+          break;
+        default:
+          codePoint = 0x10000 + codePoint % (0x110000 - 0x10000);
+          break;
+      }
+
+      if (codePoint < 0x10000) {
+        utf16.push_back(static_cast<wchar_t>(codePoint));
+      } else {
+        codePoint -= 0x10000;
+        utf16.push_back(static_cast<wchar_t>(0xD800 | (codePoint >> 10)));
+        utf16.push_back(static_cast<wchar_t>(0xDC00 | (codePoint & 0x3FF)));
+      }
+    }
+
+    return utf16;
+  }
+
+  static std::wstring Win32Utf8ToUtf16(const std::string &utf8) {
+    if (utf8.empty()) {
+      return {};
+    }
+
+    const int length = static_cast<int>(utf8.length());
+    std::wstring utf16(::MultiByteToWideChar(CP_UTF8, 0, utf8.data(), length, nullptr, 0), L'\0');
+    ::MultiByteToWideChar(CP_UTF8, 0, utf8.data(), length, &utf16[0], static_cast<int>(utf16.length()));
+    return utf16;
+  }
+
+  static std::string Win32Utf16ToUtf8(const std::wstring &utf16) {
+    if (utf16.empty()) {
+      return {};
+    }
+
+    const int length = static_cast<int>(utf16.length());
+    std::string utf8(::WideCharToMultiByte(CP_UTF8, 0, utf16.data(), length, nullptr, 0, nullptr, nullptr), '\0');
+    ::WideCharToMultiByte(
+        CP_UTF8, 0, utf16.data(), length, &utf8[0], static_cast<int>(utf8.length()), nullptr, nullptr);
+    return utf8;
+  }
+
+  static constexpr uint32_t FuzzSeed = 0x5eed;
+  static constexpr uint32_t FuzzIterations = 10000;
+
   constexpr static const char *SimpleTestStringNoBomUtf8 = "\x61\x62\x63"; // abc
   constexpr static const wchar_t *SimpleTestStringNoBomUtf16 = L"\x0061\x0062\x0063"; // abc
   constexpr static const char *SimpleTestStringBomUtf8 = "\xef\xbb\xbf\x61\x62\x63"; // <UTF-8 BOM>abc
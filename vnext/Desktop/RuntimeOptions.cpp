@@ -1,43 +1,137 @@
 #include <RuntimeOptions.h>
 
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <unordered_map>
+#include <vector>
 
+using std::atomic;
 using std::lock_guard;
 using std::mutex;
 using std::string;
 
+using Microsoft::React::InvalidRuntimeOptionId;
+using Microsoft::React::RuntimeOptionId;
+
 namespace {
-std::unordered_map<string, int32_t> g_runtimeOptions;
+
+// Options are interned into a table of chunks so that reads by identifier never need the lock.
+// Chunks are added when the table grows and are never moved or freed, so readers can keep using them.
+// Values default to zero, which matches the default of both the boolean and the integer getters.
+constexpr size_t RuntimeOptionChunkSize = 1024;
+constexpr size_t MaxRuntimeOptionChunks = 1024;
+constexpr size_t MaxRuntimeOptions = RuntimeOptionChunkSize * MaxRuntimeOptionChunks;
+
+using RuntimeOptionChunk = std::array<atomic<int32_t>, RuntimeOptionChunkSize>;
+
+std::array<atomic<RuntimeOptionChunk *>, MaxRuntimeOptionChunks> g_runtimeOptionChunks{};
+std::vector<std::unique_ptr<RuntimeOptionChunk>> g_runtimeOptionChunkOwners;
+std::unordered_map<string, RuntimeOptionId> g_runtimeOptionIds;
 mutex g_runtimeOptionsMutex;
+
+atomic<int32_t> *RuntimeOptionValue(RuntimeOptionId id) noexcept {
+  if (id >= MaxRuntimeOptions)
+    return nullptr;
+
+  RuntimeOptionChunk *chunk = g_runtimeOptionChunks[id / RuntimeOptionChunkSize].load(std::memory_order_acquire);
+  return chunk ? &(*chunk)[id % RuntimeOptionChunkSize] : nullptr;
+}
+
+// Must be called with g_runtimeOptionsMutex held.
+bool EnsureRuntimeOptionChunk(size_t chunkIndex) noexcept {
+  if (g_runtimeOptionChunks[chunkIndex].load(std::memory_order_relaxed))
+    return true;
+
+  try {
+    g_runtimeOptionChunkOwners.push_back(std::make_unique<RuntimeOptionChunk>());
+  } catch (const std::bad_alloc &) {
+    return false;
+  }
+
+  g_runtimeOptionChunks[chunkIndex].store(g_runtimeOptionChunkOwners.back().get(), std::memory_order_release);
+  return true;
+}
+
+// Must be called with g_runtimeOptionsMutex held.
+RuntimeOptionId InternRuntimeOption(const string &name) noexcept {
+  auto itr = g_runtimeOptionIds.find(name);
+  if (itr != g_runtimeOptionIds.end())
+    return itr->second;
+
+  auto id = static_cast<RuntimeOptionId>(g_runtimeOptionIds.size());
+  if (id >= MaxRuntimeOptions || !EnsureRuntimeOptionChunk(id / RuntimeOptionChunkSize)) {
+    assert(false && "The runtime option table is full.");
+    return InvalidRuntimeOptionId;
+  }
+
+  try {
+    g_runtimeOptionIds.emplace(name, id);
+  } catch (const std::bad_alloc &) {
+    assert(false && "The runtime option could not be interned.");
+    return InvalidRuntimeOptionId;
+  }
+
+  return id;
+}
+
+// Must be called with g_runtimeOptionsMutex held.
+RuntimeOptionId FindRuntimeOption(const string &name) noexcept {
+  auto itr = g_runtimeOptionIds.find(name);
+  if (itr != g_runtimeOptionIds.end())
+    return itr->second;
+
+  return InvalidRuntimeOptionId;
+}
+
 } // namespace
 
 namespace Microsoft::React {
 
 void __cdecl SetRuntimeOptionBool(string &&name, bool value) noexcept {
   lock_guard<mutex> guard{g_runtimeOptionsMutex};
-  g_runtimeOptions.insert_or_assign(std::move(name), value ? 1 : 0);
+  SetRuntimeOptionBool(InternRuntimeOption(name), value);
 }
 
 void __cdecl SetRuntimeOptionInt(string &&name, int32_t value) noexcept {
   lock_guard<mutex> guard{g_runtimeOptionsMutex};
-  g_runtimeOptions.insert_or_assign(std::move(name), value);
+  SetRuntimeOptionInt(InternRuntimeOption(name), value);
 }
 
 const bool __cdecl GetRuntimeOptionBool(const string &name) noexcept {
   lock_guard<mutex> guard{g_runtimeOptionsMutex};
-  auto itr = g_runtimeOptions.find(name);
-  if (itr != g_runtimeOptions.end())
-    return itr->second == 1;
-
-  return false;
+  return GetRuntimeOptionBool(FindRuntimeOption(name));
 }
 
 const int32_t __cdecl GetRuntimeOptionInt(const string &name) noexcept {
   lock_guard<mutex> guard{g_runtimeOptionsMutex};
-  auto itr = g_runtimeOptions.find(name);
-  if (itr != g_runtimeOptions.end())
-    return itr->second;
+  return GetRuntimeOptionInt(FindRuntimeOption(name));
+}
+
+const RuntimeOptionId __cdecl RegisterRuntimeOption(const string &name) noexcept {
+  lock_guard<mutex> guard{g_runtimeOptionsMutex};
+  return InternRuntimeOption(name);
+}
+
+void __cdecl SetRuntimeOptionBool(RuntimeOptionId id, bool value) noexcept {
+  SetRuntimeOptionInt(id, value ? 1 : 0);
+}
+
+void __cdecl SetRuntimeOptionInt(RuntimeOptionId id, int32_t value) noexcept {
+  if (auto optionValue = RuntimeOptionValue(id))
+    optionValue->store(value, std::memory_order_release);
+}
+
+const bool __cdecl GetRuntimeOptionBool(RuntimeOptionId id) noexcept {
+  return GetRuntimeOptionInt(id) == 1;
+}
+
+const int32_t __cdecl GetRuntimeOptionInt(RuntimeOptionId id) noexcept {
+  if (auto optionValue = RuntimeOptionValue(id))
+    return optionValue->load(std::memory_order_acquire);
 
   return 0;
 }
@@ -16,9 +16,12 @@ namespace Microsoft::React {
 
 /*static*/
 shared_ptr<IWebSocketResource> IWebSocketResource::Make(string &&urlString) {
-  if (!GetRuntimeOptionBool("UseBeastWebSocket")) {
+  static const RuntimeOptionId useBeastWebSocket = RegisterRuntimeOption("UseBeastWebSocket");
+  static const RuntimeOptionId acceptSelfSigned = RegisterRuntimeOption("WebSocket.AcceptSelfSigned");
+
+  if (!GetRuntimeOptionBool(useBeastWebSocket)) {
     std::vector<winrt::Windows::Security::Cryptography::Certificates::ChainValidationResult> certExceptions;
-    if (GetRuntimeOptionBool("WebSocket.AcceptSelfSigned")) {
+    if (GetRuntimeOptionBool(acceptSelfSigned)) {
       certExceptions.emplace_back(
           winrt::Windows::Security::Cryptography::Certificates::ChainValidationResult::Untrusted);
       certExceptions.emplace_back(
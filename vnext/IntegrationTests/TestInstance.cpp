@@ -121,6 +121,10 @@ void TestNativeUIManager::AddView(
     facebook::react::ShadowNode &childShadowNode,
     uint64_t index) {}
 
+void TestNativeUIManager::SpliceChildren(
+    facebook::react::ShadowNode &parentShadowNode,
+    const facebook::react::ChildrenSplice &splice) {}
+
 void TestNativeUIManager::RemoveView(facebook::react::ShadowNode &shadowNode, bool removeChildren) {}
 
 void TestNativeUIManager::ReplaceView(facebook::react::ShadowNode &shadowNode) {}
@@ -63,6 +63,9 @@ class TestNativeUIManager : public facebook::react::INativeUIManager {
       facebook::react::ShadowNode &parentShadowNode,
       facebook::react::ShadowNode &childShadowNode,
       uint64_t index) override;
+  void SpliceChildren(
+      facebook::react::ShadowNode &parentShadowNode,
+      const facebook::react::ChildrenSplice &splice) override;
   void RemoveView(facebook::react::ShadowNode &shadowNode, bool removeChildren = true) override;
   void ReplaceView(facebook::react::ShadowNode &shadowNode) override;
   void UpdateView(facebook::react::ShadowNode &shadowNode, folly::dynamic /*ReadableMap*/ props) override;
@@ -284,7 +284,8 @@ bool CompareJsPropertyIds(const ChakraObjectRef &jsPropId1, const ChakraObjectRe
   }
 
   if (type1 == JsPropertyIdTypeString) {
-    return GetPropertyName(jsPropId1) == GetPropertyName(jsPropId2);
+    // Chakra keeps one property id per name, so the names are equal only if the property ids are.
+    return static_cast<JsRef>(jsPropId1) == static_cast<JsRef>(jsPropId2);
   }
 
   if (type1 == JsPropertyIdTypeSymbol) {
@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <Modules/Animated/AnimatedEventRouter.h>
+#include <chrono>
+#include <map>
+#include <string>
+
+namespace react::uwp {
+
+namespace {
+
+constexpr int64_t ScrollViewTag = 11;
+constexpr int64_t ScrollYValueTag = 7;
+
+// Collects the animated values set by the router.
+struct AnimatedValues {
+  AnimatedEventRouter::AnimatedValueSetter Setter() {
+    return [this](int64_t animatedValueTag, double value) { Values[animatedValueTag] = value; };
+  }
+
+  std::map<int64_t, double> Values;
+};
+
+// The event props that ScrollView.js sends for every ScrollView: it has its own
+// handlers for all the scroll events, so they are all true.
+folly::dynamic ScrollViewEventProps() {
+  return folly::dynamic::object("onScroll", true)("onScrollBeginDrag", true)("onScrollEndDrag", true)(
+      "onMomentumScrollBegin", true)("onMomentumScrollEnd", true);
+}
+
+// Emits scroll events with EmitScrollViewEvent, like ScrollViewShadowNode, counting the calls to the bridge.
+struct ScrollEmitter {
+  explicit ScrollEmitter(const folly::dynamic &props) {
+    for (const auto &prop : props.items()) {
+      Filter.UpdateProperty(prop.first.getString(), prop.second);
+    }
+  }
+
+  void Emit(const AnimatedEventRouter &router, const char *registrationName, double y) {
+    EmitScrollViewEvent(
+        router,
+        ScrollViewTag,
+        GetEventNameId(registrationName),
+        Filter,
+        Now,
+        /*x:*/ 0,
+        y,
+        /*zoom:*/ 1,
+        [](bool isContentSize, bool isWidth) { return isContentSize ? (isWidth ? 300.0 : 4000.0) : 300.0; },
+        [this, registrationName]() { ++BridgeCallCounts[registrationName]; });
+  }
+
+  // Emits a drag of frameCount frames, 16 ms apart.
+  void Drag(const AnimatedEventRouter &router, int frameCount) {
+    Emit(router, "onScrollBeginDrag", 0);
+    for (int frame = 1; frame <= frameCount; ++frame) {
+      Now += std::chrono::milliseconds{16};
+      Emit(router, "onScroll", frame * 10.0);
+    }
+
+    Emit(router, "onScrollEndDrag", frameCount * 10.0);
+  }
+
+  JsEventFilter Filter{MakeScrollViewJsEventFilter()};
+  std::chrono::steady_clock::time_point Now{};
+  std::map<std::string, size_t> BridgeCallCounts;
+};
+
+} // namespace
+
+TEST_CLASS (AnimatedEventRouterTest) {
+  TEST_METHOD(InternsEventNames) {
+    TestCheckEqual(GetEventNameId("onScroll"), GetEventNameId(std::string{"onScroll"}));
+    TestCheck(GetEventNameId("onScroll") != GetEventNameId("onScrollBeginDrag"));
+    TestCheck(GetEventNameId("onScroll") != GetEventNameId("topScroll"));
+  }
+
+  TEST_METHOD(RoutesEventToMappedValues) {
+    AnimatedValues values;
+    AnimatedEventRouter router;
+    router.SetAnimatedValueSetter(values.Setter());
+    router.AddEventDriver(
+        ScrollViewTag,
+        GetEventNameId("onScroll"),
+        EventAnimationDriver(folly::dynamic::array("contentOffset", "y"), ScrollYValueTag));
+    router.AddEventDriver(
+        ScrollViewTag,
+        GetEventNameId("onScroll"),
+        EventAnimationDriver(folly::dynamic::array("contentSize", "height"), 8));
+    router.AddEventDriver(
+        ScrollViewTag, GetEventNameId("onScroll"), EventAnimationDriver(folly::dynamic::array("velocity", "y"), 9));
+
+    TestCheck(router.HasEventDrivers(ScrollViewTag, GetEventNameId("onScroll")));
+    TestCheck(!router.HasEventDrivers(ScrollViewTag, GetEventNameId("onScrollEndDrag")));
+    TestCheck(!router.HasEventDrivers(ScrollViewTag + 1, GetEventNameId("onScroll")));
+
+    ScrollEmitter emitter{ScrollViewEventProps()};
+    emitter.Emit(router, "onScroll", 42);
+    TestCheckEqual(42.0, values.Values[ScrollYValueTag]);
+    TestCheckEqual(4000.0, values.Values[8]);
+
+    // A ScrollView event has no velocity value.
+    TestCheckEqual(size_t{0}, values.Values.count(9));
+  }
+
+  TEST_METHOD(RemovesEventDrivers) {
+    AnimatedValues values;
+    AnimatedEventRouter router;
+    router.SetAnimatedValueSetter(values.Setter());
+    router.AddEventDriver(
+        ScrollViewTag,
+        GetEventNameId("onScroll"),
+        EventAnimationDriver(folly::dynamic::array("contentOffset", "y"), ScrollYValueTag));
+
+    router.RemoveEventDriver(ScrollViewTag, GetEventNameId("onScroll"), ScrollYValueTag + 1);
+    TestCheck(router.HasEventDrivers(ScrollViewTag, GetEventNameId("onScroll")));
+
+    router.RemoveEventDriver(ScrollViewTag, GetEventNameId("onScroll"), ScrollYValueTag);
+    TestCheck(!router.HasEventDrivers(ScrollViewTag, GetEventNameId("onScroll")));
+
+    ScrollEmitter emitter{ScrollViewEventProps()};
+    emitter.Emit(router, "onScroll", 42);
+    TestCheck(values.Values.empty());
+  }
+
+  TEST_METHOD(NativeDrivenScrollSendsOnlyDragEdgesToJs) {
+    AnimatedValues values;
+    AnimatedEventRouter router;
+    router.SetAnimatedValueSetter(values.Setter());
+    router.AddEventDriver(
+        ScrollViewTag,
+        GetEventNameId("onScroll"),
+        EventAnimationDriver(folly::dynamic::array("contentOffset", "y"), ScrollYValueTag));
+
+    // A ScrollView with an Animated.event onScroll mapping with the native driver and
+    // no scrollEventThrottle. Every frame sets the animated value.
+    ScrollEmitter emitter{ScrollViewEventProps()};
+    emitter.Drag(router, 120);
+    TestCheckEqual(1200.0, values.Values[ScrollYValueTag]);
+
+    // JS receives the first scroll event of the drag besides the drag events.
+    TestCheckEqual(size_t{1}, emitter.BridgeCallCounts["onScrollBeginDrag"]);
+    TestCheckEqual(size_t{1}, emitter.BridgeCallCounts["onScroll"]);
+    TestCheckEqual(size_t{1}, emitter.BridgeCallCounts["onScrollEndDrag"]);
+
+    emitter.Drag(router, 120);
+    TestCheckEqual(size_t{2}, emitter.BridgeCallCounts["onScroll"]);
+  }
+
+  TEST_METHOD(NativeDrivenScrollIsThrottled) {
+    AnimatedValues values;
+    AnimatedEventRouter router;
+    router.SetAnimatedValueSetter(values.Setter());
+    router.AddEventDriver(
+        ScrollViewTag,
+        GetEventNameId("onScroll"),
+        EventAnimationDriver(folly::dynamic::array("contentOffset", "y"), ScrollYValueTag));
+
+    // Like an Animated.FlatList, whose VirtualizedList handler still needs scroll events.
+    folly::dynamic props = ScrollViewEventProps();
+    props["scrollEventThrottle"] = 100;
+    ScrollEmitter emitter{props};
+    emitter.Drag(router, 120);
+    TestCheckEqual(1200.0, values.Values[ScrollYValueTag]);
+
+    // Frames are 16 ms apart, so JS receives frames 1, 8, 15, ..., 120.
+    TestCheckEqual(size_t{18}, emitter.BridgeCallCounts["onScroll"]);
+  }
+
+  TEST_METHOD(JsDrivenScrollIsNotThrottled) {
+    // Without native mappings every scroll event goes to JS, whatever the throttle.
+    AnimatedEventRouter router;
+    folly::dynamic props = ScrollViewEventProps();
+    props["scrollEventThrottle"] = 100;
+    ScrollEmitter emitter{props};
+    emitter.Drag(router, 120);
+
+    TestCheckEqual(size_t{120}, emitter.BridgeCallCounts["onScroll"]);
+  }
+
+  TEST_METHOD(EventsWithoutJsHandlersStayNative) {
+    AnimatedValues values;
+    AnimatedEventRouter router;
+    router.SetAnimatedValueSetter(values.Setter());
+    router.AddEventDriver(
+        ScrollViewTag,
+        GetEventNameId("onScroll"),
+        EventAnimationDriver(folly::dynamic::array("contentOffset", "y"), ScrollYValueTag));
+
+    folly::dynamic props = ScrollViewEventProps();
+    props["onScroll"] = false;
+    props["onScrollBeginDrag"] = nullptr;
+    ScrollEmitter emitter{props};
+    emitter.Drag(router, 120);
+
+    TestCheckEqual(1200.0, values.Values[ScrollYValueTag]);
+    TestCheckEqual(size_t{0}, emitter.BridgeCallCounts["onScroll"]);
+    TestCheckEqual(size_t{0}, emitter.BridgeCallCounts["onScrollBeginDrag"]);
+    TestCheckEqual(size_t{1}, emitter.BridgeCallCounts["onScrollEndDrag"]);
+  }
+};
+
+} // namespace react::uwp
@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <Modules/Animated/AnimatedNodeGraph.h>
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#include <string>
+#endif
+
+namespace react::uwp {
+
+namespace {
+
+size_t IndexOf(const std::vector<int64_t> &order, int64_t tag) {
+  return std::find(order.begin(), order.end(), tag) - order.begin();
+}
+
+// Value nodes 1 and 2 feed style nodes 11 and 12, which feed props nodes 21 and 22.
+// Value node 3 feeds addition node 4, which also depends on value node 1 and feeds style node 12.
+void AddStyleGraph(AnimatedNodeGraph &graph) {
+  for (int64_t tag : {1, 2, 3, 4, 11, 12}) {
+    graph.AddNode(tag, /*isPropsNode:*/ false);
+  }
+
+  graph.AddNode(21, /*isPropsNode:*/ true);
+  graph.AddNode(22, /*isPropsNode:*/ true);
+
+  // Connections are added child first, like Animated.js does.
+  graph.Connect(11, 21);
+  graph.Connect(12, 22);
+  graph.Connect(4, 12);
+  graph.Connect(1, 11);
+  graph.Connect(2, 11);
+  graph.Connect(1, 4);
+  graph.Connect(3, 4);
+}
+
+} // namespace
+
+TEST_CLASS (AnimatedNodeGraphTest) {
+  TEST_METHOD(OrdersParentsBeforeChildren) {
+    AnimatedNodeGraph graph;
+    AddStyleGraph(graph);
+
+    const auto &order = graph.TopologicalOrder();
+    TestCheckEqual(size_t{8}, order.size());
+    for (const auto &[parentTag, childTag] : std::vector<std::tuple<int64_t, int64_t>>{
+             {11, 21}, {12, 22}, {4, 12}, {1, 11}, {2, 11}, {1, 4}, {3, 4}}) {
+      TestCheck(IndexOf(order, parentTag) < IndexOf(order, childTag));
+    }
+  }
+
+  TEST_METHOD(DirtyNodesReachOnlyDependentPropsNodes) {
+    AnimatedNodeGraph graph;
+    AddStyleGraph(graph);
+    TestCheck(!graph.HasDirtyNodes());
+    TestCheck(graph.TakeDirtyPropsNodes().empty());
+
+    graph.MarkDirty(2);
+    TestCheck(graph.HasDirtyNodes());
+    TestCheck(graph.TakeDirtyPropsNodes() == std::vector<int64_t>{21});
+    TestCheck(!graph.HasDirtyNodes());
+
+    graph.MarkDirty(3);
+    TestCheck(graph.TakeDirtyPropsNodes() == std::vector<int64_t>{22});
+
+    // Node 1 reaches both props nodes, and each of them is returned once.
+    graph.MarkDirty(1);
+    graph.MarkDirty(4);
+    auto propsNodes = graph.TakeDirtyPropsNodes();
+    std::sort(propsNodes.begin(), propsNodes.end());
+    TestCheck(propsNodes == (std::vector<int64_t>{21, 22}));
+
+    // A props node can be marked dirty directly.
+    graph.MarkDirty(22);
+    TestCheck(graph.TakeDirtyPropsNodes() == std::vector<int64_t>{22});
+  }
+
+  TEST_METHOD(DisconnectsAndRemovesNodes) {
+    AnimatedNodeGraph graph;
+    AddStyleGraph(graph);
+
+    graph.Disconnect(4, 12);
+    graph.MarkDirty(3);
+    TestCheck(graph.TakeDirtyPropsNodes().empty());
+
+    graph.MarkDirty(11);
+    graph.RemoveNode(11);
+    TestCheck(!graph.HasNode(11));
+    TestCheck(!graph.HasDirtyNodes());
+
+    graph.MarkDirty(1);
+    TestCheck(graph.TakeDirtyPropsNodes().empty());
+    TestCheckEqual(size_t{7}, graph.TopologicalOrder().size());
+
+    // Connecting a new parent after its child reorders the graph.
+    graph.AddNode(5, /*isPropsNode:*/ false);
+    graph.Connect(5, 1);
+    const auto &order = graph.TopologicalOrder();
+    TestCheck(IndexOf(order, 5) < IndexOf(order, 1));
+    TestCheck(IndexOf(order, 1) < IndexOf(order, 4));
+
+    graph.MarkDirty(5);
+    TestCheck(graph.TakeDirtyPropsNodes().empty());
+    graph.Connect(4, 12);
+    graph.MarkDirty(5);
+    TestCheck(graph.TakeDirtyPropsNodes() == std::vector<int64_t>{22});
+  }
+
+  TEST_METHOD(TracksAnimationsByLeadNode) {
+    AnimatedNodeGraph graph;
+    TestCheck(graph.TrackingAnimations(1).empty());
+
+    graph.AddTrackingAnimation(/*leadTag:*/ 1, /*animationId:*/ 100);
+    graph.AddTrackingAnimation(/*leadTag:*/ 1, /*animationId:*/ 101);
+    graph.AddTrackingAnimation(/*leadTag:*/ 2, /*animationId:*/ 102);
+    TestCheck(graph.TrackingAnimations(1) == (std::vector<int64_t>{100, 101}));
+    TestCheck(graph.TrackingAnimations(2) == std::vector<int64_t>{102});
+
+    // Tracking another lead moves the animation.
+    graph.AddTrackingAnimation(/*leadTag:*/ 2, /*animationId:*/ 100);
+    TestCheck(graph.TrackingAnimations(1) == std::vector<int64_t>{101});
+    TestCheck(graph.TrackingAnimations(2) == (std::vector<int64_t>{102, 100}));
+
+    graph.RemoveTrackingAnimation(101);
+    graph.RemoveTrackingAnimation(101);
+    TestCheck(graph.TrackingAnimations(1).empty());
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TimeDirtyPropsNodeUpdates) {
+    // 1000 nodes: 250 chains of value -> interpolation -> style -> props, where
+    // each interpolation also depends on the value node of the previous chain.
+    constexpr int64_t chainCount = 250;
+    constexpr int frameCount = 1000;
+    AnimatedNodeGraph graph;
+    std::vector<int64_t> propsTags;
+    for (int64_t chain = 0; chain < chainCount; ++chain) {
+      const int64_t valueTag = chain * 4;
+      graph.AddNode(valueTag, false);
+      graph.AddNode(valueTag + 1, false);
+      graph.AddNode(valueTag + 2, false);
+      graph.AddNode(valueTag + 3, true);
+      graph.Connect(valueTag + 2, valueTag + 3);
+      graph.Connect(valueTag + 1, valueTag + 2);
+      graph.Connect(valueTag, valueTag + 1);
+      if (chain > 0) {
+        graph.Connect(valueTag - 4, valueTag + 1);
+      }
+
+      propsTags.push_back(valueTag + 3);
+    }
+
+    // Each frame one value node changes.
+    size_t dirtyUpdateCount = 0;
+    const LONGLONG dirtyTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int frame = 0; frame < frameCount; ++frame) {
+        graph.MarkDirty((frame % chainCount) * 4);
+        dirtyUpdateCount += graph.TakeDirtyPropsNodes().size();
+      }
+    });
+
+    // Before the graph every props node was updated.
+    size_t allUpdateCount = 0;
+    const LONGLONG allTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int frame = 0; frame < frameCount; ++frame) {
+        for (const auto tag : propsTags) {
+          allUpdateCount += graph.HasNode(tag) ? 1 : 0;
+        }
+      }
+    });
+
+    TestCheck(dirtyUpdateCount <= frameCount * 2);
+    const std::string nodes = "nodes=" + std::to_string(chainCount * 4);
+    Mso::UnitTests::PrintPerfResult(
+        "TimeDirtyPropsNodeUpdates dirty",
+        nodes + "; updates=" + std::to_string(dirtyUpdateCount),
+        frameCount,
+        dirtyTicks);
+    Mso::UnitTests::PrintPerfResult(
+        "TimeDirtyPropsNodeUpdates all", nodes + "; updates=" + std::to_string(allUpdateCount), frameCount, allTicks);
+  }
+
+  TEST_METHOD(TimeTrackingLookup) {
+    // 1000 tracking animations spread over 250 lead nodes.
+    constexpr int64_t animationCount = 1000;
+    constexpr int64_t leadCount = 250;
+    constexpr int lookupCount = 10000;
+    AnimatedNodeGraph graph;
+    std::vector<std::tuple<int64_t, int64_t>> trackingAndLeadNodeTags;
+    for (int64_t animationId = 0; animationId < animationCount; ++animationId) {
+      graph.AddTrackingAnimation(animationId % leadCount, animationId);
+      trackingAndLeadNodeTags.emplace_back(animationId, animationId % leadCount);
+    }
+
+    size_t graphCount = 0;
+    const LONGLONG graphTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int i = 0; i < lookupCount; ++i) {
+        graphCount += graph.TrackingAnimations(i % leadCount).size();
+      }
+    });
+
+    // The linear scan StartAnimatingNode used before.
+    size_t scanCount = 0;
+    const LONGLONG scanTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int i = 0; i < lookupCount; ++i) {
+        for (const auto &trackingAndLead : trackingAndLeadNodeTags) {
+          scanCount += std::get<1>(trackingAndLead) == i % leadCount ? 1 : 0;
+        }
+      }
+    });
+
+    TestCheckEqual(scanCount, graphCount);
+    const std::string animations = "animations=" + std::to_string(animationCount);
+    Mso::UnitTests::PrintPerfResult("TimeTrackingLookup graph", animations, lookupCount, graphTicks);
+    Mso::UnitTests::PrintPerfResult("TimeTrackingLookup scan", animations, lookupCount, scanTicks);
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace react::uwp
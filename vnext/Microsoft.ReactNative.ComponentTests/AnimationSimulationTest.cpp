@@ -0,0 +1,291 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <Modules/Animated/AnimationSimulation.h>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#include <string>
+#endif
+
+namespace react::uwp {
+
+namespace {
+
+// The per-frame sampling that CalculatedAnimationDriver used before the
+// simulations: 60 Hz samples until the animation is done, without the sample
+// at time 0.
+template <typename TGetValueAndVelocity, typename TIsDone>
+std::vector<float> SampleEveryFrame(TGetValueAndVelocity &&getValueAndVelocity, TIsDone &&isDone) {
+  std::vector<float> keyFrames;
+  double time = 0;
+  for (bool done = false; !done;) {
+    time += 1.0f / 60.0f;
+    auto [currentValue, currentVelocity] = getValueAndVelocity(time);
+    keyFrames.push_back(currentValue);
+    done = isDone(currentValue, currentVelocity);
+  }
+
+  return keyFrames;
+}
+
+std::vector<float> SampleSpringEveryFrame(const SpringConfig &config) {
+  const auto getValueAndVelocity = [&config](double time) {
+    const auto toValue = [&config, time]() {
+      const auto frameFromTime = static_cast<int>(time * 60.0);
+      if (frameFromTime < static_cast<int>(config.toValueFrames.size())) {
+        return config.fromValue + (config.toValueFrames[frameFromTime] * (config.toValue - config.fromValue));
+      }
+      return config.toValue;
+    }();
+    const auto c = config.damping;
+    const auto m = config.mass;
+    const auto k = config.stiffness;
+    const auto v0 = -config.initialVelocity;
+
+    const auto zeta = c / (2 * std::sqrt(k * m));
+    const auto omega0 = std::sqrt(k / m);
+    const auto omega1 = omega0 * std::sqrt(1.0 - (zeta * zeta));
+    const auto x0 = toValue - config.fromValue;
+
+    if (zeta < 1) {
+      const auto envelope = std::exp(-zeta * omega0 * time);
+      const auto value = static_cast<float>(
+          toValue -
+          envelope * ((v0 + zeta * omega0 * x0) / omega1 * std::sin(omega1 * time) + x0 * std::cos(omega1 * time)));
+      const auto velocity = zeta * omega0 * envelope *
+              (std::sin(omega1 * time) * (v0 + zeta * omega0 * x0) / omega1 + x0 * std::cos(omega1 * time)) -
+          envelope * (std::cos(omega1 * time) * (v0 + zeta * omega0 * x0) - omega1 * x0 * std::sin(omega1 * time));
+      return std::make_tuple(value, velocity);
+    } else {
+      const auto envelope = std::exp(-omega0 * time);
+      const auto value = static_cast<float>(toValue - envelope * (x0 + (v0 + omega0 * x0) * time));
+      const auto velocity = envelope * (v0 * (time * omega0 - 1) + time * x0 * (omega0 * omega0));
+      return std::make_tuple(value, velocity);
+    }
+  };
+
+  const auto isDone = [&config](double currentValue, double currentVelocity) {
+    const bool isAtRest = std::abs(currentVelocity) <= config.restSpeedThreshold &&
+        (std::abs(currentValue - config.toValue) <= config.restDisplacementThreshold || config.stiffness == 0);
+    const bool isOvershooting = config.stiffness > 0 &&
+        ((config.fromValue < config.toValue && currentValue > config.toValue) ||
+         (config.fromValue > config.toValue && currentValue < config.toValue));
+    return isAtRest || (config.overshootClamping && isOvershooting);
+  };
+
+  return SampleEveryFrame(getValueAndVelocity, isDone);
+}
+
+std::vector<float> SampleDecayEveryFrame(const DecayConfig &config) {
+  const auto toValue = config.fromValue + config.velocity / (1 - config.deceleration);
+  const auto getValueAndVelocity = [&config](double time) {
+    const auto value = config.fromValue +
+        config.velocity / (1 - config.deceleration) * (1 - std::exp(-(1 - config.deceleration) * (1000 * time)));
+    return std::make_tuple(static_cast<float>(value), 42.0f);
+  };
+
+  return SampleEveryFrame(
+      getValueAndVelocity, [toValue](double currentValue, double) { return std::abs(toValue - currentValue) < 0.1; });
+}
+
+SpringConfig MakeSpringConfig(double stiffness, double damping, double mass, double initialVelocity = 0) {
+  SpringConfig config;
+  config.fromValue = 0;
+  config.toValue = 100;
+  config.stiffness = stiffness;
+  config.damping = damping;
+  config.mass = mass;
+  config.initialVelocity = initialVelocity;
+  config.restSpeedThreshold = 0.001;
+  config.restDisplacementThreshold = 0.001;
+  return config;
+}
+
+std::vector<SpringConfig> SpringConfigs() {
+  std::vector<SpringConfig> configs{
+      MakeSpringConfig(100, 10, 1), // Animated.spring defaults
+      MakeSpringConfig(170, 26, 1), // react-spring defaults
+      MakeSpringConfig(300, 5, 2, 10), // Bouncy, with an initial velocity
+      MakeSpringConfig(100, 20, 1), // Critically damped
+      MakeSpringConfig(100, 60, 1, -5), // Overdamped
+  };
+
+  auto clamped = MakeSpringConfig(100, 10, 1);
+  clamped.overshootClamping = true;
+  configs.push_back(std::move(clamped));
+
+  auto reversed = MakeSpringConfig(200, 15, 1);
+  reversed.fromValue = 250;
+  reversed.toValue = -50;
+  configs.push_back(std::move(reversed));
+
+  auto animatedTarget = MakeSpringConfig(100, 10, 1);
+  for (int i = 0; i <= 30; ++i) {
+    animatedTarget.toValueFrames.push_back(i / 30.0);
+  }
+  configs.push_back(std::move(animatedTarget));
+
+  return configs;
+}
+
+std::vector<DecayConfig> DecayConfigs() {
+  return {{0, 1, 0.998}, {50, -2.5, 0.997}, {0, 0.05, 0.99}, {10, 0, 0.998}};
+}
+
+// Value of the linear interpolation between key frames at the given time.
+double Interpolate(const std::vector<AnimationKeyFrame> &keyFrames, double time) {
+  for (size_t i = 1; i < keyFrames.size(); ++i) {
+    if (time <= keyFrames[i].time) {
+      const auto &start = keyFrames[i - 1];
+      const auto &end = keyFrames[i];
+      return start.value + (end.value - start.value) * (time - start.time) / (end.time - start.time);
+    }
+  }
+
+  return keyFrames.back().value;
+}
+
+void TestCheckMatchesEveryFrame(const std::vector<AnimationKeyFrame> &keyFrames, const std::vector<float> &expected) {
+  // The simulation also returns the sample at time 0.
+  TestCheckEqual(expected.size() + 1, keyFrames.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    TestCheck(std::abs(keyFrames[i + 1].value - expected[i]) < 1e-3);
+    TestCheck(std::abs(keyFrames[i + 1].time - (i + 1) / 60.0) < 1e-6);
+  }
+}
+
+} // namespace
+
+TEST_CLASS (AnimationSimulationTest) {
+  TEST_METHOD(SpringMatchesPerFrameSampling) {
+    for (const auto &config : SpringConfigs()) {
+      const auto keyFrames = SimulateKeyFrames(SpringSimulation(config), SimulationOptions{});
+      TestCheckEqual(static_cast<float>(config.fromValue), keyFrames.front().value);
+      TestCheckMatchesEveryFrame(keyFrames, SampleSpringEveryFrame(config));
+    }
+  }
+
+  TEST_METHOD(DecayMatchesPerFrameSampling) {
+    for (const auto &config : DecayConfigs()) {
+      const auto keyFrames = SimulateKeyFrames(DecaySimulation(config), SimulationOptions{});
+      TestCheckEqual(static_cast<float>(config.fromValue), keyFrames.front().value);
+      TestCheckMatchesEveryFrame(keyFrames, SampleDecayEveryFrame(config));
+    }
+  }
+
+  TEST_METHOD(RestTimeBoundsDuration) {
+    for (const auto &config : SpringConfigs()) {
+      SpringSimulation simulation(config);
+      const auto keyFrames = SimulateKeyFrames(simulation, SimulationOptions{});
+      TestCheck(keyFrames.back().time <= simulation.RestTime() + 1 / 60.0);
+      TestCheck(simulation.IsDone(simulation.StateAt(simulation.RestTime())));
+    }
+
+    for (const auto &config : DecayConfigs()) {
+      DecaySimulation simulation(config);
+      const auto keyFrames = SimulateKeyFrames(simulation, SimulationOptions{});
+      TestCheck(keyFrames.back().time <= simulation.RestTime() + 1 / 60.0);
+    }
+  }
+
+  TEST_METHOD(UndampedSpringStopsAtMaxDuration) {
+    SpringSimulation simulation(MakeSpringConfig(100, 0, 1));
+    TestCheck(std::isinf(simulation.RestTime()));
+
+    SimulationOptions options;
+    options.maxDuration = 2;
+    const auto keyFrames = SimulateKeyFrames(simulation, options);
+    TestCheck(std::abs(keyFrames.back().time - 2 - 1 / 60.0) < 1e-6);
+  }
+
+  TEST_METHOD(ReducedKeyFramesStayWithinTolerance) {
+    constexpr double tolerance = 0.1;
+    for (const auto &config : SpringConfigs()) {
+      SpringSimulation simulation(config);
+      const auto keyFrames = SimulateKeyFrames(simulation, SimulationOptions{});
+
+      SimulationOptions options;
+      options.tolerance = tolerance;
+      const auto reduced = SimulateKeyFrames(simulation, options);
+
+      TestCheck(reduced.size() < keyFrames.size());
+      TestCheckEqual(keyFrames.front().time, reduced.front().time);
+      TestCheckEqual(keyFrames.back().time, reduced.back().time);
+      TestCheckEqual(keyFrames.back().value, reduced.back().value);
+      for (const auto &keyFrame : keyFrames) {
+        TestCheck(std::abs(Interpolate(reduced, keyFrame.time) - keyFrame.value) <= tolerance + 1e-6);
+      }
+    }
+  }
+
+  TEST_METHOD(ReduceKeyFramesKeepsLinearEnds) {
+    std::vector<AnimationKeyFrame> line{{0, 0}, {1, 1}, {2, 2}, {3, 3}};
+    auto reduced = ReduceKeyFrames(line, 0.001);
+    TestCheckEqual(size_t{2}, reduced.size());
+    TestCheckEqual(3.0, reduced.back().time);
+
+    std::vector<AnimationKeyFrame> peak{{0, 0}, {1, 1}, {2, 0}};
+    TestCheckEqual(size_t{3}, ReduceKeyFrames(peak, 0.001).size());
+  }
+
+  TEST_METHOD(FrameRateDoesNotChangeCurve) {
+    SimulationOptions options;
+    options.frameRate = 144;
+
+    for (const auto &config : SpringConfigs()) {
+      SpringSimulation simulation(config);
+      const auto at60Hz = SimulateKeyFrames(simulation, SimulationOptions{});
+      const auto at144Hz = SimulateKeyFrames(simulation, options);
+
+      TestCheck(std::abs(at60Hz.back().time - at144Hz.back().time) <= 1 / 60.0);
+      for (const auto &keyFrame : at144Hz) {
+        TestCheck(std::abs(simulation.StateAt(keyFrame.time).value - keyFrame.value) < 1e-3);
+      }
+    }
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TimeManySprings) {
+    constexpr int springCount = 1000;
+    std::vector<SpringConfig> configs;
+    for (int i = 0; i < springCount; ++i) {
+      configs.push_back(MakeSpringConfig(50 + i % 300, 5 + i % 30, 1 + (i % 3), i % 7));
+    }
+
+    size_t perFrameCount = 0;
+    const LONGLONG perFrameTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (const auto &config : configs) {
+        perFrameCount += SampleSpringEveryFrame(config).size();
+      }
+    });
+
+    SimulationOptions options;
+    options.frameRate = 120;
+    options.tolerance = 0.1;
+
+    size_t simulatedCount = 0;
+    const LONGLONG simulatedTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (const auto &config : configs) {
+        simulatedCount += SimulateKeyFrames(SpringSimulation(config), options).size();
+      }
+    });
+
+    Mso::UnitTests::PrintPerfResult(
+        "TimeManySprings per frame", "keyFrames=" + std::to_string(perFrameCount), springCount, perFrameTicks);
+    Mso::UnitTests::PrintPerfResult(
+        "TimeManySprings simulated at 120 Hz",
+        "keyFrames=" + std::to_string(simulatedCount),
+        springCount,
+        simulatedTicks);
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace react::uwp
@@ -0,0 +1,264 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <Executors/JsonParser.h>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#endif
+
+namespace Microsoft::React {
+
+namespace {
+
+// A flushed queue batch captured from RNTester: [moduleIds, methodIds, params, callId].
+constexpr const char *BridgeBatch =
+    R"([[12,12,12,12,12,12,12,4,12,12],[8,8,8,9,9,9,7,1,10,11],)"
+    R"([[41,"RCTView",11,{"flex":1,"backgroundColor":-1,"style":{"paddingTop":24.5}}],)"
+    R"([43,"RCTText",11,{"accessible":true,"allowFontScaling":true,"ellipsizeMode":"tail"}],)"
+    R"([45,"RCTRawText",11,{"text":"Welcome to \"RNTester\" \u2014 caf\u00e9 \ud83d\ude00\n"}],)"
+    R"([43,[45]],[41,[43]],[11,[41],[0]],)"
+    R"(["Timing","createTimer",[7,100,1602540000000.25,false]],)"
+    R"([41,{"transform":[{"translateX":0},{"scale":1.5}],"opacity":0.75}]],)"
+    R"(1234])";
+
+// Returns true if both parsers fail, or if both succeed with the same value.
+bool ParsesLikeFolly(const std::string &jsonText) {
+  folly::dynamic expected;
+  bool isExpectedValid = true;
+  try {
+    expected = folly::parseJson(jsonText);
+  } catch (const std::exception &) {
+    isExpectedValid = false;
+  }
+
+  folly::dynamic fastResult;
+  if (TryParseJsonFast(jsonText, fastResult) && (!isExpectedValid || fastResult != expected)) {
+    return false;
+  }
+
+  try {
+    return isExpectedValid && ParseJson(jsonText) == expected;
+  } catch (const std::exception &) {
+    return !isExpectedValid;
+  }
+}
+
+class RandomJsonGenerator {
+ public:
+  RandomJsonGenerator(uint32_t seed) noexcept : m_random{seed} {}
+
+  folly::dynamic Value(int depth = 0) {
+    switch (Next(depth < 6 ? 8 : 6)) {
+      case 0:
+        return nullptr;
+      case 1:
+        return Next(2) == 0;
+      case 2:
+        return static_cast<int64_t>(m_random()) - static_cast<int64_t>(m_random());
+      case 3:
+        return static_cast<int64_t>(Next(100));
+      case 4:
+        return std::uniform_real_distribution<double>{-1e6, 1e6}(m_random) * std::pow(10.0, Next(40) - 20.0);
+      case 5:
+        return String();
+      case 6: {
+        folly::dynamic result = folly::dynamic::array;
+        for (uint32_t i = Next(6); i > 0; --i) {
+          result.push_back(Value(depth + 1));
+        }
+        return result;
+      }
+      default: {
+        folly::dynamic result = folly::dynamic::object;
+        for (uint32_t i = Next(6); i > 0; --i) {
+          result.insert(String(), Value(depth + 1));
+        }
+        return result;
+      }
+    }
+  }
+
+  // Changes, inserts, or removes a few bytes of the JSON text.
+  std::string Mutate(std::string jsonText) {
+    static const char s_bytes[] = "{}[]:,\"\\ 0123456789-.eE+tfnulx\x01\x80";
+    for (uint32_t i = Next(3) + 1; i > 0 && !jsonText.empty(); --i) {
+      const size_t position = Next(static_cast<uint32_t>(jsonText.size()));
+      const char byte = s_bytes[Next(sizeof(s_bytes) - 1)];
+      switch (Next(3)) {
+        case 0:
+          jsonText[position] = byte;
+          break;
+        case 1:
+          jsonText.insert(position, 1, byte);
+          break;
+        default:
+          jsonText.resize(position);
+          break;
+      }
+    }
+
+    return jsonText;
+  }
+
+  uint32_t Next(uint32_t bound) noexcept {
+    return std::uniform_int_distribution<uint32_t>{0, bound - 1}(m_random);
+  }
+
+ private:
+  std::string String() {
+    static const char *s_parts[] = {
+        "a", "b", "\"", "\\", "/", "\n", "\t", "\x01", " ", "{", "}", "[", "]", ":", ",", u8"\u00e9", u8"\u2014"};
+    std::string result;
+    for (uint32_t i = Next(12); i > 0; --i) {
+      result += s_parts[Next(static_cast<uint32_t>(std::size(s_parts)))];
+    }
+
+    return result;
+  }
+
+ private:
+  std::mt19937 m_random;
+};
+
+#ifdef PERF_TESTS
+
+// Builds a flushed queue batch with the given number of calls, shaped like the UIManager traffic.
+std::string MakeBatch(int callCount) {
+  folly::dynamic moduleIds = folly::dynamic::array;
+  folly::dynamic methodIds = folly::dynamic::array;
+  folly::dynamic params = folly::dynamic::array;
+  for (int i = 0; i < callCount; ++i) {
+    moduleIds.push_back(12);
+    methodIds.push_back(i % 3 == 0 ? 8 : 9);
+    params.push_back(
+        i % 3 == 0 ? folly::dynamic::array(
+                         i,
+                         "RCTView",
+                         11,
+                         folly::dynamic::object("flex", 1)("backgroundColor", -16777216)("opacity", 0.75)(
+                             "transform", folly::dynamic::array(folly::dynamic::object("translateX", i * 1.5))))
+                   : folly::dynamic::array(i, folly::dynamic::array(i + 1, i + 2), folly::dynamic::array(0, 1)));
+  }
+
+  return folly::toJson(folly::dynamic::array(moduleIds, methodIds, params, callCount));
+}
+
+#endif // PERF_TESTS
+
+} // namespace
+
+TEST_CLASS (JsonParserTest) {
+  TEST_METHOD(MatchesParseJson) {
+    TestCheck(folly::parseJson(BridgeBatch) == ParseJson(BridgeBatch));
+
+    folly::dynamic result;
+    TestCheck(TryParseJsonFast(BridgeBatch, result));
+    TestCheck(folly::parseJson(BridgeBatch) == result);
+  }
+
+  TEST_METHOD(ParsesValues) {
+    for (const char *jsonText :
+         {"0",
+          "-0",
+          "-12.5e-3",
+          "1E+2",
+          "9223372036854775807",
+          "-9223372036854775808",
+          "true",
+          "false",
+          "null",
+          "\"\"",
+          R"("\"\\\/\b\f\n\r\t\u0041\u00e9\u2014\ud83d\ude00")",
+          " [ 1 , { } , [ ] , \"\" ]\r\n",
+          R"({"a":1,"a":2})",
+          R"({"\u0061":[true,false,null]})"}) {
+      folly::dynamic result;
+      TestCheck(TryParseJsonFast(jsonText, result));
+      TestCheck(folly::parseJson(jsonText) == result);
+    }
+  }
+
+  TEST_METHOD(ParsesStringsAcrossBlocks) {
+    // Escapes and quotes around the 64-byte block boundaries of the structural index.
+    for (size_t padding = 56; padding < 72; ++padding) {
+      for (const char *tail : {R"(\"")", R"(\\")", R"(\\\"x")", R"(",1)"}) {
+        const std::string jsonText = "[\"" + std::string(padding, 'x') + tail + "]";
+        TestCheck(ParsesLikeFolly(jsonText));
+      }
+    }
+  }
+
+  TEST_METHOD(FallsBackToParseJson) {
+    // The fast path leaves these to folly::parseJson: integer overflow, unpaired surrogates, and deep nesting.
+    for (const std::string &jsonText :
+         {std::string{"9223372036854775808"},
+          std::string{R"("\ud83d")"},
+          std::string(80, '[') + std::string(80, ']')}) {
+      folly::dynamic result;
+      TestCheck(!TryParseJsonFast(jsonText, result));
+      TestCheck(ParsesLikeFolly(jsonText));
+    }
+  }
+
+  TEST_METHOD(ThrowsLikeParseJson) {
+    for (const char *jsonText :
+         {"", " ", "tru", "truex", "-", "1 2", "[1 2]", "[1,]", "{\"a\" 1}", "{\"a\":}", "[1]x", "\"abc", "\"\\x\"",
+          "1\"a\"", "[", "]", "{", "}"}) {
+      folly::dynamic result;
+      TestCheck(!TryParseJsonFast(jsonText, result));
+      TestCheckException(std::runtime_error, ParseJson(jsonText));
+    }
+  }
+
+  TEST_METHOD(FuzzAgainstParseJson) {
+    RandomJsonGenerator generator{20201018};
+    for (int i = 0; i < 5000; ++i) {
+      const std::string jsonText = folly::toJson(generator.Value());
+
+      folly::dynamic result;
+      TestCheck(TryParseJsonFast(jsonText, result));
+      TestCheck(ParsesLikeFolly(jsonText));
+      TestCheck(ParsesLikeFolly(generator.Mutate(jsonText)));
+    }
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TimeBridgeBatchCorpus) {
+    std::vector<std::string> corpus{BridgeBatch};
+    for (int callCount : {1, 10, 100, 1000}) {
+      corpus.push_back(MakeBatch(callCount));
+    }
+
+    for (const std::string &batch : corpus) {
+      const int iterationCount = static_cast<int>(100000000 / (batch.size() * 100) + 1);
+
+      const LONGLONG follyTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+        for (int i = 0; i < iterationCount; ++i) {
+          folly::parseJson(batch);
+        }
+      });
+
+      const LONGLONG fastTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+        for (int i = 0; i < iterationCount; ++i) {
+          ParseJson(batch);
+        }
+      });
+
+      TestCheck(folly::parseJson(batch) == ParseJson(batch));
+      const std::string parameters = "bytes=" + std::to_string(batch.size());
+      Mso::UnitTests::PrintPerfResult("TimeBridgeBatchCorpus folly::parseJson", parameters, iterationCount, follyTicks);
+      Mso::UnitTests::PrintPerfResult("TimeBridgeBatchCorpus ParseJson", parameters, iterationCount, fastTicks);
+    }
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace Microsoft::React
@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <DynamicReader.h>
+#include <DynamicWriter.h>
+#include <JsonTextReader.h>
+#include "CommonReaderTest.h"
+
+#ifdef PERF_TESTS
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace winrt::Microsoft::ReactNative {
+
+namespace {
+
+// Reads the whole value and writes it back, so that different readers can be compared.
+void CopyValue(IJSValueReader const &reader, IJSValueWriter const &writer) {
+  switch (reader.ValueType()) {
+    case JSValueType::Object: {
+      hstring propertyName;
+      writer.WriteObjectBegin();
+      while (reader.GetNextObjectProperty(propertyName)) {
+        writer.WritePropertyName(propertyName);
+        CopyValue(reader, writer);
+      }
+      writer.WriteObjectEnd();
+      break;
+    }
+    case JSValueType::Array:
+      writer.WriteArrayBegin();
+      while (reader.GetNextArrayItem()) {
+        CopyValue(reader, writer);
+      }
+      writer.WriteArrayEnd();
+      break;
+    case JSValueType::String:
+      writer.WriteString(reader.GetString());
+      break;
+    case JSValueType::Boolean:
+      writer.WriteBoolean(reader.GetBoolean());
+      break;
+    case JSValueType::Int64:
+      writer.WriteInt64(reader.GetInt64());
+      break;
+    case JSValueType::Double:
+      writer.WriteDouble(reader.GetDouble());
+      break;
+    default:
+      writer.WriteNull();
+      break;
+  }
+}
+
+folly::dynamic ReadToDynamic(std::string jsonText) {
+  IJSValueReader reader = winrt::make<JsonTextReader>(std::move(jsonText));
+  IJSValueWriter writer = winrt::make<DynamicWriter>();
+  CopyValue(reader, writer);
+  return writer.as<DynamicWriter>()->TakeValue();
+}
+
+// A flushed queue batch captured from RNTester: [moduleIds, methodIds, params, callId].
+constexpr const char *BridgeBatch =
+    R"([[12,12,12,12,12,12,12,4,12,12],[8,8,8,9,9,9,7,1,10,11],)"
+    R"([[41,"RCTView",11,{"flex":1,"backgroundColor":-1,"style":{"paddingTop":24.5}}],)"
+    R"([43,"RCTText",11,{"accessible":true,"allowFontScaling":true,"ellipsizeMode":"tail"}],)"
+    R"([45,"RCTRawText",11,{"text":"Welcome to \"RNTester\" \u2014 caf\u00e9 \ud83d\ude00\n"}],)"
+    R"([43,[45]],[41,[43]],[11,[41],[0]],)"
+    R"(["Timing","createTimer",[7,100,1602540000000.25,false]],)"
+    R"([41,{"transform":[{"translateX":0},{"scale":1.5}],"opacity":0.75}]],)"
+    R"(1234])";
+
+#ifdef PERF_TESTS
+
+// Visits every value of the reader without keeping it.
+size_t WalkValue(IJSValueReader const &reader) {
+  size_t count = 1;
+  hstring propertyName;
+  switch (reader.ValueType()) {
+    case JSValueType::Object:
+      while (reader.GetNextObjectProperty(propertyName)) {
+        count += WalkValue(reader);
+      }
+      break;
+    case JSValueType::Array:
+      while (reader.GetNextArrayItem()) {
+        count += WalkValue(reader);
+      }
+      break;
+    case JSValueType::String:
+      reader.GetString();
+      break;
+    default:
+      break;
+  }
+
+  return count;
+}
+
+#endif // PERF_TESTS
+
+} // namespace
+
+TEST_CLASS (JsonTextReaderTest) {
+  template <typename TCase>
+  void RunReaderTest() {
+    IJSValueWriter writer = winrt::make<DynamicWriter>();
+    TCase::Write(writer);
+    auto jsonText = folly::toJson(writer.as<DynamicWriter>()->TakeValue());
+    IJSValueReader reader = winrt::make<JsonTextReader>(std::move(jsonText));
+    TCase::Read(reader);
+  }
+
+  IMPORT_READER_TEST_CASES
+
+  TEST_METHOD(MatchesParseJson) {
+    TestCheck(folly::parseJson(BridgeBatch) == ReadToDynamic(BridgeBatch));
+
+    const char *spacedJson = " [ 1 , -0.5e3 , { } , [ ] , \"\" ] ";
+    TestCheck(folly::parseJson(spacedJson) == ReadToDynamic(spacedJson));
+  }
+
+  TEST_METHOD(DecodesEscapes) {
+    IJSValueReader reader =
+        winrt::make<JsonTextReader>(std::string{R"({"a\nb":"\"\\\/\b\f\n\r\t\u0041\u00e9\u2014\ud83d\ude00"})"});
+    hstring propertyName;
+    TestCheck(reader.GetNextObjectProperty(propertyName));
+    TestCheckEqual(L"a\nb", propertyName);
+    TestCheckEqual(L"\"\\/\b\f\n\r\tA\u00e9\u2014\U0001F600", reader.GetString());
+    TestCheck(!reader.GetNextObjectProperty(propertyName));
+  }
+
+  TEST_METHOD(ReadsTextInPlace) {
+    std::string jsonText{R"(["in place",42])"};
+    IJSValueReader reader = winrt::make<JsonTextReader>(std::string_view{jsonText});
+    TestCheck(reader.GetNextArrayItem());
+    TestCheckEqual(L"in place", reader.GetString());
+    TestCheck(reader.GetNextArrayItem());
+    TestCheckEqual(42, reader.GetInt64());
+    TestCheck(!reader.GetNextArrayItem());
+  }
+
+  TEST_METHOD(ReadsLargeIntegersAsDouble) {
+    IJSValueReader reader = winrt::make<JsonTextReader>(std::string{"[9223372036854775807,9223372036854775808]"});
+    TestCheck(reader.GetNextArrayItem());
+    TestCheckEqual(JSValueType::Int64, reader.ValueType());
+    TestCheckEqual(INT64_MAX, reader.GetInt64());
+    TestCheck(reader.GetNextArrayItem());
+    TestCheckEqual(JSValueType::Double, reader.ValueType());
+    TestCheckEqual(9223372036854775808.0, reader.GetDouble());
+  }
+
+  TEST_METHOD(StopsAtInvalidJson) {
+    for (const char *jsonText : {"", "tru", "01", "1.", "-", "1 2", "\"abc", "\"a\nb\"", "\"\\x\""}) {
+      IJSValueReader reader = winrt::make<JsonTextReader>(std::string{jsonText});
+      TestCheckEqual(JSValueType::Null, reader.ValueType());
+    }
+
+    IJSValueReader reader = winrt::make<JsonTextReader>(std::string{R"([1 2])"});
+    TestCheck(reader.GetNextArrayItem());
+    TestCheckEqual(1, reader.GetInt64());
+    TestCheck(!reader.GetNextArrayItem());
+    TestCheckEqual(JSValueType::Null, reader.ValueType());
+
+    reader = winrt::make<JsonTextReader>(std::string{R"({"a" 1})"});
+    hstring propertyName;
+    TestCheck(!reader.GetNextObjectProperty(propertyName));
+    TestCheck(!reader.GetNextArrayItem());
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TimeBridgeBatch) {
+    constexpr int iterationCount = 100000;
+    const std::string batch{BridgeBatch};
+    size_t dynamicCount = 0;
+    size_t textCount = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterationCount; ++i) {
+      auto value = folly::parseJson(batch);
+      dynamicCount += WalkValue(winrt::make<DynamicReader>(value));
+    }
+    const auto dynamicTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterationCount; ++i) {
+      textCount += WalkValue(winrt::make<JsonTextReader>(std::string_view{batch}));
+    }
+    const auto textTime = std::chrono::steady_clock::now() - start;
+
+    TestCheckEqual(dynamicCount, textCount);
+    std::cout << "TimeBridgeBatch: batches=" << iterationCount << "; parseJson+DynamicReader="
+              << std::chrono::duration_cast<std::chrono::microseconds>(dynamicTime).count()
+              << " us; JsonTextReader=" << std::chrono::duration_cast<std::chrono::microseconds>(textTime).count()
+              << " us" << std::endl;
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace winrt::Microsoft::ReactNative
@@ -0,0 +1,277 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <Modules/ParallelYogaLayout.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#include <string>
+#endif
+
+namespace react::uwp {
+
+namespace {
+
+// The measured width depends on the leaf index, so that the trees get different layouts.
+YGSize TextMeasureFunc(YGNodeRef node, float width, YGMeasureMode widthMode, float, YGMeasureMode) {
+  const float textWidth = 20.0f + 7.0f * (reinterpret_cast<intptr_t>(YGNodeGetContext(node)) % 13);
+  const float measuredWidth = widthMode == YGMeasureModeUndefined || textWidth < width ? textWidth : width;
+  return YGSize{measuredWidth, textWidth > measuredWidth ? 40.0f : 20.0f};
+}
+
+// Counts the measure calls that do not run on the thread that calls CalculateLayout.
+std::thread::id s_layoutThreadId;
+std::atomic<size_t> s_otherThreadMeasureCount{0};
+
+YGSize LayoutThreadMeasureFunc(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  YGSize result{};
+  ParallelYogaLayout::RunOnLayoutThread([&]() {
+    if (std::this_thread::get_id() != s_layoutThreadId) {
+      ++s_otherThreadMeasureCount;
+    }
+
+    result = TextMeasureFunc(node, width, widthMode, height, heightMode);
+  });
+  return result;
+}
+
+// Fails to measure one leaf in each tree on the layout thread.
+YGSize ThrowingMeasureFunc(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  ParallelYogaLayout::RunOnLayoutThread([node]() {
+    if (reinterpret_cast<intptr_t>(YGNodeGetContext(node)) == 42) {
+      throw std::runtime_error("Cannot measure the leaf.");
+    }
+  });
+  return TextMeasureFunc(node, width, widthMode, height, heightMode);
+}
+
+// A root with wrapping rows of measured leaves, like a window of text views.
+struct LayoutTree {
+  LayoutTree(size_t leafCount, float width, YGMeasureFunc measureFunc) : Root{YGNodeNew()}, Width{width} {
+    constexpr size_t rowSize = 20;
+    YGNodeStyleSetFlexDirection(Root, YGFlexDirectionColumn);
+    YGNodeStyleSetPadding(Root, YGEdgeAll, 5);
+    for (size_t i = 0; i < leafCount; i += rowSize) {
+      YGNodeRef row = YGNodeNew();
+      YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+      YGNodeStyleSetFlexWrap(row, YGWrapWrap);
+      YGNodeStyleSetMargin(row, YGEdgeBottom, 3);
+      YGNodeInsertChild(Root, row, YGNodeGetChildCount(Root));
+      for (size_t j = i; j < leafCount && j < i + rowSize; ++j) {
+        YGNodeRef leaf = YGNodeNew();
+        YGNodeSetContext(leaf, reinterpret_cast<void *>(static_cast<intptr_t>(j)));
+        YGNodeSetMeasureFunc(leaf, measureFunc);
+        YGNodeStyleSetFlexGrow(leaf, static_cast<float>(j % 3));
+        YGNodeInsertChild(row, leaf, YGNodeGetChildCount(row));
+        Nodes.push_back(leaf);
+      }
+
+      Nodes.push_back(row);
+    }
+
+    Nodes.push_back(Root);
+  }
+
+  ~LayoutTree() {
+    YGNodeFreeRecursive(Root);
+  }
+
+  YogaLayoutRoot LayoutRoot() const {
+    return {Root, Width, YGUndefined};
+  }
+
+  YGNodeRef Root;
+  float Width;
+  std::vector<YGNodeRef> Nodes;
+};
+
+// Builds trees of different sizes and widths.
+std::vector<std::unique_ptr<LayoutTree>> MakeTrees(size_t treeCount, size_t leafCount, YGMeasureFunc measureFunc) {
+  std::vector<std::unique_ptr<LayoutTree>> trees;
+  for (size_t i = 0; i < treeCount; ++i) {
+    trees.push_back(std::make_unique<LayoutTree>(leafCount + i * 17, 300.0f + i * 45, measureFunc));
+  }
+
+  return trees;
+}
+
+std::vector<YogaLayoutRoot> LayoutRoots(const std::vector<std::unique_ptr<LayoutTree>> &trees) {
+  std::vector<YogaLayoutRoot> roots;
+  for (const auto &tree : trees) {
+    roots.push_back(tree->LayoutRoot());
+  }
+
+  return roots;
+}
+
+void CheckSameLayout(
+    const std::vector<std::unique_ptr<LayoutTree>> &expectedTrees,
+    const std::vector<std::unique_ptr<LayoutTree>> &trees) {
+  TestCheckEqual(expectedTrees.size(), trees.size());
+  for (size_t i = 0; i < trees.size(); ++i) {
+    const auto &expectedNodes = expectedTrees[i]->Nodes;
+    const auto &nodes = trees[i]->Nodes;
+    TestCheckEqual(expectedNodes.size(), nodes.size());
+    for (size_t j = 0; j < nodes.size(); ++j) {
+      TestCheckEqual(YGNodeLayoutGetLeft(expectedNodes[j]), YGNodeLayoutGetLeft(nodes[j]));
+      TestCheckEqual(YGNodeLayoutGetTop(expectedNodes[j]), YGNodeLayoutGetTop(nodes[j]));
+      TestCheckEqual(YGNodeLayoutGetWidth(expectedNodes[j]), YGNodeLayoutGetWidth(nodes[j]));
+      TestCheckEqual(YGNodeLayoutGetHeight(expectedNodes[j]), YGNodeLayoutGetHeight(nodes[j]));
+      TestCheck(YGNodeGetHasNewLayout(nodes[j]));
+    }
+  }
+}
+
+} // namespace
+
+TEST_CLASS (ParallelYogaLayoutTest) {
+  TEST_METHOD(MatchesSerialLayout) {
+    auto expectedTrees = MakeTrees(6, 200, &TextMeasureFunc);
+    for (const auto &root : LayoutRoots(expectedTrees)) {
+      YGNodeCalculateLayout(root.node, root.width, root.height, YGDirectionLTR);
+    }
+
+    auto trees = MakeTrees(6, 200, &TextMeasureFunc);
+    ParallelYogaLayout layout{4};
+    layout.CalculateLayout(LayoutRoots(trees));
+    CheckSameLayout(expectedTrees, trees);
+  }
+
+  TEST_METHOD(MatchesSerialLayoutAfterChanges) {
+    auto expectedTrees = MakeTrees(3, 100, &TextMeasureFunc);
+    auto trees = MakeTrees(3, 100, &TextMeasureFunc);
+    ParallelYogaLayout layout{2};
+    for (int pass = 0; pass < 3; ++pass) {
+      // Each pass changes the width of one tree and dirties a leaf in another one.
+      for (auto *treeSet : {&expectedTrees, &trees}) {
+        (*treeSet)[pass]->Width += 100;
+        YGNodeMarkDirty((*treeSet)[(pass + 1) % 3]->Nodes[pass * 5]);
+        for (const auto &tree : *treeSet) {
+          for (YGNodeRef node : tree->Nodes) {
+            YGNodeSetHasNewLayout(node, false);
+          }
+        }
+      }
+
+      for (const auto &root : LayoutRoots(expectedTrees)) {
+        YGNodeCalculateLayout(root.node, root.width, root.height, YGDirectionLTR);
+      }
+
+      layout.CalculateLayout(LayoutRoots(trees));
+      for (size_t i = 0; i < trees.size(); ++i) {
+        for (size_t j = 0; j < trees[i]->Nodes.size(); ++j) {
+          TestCheckEqual(
+              YGNodeGetHasNewLayout(expectedTrees[i]->Nodes[j]), YGNodeGetHasNewLayout(trees[i]->Nodes[j]));
+          TestCheckEqual(YGNodeLayoutGetWidth(expectedTrees[i]->Nodes[j]), YGNodeLayoutGetWidth(trees[i]->Nodes[j]));
+          TestCheckEqual(YGNodeLayoutGetTop(expectedTrees[i]->Nodes[j]), YGNodeLayoutGetTop(trees[i]->Nodes[j]));
+        }
+      }
+    }
+  }
+
+  TEST_METHOD(RunsMeasureFunctionsOnLayoutThread) {
+    auto expectedTrees = MakeTrees(4, 100, &TextMeasureFunc);
+    for (const auto &root : LayoutRoots(expectedTrees)) {
+      YGNodeCalculateLayout(root.node, root.width, root.height, YGDirectionLTR);
+    }
+
+    s_layoutThreadId = std::this_thread::get_id();
+    s_otherThreadMeasureCount = 0;
+    auto trees = MakeTrees(4, 100, &LayoutThreadMeasureFunc);
+    ParallelYogaLayout layout{3};
+    layout.CalculateLayout(LayoutRoots(trees));
+    TestCheckEqual(size_t{0}, s_otherThreadMeasureCount.load());
+    CheckSameLayout(expectedTrees, trees);
+  }
+
+  TEST_METHOD(RethrowsMeasureFunctionExceptions) {
+    auto trees = MakeTrees(4, 100, &ThrowingMeasureFunc);
+    ParallelYogaLayout layout{3};
+    TestCheckException(std::runtime_error, layout.CalculateLayout(LayoutRoots(trees)));
+
+    // The workers keep running after the failed pass.
+    s_layoutThreadId = std::this_thread::get_id();
+    s_otherThreadMeasureCount = 0;
+    auto otherTrees = MakeTrees(4, 100, &LayoutThreadMeasureFunc);
+    layout.CalculateLayout(LayoutRoots(otherTrees));
+    TestCheckEqual(size_t{0}, s_otherThreadMeasureCount.load());
+    for (const auto &tree : otherTrees) {
+      TestCheck(YGNodeLayoutGetHeight(tree->Root) > 0);
+    }
+  }
+
+  TEST_METHOD(LaysOutSingleRootOnCallingThread) {
+    s_layoutThreadId = std::this_thread::get_id();
+    s_otherThreadMeasureCount = 0;
+    auto trees = MakeTrees(1, 50, &LayoutThreadMeasureFunc);
+    ParallelYogaLayout layout{0};
+    layout.CalculateLayout(LayoutRoots(trees));
+    TestCheckEqual(size_t{0}, s_otherThreadMeasureCount.load());
+    TestCheck(YGNodeLayoutGetHeight(trees[0]->Root) > 0);
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TimeParallelLayout) {
+    // Four windows of 5000 views each are laid out from scratch each frame.
+    constexpr size_t treeCount = 4;
+    constexpr size_t leafCount = 5000;
+    constexpr int frameCount = 20;
+    auto trees = MakeTrees(treeCount, leafCount, &TextMeasureFunc);
+    auto roots = LayoutRoots(trees);
+    auto markDirty = [&trees]() {
+      for (const auto &tree : trees) {
+        for (YGNodeRef node : tree->Nodes) {
+          if (YGNodeGetChildCount(node) == 0) {
+            YGNodeMarkDirty(node);
+          }
+        }
+      }
+    };
+
+    const LONGLONG serialTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int frame = 0; frame < frameCount; ++frame) {
+        markDirty();
+        for (const auto &root : roots) {
+          YGNodeCalculateLayout(root.node, root.width, root.height, YGDirectionLTR);
+        }
+      }
+    });
+
+    ParallelYogaLayout layout;
+    const LONGLONG parallelTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int frame = 0; frame < frameCount; ++frame) {
+        markDirty();
+        layout.CalculateLayout(roots);
+      }
+    });
+
+    const std::string parameters = "roots=" + std::to_string(treeCount) + "; views=" + std::to_string(leafCount);
+    Mso::UnitTests::PrintPerfResult("TimeParallelLayout serial", parameters, frameCount, serialTicks);
+    Mso::UnitTests::PrintPerfResult(
+        "TimeParallelLayout parallel",
+        parameters + "; workers=" + std::to_string(ParallelYogaLayout::DefaultWorkerCount()),
+        frameCount,
+        parallelTicks);
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace react::uwp
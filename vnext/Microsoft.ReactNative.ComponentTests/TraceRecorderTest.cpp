@@ -0,0 +1,267 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <tracing/TraceRecorder.h>
+#include <tracing/fbsystrace.h>
+#include <atomic>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#endif
+
+namespace facebook::react::tracing {
+
+namespace {
+
+folly::dynamic ExportTraceEvents() {
+  std::ostringstream stream;
+  exportChromeTrace(stream);
+  return folly::parseJson(stream.str())["traceEvents"];
+}
+
+size_t CountEvents(const folly::dynamic &events, const std::string &phase) {
+  size_t count = 0;
+  for (const auto &event : events) {
+    if (event["ph"].asString() == phase) {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+} // namespace
+
+TEST_CLASS (TraceRecorderTest) {
+  TEST_METHOD(SectionsOfAllThreadsAreExported) {
+    constexpr int threadCount = 4;
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i) {
+      threads.emplace_back([i]() {
+        fbsystrace::FbSystraceSection outer(TRACE_TAG_REACT_CXX_BRIDGE, "outer", "thread", i);
+        fbsystrace::FbSystraceSection inner(TRACE_TAG_REACT_CXX_BRIDGE, "inner \"quoted\"");
+      });
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    stopTraceRecording();
+    const auto events = ExportTraceEvents();
+
+    TestCheckEqual(size_t{2 * threadCount}, CountEvents(events, "B"));
+    TestCheckEqual(size_t{2 * threadCount}, CountEvents(events, "E"));
+
+    std::set<int64_t> threadIds;
+    std::set<std::string> args;
+    for (const auto &event : events) {
+      threadIds.insert(event["tid"].asInt());
+      TestCheckEqual("react_cxx_bridge", event["cat"].asString());
+      if (event["ph"].asString() == "B" && event["name"].asString() == "outer") {
+        args.insert(event["args"]["args"].asString());
+      }
+    }
+
+    TestCheckEqual(size_t{threadCount}, threadIds.size());
+    TestCheckEqual(size_t{threadCount}, args.size());
+    TestCheck(args.count("thread, 0") == 1);
+  }
+
+  TEST_METHOD(SectionsWithDisabledTagsAreSkipped) {
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+    TestCheck(isTracingEnabled(TRACE_TAG_REACT_CXX_BRIDGE));
+    TestCheck(!isTracingEnabled(TRACE_TAG_REACT_APPS));
+
+    { fbsystrace::FbSystraceSection section(TRACE_TAG_REACT_APPS, "apps"); }
+    recordTraceEvent(TracePhase::Counter, TRACE_TAG_REACT_APPS, internTraceName("apps"), 0, 1);
+
+    stopTraceRecording();
+    TestCheck(!isTracingEnabled(TRACE_TAG_REACT_CXX_BRIDGE));
+    { fbsystrace::FbSystraceSection section(TRACE_TAG_REACT_CXX_BRIDGE, "stopped"); }
+
+    TestCheckEqual(size_t{0}, ExportTraceEvents().size());
+  }
+
+  TEST_METHOD(RingBufferKeepsLatestRecords) {
+    constexpr size_t overflow = 100;
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+
+    // A new thread starts with an empty ring buffer.
+    std::thread([]() {
+      const auto nameId = internTraceName("counter");
+      for (size_t i = 0; i < TraceBufferCapacity + overflow; ++i) {
+        recordTraceEvent(TracePhase::Counter, TRACE_TAG_REACT_CXX_BRIDGE, nameId, 0, static_cast<int64_t>(i));
+      }
+    }).join();
+
+    stopTraceRecording();
+    const auto events = ExportTraceEvents();
+
+    TestCheckEqual(TraceBufferCapacity, events.size());
+    TestCheckEqual(static_cast<int64_t>(overflow), events[0]["args"]["value"].asInt());
+    TestCheckEqual(
+        static_cast<int64_t>(TraceBufferCapacity + overflow - 1), events[events.size() - 1]["args"]["value"].asInt());
+  }
+
+  TEST_METHOD(ExitedThreadsReuseBuffers) {
+    constexpr int threadCount = 32;
+    const auto bufferCount = traceBufferCount();
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+
+    // Threads that run one after another share one ring buffer, and their records keep their thread ids.
+    for (int i = 0; i < threadCount; ++i) {
+      std::thread([]() { fbsystrace::FbSystraceSection section(TRACE_TAG_REACT_CXX_BRIDGE, "short"); }).join();
+    }
+
+    stopTraceRecording();
+    TestCheck(traceBufferCount() <= bufferCount + 1);
+
+    const auto events = ExportTraceEvents();
+    std::set<int64_t> threadIds;
+    for (const auto &event : events) {
+      threadIds.insert(event["tid"].asInt());
+    }
+
+    TestCheckEqual(size_t{2 * threadCount}, events.size());
+    TestCheckEqual(size_t{threadCount}, threadIds.size());
+  }
+
+  TEST_METHOD(ExportDuringRecordingSkipsTornRecords) {
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&stop]() {
+      const auto nameId = internTraceName("torn");
+      for (int64_t i = 0; !stop; ++i) {
+        recordTraceEvent(TracePhase::Counter, TRACE_TAG_REACT_CXX_BRIDGE, nameId, 0, i);
+      }
+    });
+
+    // Each exported record is complete: the values of a thread increase with the timestamps.
+    for (int exportIndex = 0; exportIndex < 20; ++exportIndex) {
+      const auto events = ExportTraceEvents();
+      for (size_t i = 1; i < events.size(); ++i) {
+        TestCheck(events[i - 1]["args"]["value"].asInt() < events[i]["args"]["value"].asInt());
+        TestCheck(events[i - 1]["ts"].asDouble() <= events[i]["ts"].asDouble());
+      }
+    }
+
+    stop = true;
+    writer.join();
+    stopTraceRecording();
+  }
+
+  TEST_METHOD(AsyncFlowsAndCountersAreExported) {
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+
+    fbsystrace::FbSystraceAsyncFlow::begin(TRACE_TAG_REACT_CXX_BRIDGE, "flow", 42);
+    std::thread([]() { fbsystrace_end_async_flow(TRACE_TAG_REACT_CXX_BRIDGE, "flow", 42); }).join();
+    recordTraceEvent(TracePhase::Counter, TRACE_TAG_REACT_CXX_BRIDGE, internTraceName("queue"), 0, 7);
+
+    stopTraceRecording();
+    const auto events = ExportTraceEvents();
+
+    TestCheckEqual(size_t{1}, CountEvents(events, "b"));
+    TestCheckEqual(size_t{1}, CountEvents(events, "e"));
+    TestCheckEqual(size_t{1}, CountEvents(events, "C"));
+    for (const auto &event : events) {
+      if (event["ph"].asString() == "C") {
+        TestCheckEqual("queue", event["name"].asString());
+        TestCheckEqual(7, event["args"]["value"].asInt());
+      } else {
+        TestCheckEqual("flow", event["name"].asString());
+        TestCheckEqual(42, event["id"].asInt());
+      }
+    }
+  }
+
+  TEST_METHOD(ArgumentsAreNotInterned) {
+    constexpr int sectionCount = MaxTraceNames + 100;
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+
+    // Each section has different arguments, like the sections of a long session.
+    std::thread([]() {
+      for (int i = 0; i < sectionCount; ++i) {
+        fbsystrace::FbSystraceSection section(TRACE_TAG_REACT_CXX_BRIDGE, "args", "index", i);
+      }
+    }).join();
+
+    stopTraceRecording();
+    TestCheck(internTraceName("ArgumentsAreNotInterned") != internTraceName("<overflow>"));
+
+    // The argument ring buffer keeps the arguments of the latest sections.
+    const auto events = ExportTraceEvents();
+    const auto &last = events[events.size() - 2];
+    TestCheckEqual("args", last["name"].asString());
+    TestCheckEqual("index, " + std::to_string(sectionCount - 1), last["args"]["args"].asString());
+  }
+
+  TEST_METHOD(OverwrittenArgumentsAreReplaced) {
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+
+    // The truncated arguments of the records take more space than the argument ring buffer has.
+    std::thread([]() {
+      const auto nameId = internTraceName("long");
+      const std::string args(MaxTraceArgsSize + 100, 'a');
+      for (size_t i = 0; i < TraceBufferCapacity / 2; ++i) {
+        recordTraceBegin(TRACE_TAG_REACT_CXX_BRIDGE, nameId, args);
+      }
+    }).join();
+
+    stopTraceRecording();
+    const auto events = ExportTraceEvents();
+    TestCheckEqual(TraceBufferCapacity / 2, events.size());
+    TestCheckEqual("<overwritten>", events[0]["args"]["args"].asString());
+    TestCheckEqual(std::string(MaxTraceArgsSize, 'a'), events[events.size() - 1]["args"]["args"].asString());
+  }
+
+  TEST_METHOD(NamesAreInternedOnce) {
+    TestCheckEqual(0u, internTraceName(""));
+
+    const auto id = internTraceName("TraceRecorderTest");
+    TestCheck(id != 0);
+    TestCheckEqual(id, internTraceName("TraceRecorderTest"));
+    TestCheckEqual(id, internTraceName(std::string("TraceRecorder") + "Test"));
+    TestCheck(id != internTraceName("TraceRecorderTest2"));
+
+    uint32_t otherThreadId = 0;
+    std::thread([&otherThreadId]() { otherThreadId = internTraceName("TraceRecorderTest"); }).join();
+    TestCheckEqual(id, otherThreadId);
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TimeSections) {
+    constexpr int sectionCount = 1000000;
+
+    const LONGLONG disabledTicks = Mso::UnitTests::MeasurePerfTicks([]() {
+      for (int i = 0; i < sectionCount; ++i) {
+        fbsystrace::FbSystraceSection section(TRACE_TAG_REACT_CXX_BRIDGE, "disabled", i);
+      }
+    });
+
+    startTraceRecording(TRACE_TAG_REACT_CXX_BRIDGE);
+    const LONGLONG enabledTicks = Mso::UnitTests::MeasurePerfTicks([]() {
+      for (int i = 0; i < sectionCount; ++i) {
+        fbsystrace::FbSystraceSection section(TRACE_TAG_REACT_CXX_BRIDGE, "enabled");
+      }
+    });
+    stopTraceRecording();
+
+    Mso::UnitTests::PrintPerfResult("TimeSections disabled", "", sectionCount, disabledTicks);
+    Mso::UnitTests::PrintPerfResult("TimeSections enabled", "", sectionCount, enabledTicks);
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace facebook::react::tracing
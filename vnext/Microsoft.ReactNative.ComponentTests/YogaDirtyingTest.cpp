@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <Views/LayoutAffectingProps.h>
+#include <yoga/yoga.h>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#include <string>
+#endif
+
+// ViewManagerBase::UpdateProperties dirties the Yoga node of a view only when the
+// property diff has a layout-affecting property. These tests run the same decision
+// with the IsLayoutAffectingProp implementations of the view managers, and use a tree
+// of self-measured views, like Text, to show what a dirtied node costs on the next
+// layout pass.
+
+namespace react::uwp {
+
+namespace {
+
+YGSize CountingMeasureFunc(YGNodeRef node, float width, YGMeasureMode, float, YGMeasureMode) {
+  ++*static_cast<size_t *>(YGNodeGetContext(node));
+  return YGSize{width < 100 ? width : 100, 20};
+}
+
+// A root with rows of self-measured leaves.
+struct MeasuredTree {
+  MeasuredTree(size_t leafCount) : Root{YGNodeNew()} {
+    constexpr size_t rowSize = 50;
+    YGNodeStyleSetFlexDirection(Root, YGFlexDirectionColumn);
+    for (size_t i = 0; i < leafCount; i += rowSize) {
+      YGNodeRef row = YGNodeNew();
+      YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+      YGNodeStyleSetFlexWrap(row, YGWrapWrap);
+      YGNodeInsertChild(Root, row, YGNodeGetChildCount(Root));
+      for (size_t j = i; j < leafCount && j < i + rowSize; ++j) {
+        YGNodeRef leaf = YGNodeNew();
+        YGNodeSetContext(leaf, &MeasureCount);
+        YGNodeSetMeasureFunc(leaf, &CountingMeasureFunc);
+        YGNodeInsertChild(row, leaf, YGNodeGetChildCount(row));
+        Leaves.push_back(leaf);
+      }
+    }
+  }
+
+  ~MeasuredTree() {
+    YGNodeFreeRecursive(Root);
+  }
+
+  void CalculateLayout() {
+    YGNodeCalculateLayout(Root, 1000, YGUndefined, YGDirectionLTR);
+  }
+
+  // Updates the properties of a leaf the way ViewManagerBase::UpdateProperties does.
+  void UpdateProperties(
+      size_t leafIndex,
+      const folly::dynamic &reactDiffMap,
+      bool (*isLayoutAffectingProp)(const std::string &)) {
+    if (HasLayoutAffectingProp(reactDiffMap, isLayoutAffectingProp)) {
+      ++DirtiedCount;
+      YGNodeMarkDirty(Leaves[leafIndex]);
+    } else {
+      ++SkippedCount;
+    }
+  }
+
+  YGNodeRef Root;
+  std::vector<YGNodeRef> Leaves;
+  size_t MeasureCount{0};
+  size_t DirtiedCount{0};
+  size_t SkippedCount{0};
+};
+
+} // namespace
+
+TEST_CLASS (YogaDirtyingTest) {
+  TEST_METHOD(PaintOnlyDiffsSkipDirtying) {
+    MeasuredTree tree{200};
+    tree.CalculateLayout();
+    TestCheck(tree.MeasureCount >= tree.Leaves.size());
+
+    tree.MeasureCount = 0;
+    tree.UpdateProperties(10, folly::dynamic::object("backgroundColor", 0xFF00FF00), &IsViewLayoutAffectingProp);
+    tree.UpdateProperties(
+        11,
+        folly::dynamic::object("opacity", 0.5)("borderTopLeftRadius", 4)("onLayout", true),
+        &IsViewLayoutAffectingProp);
+    tree.UpdateProperties(
+        12, folly::dynamic::object("color", 0xFF000000)("selectable", true), &IsTextLayoutAffectingProp);
+    tree.UpdateProperties(
+        13, folly::dynamic::object("color", 0xFF000000)("tabIndex", 1), &IsControlLayoutAffectingProp);
+    tree.CalculateLayout();
+
+    TestCheckEqual(size_t{0}, tree.DirtiedCount);
+    TestCheckEqual(size_t{4}, tree.SkippedCount);
+    TestCheckEqual(size_t{0}, tree.MeasureCount);
+  }
+
+  TEST_METHOD(LayoutDiffsDirtyTheNode) {
+    MeasuredTree tree{200};
+    tree.CalculateLayout();
+
+    tree.MeasureCount = 0;
+    tree.UpdateProperties(10, folly::dynamic::object("width", 50), &IsViewLayoutAffectingProp);
+    tree.CalculateLayout();
+
+    TestCheckEqual(size_t{1}, tree.DirtiedCount);
+    TestCheckEqual(size_t{0}, tree.SkippedCount);
+    TestCheck(tree.MeasureCount >= 1);
+    TestCheck(tree.MeasureCount < tree.Leaves.size());
+  }
+
+  TEST_METHOD(MixedDiffsDirtyTheNode) {
+    MeasuredTree tree{200};
+    tree.CalculateLayout();
+
+    // A paint-only property does not hide a layout property in the same diff.
+    tree.UpdateProperties(
+        10, folly::dynamic::object("backgroundColor", 0xFF00FF00)("width", 50), &IsViewLayoutAffectingProp);
+    tree.UpdateProperties(11, folly::dynamic::object("color", 0xFF000000)("fontSize", 20), &IsTextLayoutAffectingProp);
+
+    // Unknown properties, like those of custom view managers, are layout-affecting.
+    tree.UpdateProperties(12, folly::dynamic::object("myCustomProp", 1), &IsViewLayoutAffectingProp);
+
+    // A property that is paint-only for a View is not for a Text.
+    tree.UpdateProperties(13, folly::dynamic::object("borderColor", 0xFF000000), &IsTextLayoutAffectingProp);
+
+    TestCheckEqual(size_t{4}, tree.DirtiedCount);
+    TestCheckEqual(size_t{0}, tree.SkippedCount);
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TimeBackgroundColorAnimation) {
+    // Each frame updates the background color of 5000 views.
+    constexpr size_t viewCount = 5000;
+    constexpr int frameCount = 60;
+    MeasuredTree tree{viewCount};
+    tree.CalculateLayout();
+    const folly::dynamic diff = folly::dynamic::object("backgroundColor", 0xFF00FF00);
+
+    // Before the layout-affecting property check every update dirtied its node.
+    tree.MeasureCount = 0;
+    const LONGLONG dirtyTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int frame = 0; frame < frameCount; ++frame) {
+        for (size_t i = 0; i < viewCount; ++i) {
+          tree.UpdateProperties(i, diff, [](const std::string &) { return true; });
+        }
+        tree.CalculateLayout();
+      }
+    });
+    const size_t dirtyMeasureCount = tree.MeasureCount;
+
+    tree.MeasureCount = 0;
+    const LONGLONG skippedTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int frame = 0; frame < frameCount; ++frame) {
+        for (size_t i = 0; i < viewCount; ++i) {
+          tree.UpdateProperties(i, diff, &IsViewLayoutAffectingProp);
+        }
+        tree.CalculateLayout();
+      }
+    });
+
+    TestCheckEqual(size_t{0}, tree.MeasureCount);
+    const std::string parameters = "views=" + std::to_string(viewCount);
+    Mso::UnitTests::PrintPerfResult(
+        "TimeBackgroundColorAnimation dirtied",
+        parameters + "; measures=" + std::to_string(dirtyMeasureCount),
+        frameCount,
+        dirtyTicks);
+    Mso::UnitTests::PrintPerfResult(
+        "TimeBackgroundColorAnimation skipped", parameters + "; measures=0", frameCount, skippedTicks);
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace react::uwp
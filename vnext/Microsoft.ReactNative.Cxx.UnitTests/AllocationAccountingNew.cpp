@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <new>
+#include "memoryApi/memoryApi.h"
+
+// Replace the global operator new and operator delete of the test executable so that
+// Mso::Memory::AllocationAccountingScope counts the allocations of std containers and
+// strings, such as the ones made by JSValue. The aligned versions are not replaced.
+
+void *operator new(size_t size) {
+  if (void *memory = Mso::Memory::Allocate(size != 0 ? size : 1)) {
+    return memory;
+  }
+
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+  return ::operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return Mso::Memory::Allocate(size != 0 ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return Mso::Memory::Allocate(size != 0 ? size : 1);
+}
+
+void operator delete(void *memory) noexcept {
+  Mso::Memory::Free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+  Mso::Memory::Free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+  Mso::Memory::Free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept {
+  Mso::Memory::Free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+  Mso::Memory::Free(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept {
+  Mso::Memory::Free(memory);
+}
@@ -4,6 +4,12 @@
 #include "pch.h"
 #include "JSValue.h"
 #include "JsonJSValueReader.h"
+#include "motifCpp/testCheckAllocations.h"
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#include <string>
+#endif
 
 #undef max
 #undef min
@@ -1240,6 +1246,136 @@ TEST_CLASS (JSValueTest) {
     CheckNotEquals(0.0, false);
     CheckNotEquals(0.0, 0);
   }
+
+  TEST_METHOD(TestSharedCopy) {
+    JSValue value = JSValue::MakeShared(JSValueObject{{"prop1", JSValueArray{1, "Hello"}}, {"prop2", 42}});
+    TestCheck(value.IsShared());
+    TestCheck(value["prop1"].IsShared());
+    TestCheck(!value["prop2"].IsShared());
+
+    // The copy shares the nodes of the value.
+    JSValue copy = value.Copy();
+    TestCheck(copy.IsShared());
+    TestCheck(copy.TryGetObject() == value.TryGetObject());
+    TestCheck(copy["prop1"].TryGetArray() == value["prop1"].TryGetArray());
+    TestCheck(copy == value);
+
+    // A deep copy of an unshared value gets its own nodes.
+    JSValue unshared = JSValueObject{{"prop1", JSValueArray{1, "Hello"}}, {"prop2", 42}};
+    JSValue unsharedCopy = unshared.Copy();
+    TestCheck(!unsharedCopy.IsShared());
+    TestCheck(unsharedCopy.TryGetObject() != unshared.TryGetObject());
+    TestCheck(unsharedCopy == value);
+  }
+
+  TEST_METHOD(TestSharedMutationIsolation) {
+    JSValue value = JSValue::MakeShared(JSValueObject{{"prop1", JSValueArray{1, "Hello"}}, {"prop2", 42}});
+    JSValue copy = value.Copy();
+
+    // Change the copy: the shared nodes are copied on write.
+    JSValueObject object = copy.MoveObject();
+    TestCheck(copy.IsNull());
+    object["prop2"] = 43;
+    JSValueArray array = object["prop1"].MoveArray();
+    array.push_back(true);
+    object["prop1"] = std::move(array);
+    object["prop3"] = "New";
+
+    TestCheck(value == JSValue{JSValueObject{{"prop1", JSValueArray{1, "Hello"}}, {"prop2", 42}}});
+    TestCheck(
+        JSValue{std::move(object)} ==
+        JSValue{JSValueObject{{"prop1", JSValueArray{1, "Hello", true}}, {"prop2", 43}, {"prop3", "New"}}});
+
+    // The only owner of a shared node moves it out without copying.
+    JSValueArray const *sharedArray = value["prop1"].TryGetArray();
+    JSValueObject valueObject = value.MoveObject();
+    JSValue &prop1 = valueObject["prop1"];
+    TestCheck(prop1.IsShared());
+    auto const *firstItem = &sharedArray->front();
+    JSValueArray movedArray = prop1.MoveArray();
+    TestCheck(&movedArray.front() == firstItem);
+  }
+
+  TEST_METHOD(TestSharedEquals) {
+    JSValue value = JSValue::MakeShared(JSValueArray{JSValueObject{{"prop1", 1}}, JSValueArray{2, 3}});
+    JSValue copy = value.Copy();
+    TestCheck(value.Equals(copy));
+    TestCheck(value.JSEquals(copy));
+
+    // Shared and unshared values are compared by their content.
+    JSValue unshared = JSValueArray{JSValueObject{{"prop1", 1}}, JSValueArray{2, 3}};
+    TestCheck(value.Equals(unshared));
+    TestCheck(unshared.Equals(value));
+    TestCheck(!value.Equals(JSValueArray{JSValueObject{{"prop1", 1}}, JSValueArray{2, 4}}));
+    TestCheckEqual("[object Object],2,3", value.AsJSString());
+    TestCheckEqual(size_t{2}, value.ItemCount());
+    TestCheckEqual(1, value.GetArrayItem(0)["prop1"].AsInt32());
+  }
+
+  TEST_METHOD(TestAllocationBudgets) {
+    // AllocationAccountingNew.cpp routes the std allocations of this executable through Mso::Memory.
+    // An object property is one map node: short names and strings fit into the std::string buffer.
+    JSValueObject object;
+    TestCheckAllocationBudget(1, object["prop1"] = 42);
+    TestCheckAllocationBudget(1, object["prop2"] = "Hello");
+    TestCheckAllocationBudget(1, object["prop3"] = true);
+
+    // The items of a reserved array are built in its buffer.
+    JSValueArray array;
+    TestCheckAllocationBudget(1, array.reserve(10));
+    auto pushItems = [&array]() {
+      for (int i = 0; i < 10; ++i) {
+        array.push_back(i);
+      }
+    };
+    TestCheckAllocationBudget(0, pushItems());
+
+    // Copy of a shared value only adds a reference to its nodes.
+    object["prop4"] = std::move(array);
+    JSValue value = JSValue::MakeShared(std::move(object));
+    JSValue copy;
+    TestCheckAllocationBudget(0, copy = value.Copy());
+    TestCheck(copy == value);
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(TestCopyLargeTree) {
+    // An object with 100 arrays of 99 items has 10001 nodes.
+    constexpr int propertyCount = 100;
+    constexpr int itemCount = 99;
+    constexpr int copyCount = 100;
+    JSValueObject object;
+    for (int i = 0; i < propertyCount; ++i) {
+      JSValueArray array;
+      for (int j = 0; j < itemCount; ++j) {
+        array.push_back(j);
+      }
+
+      object["prop" + std::to_string(i)] = std::move(array);
+    }
+
+    JSValue unshared{std::move(object)};
+    const LONGLONG deepCopyTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int i = 0; i < copyCount; ++i) {
+        TestCheckEqual(size_t{propertyCount}, unshared.Copy().PropertyCount());
+      }
+    });
+
+    JSValue shared = JSValue::MakeShared(unshared.Copy());
+    const LONGLONG sharedCopyTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int i = 0; i < copyCount; ++i) {
+        TestCheckEqual(size_t{propertyCount}, shared.Copy().PropertyCount());
+      }
+    });
+
+    TestCheck(shared == unshared);
+    const std::string parameters = "nodes=" + std::to_string(1 + propertyCount * (itemCount + 1));
+    Mso::UnitTests::PrintPerfResult("TestCopyLargeTree deep", parameters, copyCount, deepCopyTicks);
+    Mso::UnitTests::PrintPerfResult("TestCopyLargeTree shared", parameters, copyCount, sharedCopyTicks);
+  }
+
+#endif // PERF_TESTS
 };
 
 } // namespace winrt::Microsoft::ReactNative
@@ -79,10 +79,16 @@ void ReactModuleBuilderMock::AddMethod(
     MethodReturnType returnType,
     MethodDelegate const &method) noexcept {
   m_methods.emplace(name, std::tuple<MethodReturnType, MethodDelegate>{returnType, method});
+  m_methodNames.emplace_back(name);
 }
 
 void ReactModuleBuilderMock::AddSyncMethod(hstring const &name, SyncMethodDelegate const &method) noexcept {
   m_syncMethods.emplace(name, method);
+  m_methodNames.emplace_back(name);
+}
+
+std::vector<std::wstring> const &ReactModuleBuilderMock::MethodNames() const noexcept {
+  return m_methodNames;
 }
 
 JSValueObject ReactModuleBuilderMock::GetConstants() noexcept {
@@ -39,6 +39,9 @@ struct ReactModuleBuilderMock {
 
   JSValueObject GetConstants() noexcept;
 
+  // The names of the async and sync methods in the order they were registered.
+  std::vector<std::wstring> const &MethodNames() const noexcept;
+
   bool IsResolveCallbackCalled() const noexcept;
   void IsResolveCallbackCalled(bool value) noexcept;
   bool IsRejectCallbackCalled() const noexcept;
@@ -102,6 +105,7 @@ struct ReactModuleBuilderMock {
   std::vector<ConstantProviderDelegate> m_constantProviders;
   std::map<std::wstring, std::tuple<MethodReturnType, MethodDelegate>> m_methods;
   std::map<std::wstring, SyncMethodDelegate> m_syncMethods;
+  std::vector<std::wstring> m_methodNames;
   bool m_isResolveCallbackCalled{false};
   bool m_isRejectCallbackCalled{false};
   Mso::Functor<void(std::wstring_view, std::wstring_view, JSValue const &)> m_jsFunctionHandler;
@@ -0,0 +1,323 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include <SnapshotMap.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef PERF_TESTS
+#include <motifCpp/perfTest.h>
+#include <map>
+#include <mutex>
+#endif
+
+namespace winrt::Microsoft::ReactNative {
+
+namespace {
+
+using TestMap = SnapshotMap<std::string, std::shared_ptr<int>>;
+
+// A value that can block the first reader that copies it after the test arms its gate.
+// The SnapshotMap readers copy values with the copy assignment, and the writers do not.
+struct GatedValue {
+  struct Gate {
+    std::atomic<bool> IsArmed{false};
+    std::promise<void> Entered;
+    std::promise<void> Opened;
+  };
+
+  GatedValue() = default;
+  GatedValue(GatedValue const &) = default;
+  GatedValue(GatedValue &&) = default;
+  GatedValue &operator=(GatedValue &&) = default;
+
+  GatedValue(std::shared_ptr<int> value, std::shared_ptr<Gate> gate = nullptr) noexcept
+      : Value{std::move(value)}, ValueGate{std::move(gate)} {}
+
+  GatedValue &operator=(GatedValue const &other) {
+    Value = other.Value;
+    ValueGate = other.ValueGate;
+    if (ValueGate && ValueGate->IsArmed.exchange(false)) {
+      ValueGate->Entered.set_value();
+      ValueGate->Opened.get_future().wait();
+    }
+
+    return *this;
+  }
+
+  std::shared_ptr<int> Value;
+  std::shared_ptr<Gate> ValueGate;
+};
+
+#ifdef PERF_TESTS
+
+// The std::map guarded by a mutex that ReactPropertyBag used before the SnapshotMap.
+struct MutexMap {
+  std::shared_ptr<int> Get(std::string const &key) noexcept {
+    std::scoped_lock lock{m_mutex};
+    auto it = m_entries.find(key);
+    return it != m_entries.end() ? it->second : nullptr;
+  }
+
+  void Set(std::string const &key, std::shared_ptr<int> const &value) noexcept {
+    std::scoped_lock lock{m_mutex};
+    m_entries[key] = value;
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::map<std::string, std::shared_ptr<int>> m_entries;
+};
+
+constexpr size_t ReadCount = 1000000;
+
+// Runs readerCount threads that read keyCount keys while one writer keeps changing their values,
+// and returns the ticks it takes to do ReadCount reads in each reader.
+template <class TMap>
+LONGLONG MeasureReads(TMap &map, size_t readerCount) {
+  constexpr size_t keyCount = 16;
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < keyCount; ++i) {
+    keys.push_back("Key" + std::to_string(i));
+    map.Set(keys.back(), std::make_shared<int>(static_cast<int>(i)));
+  }
+
+  std::atomic<bool> isReading{true};
+  std::thread writer{[&]() {
+    for (int i = 0; isReading; ++i) {
+      map.Set(keys[i % keyCount], std::make_shared<int>(i));
+      std::this_thread::yield();
+    }
+  }};
+
+  const LONGLONG readTicks = Mso::UnitTests::MeasurePerfTicks([&]() {
+    std::vector<std::thread> readers;
+    for (size_t reader = 0; reader < readerCount; ++reader) {
+      readers.emplace_back([&map, &keys, reader]() {
+        for (size_t i = 0; i < ReadCount; ++i) {
+          TestCheck(map.Get(keys[(i + reader) % keyCount]) != nullptr);
+        }
+      });
+    }
+
+    for (auto &reader : readers) {
+      reader.join();
+    }
+  });
+
+  isReading = false;
+  writer.join();
+  return readTicks;
+}
+
+#endif // PERF_TESTS
+
+} // namespace
+
+TEST_CLASS (SnapshotMapTest) {
+  TEST_METHOD(SnapshotMap_SetGetRemove) {
+    TestMap map;
+    TestCheck(map.Get("Key1") == nullptr);
+
+    auto value1 = std::make_shared<int>(1);
+    TestCheck(map.Set("Key1", value1) == nullptr);
+    TestCheck(map.Get("Key1") == value1);
+
+    std::shared_ptr<int> value;
+    TestCheck(map.TryGet("Key1", value));
+    TestCheck(value == value1);
+    TestCheck(!map.TryGet("Key2", value));
+
+    // Set returns the replaced value.
+    auto value2 = std::make_shared<int>(2);
+    TestCheck(map.Set("Key1", value2) == value1);
+    TestCheck(map.Get("Key1") == value2);
+
+    TestCheck(map.Remove("Key2") == nullptr);
+    TestCheck(map.Remove("Key1") == value2);
+    TestCheck(map.Get("Key1") == nullptr);
+  }
+
+  TEST_METHOD(SnapshotMap_GetOrCreate) {
+    TestMap map;
+    int createCount = 0;
+    auto createValue = [&createCount]() noexcept { return std::make_shared<int>(++createCount); };
+
+    auto value = map.GetOrCreate("Key1", createValue);
+    TestCheckEqual(1, *value);
+    TestCheck(map.GetOrCreate("Key1", createValue) == value);
+    TestCheckEqual(1, createCount);
+  }
+
+  TEST_METHOD(SnapshotMap_GetOrCreateFromManyThreads) {
+    TestMap map;
+    std::atomic<int> createCount{0};
+    std::vector<std::shared_ptr<int>> results(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        results[i] =
+            map.GetOrCreate("Key1", [&createCount]() noexcept { return std::make_shared<int>(++createCount); });
+      });
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    // All threads get the value that was added first, even if they created their own value.
+    for (auto const &result : results) {
+      TestCheck(result == map.Get("Key1"));
+    }
+  }
+
+  TEST_METHOD(SnapshotMap_ReleasesReplacedValues) {
+    TestMap map;
+    map.Set("Key1", std::make_shared<int>(1));
+    std::weak_ptr<int> weakValue1 = map.Get("Key1");
+
+    // The snapshot that holds value1 is deleted when it is replaced because there are no readers.
+    map.Set("Key1", std::make_shared<int>(2));
+    TestCheck(weakValue1.expired());
+
+    std::weak_ptr<int> weakValue2 = map.Get("Key1");
+    map.Remove("Key1");
+    TestCheck(weakValue2.expired());
+  }
+
+  TEST_METHOD(SnapshotMap_ReleasesReplacedValuesWhileReading) {
+    TestMap map;
+    map.Set("Key1", std::make_shared<int>(0));
+    std::atomic<bool> isReading{true};
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 4; ++reader) {
+      readers.emplace_back([&]() {
+        while (isReading) {
+          TestCheck(map.Get("Key1") != nullptr);
+        }
+      });
+    }
+
+    std::vector<std::weak_ptr<int>> weakValues;
+    for (int i = 1; i <= 1000; ++i) {
+      auto value = std::make_shared<int>(i);
+      weakValues.push_back(value);
+      map.Set("Key1", value);
+    }
+
+    // The readers never stop together, but each of them moves on to a later epoch,
+    // so later writers delete the snapshots with the replaced values.
+    weakValues.pop_back();
+    auto isReleased = [&weakValues]() {
+      for (auto const &weakValue : weakValues) {
+        if (!weakValue.expired()) {
+          return false;
+        }
+      }
+
+      return true;
+    };
+
+    for (int i = 0; i < 1000 && !isReleased(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      map.Set("Key2", std::make_shared<int>(i));
+    }
+
+    TestCheck(isReleased());
+    isReading = false;
+    for (auto &reader : readers) {
+      reader.join();
+    }
+  }
+
+  TEST_METHOD(SnapshotMap_DeletesSnapshotsAfterUnlocking) {
+    SnapshotMap<int, GatedValue> map;
+    auto gate = std::make_shared<GatedValue::Gate>();
+    map.GetOrCreate(0, [&gate]() { return GatedValue{std::make_shared<int>(0), gate}; });
+
+    // The value deleter uses the map, which would deadlock if the snapshot was deleted under the writer lock.
+    bool isDeleted = false;
+    map.Set(1, GatedValue{std::shared_ptr<int>(new int(1), [&map, &isDeleted](int *value) {
+                 delete value;
+                 map.Set(2, GatedValue{std::make_shared<int>(2)});
+                 isDeleted = true;
+               })});
+
+    // The reader keeps the snapshot with the value alive after it is replaced.
+    gate->IsArmed = true;
+    std::thread reader{[&map]() { TestCheckEqual(0, *map.Get(0).Value); }};
+    gate->Entered.get_future().wait();
+    map.Set(1, GatedValue{});
+    TestCheck(!isDeleted);
+
+    gate->Opened.set_value();
+    reader.join();
+    map.Set(3, GatedValue{std::make_shared<int>(3)});
+    TestCheck(isDeleted);
+    TestCheckEqual(2, *map.Get(2).Value);
+  }
+
+  TEST_METHOD(SnapshotMap_ReadersSeeLatestValues) {
+    // The writer only increases the value, so a reader must never see an older value after a newer one.
+    SnapshotMap<int, int> map;
+    map.Set(1, 0);
+    map.Set(2, 0);
+    std::atomic<bool> isWriting{true};
+    std::atomic<bool> isInOrder{true};
+
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 4; ++reader) {
+      readers.emplace_back([&]() {
+        int lastValue = 0;
+        while (isWriting) {
+          int value1 = map.Get(1);
+          if (value1 < lastValue) {
+            isInOrder = false;
+          }
+
+          lastValue = value1;
+        }
+      });
+    }
+
+    for (int i = 1; i <= 1000; ++i) {
+      map.Set(1, i);
+      map.Set(2, i);
+      TestCheckEqual(i, map.Get(1));
+    }
+
+    isWriting = false;
+    for (auto &reader : readers) {
+      reader.join();
+    }
+
+    TestCheck(isInOrder);
+    TestCheckEqual(1000, map.Get(2));
+  }
+
+#ifdef PERF_TESTS
+
+  TEST_METHOD(SnapshotMap_MeasureContendedReads) {
+    for (size_t readerCount : {1, 4, 16}) {
+      TestMap snapshotMap;
+      MutexMap mutexMap;
+      const LONGLONG snapshotTicks = MeasureReads(snapshotMap, readerCount);
+      const LONGLONG mutexTicks = MeasureReads(mutexMap, readerCount);
+      const std::string parameters = "readers=" + std::to_string(readerCount);
+      Mso::UnitTests::PrintPerfResult(
+          "SnapshotMap_MeasureContendedReads snapshot map", parameters, ReadCount * readerCount, snapshotTicks);
+      Mso::UnitTests::PrintPerfResult(
+          "SnapshotMap_MeasureContendedReads mutex map", parameters, ReadCount * readerCount, mutexTicks);
+    }
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace winrt::Microsoft::ReactNative
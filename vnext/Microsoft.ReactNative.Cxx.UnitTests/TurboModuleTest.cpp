@@ -2261,4 +2261,104 @@ TEST_CLASS (TurboModuleTest) {
   }
 };
 
+// The methods are declared in a different order than in the spec, and one method is not in the spec.
+REACT_MODULE(ReorderedTurboModule)
+struct ReorderedTurboModule {
+  REACT_SYNC_METHOD(MultiplySync)
+  int MultiplySync(int x, int y) noexcept {
+    return x * y;
+  }
+
+  REACT_METHOD(Describe)
+  std::string Describe() noexcept {
+    return "Reordered";
+  }
+
+  REACT_METHOD(Add)
+  int Add(int x, int y) noexcept {
+    return x + y;
+  }
+
+  REACT_METHOD(Negate)
+  int Negate(int x) noexcept {
+    return -x;
+  }
+};
+
+struct ReorderedTurboModuleSpec : winrt::Microsoft::ReactNative::TurboModuleSpec {
+  static constexpr auto methods = std::tuple{
+      Method<void(int, int, Callback<int>) noexcept>{0, L"Add"},
+      Method<void(int, Callback<int>) noexcept>{1, L"Negate"},
+      SyncMethod<int(int, int) noexcept>{2, L"MultiplySync"},
+  };
+
+  template <class TModule>
+  static constexpr void ValidateModule() noexcept {
+    constexpr auto methodCheckResults = CheckMethods<TModule, ReorderedTurboModuleSpec>();
+
+    REACT_SHOW_METHOD_SPEC_ERRORS(
+        0,
+        "Add",
+        "    REACT_METHOD(Add) int Add(int, int) noexcept {/*implementation*/}\n");
+    REACT_SHOW_METHOD_SPEC_ERRORS(
+        1,
+        "Negate",
+        "    REACT_METHOD(Negate) int Negate(int) noexcept {/*implementation*/}\n");
+    REACT_SHOW_SYNC_METHOD_SPEC_ERRORS(
+        2,
+        "MultiplySync",
+        "    REACT_SYNC_METHOD(MultiplySync) int MultiplySync(int, int) noexcept {/*implementation*/}\n");
+  }
+};
+
+TEST_CLASS (TurboModuleMethodOrderTest) {
+  // Registers the module with MakeModuleProvider and with MakeTurboModuleProvider.
+  // Both must register the same methods and give the same results.
+  winrt::Microsoft::ReactNative::ReactModuleBuilderMock m_moduleMock{};
+  winrt::Microsoft::ReactNative::ReactModuleBuilderMock m_turboModuleMock{};
+  Windows::Foundation::IInspectable m_moduleObject{nullptr};
+  Windows::Foundation::IInspectable m_turboModuleObject{nullptr};
+
+  TurboModuleMethodOrderTest() {
+    m_moduleObject = m_moduleMock.CreateModule(
+        winrt::Microsoft::ReactNative::MakeModuleProvider<ReorderedTurboModule>(),
+        winrt::make<winrt::Microsoft::ReactNative::ReactModuleBuilderImpl>(m_moduleMock));
+    m_turboModuleObject = m_turboModuleMock.CreateModule(
+        winrt::Microsoft::ReactNative::MakeTurboModuleProvider<ReorderedTurboModule, ReorderedTurboModuleSpec>(),
+        winrt::make<winrt::Microsoft::ReactNative::ReactModuleBuilderImpl>(m_turboModuleMock));
+  }
+
+  TEST_METHOD(TestMethodRegistration_MemberOrder) {
+    TestCheck(m_moduleMock.MethodNames() == std::vector<std::wstring>{L"MultiplySync", L"Describe", L"Add", L"Negate"});
+  }
+
+  TEST_METHOD(TestMethodRegistration_SameWithSpec) {
+    // The spec does not change the registration order, and the methods that are not in the spec are registered too.
+    TestCheck(m_turboModuleMock.MethodNames() == m_moduleMock.MethodNames());
+  }
+
+  TEST_METHOD(TestMethodCall_SameResults) {
+    for (auto *builderMock : {&m_moduleMock, &m_turboModuleMock}) {
+      builderMock->Call1(
+          L"Add", std::function<void(int)>([](int result) noexcept { TestCheckEqual(8, result); }), 3, 5);
+      TestCheck(builderMock->IsResolveCallbackCalled());
+      builderMock->IsResolveCallbackCalled(false);
+
+      builderMock->Call1(
+          L"Negate", std::function<void(int)>([](int result) noexcept { TestCheckEqual(-3, result); }), 3);
+      TestCheck(builderMock->IsResolveCallbackCalled());
+      builderMock->IsResolveCallbackCalled(false);
+
+      builderMock->Call1(L"Describe", std::function<void(const std::string &)>([](const std::string &result) noexcept {
+                           TestCheck(result == "Reordered");
+                         }));
+      TestCheck(builderMock->IsResolveCallbackCalled());
+
+      int product;
+      builderMock->CallSync(L"MultiplySync", /*out*/ product, 6, 7);
+      TestCheckEqual(42, product);
+    }
+  }
+};
+
 } // namespace ReactNativeTests
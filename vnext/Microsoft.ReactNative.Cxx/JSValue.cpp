@@ -3,6 +3,7 @@
 
 #include "pch.h"
 #include "JSValue.h"
+#include <atomic>
 #include <cctype>
 #include <iomanip>
 #include <set>
@@ -236,6 +237,18 @@ struct JSValueLogWriter {
   std::ostream &m_stream;
 };
 
+// Moves out the shared node if this is its only owner, or copies its top level otherwise.
+template <class TNode>
+TNode MoveOrCopySharedNode(std::shared_ptr<TNode> &sharedNode) noexcept {
+  if (sharedNode.use_count() == 1) {
+    // Make sure that we see all changes done by the other owners before they released the node.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return std::move(*sharedNode);
+  }
+
+  return sharedNode->Copy();
+}
+
 } // namespace
 
 //===========================================================================
@@ -279,6 +292,11 @@ JSValue const &JSValueObject::operator[](std::string_view propertyName) const no
 }
 
 bool JSValueObject::Equals(JSValueObject const &other) const noexcept {
+  if (this == &other) {
+    // The same shared node.
+    return true;
+  }
+
   if (size() != other.size()) {
     return false;
   }
@@ -297,6 +315,10 @@ bool JSValueObject::Equals(JSValueObject const &other) const noexcept {
 }
 
 bool JSValueObject::JSEquals(JSValueObject const &other) const noexcept {
+  if (this == &other) {
+    return true;
+  }
+
   if (size() != other.size()) {
     return false;
   }
@@ -373,6 +395,11 @@ JSValueArray JSValueArray::Copy() const noexcept {
 }
 
 bool JSValueArray::Equals(JSValueArray const &other) const noexcept {
+  if (this == &other) {
+    // The same shared node.
+    return true;
+  }
+
   if (size() != other.size()) {
     return false;
   }
@@ -388,6 +415,10 @@ bool JSValueArray::Equals(JSValueArray const &other) const noexcept {
 }
 
 bool JSValueArray::JSEquals(JSValueArray const &other) const noexcept {
+  if (this == &other) {
+    return true;
+  }
+
   if (size() != other.size()) {
     return false;
   }
@@ -433,13 +464,23 @@ void JSValueArray::WriteTo(IJSValueWriter const &writer) const noexcept {
 
 #pragma warning(push)
 #pragma warning(disable : 26495) // False positive for union member not initialized
-JSValue::JSValue(JSValue &&other) noexcept : m_type{other.m_type} {
+JSValue::JSValue(JSValue &&other) noexcept : m_type{other.m_type}, m_isShared{other.m_isShared} {
   switch (m_type) {
     case JSValueType::Object:
-      new (&m_object) JSValueObject(std::move(other.m_object));
+      if (m_isShared) {
+        new (&m_sharedObject) std::shared_ptr<JSValueObject>(std::move(other.m_sharedObject));
+        other.m_sharedObject.~shared_ptr();
+      } else {
+        new (&m_object) JSValueObject(std::move(other.m_object));
+      }
       break;
     case JSValueType::Array:
-      new (&m_array) JSValueArray(std::move(other.m_array));
+      if (m_isShared) {
+        new (&m_sharedArray) std::shared_ptr<JSValueArray>(std::move(other.m_sharedArray));
+        other.m_sharedArray.~shared_ptr();
+      } else {
+        new (&m_array) JSValueArray(std::move(other.m_array));
+      }
       break;
     case JSValueType::String:
       new (&m_string) std::string(std::move(other.m_string));
@@ -456,6 +497,7 @@ JSValue::JSValue(JSValue &&other) noexcept : m_type{other.m_type} {
   }
 
   other.m_type = JSValueType::Null;
+  other.m_isShared = false;
   other.m_int64 = 0;
 }
 #pragma warning(pop)
@@ -463,10 +505,18 @@ JSValue::JSValue(JSValue &&other) noexcept : m_type{other.m_type} {
 JSValue::~JSValue() noexcept {
   switch (m_type) {
     case JSValueType::Object:
-      m_object.~JSValueObject();
+      if (m_isShared) {
+        m_sharedObject.~shared_ptr();
+      } else {
+        m_object.~JSValueObject();
+      }
       break;
     case JSValueType::Array:
-      m_array.~JSValueArray();
+      if (m_isShared) {
+        m_sharedArray.~shared_ptr();
+      } else {
+        m_array.~JSValueArray();
+      }
       break;
     case JSValueType::String:
       m_string.~basic_string();
@@ -479,6 +529,7 @@ JSValue::~JSValue() noexcept {
   }
 
   m_type = JSValueType::Null;
+  m_isShared = false;
   m_int64 = 0;
 }
 
@@ -494,9 +545,9 @@ JSValue &JSValue::operator=(JSValue &&other) noexcept {
 JSValue JSValue::Copy() const noexcept {
   switch (m_type) {
     case JSValueType::Object:
-      return JSValue{m_object.Copy()};
+      return m_isShared ? JSValue{std::shared_ptr<JSValueObject>{m_sharedObject}} : JSValue{m_object.Copy()};
     case JSValueType::Array:
-      return JSValue{m_array.Copy()};
+      return m_isShared ? JSValue{std::shared_ptr<JSValueArray>{m_sharedArray}} : JSValue{m_array.Copy()};
     case JSValueType::String:
       return JSValue{std::string(m_string)};
     case JSValueType::Boolean:
@@ -510,10 +561,44 @@ JSValue JSValue::Copy() const noexcept {
   }
 }
 
+/*static*/ JSValue JSValue::MakeShared(JSValue &&value) noexcept {
+  if (value.m_isShared) {
+    return std::move(value);
+  }
+
+  switch (value.m_type) {
+    case JSValueType::Object: {
+      JSValueObject object = value.MoveObject();
+      for (auto &property : object) {
+        property.second = MakeShared(std::move(property.second));
+      }
+
+      return JSValue{std::make_shared<JSValueObject>(std::move(object))};
+    }
+    case JSValueType::Array: {
+      JSValueArray array = value.MoveArray();
+      for (auto &item : array) {
+        item = MakeShared(std::move(item));
+      }
+
+      return JSValue{std::make_shared<JSValueArray>(std::move(array))};
+    }
+    default:
+      return std::move(value);
+  }
+}
+
 JSValueObject JSValue::MoveObject() noexcept {
   JSValueObject result;
   if (m_type == JSValueType::Object) {
-    result = std::move(m_object);
+    if (m_isShared) {
+      result = MoveOrCopySharedNode(m_sharedObject);
+      m_sharedObject.~shared_ptr();
+      m_isShared = false;
+    } else {
+      result = std::move(m_object);
+    }
+
     m_type = JSValueType::Null;
     m_int64 = 0;
   }
@@ -524,7 +609,14 @@ JSValueObject JSValue::MoveObject() noexcept {
 JSValueArray JSValue::MoveArray() noexcept {
   JSValueArray result;
   if (m_type == JSValueType::Array) {
-    result = std::move(m_array);
+    if (m_isShared) {
+      result = MoveOrCopySharedNode(m_sharedArray);
+      m_sharedArray.~shared_ptr();
+      m_isShared = false;
+    } else {
+      result = std::move(m_array);
+    }
+
     m_type = JSValueType::Null;
     m_int64 = 0;
   }
@@ -552,9 +644,9 @@ std::string JSValue::AsString() const noexcept {
 bool JSValue::AsBoolean() const noexcept {
   switch (m_type) {
     case JSValueType::Object:
-      return !m_object.empty();
+      return !ObjectValue().empty();
     case JSValueType::Array:
-      return !m_array.empty();
+      return !ArrayValue().empty();
     case JSValueType::String:
       return JSConverter::ToBoolean(m_string);
     case JSValueType::Boolean:
@@ -608,7 +700,7 @@ std::string JSValue::AsJSString() const noexcept {
           return os << JSConverter::ObjectString;
         case JSValueType::Array: {
           bool start = true;
-          for (auto const &item : node.m_array) {
+          for (auto const &item : node.ArrayValue()) {
             if (start) {
               start = false;
             } else {
@@ -680,11 +772,11 @@ double JSValue::AsJSNumber() const noexcept {
     case JSValueType::Object:
       return std::numeric_limits<double>::quiet_NaN();
     case JSValueType::Array:
-      switch (m_array.size()) {
+      switch (ArrayValue().size()) {
         case 0:
           return 0;
         case 1:
-          return JSConverter::ToJSNumber(m_array[0].AsJSString());
+          return JSConverter::ToJSNumber(ArrayValue()[0].AsJSString());
         default:
           return std::numeric_limits<double>::quiet_NaN();
       }
@@ -721,13 +813,14 @@ std::string JSValue::ToString() const noexcept {
 }
 
 size_t JSValue::PropertyCount() const noexcept {
-  return (m_type == JSValueType::Object) ? m_object.size() : 0;
+  return (m_type == JSValueType::Object) ? ObjectValue().size() : 0;
 }
 
 JSValue const *JSValue::TryGetObjectProperty(std::string_view propertyName) const noexcept {
   if (m_type == JSValueType::Object) {
-    auto it = m_object.find(propertyName);
-    if (it != m_object.end()) {
+    auto const &object = ObjectValue();
+    auto it = object.find(propertyName);
+    if (it != object.end()) {
       return &it->second;
     }
   }
@@ -741,11 +834,11 @@ JSValue const &JSValue::GetObjectProperty(std::string_view propertyName) const n
 }
 
 size_t JSValue::ItemCount() const noexcept {
-  return (m_type == JSValueType::Array) ? m_array.size() : 0;
+  return (m_type == JSValueType::Array) ? ArrayValue().size() : 0;
 }
 
 JSValue const *JSValue::TryGetArrayItem(JSValueArray::size_type index) const noexcept {
-  return (m_type == JSValueType::Array && index < m_array.size()) ? &m_array[index] : nullptr;
+  return (m_type == JSValueType::Array && index < ArrayValue().size()) ? &ArrayValue()[index] : nullptr;
 }
 
 JSValue const &JSValue::GetArrayItem(JSValueArray::size_type index) const noexcept {
@@ -762,9 +855,9 @@ bool JSValue::Equals(JSValue const &other) const noexcept {
     case JSValueType::Null:
       return true;
     case JSValueType::Object:
-      return m_object.Equals(other.m_object);
+      return ObjectValue().Equals(other.ObjectValue());
     case JSValueType::Array:
-      return m_array.Equals(other.m_array);
+      return ArrayValue().Equals(other.ArrayValue());
     case JSValueType::String:
       return m_string == other.m_string;
     case JSValueType::Boolean:
@@ -782,9 +875,9 @@ bool JSValue::JSEquals(JSValue const &other) const noexcept {
   if (m_type == other.m_type) {
     switch (m_type) {
       case JSValueType::Object:
-        return m_object.JSEquals(other.m_object);
+        return ObjectValue().JSEquals(other.ObjectValue());
       case JSValueType::Array:
-        return m_array.JSEquals(other.m_array);
+        return ArrayValue().JSEquals(other.ArrayValue());
       default:
         return Equals(other);
     }
@@ -828,9 +921,9 @@ void JSValue::WriteTo(IJSValueWriter const &writer) const noexcept {
     case JSValueType::Null:
       return writer.WriteNull();
     case JSValueType::Object:
-      return m_object.WriteTo(writer);
+      return ObjectValue().WriteTo(writer);
     case JSValueType::Array:
-      return m_array.WriteTo(writer);
+      return ArrayValue().WriteTo(writer);
     case JSValueType::String:
       return writer.WriteString(to_hstring(m_string));
     case JSValueType::Boolean:
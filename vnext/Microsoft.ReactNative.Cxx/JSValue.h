@@ -5,6 +5,7 @@
 #ifndef MICROSOFT_REACTNATIVE_JSVALUE
 #define MICROSOFT_REACTNATIVE_JSVALUE
 
+#include <memory>
 #include "Crash.h"
 #include "winrt/Microsoft.ReactNative.h"
 
@@ -236,14 +237,25 @@ struct JSValue {
   JSValue &operator=(JSValue &&other) noexcept;
 
   //! Do a deep copy of JSValue.
+  //! The shared Object and Array nodes are not copied: the copy shares them with this JSValue.
   JSValue Copy() const noexcept;
 
+  //! Create JSValue where the Object and Array nodes of the value tree are shared.
+  //! The shared nodes are immutable and reference counted: Copy() of a shared Object or Array is O(1),
+  //! and MoveObject() or MoveArray() copy only the top level node if it is used by other JSValues.
+  static JSValue MakeShared(JSValue &&value) noexcept;
+
+  //! Return true if JSValue type is Object or Array and the node is shared.
+  bool IsShared() const noexcept;
+
   //! Move out Object and set this to JSValue::Null. It returns JSValue::EmptyObject
   //! and keeps this JSValue unchanged if current type is not an object.
+  //! A shared Object is copied if it is used by other JSValues. Its property values stay shared.
   JSValueObject MoveObject() noexcept;
 
   //! Move out Array and set this to JSValue::Null. It returns JSValue::EmptyArray
   //! and keeps this JSValue unchanged if current type is not an array.
+  //! A shared Array is copied if it is used by other JSValues. Its items stay shared.
   JSValueArray MoveArray() noexcept;
 
   //! Get JSValue type.
@@ -486,11 +498,20 @@ struct JSValue {
 
 #pragma endregion
 
+ private:
+  JSValue(std::shared_ptr<JSValueObject> &&value) noexcept;
+  JSValue(std::shared_ptr<JSValueArray> &&value) noexcept;
+  JSValueObject const &ObjectValue() const noexcept;
+  JSValueArray const &ArrayValue() const noexcept;
+
  private: // Instance fields
   JSValueType m_type;
+  bool m_isShared{false}; // The Object or Array value is in m_sharedObject or m_sharedArray.
   union {
     JSValueObject m_object;
     JSValueArray m_array;
+    std::shared_ptr<JSValueObject> m_sharedObject;
+    std::shared_ptr<JSValueArray> m_sharedArray;
     std::string m_string;
     bool m_bool;
     int64_t m_int64;
@@ -604,6 +625,10 @@ inline JSValue::JSValue(TBool value) noexcept : m_type{JSValueType::Boolean}, m_
 template <class TInt, std::enable_if_t<std::is_integral_v<TInt> && !std::is_same_v<TInt, bool>, int>>
 inline JSValue::JSValue(TInt value) noexcept : m_type{JSValueType::Int64}, m_int64{static_cast<int64_t>(value)} {}
 inline JSValue::JSValue(double value) noexcept : m_type{JSValueType::Double}, m_double{value} {}
+inline JSValue::JSValue(std::shared_ptr<JSValueObject> &&value) noexcept
+    : m_type{JSValueType::Object}, m_isShared{true}, m_sharedObject{std::move(value)} {}
+inline JSValue::JSValue(std::shared_ptr<JSValueArray> &&value) noexcept
+    : m_type{JSValueType::Array}, m_isShared{true}, m_sharedArray{std::move(value)} {}
 #pragma warning(pop)
 
 inline JSValueType JSValue::Type() const noexcept {
@@ -614,12 +639,24 @@ inline bool JSValue::IsNull() const noexcept {
   return m_type == JSValueType::Null;
 }
 
+inline bool JSValue::IsShared() const noexcept {
+  return m_isShared;
+}
+
+inline JSValueObject const &JSValue::ObjectValue() const noexcept {
+  return m_isShared ? *m_sharedObject : m_object;
+}
+
+inline JSValueArray const &JSValue::ArrayValue() const noexcept {
+  return m_isShared ? *m_sharedArray : m_array;
+}
+
 inline JSValueObject const *JSValue::TryGetObject() const noexcept {
-  return (m_type == JSValueType::Object) ? &m_object : nullptr;
+  return (m_type == JSValueType::Object) ? &ObjectValue() : nullptr;
 }
 
 inline JSValueArray const *JSValue::TryGetArray() const noexcept {
-  return (m_type == JSValueType::Array) ? &m_array : nullptr;
+  return (m_type == JSValueType::Array) ? &ArrayValue() : nullptr;
 }
 
 inline std::string const *JSValue::TryGetString() const noexcept {
@@ -639,11 +676,11 @@ inline double const *JSValue::TryGetDouble() const noexcept {
 }
 
 inline JSValueObject const &JSValue::AsObject() const noexcept {
-  return (m_type == JSValueType::Object) ? m_object : EmptyObject.m_object;
+  return (m_type == JSValueType::Object) ? ObjectValue() : EmptyObject.m_object;
 }
 
 inline JSValueArray const &JSValue::AsArray() const noexcept {
-  return (m_type == JSValueType::Array) ? m_array : EmptyArray.m_array;
+  return (m_type == JSValueType::Array) ? ArrayValue() : EmptyArray.m_array;
 }
 
 inline int8_t JSValue::AsInt8() const noexcept {
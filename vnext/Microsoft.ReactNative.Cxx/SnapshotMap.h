@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#ifndef MICROSOFT_REACTNATIVE_SNAPSHOTMAP
+#define MICROSOFT_REACTNATIVE_SNAPSHOTMAP
+
+//
+// SnapshotMap is a thread-safe hash map for data that is read much more often than it is changed.
+// Readers find values in an immutable snapshot of the map without taking a lock.
+// Writers are serialized by a mutex: they copy the current snapshot, change the copy,
+// and publish it as the new current snapshot.
+// Each publish starts a new epoch, and a replaced snapshot is retired with the epoch that it ended.
+// A reader claims one of the reader slots with the epoch that it started in while it uses a snapshot,
+// or takes the writer mutex if all slots are taken.
+// A writer deletes the retired snapshots that ended in an epoch at or before the oldest claimed epoch,
+// after it releases the mutex. The rest are deleted by later writers or by the SnapshotMap destructor.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace winrt::Microsoft::ReactNative {
+
+template <class TKey, class TValue, class THash = std::hash<TKey>, class TKeyEqual = std::equal_to<TKey>>
+struct SnapshotMap {
+  using Snapshot = std::unordered_map<TKey, TValue, THash, TKeyEqual>;
+
+  SnapshotMap() noexcept = default;
+  SnapshotMap(SnapshotMap const &) = delete;
+  SnapshotMap &operator=(SnapshotMap const &) = delete;
+
+  ~SnapshotMap() noexcept {
+    delete m_snapshot.load(std::memory_order_relaxed);
+  }
+
+  // Copies the value to the output parameter and returns true if the key is in the map.
+  bool TryGet(TKey const &key, TValue &value) const noexcept {
+    ReaderScope readerScope{*this};
+    if (Snapshot const *snapshot = m_snapshot.load()) {
+      auto it = snapshot->find(key);
+      if (it != snapshot->end()) {
+        value = it->second;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Returns a copy of the value, or a default constructed value if the key is not in the map.
+  TValue Get(TKey const &key) const noexcept {
+    TValue result{};
+    TryGet(key, result);
+    return result;
+  }
+
+  // Returns the value for the key. If the key is not in the map, then adds the value returned by createValue.
+  // The createValue is called outside of the lock, and its result is dropped if another thread adds the key first.
+  template <class TCreateValue>
+  TValue GetOrCreate(TKey const &key, TCreateValue const &createValue) {
+    TValue result{};
+    if (!TryGet(key, result)) {
+      TValue newValue = createValue();
+      RetiredSnapshots deletedSnapshots;
+      std::scoped_lock lock{m_writeMutex};
+      Snapshot const *snapshot = m_snapshot.load(std::memory_order_relaxed);
+      if (snapshot) {
+        // Make sure that the value was not added while we were unlocked.
+        auto it = snapshot->find(key);
+        if (it != snapshot->end()) {
+          return it->second;
+        }
+      }
+
+      auto newSnapshot = CopySnapshot(snapshot);
+      result = newSnapshot->emplace(key, std::move(newValue)).first->second;
+      deletedSnapshots = Publish(std::move(newSnapshot));
+    }
+
+    return result;
+  }
+
+  // Sets the value for the key, and returns the previous value or a default constructed value.
+  TValue Set(TKey const &key, TValue const &value) {
+    RetiredSnapshots deletedSnapshots;
+    std::scoped_lock lock{m_writeMutex};
+    auto newSnapshot = CopySnapshot(m_snapshot.load(std::memory_order_relaxed));
+    auto &entry = (*newSnapshot)[key];
+    TValue result = std::exchange(entry, value);
+    deletedSnapshots = Publish(std::move(newSnapshot));
+    return result;
+  }
+
+  // Removes the key from the map, and returns its value or a default constructed value.
+  TValue Remove(TKey const &key) {
+    RetiredSnapshots deletedSnapshots;
+    std::scoped_lock lock{m_writeMutex};
+    Snapshot const *snapshot = m_snapshot.load(std::memory_order_relaxed);
+    if (!snapshot || snapshot->find(key) == snapshot->end()) {
+      return TValue{};
+    }
+
+    auto newSnapshot = CopySnapshot(snapshot);
+    auto it = newSnapshot->find(key);
+    TValue result = std::move(it->second);
+    newSnapshot->erase(it);
+    deletedSnapshots = Publish(std::move(newSnapshot));
+    return result;
+  }
+
+ private:
+  static constexpr size_t ReaderSlotCount = 16;
+
+  // The epoch claimed by a reader, or zero if the slot is free.
+  // Each reader slot is in its own cache line to avoid contention between reader threads.
+  struct alignas(64) ReaderSlot {
+    std::atomic<size_t> Epoch{0};
+  };
+
+  struct RetiredSnapshot {
+    size_t Epoch;
+    std::unique_ptr<Snapshot const> Value;
+  };
+
+  using RetiredSnapshots = std::vector<RetiredSnapshot>;
+
+  // Registers the calling thread as a reader for the scope lifetime.
+  // A reader that claims its slot after a snapshot is retired claims a later epoch and only sees newer snapshots.
+  struct ReaderScope {
+    ReaderScope(SnapshotMap const &map) noexcept : m_map{map} {
+      const size_t epoch = map.m_epoch.load();
+      const size_t startIndex = ThreadSlotIndex();
+      for (size_t i = 0; i < ReaderSlotCount; ++i) {
+        ReaderSlot &slot = map.m_readerSlots[(startIndex + i) % ReaderSlotCount];
+        size_t freeEpoch = 0;
+        if (slot.Epoch.load(std::memory_order_relaxed) == 0 && slot.Epoch.compare_exchange_strong(freeEpoch, epoch)) {
+          m_slot = &slot;
+          return;
+        }
+      }
+
+      // Writers do not delete snapshots while we hold the mutex.
+      map.m_writeMutex.lock();
+    }
+
+    ~ReaderScope() noexcept {
+      if (m_slot) {
+        m_slot->Epoch.store(0, std::memory_order_release);
+      } else {
+        m_map.m_writeMutex.unlock();
+      }
+    }
+
+    ReaderScope(ReaderScope const &) = delete;
+    ReaderScope &operator=(ReaderScope const &) = delete;
+
+   private:
+    SnapshotMap const &m_map;
+    ReaderSlot *m_slot{nullptr};
+  };
+
+  static size_t ThreadSlotIndex() noexcept {
+    static std::atomic<size_t> s_nextIndex{0};
+    thread_local size_t t_index{s_nextIndex.fetch_add(1, std::memory_order_relaxed) % ReaderSlotCount};
+    return t_index;
+  }
+
+  static std::unique_ptr<Snapshot> CopySnapshot(Snapshot const *snapshot) {
+    return snapshot ? std::make_unique<Snapshot>(*snapshot) : std::make_unique<Snapshot>();
+  }
+
+  // Makes the new snapshot current, and returns the retired snapshots that no reader can use anymore.
+  // It must be called under the m_writeMutex lock, and the caller deletes the returned snapshots after unlocking.
+  RetiredSnapshots Publish(std::unique_ptr<Snapshot> newSnapshot) {
+    RetiredSnapshots deletedSnapshots;
+    deletedSnapshots.reserve(m_retiredSnapshots.size() + 1);
+    m_retiredSnapshots.reserve(m_retiredSnapshots.size() + 1);
+    if (Snapshot const *oldSnapshot = m_snapshot.exchange(newSnapshot.release())) {
+      // Readers that claim the new epoch or a later one see the new snapshot.
+      const size_t newEpoch = m_epoch.fetch_add(1) + 1;
+      m_retiredSnapshots.push_back(RetiredSnapshot{newEpoch, std::unique_ptr<Snapshot const>{oldSnapshot}});
+    }
+
+    size_t oldestEpoch = SIZE_MAX;
+    for (ReaderSlot const &slot : m_readerSlots) {
+      const size_t epoch = slot.Epoch.load();
+      if (epoch != 0 && epoch < oldestEpoch) {
+        oldestEpoch = epoch;
+      }
+    }
+
+    auto it = std::partition(
+        m_retiredSnapshots.begin(), m_retiredSnapshots.end(), [oldestEpoch](RetiredSnapshot const &retired) noexcept {
+          return retired.Epoch > oldestEpoch;
+        });
+    std::move(it, m_retiredSnapshots.end(), std::back_inserter(deletedSnapshots));
+    m_retiredSnapshots.erase(it, m_retiredSnapshots.end());
+    return deletedSnapshots;
+  }
+
+ private:
+  std::atomic<Snapshot const *> m_snapshot{nullptr};
+  std::atomic<size_t> m_epoch{1};
+  mutable ReaderSlot m_readerSlots[ReaderSlotCount];
+  mutable std::mutex m_writeMutex;
+  RetiredSnapshots m_retiredSnapshots;
+};
+
+} // namespace winrt::Microsoft::ReactNative
+
+#endif // MICROSOFT_REACTNATIVE_SNAPSHOTMAP
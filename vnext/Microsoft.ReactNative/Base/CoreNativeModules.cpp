@@ -50,14 +50,16 @@ std::vector<facebook::react::NativeModuleDescription> GetCoreModules(
     const std::shared_ptr<facebook::react::MessageQueueThread> &uiMessageQueue,
     std::shared_ptr<react::uwp::AppTheme> &&appTheme,
     Mso::CntPtr<AppearanceChangeListener> &&appearanceListener,
-    const std::shared_ptr<IReactInstance> &uwpInstance) noexcept {
+    const std::shared_ptr<IReactInstance> &uwpInstance,
+    bool lazyViewManagerConstants) noexcept {
   // Modules
   std::vector<facebook::react::NativeModuleDescription> modules;
 
   modules.emplace_back(
       "UIManager",
-      [uiManager, uiMessageQueue]() {
-        return facebook::react::createUIManagerModule(std::shared_ptr(uiManager), std::shared_ptr(uiMessageQueue));
+      [uiManager, uiMessageQueue, lazyViewManagerConstants]() {
+        return facebook::react::createUIManagerModule(
+            std::shared_ptr(uiManager), std::shared_ptr(uiMessageQueue), lazyViewManagerConstants);
       },
       messageQueue);
 
@@ -29,6 +29,7 @@ std::vector<facebook::react::NativeModuleDescription> GetCoreModules(
     const std::shared_ptr<facebook::react::MessageQueueThread> &uiMessageQueue,
     std::shared_ptr<react::uwp::AppTheme> &&appTheme,
     Mso::CntPtr<AppearanceChangeListener> &&appearanceListener,
-    const std::shared_ptr<IReactInstance> &uwpInstance) noexcept;
+    const std::shared_ptr<IReactInstance> &uwpInstance,
+    bool lazyViewManagerConstants) noexcept;
 
 } // namespace react::uwp
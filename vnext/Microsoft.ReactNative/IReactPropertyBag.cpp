@@ -146,49 +146,17 @@ com_ptr<ReactPropertyName> ReactPropertyNamespace::GetLocalName(hstring const &l
 namespace winrt::Microsoft::ReactNative::implementation {
 
 IInspectable ReactPropertyBag::Get(IReactPropertyName const &propertyName) noexcept {
-  std::scoped_lock lock{m_mutex};
-  auto it = m_entries.find(propertyName);
-  if (it != m_entries.end()) {
-    return it->second;
-  }
-
-  return {nullptr};
+  return m_entries.Get(propertyName);
 }
 
 IInspectable ReactPropertyBag::GetOrCreate(
     IReactPropertyName const &propertyName,
     ReactCreatePropertyValue const &createValue) noexcept {
-  IInspectable result{Get(propertyName)};
-  if (!result) {
-    IInspectable newValue = createValue();
-    std::scoped_lock lock{m_mutex};
-    auto &entry = m_entries[propertyName];
-    if (!entry) {
-      entry = std::move(newValue);
-    }
-
-    result = entry;
-  }
-
-  return result;
+  return m_entries.GetOrCreate(propertyName, [&createValue]() noexcept { return createValue(); });
 }
 
 IInspectable ReactPropertyBag::Set(IReactPropertyName const &propertyName, IInspectable const &value) noexcept {
-  IInspectable result{nullptr};
-  std::scoped_lock lock{m_mutex};
-  if (value) {
-    auto &entry = m_entries[propertyName];
-    result = std::move(entry);
-    entry = value;
-  } else {
-    auto it = m_entries.find(propertyName);
-    if (it != m_entries.end()) {
-      result = std::move(it->second);
-      m_entries.erase(it);
-    }
-  }
-
-  return result;
+  return value ? m_entries.Set(propertyName, value) : m_entries.Remove(propertyName);
 }
 
 /*static*/ IReactPropertyNamespace ReactPropertyBagHelper::GlobalNamespace() noexcept {
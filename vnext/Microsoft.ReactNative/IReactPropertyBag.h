@@ -3,6 +3,7 @@
 
 #pragma once
 #include "ReactPropertyBagHelper.g.h"
+#include "SnapshotMap.h"
 
 namespace winrt::Microsoft::ReactNative::implementation {
 
@@ -14,8 +15,21 @@ struct ReactPropertyBag : implements<ReactPropertyBag, IReactPropertyBag> {
   IInspectable Set(IReactPropertyName const &name, IInspectable const &value) noexcept;
 
  private:
-  std::mutex m_mutex;
-  std::map<IReactPropertyName, IInspectable> m_entries;
+  // Property names are atomized by ReactPropertyBagHelper::GetName, and we can compare them by their ABI pointers.
+  struct PropertyNameHash {
+    size_t operator()(IReactPropertyName const &name) const noexcept {
+      return std::hash<void *>{}(get_abi(name));
+    }
+  };
+
+  struct PropertyNameEqual {
+    bool operator()(IReactPropertyName const &left, IReactPropertyName const &right) const noexcept {
+      return get_abi(left) == get_abi(right);
+    }
+  };
+
+  // Reads do not take a lock because the bag is read much more often than it is changed.
+  SnapshotMap<IReactPropertyName, IInspectable, PropertyNameHash, PropertyNameEqual> m_entries;
 };
 
 struct ReactPropertyBagHelper {
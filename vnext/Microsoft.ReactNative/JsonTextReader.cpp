@@ -0,0 +1,423 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include "JsonTextReader.h"
+#include <charconv>
+
+namespace winrt::Microsoft::ReactNative {
+
+namespace {
+
+bool IsDigit(char c) noexcept {
+  return c >= '0' && c <= '9';
+}
+
+int HexDigitValue(char c) noexcept {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+
+  return -1;
+}
+
+// Reads the four hex digits of a \uXXXX escape sequence.
+// The string was validated by ReadString, so the digits are always there.
+uint32_t ReadHex4(const char *&current) noexcept {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value = (value << 4) | static_cast<uint32_t>(HexDigitValue(*current++));
+  }
+
+  return value;
+}
+
+void AppendUtf8(std::string &result, uint32_t codePoint) noexcept {
+  if (codePoint < 0x80) {
+    result += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    result += static_cast<char>(0xC0 | (codePoint >> 6));
+    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    result += static_cast<char>(0xE0 | (codePoint >> 12));
+    result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    result += static_cast<char>(0xF0 | (codePoint >> 18));
+    result += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+} // namespace
+
+//===========================================================================
+// JsonTextReader implementation
+//===========================================================================
+
+JsonTextReader::JsonTextReader(std::string &&jsonText) noexcept
+    : m_jsonText{std::move(jsonText)}, m_current{m_jsonText.data()}, m_end{m_jsonText.data() + m_jsonText.size()} {
+  ReadRoot();
+}
+
+JsonTextReader::JsonTextReader(std::string_view jsonText) noexcept
+    : m_current{jsonText.data()}, m_end{jsonText.data() + jsonText.size()} {
+  ReadRoot();
+}
+
+JSValueType JsonTextReader::ValueType() noexcept {
+  return m_valueType;
+}
+
+bool JsonTextReader::GetNextObjectProperty(hstring &propertyName) noexcept {
+  propertyName = hstring{};
+  if (!m_isIterating) {
+    if (m_valueType == JSValueType::Object) {
+      m_stack.push_back(JSValueType::Object);
+      SkipWhitespace();
+      if (m_current != m_end && *m_current == '}') {
+        ++m_current;
+        m_stack.pop_back();
+        m_isIterating = !m_stack.empty();
+        return false;
+      }
+
+      return ReadProperty(propertyName);
+    }
+  } else if (!m_stack.empty() && m_stack.back() == JSValueType::Object) {
+    return ReadNextItem(JSValueType::Object, '}') && ReadProperty(propertyName);
+  }
+
+  return false;
+}
+
+bool JsonTextReader::GetNextArrayItem() noexcept {
+  if (!m_isIterating) {
+    if (m_valueType == JSValueType::Array) {
+      m_stack.push_back(JSValueType::Array);
+      SkipWhitespace();
+      if (m_current != m_end && *m_current == ']') {
+        ++m_current;
+        m_stack.pop_back();
+        m_isIterating = !m_stack.empty();
+        return false;
+      }
+
+      return ReadValue();
+    }
+  } else if (!m_stack.empty() && m_stack.back() == JSValueType::Array) {
+    return ReadNextItem(JSValueType::Array, ']') && ReadValue();
+  }
+
+  return false;
+}
+
+hstring JsonTextReader::GetString() noexcept {
+  return (m_valueType == JSValueType::String) ? DecodeString(m_stringValue, m_stringHasEscapes) : hstring{};
+}
+
+bool JsonTextReader::GetBoolean() noexcept {
+  return (m_valueType == JSValueType::Boolean) ? m_boolValue : false;
+}
+
+int64_t JsonTextReader::GetInt64() noexcept {
+  return (m_valueType == JSValueType::Int64) ? m_int64Value : 0;
+}
+
+double JsonTextReader::GetDouble() noexcept {
+  return (m_valueType == JSValueType::Double) ? m_doubleValue : 0;
+}
+
+void JsonTextReader::ReadRoot() noexcept {
+  if (ReadValue()) {
+    // A primitive root value must be the only value in the text.
+    // Text after a root container is not checked because it is never read.
+    SkipWhitespace();
+    if (m_isIterating && m_current != m_end) {
+      SetError();
+    }
+  }
+}
+
+// Parses the value at the current position and makes it the current value.
+// For objects and arrays it only consumes the opening bracket.
+bool JsonTextReader::ReadValue() noexcept {
+  SkipWhitespace();
+  if (m_current == m_end) {
+    return SetError();
+  }
+
+  m_isIterating = true;
+  switch (*m_current) {
+    case '{':
+      ++m_current;
+      m_valueType = JSValueType::Object;
+      m_isIterating = false;
+      return true;
+    case '[':
+      ++m_current;
+      m_valueType = JSValueType::Array;
+      m_isIterating = false;
+      return true;
+    case '"':
+      m_valueType = JSValueType::String;
+      return ReadString(m_stringValue, m_stringHasEscapes) || SetError();
+    case 't':
+      m_valueType = JSValueType::Boolean;
+      m_boolValue = true;
+      return ReadLiteral("true") || SetError();
+    case 'f':
+      m_valueType = JSValueType::Boolean;
+      m_boolValue = false;
+      return ReadLiteral("false") || SetError();
+    case 'n':
+      m_valueType = JSValueType::Null;
+      return ReadLiteral("null") || SetError();
+    default:
+      return ReadNumber() || SetError();
+  }
+}
+
+// Reads the string that starts at the current quote. The value is the text between
+// the quotes with the escape sequences left as they are.
+bool JsonTextReader::ReadString(std::string_view &value, bool &hasEscapes) noexcept {
+  const char *start = ++m_current;
+  hasEscapes = false;
+  while (m_current != m_end) {
+    const char c = *m_current;
+    if (c == '"') {
+      value = std::string_view(start, m_current - start);
+      ++m_current;
+      return true;
+    } else if (c == '\\') {
+      hasEscapes = true;
+      if (++m_current == m_end) {
+        return false;
+      }
+
+      switch (*m_current) {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+          break;
+        case 'u':
+          for (int i = 0; i < 4; ++i) {
+            if (++m_current == m_end || HexDigitValue(*m_current) < 0) {
+              return false;
+            }
+          }
+          break;
+        default:
+          return false;
+      }
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      return false;
+    }
+
+    ++m_current;
+  }
+
+  return false;
+}
+
+bool JsonTextReader::ReadNumber() noexcept {
+  const char *start = m_current;
+  bool isInteger = true;
+
+  if (m_current != m_end && *m_current == '-') {
+    ++m_current;
+  }
+
+  if (m_current == m_end || !IsDigit(*m_current)) {
+    return false;
+  }
+
+  if (*m_current == '0') {
+    ++m_current;
+  } else {
+    while (m_current != m_end && IsDigit(*m_current)) {
+      ++m_current;
+    }
+  }
+
+  if (m_current != m_end && *m_current == '.') {
+    isInteger = false;
+    if (++m_current == m_end || !IsDigit(*m_current)) {
+      return false;
+    }
+
+    while (m_current != m_end && IsDigit(*m_current)) {
+      ++m_current;
+    }
+  }
+
+  if (m_current != m_end && (*m_current == 'e' || *m_current == 'E')) {
+    isInteger = false;
+    if (++m_current != m_end && (*m_current == '+' || *m_current == '-')) {
+      ++m_current;
+    }
+
+    if (m_current == m_end || !IsDigit(*m_current)) {
+      return false;
+    }
+
+    while (m_current != m_end && IsDigit(*m_current)) {
+      ++m_current;
+    }
+  }
+
+  if (isInteger) {
+    auto result = std::from_chars(start, m_current, m_int64Value);
+    if (result.ec == std::errc{}) {
+      m_valueType = JSValueType::Int64;
+      return true;
+    }
+
+    // The integer does not fit into int64_t: read it as a double.
+  }
+
+  m_valueType = JSValueType::Double;
+  return std::from_chars(start, m_current, m_doubleValue).ec == std::errc{};
+}
+
+bool JsonTextReader::ReadLiteral(std::string_view literal) noexcept {
+  if (static_cast<size_t>(m_end - m_current) < literal.size() ||
+      std::string_view(m_current, literal.size()) != literal) {
+    return false;
+  }
+
+  m_current += literal.size();
+  return true;
+}
+
+// Reads the property name and moves to the property value.
+bool JsonTextReader::ReadProperty(hstring &propertyName) noexcept {
+  std::string_view name;
+  bool hasEscapes{false};
+
+  SkipWhitespace();
+  if (m_current == m_end || *m_current != '"' || !ReadString(name, hasEscapes)) {
+    return SetError();
+  }
+
+  SkipWhitespace();
+  if (m_current == m_end || *m_current != ':') {
+    return SetError();
+  }
+
+  ++m_current;
+  if (!ReadValue()) {
+    return false;
+  }
+
+  propertyName = DecodeString(name, hasEscapes);
+  return true;
+}
+
+// Moves past the comma after the current item.
+// Returns false and leaves the container if it has no more items.
+bool JsonTextReader::ReadNextItem(JSValueType containerType, char endChar) noexcept {
+  SkipWhitespace();
+  if (m_current != m_end) {
+    if (*m_current == ',') {
+      ++m_current;
+      return true;
+    } else if (*m_current == endChar) {
+      ++m_current;
+      m_valueType = containerType;
+      m_stack.pop_back();
+      m_isIterating = !m_stack.empty();
+      return false;
+    }
+  }
+
+  return SetError();
+}
+
+void JsonTextReader::SkipWhitespace() noexcept {
+  while (m_current != m_end && (*m_current == ' ' || *m_current == '\n' || *m_current == '\r' || *m_current == '\t')) {
+    ++m_current;
+  }
+}
+
+bool JsonTextReader::SetError() noexcept {
+  m_current = m_end;
+  m_valueType = JSValueType::Null;
+  m_stack.clear();
+  m_isIterating = true;
+  return false;
+}
+
+/*static*/ hstring JsonTextReader::DecodeString(std::string_view value, bool hasEscapes) noexcept {
+  if (!hasEscapes) {
+    return to_hstring(value);
+  }
+
+  std::string decoded;
+  decoded.reserve(value.size());
+
+  const char *current = value.data();
+  const char *end = value.data() + value.size();
+  while (current != end) {
+    const char c = *current++;
+    if (c != '\\') {
+      decoded += c;
+      continue;
+    }
+
+    switch (*current++) {
+      case 'b':
+        decoded += '\b';
+        break;
+      case 'f':
+        decoded += '\f';
+        break;
+      case 'n':
+        decoded += '\n';
+        break;
+      case 'r':
+        decoded += '\r';
+        break;
+      case 't':
+        decoded += '\t';
+        break;
+      case 'u': {
+        uint32_t codePoint = ReadHex4(current);
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF && end - current >= 6 && current[0] == '\\' &&
+            current[1] == 'u') {
+          const char *lowStart = current + 2;
+          uint32_t low = ReadHex4(lowStart);
+          if (low >= 0xDC00 && low <= 0xDFFF) {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            current = lowStart;
+          }
+        }
+
+        if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+          // Unpaired surrogate.
+          codePoint = 0xFFFD;
+        }
+
+        AppendUtf8(decoded, codePoint);
+        break;
+      }
+      default: // '"', '\\' and '/'
+        decoded += current[-1];
+        break;
+    }
+  }
+
+  return to_hstring(decoded);
+}
+
+} // namespace winrt::Microsoft::ReactNative
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "winrt/Microsoft.ReactNative.h"
+
+namespace winrt::Microsoft::ReactNative {
+
+// IJSValueReader that parses UTF-8 JSON text while it is being read.
+//
+// Unlike the folly::parseJson + DynamicReader pair it does not build an intermediate tree:
+// each call to GetNextObjectProperty or GetNextArrayItem parses only the next value.
+// Strings are kept as views into the JSON text, and their escape sequences are decoded
+// only when GetString is called.
+//
+// The reader has the same behavior as DynamicReader. Invalid JSON ends the reading:
+// the current value becomes null and GetNextObjectProperty / GetNextArrayItem return false.
+struct JsonTextReader : implements<JsonTextReader, IJSValueReader> {
+  // Takes ownership of the JSON text.
+  JsonTextReader(std::string &&jsonText) noexcept;
+
+  // Reads the JSON text in place. The text must outlive the reader.
+  JsonTextReader(std::string_view jsonText) noexcept;
+
+ public: // IJSValueReader
+  JSValueType ValueType() noexcept;
+  bool GetNextObjectProperty(hstring &propertyName) noexcept;
+  bool GetNextArrayItem() noexcept;
+  hstring GetString() noexcept;
+  bool GetBoolean() noexcept;
+  int64_t GetInt64() noexcept;
+  double GetDouble() noexcept;
+
+ private:
+  void ReadRoot() noexcept;
+  bool ReadValue() noexcept;
+  bool ReadString(std::string_view &value, bool &hasEscapes) noexcept;
+  bool ReadNumber() noexcept;
+  bool ReadLiteral(std::string_view literal) noexcept;
+  bool ReadProperty(hstring &propertyName) noexcept;
+  bool ReadNextItem(JSValueType containerType, char endChar) noexcept;
+  void SkipWhitespace() noexcept;
+  bool SetError() noexcept;
+
+  static hstring DecodeString(std::string_view value, bool hasEscapes) noexcept;
+
+ private:
+  const std::string m_jsonText;
+  const char *m_current{nullptr};
+  const char *m_end{nullptr};
+
+  JSValueType m_valueType{JSValueType::Null};
+  std::string_view m_stringValue;
+  bool m_stringHasEscapes{false};
+  union {
+    bool m_boolValue;
+    int64_t m_int64Value;
+    double m_doubleValue{0};
+  };
+
+  // Types of the containers that are being iterated.
+  std::vector<JSValueType> m_stack;
+
+  // False when the current value is a container that is not iterated yet.
+  bool m_isIterating{false};
+};
+
+} // namespace winrt::Microsoft::ReactNative
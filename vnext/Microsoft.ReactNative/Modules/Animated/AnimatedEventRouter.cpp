@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "AnimatedEventRouter.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+namespace react::uwp {
+
+EventNameId GetEventNameId(std::string_view registrationName) {
+  static std::mutex s_mutex;
+  static std::unordered_map<std::string, EventNameId> s_eventNameIds;
+
+  std::lock_guard<std::mutex> lock{s_mutex};
+  return s_eventNameIds.emplace(registrationName, static_cast<EventNameId>(s_eventNameIds.size() + 1)).first->second;
+}
+
+JsEventFilter::JsEventFilter(std::initializer_list<std::string_view> registrationNames) {
+  for (const auto registrationName : registrationNames) {
+    m_registrations.emplace_back(registrationName, GetEventNameId(registrationName));
+  }
+}
+
+bool JsEventFilter::UpdateProperty(const std::string &propertyName, const folly::dynamic &propertyValue) {
+  if (propertyName == "scrollEventThrottle") {
+    m_throttle = std::chrono::duration<double, std::milli>{propertyValue.isNumber() ? propertyValue.asDouble() : 0};
+    return true;
+  }
+
+  const auto it = std::find_if(
+      m_registrations.begin(), m_registrations.end(), [&propertyName](const auto &registration) {
+        return registration.first == propertyName;
+      });
+  if (it == m_registrations.end()) {
+    return false;
+  }
+
+  if (!propertyValue.isNull() && propertyValue.asBool()) {
+    m_jsListeners.insert(it->second);
+  } else {
+    m_jsListeners.erase(it->second);
+  }
+
+  return true;
+}
+
+bool JsEventFilter::ShouldSendToJs(
+    EventNameId eventNameId,
+    bool isContinuous,
+    bool isNativeDriven,
+    std::chrono::steady_clock::time_point timestamp) noexcept {
+  if (!isContinuous) {
+    m_sendNextThrottledEvent = true;
+  }
+
+  if (m_jsListeners.count(eventNameId) == 0) {
+    return false;
+  }
+
+  if (!isContinuous || !isNativeDriven) {
+    return true;
+  }
+
+  if (m_sendNextThrottledEvent || (m_throttle.count() > 0 && timestamp - m_lastThrottledEventTime >= m_throttle)) {
+    m_sendNextThrottledEvent = false;
+    m_lastThrottledEventTime = timestamp;
+    return true;
+  }
+
+  return false;
+}
+
+void AnimatedEventRouter::SetAnimatedValueSetter(AnimatedValueSetter &&setAnimatedValue) noexcept {
+  m_setAnimatedValue = std::move(setAnimatedValue);
+}
+
+void AnimatedEventRouter::AddEventDriver(int64_t viewTag, EventNameId eventNameId, EventAnimationDriver &&driver) {
+  m_eventDrivers[EventKey{viewTag, eventNameId}].push_back(std::move(driver));
+}
+
+void AnimatedEventRouter::RemoveEventDriver(int64_t viewTag, EventNameId eventNameId, int64_t animatedValueTag) {
+  const auto it = m_eventDrivers.find(EventKey{viewTag, eventNameId});
+  if (it != m_eventDrivers.end()) {
+    auto &drivers = it->second;
+    drivers.erase(
+        std::remove_if(
+            drivers.begin(),
+            drivers.end(),
+            [animatedValueTag](const EventAnimationDriver &driver) {
+              return driver.AnimatedValueTag() == animatedValueTag;
+            }),
+        drivers.end());
+
+    if (drivers.empty()) {
+      m_eventDrivers.erase(it);
+    }
+  }
+}
+
+bool AnimatedEventRouter::HasEventDrivers(int64_t viewTag, EventNameId eventNameId) const noexcept {
+  return !m_eventDrivers.empty() && m_eventDrivers.count(EventKey{viewTag, eventNameId}) != 0;
+}
+
+bool AnimatedEventRouter::RouteEvent(int64_t viewTag, EventNameId eventNameId, const EventValueReader &readValue)
+    const {
+  if (m_eventDrivers.empty()) {
+    return false;
+  }
+
+  const auto it = m_eventDrivers.find(EventKey{viewTag, eventNameId});
+  if (it == m_eventDrivers.end()) {
+    return false;
+  }
+
+  for (const auto &driver : it->second) {
+    double value{};
+    if (driver.ReadValue(readValue, value) && m_setAnimatedValue) {
+      m_setAnimatedValue(driver.AnimatedValueTag(), value);
+    }
+  }
+
+  return true;
+}
+
+JsEventFilter MakeScrollViewJsEventFilter() {
+  return JsEventFilter{
+      {"onScroll", "onScrollBeginDrag", "onScrollEndDrag", "onMomentumScrollBegin", "onMomentumScrollEnd"}};
+}
+
+bool IsContinuousScrollViewEvent(EventNameId eventNameId) noexcept {
+  static const EventNameId s_scrollEventNameId = GetEventNameId("onScroll");
+  return eventNameId == s_scrollEventNameId;
+}
+
+} // namespace react::uwp
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#include <folly/dynamic.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "EventAnimationDriver.h"
+
+namespace react::uwp {
+
+// Interned id of the registration name of a view event, like "onScroll".
+// Views intern the names of their events once instead of hashing them per event.
+using EventNameId = uint32_t;
+EventNameId GetEventNameId(std::string_view registrationName);
+
+// Decides which events of a view go to JS, from the props of the view. JS receives the
+// events it has handlers for. A ScrollView always has onScroll handlers, so the onScroll
+// events that drive native Animated.event mappings are throttled as RCTScrollView does on
+// iOS: JS receives one of them per scrollEventThrottle milliseconds, and the first one
+// after any other event of the view, like the start or the end of a drag. With a
+// scrollEventThrottle of 0, the default, it receives only the latter.
+class JsEventFilter {
+ public:
+  explicit JsEventFilter(std::initializer_list<std::string_view> registrationNames);
+
+  // Updates the filter from a property of the view. Returns false if the property is neither
+  // one of the event registrations nor scrollEventThrottle.
+  bool UpdateProperty(const std::string &propertyName, const folly::dynamic &propertyValue);
+
+  // Returns true if JS is to receive the event. Continuous events are the ones sent on every
+  // frame, like onScroll; only those are throttled, and only if they drive native mappings.
+  bool ShouldSendToJs(
+      EventNameId eventNameId,
+      bool isContinuous,
+      bool isNativeDriven,
+      std::chrono::steady_clock::time_point timestamp) noexcept;
+
+ private:
+  std::vector<std::pair<std::string, EventNameId>> m_registrations{};
+  std::unordered_set<EventNameId> m_jsListeners{};
+  std::chrono::duration<double, std::milli> m_throttle{0};
+  std::chrono::steady_clock::time_point m_lastThrottledEventTime{};
+  bool m_sendNextThrottledEvent{true};
+};
+
+// Routes the native view events that have Animated.event mappings straight into
+// the animated values, without a round trip through JS. There is one router per
+// React instance; views and the NativeAnimatedNodeManager use it on the UI thread.
+class AnimatedEventRouter {
+ public:
+  using AnimatedValueSetter = std::function<void(int64_t animatedValueTag, double value)>;
+
+  void SetAnimatedValueSetter(AnimatedValueSetter &&setAnimatedValue) noexcept;
+
+  void AddEventDriver(int64_t viewTag, EventNameId eventNameId, EventAnimationDriver &&driver);
+  void RemoveEventDriver(int64_t viewTag, EventNameId eventNameId, int64_t animatedValueTag);
+  bool HasEventDrivers(int64_t viewTag, EventNameId eventNameId) const noexcept;
+
+  // Sets the animated values mapped to the event. Returns false if the event has no mappings.
+  bool RouteEvent(int64_t viewTag, EventNameId eventNameId, const EventValueReader &readValue) const;
+
+  // Routes the event to its mapped animated values and then calls sendToJs only if
+  // jsEventFilter lets the event go to JS, so that the JS event object is not even
+  // built for the events that only drive native animations.
+  template <typename TSendToJs>
+  void EmitEvent(
+      int64_t viewTag,
+      EventNameId eventNameId,
+      bool isContinuous,
+      JsEventFilter &jsEventFilter,
+      std::chrono::steady_clock::time_point timestamp,
+      const EventValueReader &readValue,
+      TSendToJs &&sendToJs) const {
+    const bool isNativeDriven = RouteEvent(viewTag, eventNameId, readValue);
+    if (jsEventFilter.ShouldSendToJs(eventNameId, isContinuous, isNativeDriven, timestamp)) {
+      sendToJs();
+    }
+  }
+
+ private:
+  struct EventKey {
+    int64_t viewTag;
+    EventNameId eventNameId;
+
+    bool operator==(const EventKey &other) const noexcept {
+      return viewTag == other.viewTag && eventNameId == other.eventNameId;
+    }
+  };
+
+  struct EventKeyHash {
+    size_t operator()(const EventKey &key) const noexcept {
+      return std::hash<int64_t>{}(key.viewTag) ^ (static_cast<size_t>(key.eventNameId) * 0x9E3779B9u);
+    }
+  };
+
+  std::unordered_map<EventKey, std::vector<EventAnimationDriver>, EventKeyHash> m_eventDrivers{};
+  AnimatedValueSetter m_setAnimatedValue{};
+};
+
+// Returns the JsEventFilter of a ScrollView, for its five scroll event registrations.
+JsEventFilter MakeScrollViewJsEventFilter();
+
+// Returns true for onScroll, the continuous event of a ScrollView.
+bool IsContinuousScrollViewEvent(EventNameId eventNameId) noexcept;
+
+// Emits a scroll event of a ScrollView through the router. The Animated.event mappings read
+// the contentOffset, zoomScale and contentInset values, and the contentSize and layoutMeasurement
+// sizes returned by readSize(isContentSize, isWidth), which is called only for the mappings
+// that use them. ScrollViewShadowNode emits all its scroll events with it.
+template <typename TReadSize, typename TSendToJs>
+void EmitScrollViewEvent(
+    const AnimatedEventRouter &router,
+    int64_t viewTag,
+    EventNameId eventNameId,
+    JsEventFilter &jsEventFilter,
+    std::chrono::steady_clock::time_point timestamp,
+    double x,
+    double y,
+    double zoom,
+    TReadSize &&readSize,
+    TSendToJs &&sendToJs) {
+  const auto readValue = [&](const std::vector<std::string> &path, double &value) {
+    if (path.size() == 1 && path[0] == "zoomScale") {
+      value = zoom;
+    } else if (path.size() != 2) {
+      return false;
+    } else if (path[0] == "contentOffset") {
+      value = path[1] == "x" ? x : y;
+    } else if (path[0] == "contentSize" || path[0] == "layoutMeasurement") {
+      value = readSize(path[0] == "contentSize", path[1] == "width");
+    } else if (path[0] == "contentInset") {
+      value = 0;
+    } else {
+      return false;
+    }
+
+    return true;
+  };
+
+  router.EmitEvent(
+      viewTag,
+      eventNameId,
+      IsContinuousScrollViewEvent(eventNameId),
+      jsEventFilter,
+      timestamp,
+      readValue,
+      std::forward<TSendToJs>(sendToJs));
+}
+
+} // namespace react::uwp
@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "AnimatedNodeGraph.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace react::uwp {
+
+namespace {
+
+void EraseValue(std::vector<int64_t> &values, int64_t value) {
+  const auto it = std::find(values.begin(), values.end(), value);
+  if (it != values.end()) {
+    values.erase(it);
+  }
+}
+
+} // namespace
+
+void AnimatedNodeGraph::AddNode(int64_t tag, bool isPropsNode) {
+  const auto [it, isInserted] = m_nodes.try_emplace(tag);
+  it->second.isPropsNode = isPropsNode;
+  if (isInserted && m_isOrderValid) {
+    // A node without connections can go last.
+    it->second.order = m_order.size();
+    m_order.push_back(tag);
+  }
+}
+
+void AnimatedNodeGraph::RemoveNode(int64_t tag) {
+  const auto it = m_nodes.find(tag);
+  if (it == m_nodes.end()) {
+    return;
+  }
+
+  for (const auto parentTag : it->second.parents) {
+    EraseValue(m_nodes.at(parentTag).children, tag);
+  }
+
+  for (const auto childTag : it->second.children) {
+    EraseValue(m_nodes.at(childTag).parents, tag);
+  }
+
+  if (it->second.isDirty) {
+    EraseValue(m_dirtyNodes, tag);
+  }
+
+  m_nodes.erase(it);
+  InvalidateOrder();
+}
+
+bool AnimatedNodeGraph::HasNode(int64_t tag) const noexcept {
+  return m_nodes.count(tag) != 0;
+}
+
+void AnimatedNodeGraph::Connect(int64_t parentTag, int64_t childTag) {
+  const auto parentIt = m_nodes.find(parentTag);
+  const auto childIt = m_nodes.find(childTag);
+  if (parentIt == m_nodes.end() || childIt == m_nodes.end()) {
+    return;
+  }
+
+  auto &children = parentIt->second.children;
+  if (std::find(children.begin(), children.end(), childTag) != children.end()) {
+    return;
+  }
+
+  children.push_back(childTag);
+  childIt->second.parents.push_back(parentTag);
+
+  // The cached order stays valid while parents come before their children.
+  if (m_isOrderValid && parentIt->second.order > childIt->second.order) {
+    InvalidateOrder();
+  }
+}
+
+void AnimatedNodeGraph::Disconnect(int64_t parentTag, int64_t childTag) {
+  // Removing a connection keeps the cached order valid.
+  const auto parentIt = m_nodes.find(parentTag);
+  const auto childIt = m_nodes.find(childTag);
+  if (parentIt != m_nodes.end() && childIt != m_nodes.end()) {
+    EraseValue(parentIt->second.children, childTag);
+    EraseValue(childIt->second.parents, parentTag);
+  }
+}
+
+const std::vector<int64_t> &AnimatedNodeGraph::TopologicalOrder() {
+  UpdateOrder();
+  return m_order;
+}
+
+void AnimatedNodeGraph::MarkDirty(int64_t tag) {
+  const auto it = m_nodes.find(tag);
+  if (it != m_nodes.end() && !it->second.isDirty) {
+    it->second.isDirty = true;
+    m_dirtyNodes.push_back(tag);
+  }
+}
+
+bool AnimatedNodeGraph::HasDirtyNodes() const noexcept {
+  return !m_dirtyNodes.empty();
+}
+
+std::vector<int64_t> AnimatedNodeGraph::TakeDirtyPropsNodes() {
+  std::vector<int64_t> propsNodes;
+  if (m_dirtyNodes.empty()) {
+    return propsNodes;
+  }
+
+  UpdateOrder();
+
+  // Visit the dirty nodes and their descendants in topological order. Only the
+  // affected part of the graph is visited.
+  using OrderAndTag = std::pair<size_t, int64_t>;
+  std::priority_queue<OrderAndTag, std::vector<OrderAndTag>, std::greater<OrderAndTag>> pending;
+  for (const auto tag : m_dirtyNodes) {
+    pending.emplace(m_nodes.at(tag).order, tag);
+  }
+
+  while (!pending.empty()) {
+    const auto tag = pending.top().second;
+    pending.pop();
+
+    const auto &node = m_nodes.at(tag);
+    if (node.isPropsNode) {
+      propsNodes.push_back(tag);
+    }
+
+    for (const auto childTag : node.children) {
+      auto &child = m_nodes.at(childTag);
+      if (!child.isDirty) {
+        child.isDirty = true;
+        m_dirtyNodes.push_back(childTag);
+        pending.emplace(child.order, childTag);
+      }
+    }
+  }
+
+  for (const auto tag : m_dirtyNodes) {
+    m_nodes.at(tag).isDirty = false;
+  }
+
+  m_dirtyNodes.clear();
+  return propsNodes;
+}
+
+void AnimatedNodeGraph::AddTrackingAnimation(int64_t leadTag, int64_t animationId) {
+  RemoveTrackingAnimation(animationId);
+  m_trackingAnimations[leadTag].push_back(animationId);
+  m_trackingAnimationLeads.emplace(animationId, leadTag);
+}
+
+void AnimatedNodeGraph::RemoveTrackingAnimation(int64_t animationId) {
+  const auto leadIt = m_trackingAnimationLeads.find(animationId);
+  if (leadIt == m_trackingAnimationLeads.end()) {
+    return;
+  }
+
+  const auto animationsIt = m_trackingAnimations.find(leadIt->second);
+  EraseValue(animationsIt->second, animationId);
+  if (animationsIt->second.empty()) {
+    m_trackingAnimations.erase(animationsIt);
+  }
+
+  m_trackingAnimationLeads.erase(leadIt);
+}
+
+const std::vector<int64_t> &AnimatedNodeGraph::TrackingAnimations(int64_t leadTag) const noexcept {
+  static const std::vector<int64_t> s_noAnimations;
+  const auto it = m_trackingAnimations.find(leadTag);
+  return it != m_trackingAnimations.end() ? it->second : s_noAnimations;
+}
+
+void AnimatedNodeGraph::InvalidateOrder() noexcept {
+  m_isOrderValid = false;
+}
+
+void AnimatedNodeGraph::UpdateOrder() {
+  if (m_isOrderValid) {
+    return;
+  }
+
+  // Kahn's algorithm.
+  m_order.clear();
+  m_order.reserve(m_nodes.size());
+  for (auto &[tag, node] : m_nodes) {
+    node.pendingParentCount = node.parents.size();
+    if (node.pendingParentCount == 0) {
+      m_order.push_back(tag);
+    }
+  }
+
+  for (size_t i = 0; i < m_order.size(); ++i) {
+    for (const auto childTag : m_nodes.at(m_order[i]).children) {
+      if (--m_nodes.at(childTag).pendingParentCount == 0) {
+        m_order.push_back(childTag);
+      }
+    }
+  }
+
+  // Animated.js does not create cycles. If it ever does, the nodes of the cycle go last.
+  if (m_order.size() != m_nodes.size()) {
+    for (const auto &[tag, node] : m_nodes) {
+      if (node.pendingParentCount != 0) {
+        m_order.push_back(tag);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < m_order.size(); ++i) {
+    m_nodes.at(m_order[i]).order = i;
+  }
+
+  m_isOrderValid = true;
+}
+
+} // namespace react::uwp
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace react::uwp {
+
+// The connections of the animated nodes, kept apart from the nodes themselves so
+// that nothing in this header depends on Composition.
+//
+// Connections go from a parent node to the child node that uses its value, for
+// example from a value node to a style node and then to a props node. The graph
+// caches a topological order of the nodes, and propagates dirty bits along that
+// order so that only the props nodes that depend on a changed node are updated.
+// It also maps a lead value node to the animations that track it.
+class AnimatedNodeGraph {
+ public:
+  void AddNode(int64_t tag, bool isPropsNode);
+  void RemoveNode(int64_t tag);
+  bool HasNode(int64_t tag) const noexcept;
+
+  void Connect(int64_t parentTag, int64_t childTag);
+  void Disconnect(int64_t parentTag, int64_t childTag);
+
+  // Nodes ordered so that every parent comes before its children.
+  const std::vector<int64_t> &TopologicalOrder();
+
+  void MarkDirty(int64_t tag);
+  bool HasDirtyNodes() const noexcept;
+
+  // Returns the props nodes that are dirty or depend on a dirty node, in
+  // topological order, and clears the dirty bits.
+  std::vector<int64_t> TakeDirtyPropsNodes();
+
+  void AddTrackingAnimation(int64_t leadTag, int64_t animationId);
+  void RemoveTrackingAnimation(int64_t animationId);
+
+  // Animations that track the value of the lead node.
+  const std::vector<int64_t> &TrackingAnimations(int64_t leadTag) const noexcept;
+
+ private:
+  struct Node {
+    std::vector<int64_t> parents;
+    std::vector<int64_t> children;
+    size_t order{0}; // Index in m_order.
+    size_t pendingParentCount{0}; // Used while sorting.
+    bool isPropsNode{false};
+    bool isDirty{false};
+  };
+
+  void InvalidateOrder() noexcept;
+  void UpdateOrder();
+
+ private:
+  std::unordered_map<int64_t, Node> m_nodes{};
+  std::vector<int64_t> m_order{};
+  bool m_isOrderValid{true};
+  std::vector<int64_t> m_dirtyNodes{};
+  std::unordered_map<int64_t, std::vector<int64_t>> m_trackingAnimations{};
+  std::unordered_map<int64_t, int64_t> m_trackingAnimationLeads{};
+};
+
+} // namespace react::uwp
@@ -0,0 +1,259 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "AnimationSimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace react::uwp {
+
+namespace {
+
+constexpr double s_toValueFrameRate{60.0};
+
+// Time after which amplitude * e^(-rate * t) stays within threshold.
+double DecayTime(double amplitude, double rate, double threshold) noexcept {
+  if (amplitude <= threshold) {
+    return 0;
+  }
+
+  if (!(rate > 0) || !(threshold > 0)) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  return std::log(amplitude / threshold) / rate;
+}
+
+template <typename TSimulation>
+std::vector<AnimationKeyFrame> SimulateKeyFramesImpl(const TSimulation &simulation, const SimulationOptions &options) {
+  // The rest time is an upper bound: the loop below normally stops earlier, on
+  // the first sampled frame at rest. The extra frame absorbs rounding errors.
+  const double duration = (std::min)(simulation.RestTime(), options.maxDuration);
+  const auto maxFrames = static_cast<size_t>(std::ceil(duration * options.frameRate)) + 1;
+
+  std::vector<AnimationKeyFrame> keyFrames;
+  keyFrames.reserve(maxFrames + 1);
+  keyFrames.push_back({0, static_cast<float>(simulation.StateAt(0).value)});
+
+  typename TSimulation::FrameSampler sampler(simulation, options.frameRate);
+  for (size_t frame = 1; frame <= maxFrames; ++frame) {
+    const double time = frame / options.frameRate;
+    auto state = sampler.Next();
+
+    // Check for rest on the value that is displayed.
+    state.value = static_cast<float>(state.value);
+    keyFrames.push_back({time, static_cast<float>(state.value)});
+    if (simulation.IsDone(state)) {
+      break;
+    }
+  }
+
+  if (options.tolerance > 0) {
+    return ReduceKeyFrames(keyFrames, options.tolerance);
+  }
+
+  return keyFrames;
+}
+
+} // namespace
+
+//===========================================================================
+// SpringSimulation
+//===========================================================================
+
+SpringSimulation::SpringSimulation(SpringConfig config) noexcept : m_config(std::move(config)) {
+  const auto c = m_config.damping;
+  const auto m = m_config.mass;
+  const auto k = m_config.stiffness;
+
+  m_zeta = c / (2 * std::sqrt(k * m));
+  m_omega0 = std::sqrt(k / m);
+  m_omega1 = m_omega0 * std::sqrt(1.0 - (m_zeta * m_zeta));
+}
+
+double SpringSimulation::TargetAt(double time) const noexcept {
+  const auto frame = static_cast<size_t>(time * s_toValueFrameRate);
+  if (frame < m_config.toValueFrames.size()) {
+    return m_config.fromValue + m_config.toValueFrames[frame] * (m_config.toValue - m_config.fromValue);
+  }
+
+  return m_config.toValue;
+}
+
+SimulationState SpringSimulation::StateAt(double time) const noexcept {
+  if (m_zeta < 1) {
+    return StateAt(time, std::exp(-m_zeta * m_omega0 * time), std::sin(m_omega1 * time), std::cos(m_omega1 * time));
+  } else {
+    return StateAt(time, std::exp(-m_omega0 * time), 0, 1);
+  }
+}
+
+SimulationState SpringSimulation::StateAt(double time, double envelope, double sin, double cos) const noexcept {
+  const auto toValue = TargetAt(time);
+  const auto v0 = -m_config.initialVelocity;
+  const auto x0 = toValue - m_config.fromValue;
+
+  if (m_zeta < 1) {
+    const auto c = v0 + m_zeta * m_omega0 * x0;
+    return {toValue - envelope * (c / m_omega1 * sin + x0 * cos),
+            m_zeta * m_omega0 * envelope * (sin * c / m_omega1 + x0 * cos) -
+                envelope * (cos * c - m_omega1 * x0 * sin)};
+  } else {
+    return {toValue - envelope * (x0 + (v0 + m_omega0 * x0) * time),
+            envelope * (v0 * (time * m_omega0 - 1) + time * x0 * (m_omega0 * m_omega0))};
+  }
+}
+
+SpringSimulation::FrameSampler::FrameSampler(const SpringSimulation &simulation, double frameRate) noexcept
+    : m_simulation(simulation),
+      m_frameRate(frameRate),
+      m_envelopeStep(std::exp(
+          -(simulation.m_zeta < 1 ? simulation.m_zeta * simulation.m_omega0 : simulation.m_omega0) / frameRate)),
+      m_sinStep(simulation.m_zeta < 1 ? std::sin(simulation.m_omega1 / frameRate) : 0),
+      m_cosStep(simulation.m_zeta < 1 ? std::cos(simulation.m_omega1 / frameRate) : 1) {}
+
+SimulationState SpringSimulation::FrameSampler::Next() noexcept {
+  // e^(-a * (t + dt)) = e^(-a * t) * e^(-a * dt), and the angle addition formulas.
+  const auto sin = m_sin * m_cosStep + m_cos * m_sinStep;
+  const auto cos = m_cos * m_cosStep - m_sin * m_sinStep;
+  m_sin = sin;
+  m_cos = cos;
+  m_envelope *= m_envelopeStep;
+
+  return m_simulation.StateAt(++m_frame / m_frameRate, m_envelope, m_sin, m_cos);
+}
+
+bool SpringSimulation::IsDone(const SimulationState &state) const noexcept {
+  const bool isAtRest = std::abs(state.velocity) <= m_config.restSpeedThreshold &&
+      (std::abs(state.value - m_config.toValue) <= m_config.restDisplacementThreshold || m_config.stiffness == 0);
+
+  const bool isOvershooting = m_config.overshootClamping && m_config.stiffness > 0 &&
+      ((m_config.fromValue < m_config.toValue && state.value > m_config.toValue) ||
+       (m_config.fromValue > m_config.toValue && state.value < m_config.toValue));
+
+  return isAtRest || isOvershooting;
+}
+
+double SpringSimulation::RestTime() const noexcept {
+  // Both the displacement and the velocity are bounded by amplitude * e^(-rate * t).
+  const auto v0 = -m_config.initialVelocity;
+  const auto x0 = m_config.toValue - m_config.fromValue;
+  double rate, displacementAmplitude, velocityAmplitude;
+
+  if (m_zeta < 1) {
+    // The displacement and the velocity are damped sinusoids.
+    const auto c = v0 + m_zeta * m_omega0 * x0;
+    rate = m_zeta * m_omega0;
+    displacementAmplitude = std::hypot(x0, c / m_omega1);
+    velocityAmplitude = std::hypot(rate * x0 - c, rate * c / m_omega1 + m_omega1 * x0);
+  } else {
+    // The displacement and the velocity are (a + b * t) * e^(-omega0 * t).
+    // Since t * e^(-omega0 * t / 2) <= 2 / (e * omega0), they are bounded by
+    // (|a| + 2 * |b| / (e * omega0)) * e^(-omega0 * t / 2).
+    const auto bScale = 2 / (std::exp(1.0) * m_omega0);
+    rate = m_omega0 / 2;
+    displacementAmplitude = std::abs(x0) + bScale * std::abs(v0 + m_omega0 * x0);
+    velocityAmplitude = std::abs(v0) + bScale * std::abs(v0 * m_omega0 + x0 * m_omega0 * m_omega0);
+  }
+
+  const auto velocityTime = DecayTime(velocityAmplitude, rate, m_config.restSpeedThreshold);
+  const auto displacementTime =
+      m_config.stiffness == 0 ? 0 : DecayTime(displacementAmplitude, rate, m_config.restDisplacementThreshold);
+  const auto toValueFramesTime = m_config.toValueFrames.size() / s_toValueFrameRate;
+
+  const auto restTime = (std::max)({velocityTime, displacementTime, toValueFramesTime});
+  return std::isnan(restTime) ? std::numeric_limits<double>::infinity() : restTime;
+}
+
+//===========================================================================
+// DecaySimulation
+//===========================================================================
+
+DecaySimulation::DecaySimulation(const DecayConfig &config) noexcept
+    : m_config(config),
+      // The velocity is in units per millisecond.
+      m_rate((1 - config.deceleration) * 1000),
+      m_distance(config.velocity / (1 - config.deceleration)) {}
+
+SimulationState DecaySimulation::StateAt(double time) const noexcept {
+  return StateForEnvelope(std::exp(-m_rate * time));
+}
+
+SimulationState DecaySimulation::StateForEnvelope(double envelope) const noexcept {
+  return {m_config.fromValue + m_distance * (1 - envelope), m_config.velocity * envelope};
+}
+
+DecaySimulation::FrameSampler::FrameSampler(const DecaySimulation &simulation, double frameRate) noexcept
+    : m_simulation(simulation), m_envelopeStep(std::exp(-simulation.m_rate / frameRate)) {}
+
+SimulationState DecaySimulation::FrameSampler::Next() noexcept {
+  m_envelope *= m_envelopeStep;
+  return m_simulation.StateForEnvelope(m_envelope);
+}
+
+bool DecaySimulation::IsDone(const SimulationState &state) const noexcept {
+  return std::abs(ToValue() - state.value) < s_restDisplacementThreshold;
+}
+
+double DecaySimulation::RestTime() const noexcept {
+  return DecayTime(std::abs(m_distance), m_rate, s_restDisplacementThreshold);
+}
+
+double DecaySimulation::ToValue() const noexcept {
+  return m_config.fromValue + m_distance;
+}
+
+//===========================================================================
+// Key frames
+//===========================================================================
+
+std::vector<AnimationKeyFrame> SimulateKeyFrames(const SpringSimulation &simulation, const SimulationOptions &options) {
+  return SimulateKeyFramesImpl(simulation, options);
+}
+
+std::vector<AnimationKeyFrame> SimulateKeyFrames(const DecaySimulation &simulation, const SimulationOptions &options) {
+  return SimulateKeyFramesImpl(simulation, options);
+}
+
+std::vector<AnimationKeyFrame> ReduceKeyFrames(const std::vector<AnimationKeyFrame> &keyFrames, double tolerance) {
+  if (keyFrames.size() <= 2) {
+    return keyFrames;
+  }
+
+  std::vector<AnimationKeyFrame> reduced;
+  reduced.push_back(keyFrames.front());
+
+  // Extend the segment that starts at the last kept key frame for as long as it
+  // passes within tolerance of every key frame it covers. Each covered key
+  // frame bounds the slope of the segment, so we only track the intersection
+  // of these bounds.
+  size_t anchor = 0;
+  double minSlope = -std::numeric_limits<double>::infinity();
+  double maxSlope = std::numeric_limits<double>::infinity();
+
+  for (size_t candidate = 1; candidate < keyFrames.size(); ++candidate) {
+    const auto &end = keyFrames[candidate];
+    const auto slope = (end.value - keyFrames[anchor].value) / (end.time - keyFrames[anchor].time);
+    if (slope < minSlope || slope > maxSlope) {
+      anchor = candidate - 1;
+      reduced.push_back(keyFrames[anchor]);
+      minSlope = -std::numeric_limits<double>::infinity();
+      maxSlope = std::numeric_limits<double>::infinity();
+    }
+
+    const auto &start = keyFrames[anchor];
+    const auto interval = end.time - start.time;
+    minSlope = (std::max)(minSlope, (end.value - tolerance - start.value) / interval);
+    maxSlope = (std::min)(maxSlope, (end.value + tolerance - start.value) / interval);
+  }
+
+  reduced.push_back(keyFrames.back());
+  return reduced;
+}
+
+} // namespace react::uwp
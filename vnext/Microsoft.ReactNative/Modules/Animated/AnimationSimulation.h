@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace react::uwp {
+
+// Platform-independent simulations of the physics-based animations. The
+// calculated animation drivers turn their key frames into Composition key frame
+// animations, but nothing in this header depends on Composition.
+
+struct SimulationState {
+  double value{0};
+  double velocity{0};
+};
+
+struct AnimationKeyFrame {
+  double time{0}; // In seconds from the start of the animation.
+  float value{0}; // Composition key frames are single precision.
+};
+
+struct SimulationOptions {
+  // Rate at which the simulation is sampled, in frames per second.
+  double frameRate{60.0};
+
+  // Key frames that can be linearly interpolated from the key frames around
+  // them within this absolute error are dropped. Zero keeps every sample.
+  double tolerance{0.0};
+
+  // Animations that never come to rest, such as undamped springs, stop after
+  // this many seconds.
+  double maxDuration{30.0};
+};
+
+struct SpringConfig {
+  double fromValue{0};
+  double toValue{0};
+  double stiffness{0};
+  double damping{0};
+  double mass{0};
+  double initialVelocity{0};
+  double restSpeedThreshold{0};
+  double restDisplacementThreshold{0};
+  bool overshootClamping{false};
+
+  // Optional 60 Hz frames of an animated target, as fractions of the distance
+  // between fromValue and toValue. The target is toValue after the last frame.
+  std::vector<double> toValueFrames;
+};
+
+class SpringSimulation {
+ public:
+  explicit SpringSimulation(SpringConfig config) noexcept;
+
+  SimulationState StateAt(double time) const noexcept;
+  bool IsDone(const SimulationState &state) const noexcept;
+
+  // Closed-form upper bound of the time after which the spring stays at rest.
+  // Infinite if the spring never comes to rest.
+  double RestTime() const noexcept;
+
+  // Returns the states at consecutive frames. Instead of evaluating exp, sin
+  // and cos at every frame, it multiplies by the change over one frame.
+  class FrameSampler {
+   public:
+    FrameSampler(const SpringSimulation &simulation, double frameRate) noexcept;
+    SimulationState Next() noexcept;
+
+   private:
+    const SpringSimulation &m_simulation;
+    double m_frameRate;
+    size_t m_frame{0};
+    double m_envelope{1};
+    double m_envelopeStep;
+    double m_sin{0};
+    double m_cos{1};
+    double m_sinStep;
+    double m_cosStep;
+  };
+
+ private:
+  double TargetAt(double time) const noexcept;
+  SimulationState StateAt(double time, double envelope, double sin, double cos) const noexcept;
+
+  SpringConfig m_config;
+  double m_zeta{0};
+  double m_omega0{0};
+  double m_omega1{0};
+};
+
+struct DecayConfig {
+  double fromValue{0};
+  double velocity{0}; // In units per millisecond.
+  double deceleration{0};
+};
+
+class DecaySimulation {
+ public:
+  explicit DecaySimulation(const DecayConfig &config) noexcept;
+
+  SimulationState StateAt(double time) const noexcept;
+  bool IsDone(const SimulationState &state) const noexcept;
+  double RestTime() const noexcept;
+  double ToValue() const noexcept;
+
+  class FrameSampler {
+   public:
+    FrameSampler(const DecaySimulation &simulation, double frameRate) noexcept;
+    SimulationState Next() noexcept;
+
+   private:
+    const DecaySimulation &m_simulation;
+    double m_envelope{1};
+    double m_envelopeStep;
+  };
+
+ private:
+  SimulationState StateForEnvelope(double envelope) const noexcept;
+
+  DecayConfig m_config;
+  double m_rate{0};
+  double m_distance{0};
+
+  static constexpr double s_restDisplacementThreshold{0.1};
+};
+
+// Samples the simulation at options.frameRate until it comes to rest. The first
+// key frame is the state at time 0, and the time of the last key frame is the
+// duration of the animation.
+std::vector<AnimationKeyFrame> SimulateKeyFrames(const SpringSimulation &simulation, const SimulationOptions &options);
+std::vector<AnimationKeyFrame> SimulateKeyFrames(const DecaySimulation &simulation, const SimulationOptions &options);
+
+// Drops the key frames that linear interpolation between the remaining key
+// frames reproduces within tolerance. The first and last key frames are kept.
+std::vector<AnimationKeyFrame> ReduceKeyFrames(const std::vector<AnimationKeyFrame> &keyFrames, double tolerance);
+
+} // namespace react::uwp
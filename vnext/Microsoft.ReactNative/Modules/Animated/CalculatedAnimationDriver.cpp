@@ -19,29 +19,23 @@ std::tuple<comp::CompositionAnimation, comp::CompositionScopedBatch> CalculatedA
   }();
 
   m_startValue = GetAnimatedValue()->Value();
-  std::vector<float> keyFrames = [this]() {
-    std::vector<float> keyFrames;
-    bool done = false;
-    double time = 0;
-    while (!done) {
-      time += 1.0f / 60.0f;
-      auto [currentValue, currentVelocity] = GetValueAndVelocityForTime(time);
-      keyFrames.push_back(currentValue);
-      if (IsAnimationDone(currentValue, currentVelocity)) {
-        done = true;
-      }
-    }
-    return keyFrames;
+  const auto keyFrames = [this]() {
+    SimulationOptions options;
+    options.frameRate = s_frameRate;
+    options.tolerance = std::max(std::abs(ToValue() - m_startValue), 1.0) * s_relativeTolerance;
+    return MakeKeyFrames(options);
   }();
 
-  std::chrono::milliseconds duration(static_cast<int>(keyFrames.size() / 60.0f * 1000.0f));
-  animation.Duration(duration);
-  auto normalizedProgress = 0.0f;
+  // The first key frame is at time 0 and the last one ends the animation.
+  const auto duration = keyFrames.back().time;
+  animation.Duration(std::chrono::milliseconds(static_cast<int>(duration * 1000.0)));
+
   // We are animating the values offset property which should start at 0.
-  animation.InsertKeyFrame(normalizedProgress, 0.0f, easingFunction);
-  for (const auto keyFrame : keyFrames) {
-    normalizedProgress = std::min(normalizedProgress + 1.0f / keyFrames.size(), 1.0f);
-    animation.InsertKeyFrame(normalizedProgress, keyFrame - static_cast<float>(m_startValue), easingFunction);
+  animation.InsertKeyFrame(0.0f, 0.0f, easingFunction);
+  for (size_t i = 1; i < keyFrames.size(); ++i) {
+    const auto normalizedProgress = std::min(static_cast<float>(keyFrames[i].time / duration), 1.0f);
+    animation.InsertKeyFrame(
+        normalizedProgress, keyFrames[i].value - static_cast<float>(m_startValue), easingFunction);
   }
 
   if (m_iterations == -1) {
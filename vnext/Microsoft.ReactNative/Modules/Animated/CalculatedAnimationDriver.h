@@ -6,6 +6,7 @@
 #include <utility>
 #include "AnimatedNode.h"
 #include "AnimationDriver.h"
+#include "AnimationSimulation.h"
 
 namespace react::uwp {
 class CalculatedAnimationDriver : public AnimationDriver {
@@ -16,9 +17,16 @@ class CalculatedAnimationDriver : public AnimationDriver {
       const folly::dynamic &config) override;
 
  protected:
-  virtual std::tuple<float, double> GetValueAndVelocityForTime(double time) = 0;
+  // Returns the key frames of the animation from m_startValue, with absolute values.
+  virtual std::vector<AnimationKeyFrame> MakeKeyFrames(const SimulationOptions &options) = 0;
 
-  virtual bool IsAnimationDone(double currentValue, double currentVelocity) = 0;
   double m_startValue{0};
+
+ private:
+  // Composition interpolates between the key frames, so we can sample faster
+  // than 60 Hz for high refresh rate displays and still create fewer key
+  // frames by dropping the ones that interpolation reproduces.
+  static constexpr double s_frameRate{120.0};
+  static constexpr double s_relativeTolerance{0.001};
 };
 } // namespace react::uwp
@@ -19,15 +19,8 @@ DecayAnimationDriver::DecayAnimationDriver(
   m_velocity = config.find(s_velocityName).dereference().second.asDouble();
 }
 
-std::tuple<float, double> DecayAnimationDriver::GetValueAndVelocityForTime(double time) {
-  const auto value =
-      m_startValue + m_velocity / (1 - m_deceleration) * (1 - std::exp(-(1 - m_deceleration) * (1000 * time)));
-  return std::make_tuple(static_cast<float>(value),
-                         42.0f); // we don't need the velocity, so set it to a dummy value
-}
-
-bool DecayAnimationDriver::IsAnimationDone(double currentValue, double /*currentVelocity*/) {
-  return (std::abs(ToValue() - currentValue) < 0.1);
+std::vector<AnimationKeyFrame> DecayAnimationDriver::MakeKeyFrames(const SimulationOptions &options) {
+  return SimulateKeyFrames(DecaySimulation({m_startValue, m_velocity, m_deceleration}), options);
 }
 
 double DecayAnimationDriver::ToValue() {
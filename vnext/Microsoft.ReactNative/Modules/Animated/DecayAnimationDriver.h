@@ -19,8 +19,7 @@ class DecayAnimationDriver : public CalculatedAnimationDriver {
   double ToValue() override;
 
  protected:
-  std::tuple<float, double> GetValueAndVelocityForTime(double time) override;
-  bool IsAnimationDone(double currentValue, double currentVelocity) override;
+  std::vector<AnimationKeyFrame> MakeKeyFrames(const SimulationOptions &options) override;
 
  private:
   double m_velocity{0};
@@ -4,24 +4,21 @@
 #include "pch.h"
 
 #include "EventAnimationDriver.h"
-#include "NativeAnimatedNodeManager.h"
 
 namespace react::uwp {
-EventAnimationDriver::EventAnimationDriver(
-    const folly::dynamic &eventPath,
-    int64_t animatedValueTag,
-    const std::shared_ptr<NativeAnimatedNodeManager> &manager)
-    : m_animatedValueTag(animatedValueTag), m_manager(manager) {
+EventAnimationDriver::EventAnimationDriver(const folly::dynamic &eventPath, int64_t animatedValueTag)
+    : m_animatedValueTag(animatedValueTag) {
   for (const auto &path : eventPath) {
     m_eventPath.push_back(path.getString());
   }
 }
 
-ValueAnimatedNode *EventAnimationDriver::AnimatedValue() {
-  if (const auto manager = m_manager.lock()) {
-    return manager->GetValueAnimatedNode(m_animatedValueTag);
-  }
-  return static_cast<ValueAnimatedNode *>(nullptr);
+int64_t EventAnimationDriver::AnimatedValueTag() const noexcept {
+  return m_animatedValueTag;
+}
+
+bool EventAnimationDriver::ReadValue(const EventValueReader &readValue, double &value) const {
+  return readValue(m_eventPath, value);
 }
 
 } // namespace react::uwp
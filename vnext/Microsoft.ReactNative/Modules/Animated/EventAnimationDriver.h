@@ -3,22 +3,27 @@
 
 #pragma once
 #include <folly/dynamic.h>
-#include "AnimatedNode.h"
-#include "ValueAnimatedNode.h"
+#include <functional>
+#include <string>
+#include <vector>
 
 namespace react::uwp {
-class ValueAnimatedNode;
+
+// Reads the numeric value of a native event at the given path, e.g. {"contentOffset", "y"}.
+// Returns false if the event has no numeric value at the path.
+using EventValueReader = std::function<bool(const std::vector<std::string> &path, double &value)>;
+
+// Maps a value of a native view event to an animated value, as Animated.event does
+// with useNativeDriver. It does not depend on Composition.
 class EventAnimationDriver {
  public:
-  EventAnimationDriver(
-      const folly::dynamic &eventPath,
-      int64_t animatedValueTag,
-      const std::shared_ptr<NativeAnimatedNodeManager> &manager);
-  ValueAnimatedNode *AnimatedValue();
+  EventAnimationDriver(const folly::dynamic &eventPath, int64_t animatedValueTag);
+
+  int64_t AnimatedValueTag() const noexcept;
+  bool ReadValue(const EventValueReader &readValue, double &value) const;
 
  private:
   std::vector<std::string> m_eventPath{};
   int64_t m_animatedValueTag{};
-  std::weak_ptr<NativeAnimatedNodeManager> m_manager{};
 };
 } // namespace react::uwp
@@ -32,6 +32,9 @@ const char *NativeAnimatedModule::s_stopListeningToAnimatedNodeValueName{"stopLi
 NativeAnimatedModule::NativeAnimatedModule(const std::weak_ptr<IReactInstance> &reactInstance)
     : m_wkReactInstance(reactInstance) {
   m_nodesManager = std::make_shared<NativeAnimatedNodeManager>(NativeAnimatedNodeManager());
+  if (const auto instance = reactInstance.lock()) {
+    m_nodesManager->ConnectEventRouter(instance->GetAnimatedEventRouter(), m_nodesManager);
+  }
 }
 
 std::vector<facebook::xplat::module::CxxModule::Method> NativeAnimatedModule::getMethods() {
@@ -204,14 +207,18 @@ void NativeAnimatedModule::AddAnimatedEventToView(
     int64_t tag,
     const std::string &eventName,
     const folly::dynamic &eventMapping) {
-  m_nodesManager->AddAnimatedEventToView(tag, eventName, eventMapping, m_nodesManager);
+  if (const auto instance = m_wkReactInstance.lock()) {
+    m_nodesManager->AddAnimatedEventToView(tag, eventName, eventMapping, instance->GetAnimatedEventRouter());
+  }
 }
 
 void NativeAnimatedModule::RemoveAnimatedEventFromView(
     int64_t tag,
     const std::string &eventName,
     int64_t animatedValueTag) {
-  m_nodesManager->RemoveAnimatedEventFromView(tag, eventName, animatedValueTag);
+  if (const auto instance = m_wkReactInstance.lock()) {
+    m_nodesManager->RemoveAnimatedEventFromView(tag, eventName, animatedValueTag, instance->GetAnimatedEventRouter());
+  }
 }
 
 void NativeAnimatedModule::StartListeningToAnimatedNodeValue(int64_t /*tag*/) {
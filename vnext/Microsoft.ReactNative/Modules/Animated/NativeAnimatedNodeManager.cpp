@@ -31,89 +31,100 @@ void NativeAnimatedNodeManager::CreateAnimatedNode(
     const folly::dynamic &config,
     const std::weak_ptr<IReactInstance> &instance,
     const std::shared_ptr<NativeAnimatedNodeManager> &manager) {
-  if (m_transformNodes.count(tag) > 0 || m_propsNodes.count(tag) > 0 || m_styleNodes.count(tag) > 0 ||
-      m_valueNodes.count(tag) > 0) {
+  if (m_nodes.count(tag) > 0) {
     throw std::invalid_argument("AnimatedNode with tag " + std::to_string(tag) + " already exists.");
     return;
   }
 
-  switch (const auto type = AnimatedNodeTypeFromString(config.find("type").dereference().second.getString())) {
+  std::unique_ptr<AnimatedNode> node;
+  const auto type = AnimatedNodeTypeFromString(config.find("type").dereference().second.getString());
+  switch (type) {
     case AnimatedNodeType::Style: {
-      m_styleNodes.emplace(tag, std::make_unique<StyleAnimatedNode>(tag, config, manager));
+      node = std::make_unique<StyleAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Value: {
-      m_valueNodes.emplace(tag, std::make_unique<ValueAnimatedNode>(tag, config, manager));
+      node = std::make_unique<ValueAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Props: {
-      m_propsNodes.emplace(tag, std::make_unique<PropsAnimatedNode>(tag, config, instance, manager));
+      node = std::make_unique<PropsAnimatedNode>(tag, config, instance, manager);
       break;
     }
     case AnimatedNodeType::Interpolation: {
-      m_valueNodes.emplace(tag, std::make_unique<InterpolationAnimatedNode>(tag, config, manager));
+      node = std::make_unique<InterpolationAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Addition: {
-      m_valueNodes.emplace(tag, std::make_unique<AdditionAnimatedNode>(tag, config, manager));
+      node = std::make_unique<AdditionAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Subtraction: {
-      m_valueNodes.emplace(tag, std::make_unique<SubtractionAnimatedNode>(tag, config, manager));
+      node = std::make_unique<SubtractionAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Division: {
-      m_valueNodes.emplace(tag, std::make_unique<DivisionAnimatedNode>(tag, config, manager));
+      node = std::make_unique<DivisionAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Multiplication: {
-      m_valueNodes.emplace(tag, std::make_unique<MultiplicationAnimatedNode>(tag, config, manager));
+      node = std::make_unique<MultiplicationAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Modulus: {
-      m_valueNodes.emplace(tag, std::make_unique<ModulusAnimatedNode>(tag, config, manager));
+      node = std::make_unique<ModulusAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Diffclamp: {
-      m_valueNodes.emplace(tag, std::make_unique<DiffClampAnimatedNode>(tag, config, manager));
+      node = std::make_unique<DiffClampAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Transform: {
-      m_transformNodes.emplace(tag, std::make_unique<TransformAnimatedNode>(tag, config, manager));
+      node = std::make_unique<TransformAnimatedNode>(tag, config, manager);
       break;
     }
     case AnimatedNodeType::Tracking: {
-      m_trackingNodes.emplace(tag, std::make_unique<TrackingAnimatedNode>(tag, config, manager));
+      node = std::make_unique<TrackingAnimatedNode>(tag, config, manager);
       break;
     }
     default: {
       assert(false);
-      break;
+      return;
     }
   }
+
+  m_nodes.emplace(tag, AnimatedNodeEntry{type, std::move(node)});
+  m_graph.AddNode(tag, type == AnimatedNodeType::Props);
 }
 
 void NativeAnimatedNodeManager::ConnectAnimatedNodeToView(int64_t propsNodeTag, int64_t viewTag) {
-  m_propsNodes.at(propsNodeTag)->ConnectToView(viewTag);
+  if (const auto propsNode = GetPropsAnimatedNode(propsNodeTag)) {
+    propsNode->ConnectToView(viewTag);
+  }
 }
 
 void NativeAnimatedNodeManager::DisconnectAnimatedNodeToView(int64_t propsNodeTag, int64_t viewTag) {
-  m_propsNodes.at(propsNodeTag)->DisconnectFromView(viewTag);
+  if (const auto propsNode = GetPropsAnimatedNode(propsNodeTag)) {
+    propsNode->DisconnectFromView(viewTag);
+  }
 }
 
 void NativeAnimatedNodeManager::ConnectAnimatedNode(int64_t parentNodeTag, int64_t childNodeTag) {
   if (const auto parentNode = GetAnimatedNode(parentNodeTag)) {
     parentNode->AddChild(childNodeTag);
+    m_graph.Connect(parentNodeTag, childNodeTag);
   }
 }
 
 void NativeAnimatedNodeManager::DisconnectAnimatedNode(int64_t parentNodeTag, int64_t childNodeTag) {
   if (const auto parentNode = GetAnimatedNode(parentNodeTag)) {
     parentNode->RemoveChild(childNodeTag);
+    m_graph.Disconnect(parentNodeTag, childNodeTag);
   }
 }
 
 void NativeAnimatedNodeManager::StopAnimation(int64_t animationId) {
+  m_graph.RemoveTrackingAnimation(animationId);
   if (m_activeAnimations.count(animationId)) {
     if (const auto animation = m_activeAnimations.at(animationId).get()) {
       animation->StopAnimation();
@@ -196,7 +207,7 @@ void NativeAnimatedNodeManager::StartTrackingAnimatedNode(
     }
   }
   if (track) {
-    m_trackingAndLeadNodeTags.push_back(std::make_tuple(animationId, animatedToValueTag));
+    m_graph.AddTrackingAnimation(animatedToValueTag, animationId);
   }
   StartAnimatingNode(animationId, animatedNodeTag, updatedAnimationConfig, endCallback, manager);
 }
@@ -237,96 +248,82 @@ void NativeAnimatedNodeManager::StartAnimatingNode(
   if (m_activeAnimations.count(animationId)) {
     m_activeAnimations.at(animationId)->StartAnimation();
 
-    for (auto const &trackingAndLead : m_trackingAndLeadNodeTags) {
-      if (std::get<1>(trackingAndLead) == animatedNodeTag) {
-        RestartTrackingAnimatedNode(std::get<0>(trackingAndLead), std::get<1>(trackingAndLead), manager);
-      }
+    // Restarting a tracking animation can start other animations, so iterate over a copy.
+    const auto trackingAnimations = m_graph.TrackingAnimations(animatedNodeTag);
+    for (const auto trackingAnimationId : trackingAnimations) {
+      RestartTrackingAnimatedNode(trackingAnimationId, animatedNodeTag, manager);
     }
   }
 }
 
 void NativeAnimatedNodeManager::DropAnimatedNode(int64_t tag) {
-  m_valueNodes.erase(tag);
-  m_propsNodes.erase(tag);
-  m_styleNodes.erase(tag);
-  m_transformNodes.erase(tag);
+  m_nodes.erase(tag);
+  m_graph.RemoveNode(tag);
 }
 
 void NativeAnimatedNodeManager::SetAnimatedNodeValue(int64_t tag, double value) {
-  if (const auto valueNode = m_valueNodes.at(tag).get()) {
+  if (const auto valueNode = GetValueAnimatedNode(tag)) {
     valueNode->RawValue(static_cast<float>(value));
   }
 }
 
 void NativeAnimatedNodeManager::SetAnimatedNodeOffset(int64_t tag, double offset) {
-  if (const auto valueNode = m_valueNodes.at(tag).get()) {
+  if (const auto valueNode = GetValueAnimatedNode(tag)) {
     valueNode->Offset(static_cast<float>(offset));
   }
 }
 
 void NativeAnimatedNodeManager::FlattenAnimatedNodeOffset(int64_t tag) {
-  if (const auto valueNode = m_valueNodes.at(tag).get()) {
+  if (const auto valueNode = GetValueAnimatedNode(tag)) {
     valueNode->FlattenOffset();
   }
 }
 
 void NativeAnimatedNodeManager::ExtractAnimatedNodeOffset(int64_t tag) {
-  if (const auto valueNode = m_valueNodes.at(tag).get()) {
+  if (const auto valueNode = GetValueAnimatedNode(tag)) {
     valueNode->ExtractOffset();
   }
 }
 
+void NativeAnimatedNodeManager::ConnectEventRouter(
+    AnimatedEventRouter &eventRouter,
+    const std::shared_ptr<NativeAnimatedNodeManager> &manager) {
+  // The views route their events through the instance router straight into the value nodes.
+  eventRouter.SetAnimatedValueSetter(
+      [weakManager = std::weak_ptr<NativeAnimatedNodeManager>(manager)](int64_t animatedValueTag, double value) {
+        if (const auto manager = weakManager.lock()) {
+          if (const auto valueNode = manager->GetValueAnimatedNode(animatedValueTag)) {
+            valueNode->RawValue(value);
+          }
+        }
+      });
+}
+
 void NativeAnimatedNodeManager::AddAnimatedEventToView(
     int64_t viewTag,
     const std::string &eventName,
     const folly::dynamic &eventMapping,
-    const std::shared_ptr<NativeAnimatedNodeManager> &manager) {
+    AnimatedEventRouter &eventRouter) {
   const auto valueNodeTag = static_cast<int64_t>(eventMapping.find("animatedValueTag").dereference().second.asDouble());
   const auto pathList = eventMapping.find("nativeEventPath").dereference().second;
-
-  const auto key = std::make_tuple(viewTag, eventName);
-  if (m_eventDrivers.count(key)) {
-    m_eventDrivers.at(key).emplace_back(std::make_unique<EventAnimationDriver>(pathList, valueNodeTag, manager));
-  } else {
-    auto vector = std::vector<std::unique_ptr<EventAnimationDriver>>{};
-    vector.emplace_back(std::make_unique<EventAnimationDriver>(pathList, valueNodeTag, manager));
-    m_eventDrivers.insert({key, std::move(vector)});
-  }
+  eventRouter.AddEventDriver(viewTag, GetEventNameId(eventName), EventAnimationDriver(pathList, valueNodeTag));
 }
 
 void NativeAnimatedNodeManager::RemoveAnimatedEventFromView(
     int64_t viewTag,
     const std::string &eventName,
-    int64_t animatedValueTag) {
-  const auto key = std::make_tuple(viewTag, eventName);
-  if (m_eventDrivers.count(key)) {
-    auto &drivers = m_eventDrivers.at(key);
-
-    for (auto iterator = drivers.begin(); iterator != drivers.end();) {
-      if (const auto value = iterator->get()->AnimatedValue()) {
-        if (value->Tag() == animatedValueTag) {
-          iterator = drivers.erase(iterator);
-          continue;
-        }
-      }
-      ++iterator;
-    }
-
-    if (!drivers.size()) {
-      m_eventDrivers.erase(key);
-    }
-  }
+    int64_t animatedValueTag,
+    AnimatedEventRouter &eventRouter) {
+  eventRouter.RemoveEventDriver(viewTag, GetEventNameId(eventName), animatedValueTag);
 }
 
 void NativeAnimatedNodeManager::ProcessDelayedPropsNodes() {
-  // If StartAnimations fails we'll put the props nodes back into this queue to
-  // try again when the next batch completes. Because of this we need to copy
-  // the props to change into a local and clear the member before we begin.
-  const auto delayedPropsNodes = m_delayedPropsNodes;
-  m_delayedPropsNodes.clear();
-  for (const auto tag : delayedPropsNodes) {
-    if (m_propsNodes.count(tag) > 0) {
-      m_propsNodes.at(tag)->StartAnimations();
+  // If StartAnimations fails the props node is marked dirty again to try again
+  // when the next batch completes. Taking the dirty props nodes clears the
+  // dirty bits before we begin.
+  for (const auto tag : m_graph.TakeDirtyPropsNodes()) {
+    if (const auto propsNode = GetPropsAnimatedNode(tag)) {
+      propsNode->StartAnimations();
     }
   }
 }
@@ -334,66 +331,65 @@ void NativeAnimatedNodeManager::ProcessDelayedPropsNodes() {
 void NativeAnimatedNodeManager::AddDelayedPropsNode(
     int64_t propsNodeTag,
     const std::shared_ptr<IReactInstance> &instance) {
-  m_delayedPropsNodes.push_back(propsNodeTag);
-  if (m_delayedPropsNodes.size() <= 1) {
+  const bool hadDirtyNodes = m_graph.HasDirtyNodes();
+  m_graph.MarkDirty(propsNodeTag);
+  if (!hadDirtyNodes) {
     static_cast<NativeUIManager *>(instance->NativeUIManager())->AddBatchCompletedCallback([this]() {
       ProcessDelayedPropsNodes();
     });
   }
 }
 
-AnimatedNode *NativeAnimatedNodeManager::GetAnimatedNode(int64_t tag) {
-  if (m_valueNodes.count(tag)) {
-    return m_valueNodes.at(tag).get();
-  }
-  if (m_styleNodes.count(tag)) {
-    return m_styleNodes.at(tag).get();
-  }
-  if (m_propsNodes.count(tag)) {
-    return m_propsNodes.at(tag).get();
-  }
-  if (m_transformNodes.count(tag)) {
-    return m_transformNodes.at(tag).get();
+static bool IsValueNodeType(AnimatedNodeType type) noexcept {
+  switch (type) {
+    case AnimatedNodeType::Value:
+    case AnimatedNodeType::Interpolation:
+    case AnimatedNodeType::Addition:
+    case AnimatedNodeType::Subtraction:
+    case AnimatedNodeType::Division:
+    case AnimatedNodeType::Multiplication:
+    case AnimatedNodeType::Modulus:
+    case AnimatedNodeType::Diffclamp:
+      return true;
+    default:
+      return false;
   }
-  if (m_trackingNodes.count(tag)) {
-    return m_trackingNodes.at(tag).get();
+}
+
+AnimatedNode *NativeAnimatedNodeManager::GetAnimatedNode(int64_t tag) {
+  const auto it = m_nodes.find(tag);
+  return it != m_nodes.end() ? it->second.node.get() : nullptr;
+}
+
+AnimatedNode *NativeAnimatedNodeManager::GetAnimatedNode(int64_t tag, AnimatedNodeType type) {
+  const auto it = m_nodes.find(tag);
+  if (it == m_nodes.end()) {
+    return nullptr;
   }
-  return static_cast<AnimatedNode *>(nullptr);
+
+  const auto nodeType = it->second.type;
+  const bool isMatch = type == AnimatedNodeType::Value ? IsValueNodeType(nodeType) : nodeType == type;
+  return isMatch ? it->second.node.get() : nullptr;
 }
 
 ValueAnimatedNode *NativeAnimatedNodeManager::GetValueAnimatedNode(int64_t tag) {
-  if (m_valueNodes.count(tag)) {
-    return m_valueNodes.at(tag).get();
-  }
-  return static_cast<ValueAnimatedNode *>(nullptr);
+  return static_cast<ValueAnimatedNode *>(GetAnimatedNode(tag, AnimatedNodeType::Value));
 }
 
 PropsAnimatedNode *NativeAnimatedNodeManager::GetPropsAnimatedNode(int64_t tag) {
-  if (m_propsNodes.count(tag)) {
-    return m_propsNodes.at(tag).get();
-  }
-  return static_cast<PropsAnimatedNode *>(nullptr);
+  return static_cast<PropsAnimatedNode *>(GetAnimatedNode(tag, AnimatedNodeType::Props));
 }
 
 StyleAnimatedNode *NativeAnimatedNodeManager::GetStyleAnimatedNode(int64_t tag) {
-  if (m_styleNodes.count(tag)) {
-    return m_styleNodes.at(tag).get();
-  }
-  return static_cast<StyleAnimatedNode *>(nullptr);
+  return static_cast<StyleAnimatedNode *>(GetAnimatedNode(tag, AnimatedNodeType::Style));
 }
 
 TransformAnimatedNode *NativeAnimatedNodeManager::GetTransformAnimatedNode(int64_t tag) {
-  if (m_transformNodes.count(tag)) {
-    return m_transformNodes.at(tag).get();
-  }
-  return static_cast<TransformAnimatedNode *>(nullptr);
+  return static_cast<TransformAnimatedNode *>(GetAnimatedNode(tag, AnimatedNodeType::Transform));
 }
 
 TrackingAnimatedNode *NativeAnimatedNodeManager::GetTrackingAnimatedNode(int64_t tag) {
-  if (m_trackingNodes.count(tag)) {
-    return m_trackingNodes.at(tag).get();
-  }
-  return nullptr;
+  return static_cast<TrackingAnimatedNode *>(GetAnimatedNode(tag, AnimatedNodeType::Tracking));
 }
 
 void NativeAnimatedNodeManager::RemoveActiveAnimation(int64_t tag) {
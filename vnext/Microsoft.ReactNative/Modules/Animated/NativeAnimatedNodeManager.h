@@ -7,9 +7,11 @@
 #include <IReactInstance.h>
 #include <cxxreact/CxxModule.h>
 #include <folly/dynamic.h>
+#include "AnimatedEventRouter.h"
 #include "AnimatedNode.h"
+#include "AnimatedNodeGraph.h"
+#include "AnimatedNodeType.h"
 #include "AnimationDriver.h"
-#include "EventAnimationDriver.h"
 #include "PropsAnimatedNode.h"
 #include "StyleAnimatedNode.h"
 #include "TrackingAnimatedNode.h"
@@ -36,7 +38,6 @@ class ValueAnimatedNode;
 class TransformAnimatedNode;
 class TrackingAnimatedNode;
 class AnimationDriver;
-class EventAnimationDriver;
 class NativeAnimatedNodeManager {
  public:
   void CreateAnimatedNode(
@@ -72,12 +73,17 @@ class NativeAnimatedNodeManager {
   void SetAnimatedNodeOffset(int64_t tag, double offset);
   void FlattenAnimatedNodeOffset(int64_t tag);
   void ExtractAnimatedNodeOffset(int64_t tag);
+  void ConnectEventRouter(AnimatedEventRouter &eventRouter, const std::shared_ptr<NativeAnimatedNodeManager> &manager);
   void AddAnimatedEventToView(
       int64_t viewTag,
       const std::string &eventName,
       const folly::dynamic &eventMapping,
-      const std::shared_ptr<NativeAnimatedNodeManager> &manager);
-  void RemoveAnimatedEventFromView(int64_t viewTag, const std::string &eventName, int64_t animatedValueTag);
+      AnimatedEventRouter &eventRouter);
+  void RemoveAnimatedEventFromView(
+      int64_t viewTag,
+      const std::string &eventName,
+      int64_t animatedValueTag,
+      AnimatedEventRouter &eventRouter);
   void ProcessDelayedPropsNodes();
   void AddDelayedPropsNode(int64_t propsNodeTag, const std::shared_ptr<IReactInstance> &instance);
 
@@ -90,16 +96,19 @@ class NativeAnimatedNodeManager {
   void RemoveActiveAnimation(int64_t tag);
 
  private:
-  std::unordered_map<int64_t, std::unique_ptr<ValueAnimatedNode>> m_valueNodes{};
-  std::unordered_map<int64_t, std::unique_ptr<PropsAnimatedNode>> m_propsNodes{};
-  std::unordered_map<int64_t, std::unique_ptr<StyleAnimatedNode>> m_styleNodes{};
-  std::unordered_map<int64_t, std::unique_ptr<TransformAnimatedNode>> m_transformNodes{};
-  std::unordered_map<int64_t, std::unique_ptr<TrackingAnimatedNode>> m_trackingNodes{};
-  std::unordered_map<std::tuple<int64_t, std::string>, std::vector<std::unique_ptr<EventAnimationDriver>>>
-      m_eventDrivers{};
+  struct AnimatedNodeEntry {
+    AnimatedNodeType type;
+    std::unique_ptr<AnimatedNode> node;
+  };
+
+  AnimatedNode *GetAnimatedNode(int64_t tag, AnimatedNodeType type);
+
+ private:
+  // All nodes are kept in one table, and their connections and tracking
+  // animations in the graph.
+  std::unordered_map<int64_t, AnimatedNodeEntry> m_nodes{};
+  AnimatedNodeGraph m_graph{};
   std::unordered_map<int64_t, std::unique_ptr<AnimationDriver>> m_activeAnimations{};
-  std::vector<std::tuple<int64_t, int64_t>> m_trackingAndLeadNodeTags{};
-  std::vector<int64_t> m_delayedPropsNodes{};
 
   static constexpr std::string_view s_toValueIdName{"toValue"};
   static constexpr std::string_view s_framesName{"frames"};
@@ -29,56 +29,24 @@ SpringAnimationDriver::SpringAnimationDriver(
   m_iterations = static_cast<int>(config.find(s_iterationsParameterName).dereference().second.asDouble());
 }
 
-bool SpringAnimationDriver::IsAnimationDone(double currentValue, double currentVelocity) {
-  return (
-      IsAtRest(currentVelocity, currentValue, m_endValue) ||
-      (m_overshootClampingEnabled && IsOvershooting(currentValue)));
-}
-
-std::tuple<float, double> SpringAnimationDriver::GetValueAndVelocityForTime(double time) {
-  const auto toValue = [this, time]() {
-    const auto frameFromTime = static_cast<int>(time * 60.0);
-    if (frameFromTime < static_cast<int>(m_dynamicToValues.size())) {
-      return m_startValue + (m_dynamicToValues[frameFromTime].asDouble() * (m_endValue - m_startValue));
-    }
-    return m_endValue;
-  }();
-  const auto c = m_springDamping;
-  const auto m = m_springMass;
-  const auto k = m_springStiffness;
-  const auto v0 = -m_initialVelocity;
-
-  const auto zeta = c / (2 * std::sqrt(k * m));
-  const auto omega0 = std::sqrt(k / m);
-  const auto omega1 = omega0 * std::sqrt(1.0 - (zeta * zeta));
-  const auto x0 = toValue - m_startValue;
-
-  if (zeta < 1) {
-    const auto envelope = std::exp(-zeta * omega0 * time);
-    const auto value = static_cast<float>(
-        toValue -
-        envelope * ((v0 + zeta * omega0 * x0) / omega1 * std::sin(omega1 * time) + x0 * std::cos(omega1 * time)));
-    const auto velocity = zeta * omega0 * envelope *
-            (std::sin(omega1 * time) * (v0 + zeta * omega0 * x0) / omega1 + x0 * std::cos(omega1 * time)) -
-        envelope * (std::cos(omega1 * time) * (v0 + zeta * omega0 * x0) - omega1 * x0 * std::sin(omega1 * time));
-    return std::make_tuple(value, velocity);
-  } else {
-    const auto envelope = std::exp(-omega0 * time);
-    const auto value = static_cast<float>(m_endValue - envelope * (x0 + (v0 + omega0 * x0) * time));
-    const auto velocity = envelope * (v0 * (time * omega0 - 1) + time * x0 * (omega0 * omega0));
-    return std::make_tuple(value, velocity);
+std::vector<AnimationKeyFrame> SpringAnimationDriver::MakeKeyFrames(const SimulationOptions &options) {
+  SpringConfig config;
+  config.fromValue = m_startValue;
+  config.toValue = m_endValue;
+  config.stiffness = m_springStiffness;
+  config.damping = m_springDamping;
+  config.mass = m_springMass;
+  config.initialVelocity = m_initialVelocity;
+  config.restSpeedThreshold = m_restSpeedThreshold;
+  config.restDisplacementThreshold = m_displacementFromRestThreshold;
+  config.overshootClamping = m_overshootClampingEnabled;
+
+  config.toValueFrames.reserve(m_dynamicToValues.size());
+  for (const auto &frame : m_dynamicToValues) {
+    config.toValueFrames.push_back(frame.asDouble());
   }
-}
-
-bool SpringAnimationDriver::IsAtRest(double currentVelocity, double currentValue, double endValue) {
-  return std::abs(currentVelocity) <= m_restSpeedThreshold &&
-      (std::abs(currentValue - endValue) <= m_displacementFromRestThreshold || m_springStiffness == 0);
-}
 
-bool SpringAnimationDriver::IsOvershooting(double currentValue) {
-  return m_springStiffness > 0 &&
-      ((m_startValue < m_endValue && currentValue > m_endValue) ||
-       (m_startValue > m_endValue && currentValue < m_endValue));
+  return SimulateKeyFrames(SpringSimulation(std::move(config)), options);
 }
 
 double SpringAnimationDriver::ToValue() {
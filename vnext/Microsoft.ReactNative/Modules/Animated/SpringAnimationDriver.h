@@ -21,13 +21,9 @@ class SpringAnimationDriver : public CalculatedAnimationDriver {
   double ToValue() override;
 
  protected:
-  std::tuple<float, double> GetValueAndVelocityForTime(double time) override;
-  bool IsAnimationDone(double currentValue, double currentVelocity) override;
+  std::vector<AnimationKeyFrame> MakeKeyFrames(const SimulationOptions &options) override;
 
  private:
-  bool IsAtRest(double currentVelocity, double currentPosition, double endValue);
-  bool IsOvershooting(double currentValue);
-
   double m_springStiffness{0};
   double m_springDamping{0};
   double m_springMass{0};
@@ -31,6 +31,22 @@ static YogaNodePtr make_yoga_node(YGConfigRef config) {
   return result;
 }
 
+// Yoga may call measure functions on a layout worker, but they measure XAML
+// elements, which can only be used on the UI thread.
+static YGSize MeasureOnLayoutThread(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  YGSize result{};
+  ParallelYogaLayout::RunOnLayoutThread([&]() {
+    YogaContext *context = reinterpret_cast<YogaContext *>(YGNodeGetContext(node));
+    result = context->measureFunc(node, width, widthMode, height, heightMode);
+  });
+  return result;
+}
+
 #if defined(_DEBUG)
 static int YogaLog(
     const YGConfigRef /*config*/,
@@ -737,9 +753,9 @@ void NativeUIManager::CreateView(facebook::react::ShadowNode &shadowNode, folly:
 
       YGMeasureFunc func = pViewManager->GetYogaCustomMeasureFunc();
       if (func != nullptr) {
-        YGNodeSetMeasureFunc(yogaNode, func);
+        YGNodeSetMeasureFunc(yogaNode, &MeasureOnLayoutThread);
 
-        auto context = std::make_unique<YogaContext>(node.GetView());
+        auto context = std::make_unique<YogaContext>(node.GetView(), func);
         YGNodeSetContext(yogaNode, reinterpret_cast<void *>(context.get()));
 
         m_tagsToYogaContext.emplace(node.m_tag, std::move(context));
@@ -770,6 +786,42 @@ void NativeUIManager::AddView(
   }
 }
 
+void NativeUIManager::SpliceChildren(
+    facebook::react::ShadowNode &parentShadowNode,
+    const facebook::react::ChildrenSplice &splice) {
+  ShadowNodeBase &parentNode = static_cast<ShadowNodeBase &>(parentShadowNode);
+  auto *pViewManager = parentNode.GetViewManager();
+
+  if (pViewManager->RequiresYogaNode() && !pViewManager->IsNativeControlWithSelfLayout()) {
+    YGNodeRef yogaNodeToManage = GetYogaNode(parentNode.m_tag);
+    if (yogaNodeToManage == nullptr) {
+      return;
+    }
+
+    // Take out the removed and the moved children first, so that the yoga
+    // children match the shadow node children when the added ones are inserted.
+    for (const auto &removed : splice.Removed) {
+      if (YGNodeRef yogaNodeToRemove = GetYogaNode(removed.Node->m_tag)) {
+        YGNodeRemoveChild(yogaNodeToManage, yogaNodeToRemove);
+      }
+    }
+
+    for (const auto &added : splice.Added) {
+      if (YGNodeRef yogaNodeToAdd = GetYogaNode(added.Node->m_tag)) {
+        if (YGNodeRef yogaOldParent = YGNodeGetOwner(yogaNodeToAdd)) {
+          YGNodeRemoveChild(yogaOldParent, yogaNodeToAdd);
+        }
+      }
+    }
+
+    for (const auto &added : splice.Added) {
+      if (YGNodeRef yogaNodeToAdd = GetYogaNode(added.Node->m_tag)) {
+        YGNodeInsertChild(yogaNodeToManage, yogaNodeToAdd, static_cast<uint32_t>(added.Index));
+      }
+    }
+  }
+}
+
 void NativeUIManager::RemoveView(facebook::react::ShadowNode &shadowNode, bool removeChildren /*= true*/) {
   ShadowNodeBase &node = static_cast<ShadowNodeBase &>(shadowNode);
 
@@ -801,7 +853,7 @@ void NativeUIManager::ReplaceView(facebook::react::ShadowNode &shadowNode) {
 
       YGMeasureFunc func = pViewManager->GetYogaCustomMeasureFunc();
       if (func != nullptr) {
-        auto context = std::make_unique<YogaContext>(node.GetView());
+        auto context = std::make_unique<YogaContext>(node.GetView(), func);
         YGNodeSetContext(yogaNode, reinterpret_cast<void *>(context.get()));
 
         m_tagsToYogaContext.erase(node.m_tag);
@@ -855,6 +907,8 @@ void NativeUIManager::DoLayout() {
   // Values need to be cleared from the vector before next call to DoLayout.
   m_extraLayoutNodes.clear();
   auto &rootTags = m_host->GetAllRootTags();
+  std::vector<YogaLayoutRoot> layoutRoots;
+  layoutRoots.reserve(rootTags.size());
   for (int64_t rootTag : rootTags) {
     UpdateExtraLayout(rootTag);
 
@@ -864,13 +918,15 @@ void NativeUIManager::DoLayout() {
 
     float actualWidth = static_cast<float>(rootElement.ActualWidth());
     float actualHeight = static_cast<float>(rootElement.ActualHeight());
-
-    // We must always run layout in LTR mode, which might seem unintuitive.
-    // We will flip the root of the tree into RTL by forcing the root XAML node's FlowDirection to RightToLeft
-    // which will inherit down the XAML tree, allowing all native controls to pick it up.
-    YGNodeCalculateLayout(rootNode, actualWidth, actualHeight, YGDirectionLTR);
+    layoutRoots.push_back({rootNode, actualWidth, actualHeight});
   }
 
+  // Root views share no Yoga nodes, so they are laid out concurrently.
+  // We must always run layout in LTR mode, which might seem unintuitive.
+  // We will flip the root of the tree into RTL by forcing the root XAML node's FlowDirection to RightToLeft
+  // which will inherit down the XAML tree, allowing all native controls to pick it up.
+  m_parallelLayout.CalculateLayout(layoutRoots);
+
   for (auto &tagToYogaNode : m_tagsToYogaNodes) {
     int64_t tag = tagToYogaNode.first;
     YGNodeRef yogaNode = tagToYogaNode.second.get();
@@ -5,6 +5,7 @@
 
 #include <INativeUIManager.h>
 #include <IReactRootView.h>
+#include <Modules/ParallelYogaLayout.h>
 #include <Views/ViewManagerBase.h>
 
 #include <folly/dynamic.h>
@@ -50,6 +51,9 @@ class NativeUIManager final : public facebook::react::INativeUIManager {
       facebook::react::ShadowNode &parentShadowNode,
       facebook::react::ShadowNode &childShadowNode,
       uint64_t index) override;
+  void SpliceChildren(
+      facebook::react::ShadowNode &parentShadowNode,
+      const facebook::react::ChildrenSplice &splice) override;
   void RemoveView(facebook::react::ShadowNode &shadowNode, bool removeChildren = true) override;
   void ReplaceView(facebook::react::ShadowNode &shadowNode) override;
   void UpdateView(facebook::react::ShadowNode &shadowNode, folly::dynamic /*ReadableMap*/ props) override;
@@ -77,6 +81,16 @@ class NativeUIManager final : public facebook::react::INativeUIManager {
 
   // Other public functions
   void DirtyYogaNode(int64_t tag);
+
+  // Counts the property updates that did not dirty a Yoga node because none
+  // of their properties can change the measured size of the view.
+  void SkipDirtyYogaNode() noexcept {
+    ++m_skippedDirtyYogaNodeCount;
+  }
+  uint64_t GetSkippedDirtyYogaNodeCount() const noexcept {
+    return m_skippedDirtyYogaNodeCount;
+  }
+
   void AddBatchCompletedCallback(std::function<void()> callback);
 
   // For unparented node like Flyout, XamlRoot should be set to handle
@@ -100,7 +114,9 @@ class NativeUIManager final : public facebook::react::INativeUIManager {
   facebook::react::INativeUIManagerHost *m_host = nullptr;
   Mso::CntPtr<Mso::React::IReactContext> m_context;
   YGConfigRef m_yogaConfig;
+  ParallelYogaLayout m_parallelLayout;
   bool m_inBatch = false;
+  uint64_t m_skippedDirtyYogaNodeCount = 0;
 
   std::map<int64_t, YogaNodePtr> m_tagsToYogaNodes;
   std::map<int64_t, std::unique_ptr<YogaContext>> m_tagsToYogaContext;
@@ -0,0 +1,170 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "ParallelYogaLayout.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace react::uwp {
+
+namespace {
+
+// The layout that owns the current worker thread.
+thread_local ParallelYogaLayout *t_layout{nullptr};
+
+} // namespace
+
+ParallelYogaLayout::ParallelYogaLayout(size_t workerCount) : m_workerCount{workerCount} {}
+
+ParallelYogaLayout::~ParallelYogaLayout() {
+  {
+    std::scoped_lock lock{m_mutex};
+    m_isStopping = true;
+  }
+
+  m_workCondition.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+}
+
+size_t ParallelYogaLayout::DefaultWorkerCount() noexcept {
+  // The layout thread only runs calls from the workers, so it is not counted.
+  const size_t threadCount = std::thread::hardware_concurrency();
+  return std::min<size_t>(threadCount > 1 ? threadCount - 1 : 0, 4);
+}
+
+void ParallelYogaLayout::CalculateLayout(const std::vector<YogaLayoutRoot> &roots) {
+  if (roots.size() <= 1 || m_workerCount == 0) {
+    for (const auto &root : roots) {
+      YGNodeCalculateLayout(root.node, root.width, root.height, YGDirectionLTR);
+    }
+
+    return;
+  }
+
+  if (m_workers.empty()) {
+    for (size_t i = 0; i < m_workerCount; ++i) {
+      m_workers.emplace_back([this]() { RunWorker(); });
+    }
+  }
+
+  {
+    std::scoped_lock lock{m_mutex};
+    m_roots = &roots;
+    m_nextRoot = 0;
+    m_runningWorkerCount = m_workerCount;
+    ++m_passId;
+  }
+
+  m_workCondition.notify_all();
+  RunCallsUntilWorkersAreDone();
+
+  std::exception_ptr exception;
+  {
+    std::scoped_lock lock{m_mutex};
+    m_roots = nullptr;
+    exception = std::exchange(m_layoutException, nullptr);
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ParallelYogaLayout::RunOnLayoutThread(const std::function<void()> &func) {
+  if (ParallelYogaLayout *layout = t_layout) {
+    layout->RunCall(func);
+  } else {
+    func();
+  }
+}
+
+void ParallelYogaLayout::RunWorker() noexcept {
+  t_layout = this;
+
+  // Each pass waits for all workers, so a worker never misses a pass.
+  uint64_t lastPassId = 0;
+  for (;;) {
+    {
+      std::unique_lock lock{m_mutex};
+      m_workCondition.wait(lock, [this, lastPassId]() { return m_isStopping || m_passId != lastPassId; });
+      if (m_isStopping) {
+        return;
+      }
+
+      lastPassId = m_passId;
+    }
+
+    std::exception_ptr exception;
+    try {
+      LayoutRoots();
+    } catch (...) {
+      exception = std::current_exception();
+      m_nextRoot = m_roots->size();
+    }
+
+    std::scoped_lock lock{m_mutex};
+    if (exception && !m_layoutException) {
+      m_layoutException = std::move(exception);
+    }
+
+    if (--m_runningWorkerCount == 0) {
+      m_layoutCondition.notify_one();
+    }
+  }
+}
+
+void ParallelYogaLayout::LayoutRoots() {
+  const auto &roots = *m_roots;
+  for (size_t i = m_nextRoot++; i < roots.size(); i = m_nextRoot++) {
+    YGNodeCalculateLayout(roots[i].node, roots[i].width, roots[i].height, YGDirectionLTR);
+  }
+}
+
+void ParallelYogaLayout::RunCall(const std::function<void()> &func) {
+  Call call{&func, false, nullptr};
+  {
+    std::unique_lock lock{m_mutex};
+    m_calls.push_back(&call);
+    m_layoutCondition.notify_one();
+    m_callDoneCondition.wait(lock, [&call]() { return call.isDone; });
+  }
+
+  if (call.exception) {
+    std::rethrow_exception(call.exception);
+  }
+}
+
+void ParallelYogaLayout::RunCallsUntilWorkersAreDone() {
+  std::unique_lock lock{m_mutex};
+  for (;;) {
+    m_layoutCondition.wait(lock, [this]() { return !m_calls.empty() || m_runningWorkerCount == 0; });
+    if (m_calls.empty()) {
+      return;
+    }
+
+    auto calls = std::exchange(m_calls, {});
+    lock.unlock();
+    for (Call *call : calls) {
+      // The worker that waits for the call rethrows its exception.
+      try {
+        (*call->func)();
+      } catch (...) {
+        call->exception = std::current_exception();
+      }
+    }
+
+    lock.lock();
+    for (Call *call : calls) {
+      call->isDone = true;
+    }
+
+    m_callDoneCondition.notify_all();
+  }
+}
+
+} // namespace react::uwp
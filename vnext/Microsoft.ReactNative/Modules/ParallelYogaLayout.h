@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#include <yoga/yoga.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace react::uwp {
+
+// A Yoga tree root and the size available to it.
+struct YogaLayoutRoot {
+  YGNodeRef node;
+  float width;
+  float height;
+};
+
+// Calculates the layout of independent Yoga trees at the same time on a pool of
+// worker threads. The trees must not share nodes.
+//
+// The thread that calls CalculateLayout waits for the workers, and meanwhile runs
+// the functions that the workers pass to RunOnLayoutThread. Measure functions that
+// use thread-affine objects, such as XAML elements, must go through it.
+// An exception thrown by a measure function is rethrown by CalculateLayout.
+class ParallelYogaLayout {
+ public:
+  explicit ParallelYogaLayout(size_t workerCount = DefaultWorkerCount());
+  ~ParallelYogaLayout();
+
+  ParallelYogaLayout(const ParallelYogaLayout &) = delete;
+  ParallelYogaLayout &operator=(const ParallelYogaLayout &) = delete;
+
+  // Calculates the layout of all roots in LTR direction and returns when all of them are done.
+  // A single root is laid out on the calling thread.
+  // If the layout of a root throws, then the roots that are not started yet are skipped,
+  // and the first exception is rethrown after the workers are done.
+  void CalculateLayout(const std::vector<YogaLayoutRoot> &roots);
+
+  // Runs the function on the thread that called CalculateLayout and waits for it.
+  // Outside of a layout worker the function runs right away.
+  // An exception thrown by the function is rethrown on the calling thread.
+  static void RunOnLayoutThread(const std::function<void()> &func);
+
+  static size_t DefaultWorkerCount() noexcept;
+
+ private:
+  struct Call {
+    const std::function<void()> *func;
+    bool isDone;
+    std::exception_ptr exception;
+  };
+
+  void RunWorker() noexcept;
+  void LayoutRoots();
+  void RunCall(const std::function<void()> &func);
+  void RunCallsUntilWorkersAreDone();
+
+ private:
+  const size_t m_workerCount;
+  std::vector<std::thread> m_workers; // Started by the first parallel layout.
+
+  const std::vector<YogaLayoutRoot> *m_roots{nullptr};
+  std::atomic<size_t> m_nextRoot{0};
+
+  std::mutex m_mutex;
+  std::condition_variable m_workCondition; // Signals workers about a new layout pass or stop.
+  std::condition_variable m_layoutCondition; // Signals the layout thread about new calls or finished workers.
+  std::condition_variable m_callDoneCondition; // Signals workers about finished calls.
+  uint64_t m_passId{0};
+  size_t m_runningWorkerCount{0};
+  std::vector<Call *> m_calls;
+  std::exception_ptr m_layoutException; // The first exception thrown by a worker in the current pass.
+  bool m_isStopping{false};
+};
+
+} // namespace react::uwp
@@ -22,6 +22,7 @@ namespace react::uwp {
 
 struct IXamlRootView;
 class ExpressionAnimationStore;
+class AnimatedEventRouter;
 
 typedef unsigned int LiveReloadCallbackCookie;
 typedef unsigned int ErrorCallbackCookie;
@@ -83,6 +84,7 @@ struct IReactInstance {
   virtual void CallXamlViewCreatedTestHook(react::uwp::XamlView view) = 0;
 
   virtual ExpressionAnimationStore &GetExpressionAnimationStore() = 0;
+  virtual AnimatedEventRouter &GetAnimatedEventRouter() = 0;
 
   virtual bool IsLoaded() const noexcept = 0;
 };
@@ -189,37 +189,66 @@ void ReactInstanceWin::LoadModules(
 
 //! Initialize() is called from the native queue.
 void ReactInstanceWin::Initialize() noexcept {
+  facebook::react::SystraceSection s("ReactInstanceWin::Initialize");
+
   InitJSMessageThread();
   InitNativeMessageThread();
   InitUIMessageThread();
 
   m_legacyReactInstance = std::make_shared<react::uwp::UwpReactInstanceProxy>(this);
 
-  // InitUIManager uses m_legacyReactInstance
-  InitUIManager();
-
   Microsoft::ReactNative::DevMenuManager::InitDevMenu(m_reactContext, [weakReactHost = m_weakReactHost]() noexcept {
     Microsoft::ReactNative::ShowConfigureBundlerDialog(weakReactHost);
   });
 
-  Mso::PostFuture(
-      m_uiQueue,
-      [weakThis = Mso::WeakPtr{this}]() noexcept {
-        // Objects that must be created on the UI thread
-        if (auto strongThis = weakThis.GetStrongPtr()) {
-          auto const &legacyInstance = strongThis->m_legacyReactInstance;
-          strongThis->m_appTheme =
-              std::make_shared<react::uwp::AppTheme>(legacyInstance, strongThis->m_uiMessageThread.LoadWithLock());
-          Microsoft::ReactNative::I18nManager::InitI18nInfo(
-              winrt::Microsoft::ReactNative::ReactPropertyBag(strongThis->Options().Properties));
-          strongThis->m_appearanceListener =
-              Mso::Make<react::uwp::AppearanceChangeListener>(legacyInstance, strongThis->m_uiQueue);
-          Microsoft::ReactNative::DeviceInfoHolder::InitDeviceInfoHolder(
-              winrt::Microsoft::ReactNative::ReactPropertyBag(strongThis->Options().Properties));
-        }
-      })
+  // Custom view managers come from the app's provider, which is always called in the native queue.
+  std::vector<std::unique_ptr<facebook::react::IViewManager>> customViewManagers;
+  if (m_options.ViewManagerProvider) {
+    facebook::react::SystraceSection providerSection("ReactInstanceWin::GetCustomViewManagers");
+    customViewManagers = m_options.ViewManagerProvider->GetViewManagers(m_reactContext, m_legacyReactInstance);
+  }
+
+  // Creating the built-in view managers and the objects that live on the UI thread do not depend on each other.
+  // We run them concurrently and continue the initialization in the native queue when both are done.
+  auto whenUIManagerCreated =
+      Mso::PostFuture(
+          Mso::DispatchQueue::ConcurrentQueue(),
+          [ weakThis = Mso::WeakPtr{this}, viewManagers = std::move(customViewManagers) ]() mutable noexcept {
+            if (auto strongThis = weakThis.GetStrongPtr()) {
+              // CreateUIManager uses m_legacyReactInstance
+              return strongThis->CreateUIManager(std::move(viewManagers));
+            }
+            return std::shared_ptr<facebook::react::IUIManager>{};
+          })
+          .Then(
+              Queue(),
+              [weakThis = Mso::WeakPtr{this}](std::shared_ptr<facebook::react::IUIManager> &&uiManager) noexcept {
+                if (auto strongThis = weakThis.GetStrongPtr()) {
+                  strongThis->m_uiManager.Exchange(std::move(uiManager));
+                }
+              });
+
+  auto whenUIObjectsCreated = Mso::PostFuture(m_uiQueue, [weakThis = Mso::WeakPtr{this}]() noexcept {
+    // Objects that must be created on the UI thread
+    if (auto strongThis = weakThis.GetStrongPtr()) {
+      facebook::react::SystraceSection s("ReactInstanceWin::InitUIThreadObjects");
+      auto const &legacyInstance = strongThis->m_legacyReactInstance;
+      strongThis->m_appTheme =
+          std::make_shared<react::uwp::AppTheme>(legacyInstance, strongThis->m_uiMessageThread.LoadWithLock());
+      Microsoft::ReactNative::I18nManager::InitI18nInfo(
+          winrt::Microsoft::ReactNative::ReactPropertyBag(strongThis->Options().Properties));
+      strongThis->m_appearanceListener =
+          Mso::Make<react::uwp::AppearanceChangeListener>(legacyInstance, strongThis->m_uiQueue);
+      Microsoft::ReactNative::DeviceInfoHolder::InitDeviceInfoHolder(
+          winrt::Microsoft::ReactNative::ReactPropertyBag(strongThis->Options().Properties));
+    }
+  });
+
+  Mso::WhenAll({whenUIManagerCreated, whenUIObjectsCreated})
       .Then(Queue(), [ this, weakThis = Mso::WeakPtr{this} ]() noexcept {
         if (auto strongThis = weakThis.GetStrongPtr()) {
+          facebook::react::SystraceSection s("ReactInstanceWin::CreateReactInstance");
+
           // auto cxxModulesProviders = GetCxxModuleProviders();
 
           auto devSettings = std::make_shared<facebook::react::DevSettings>();
@@ -266,7 +295,8 @@ void ReactInstanceWin::Initialize() noexcept {
               m_uiMessageThread.Load(),
               std::move(m_appTheme),
               std::move(m_appearanceListener),
-              m_legacyReactInstance);
+              m_legacyReactInstance,
+              /*lazyViewManagerConstants:*/ !m_useWebDebugger);
 
           auto nmp = std::make_shared<winrt::Microsoft::ReactNative::NativeModulesProvider>();
 
@@ -276,7 +306,10 @@ void ReactInstanceWin::Initialize() noexcept {
                   reactHost->ReloadInstance();
                 }
               });
-          LoadModules(nmp, m_options.TurboModuleProvider);
+          {
+            facebook::react::SystraceSection loadModulesSection("ReactInstanceWin::LoadModules");
+            LoadModules(nmp, m_options.TurboModuleProvider);
+          }
 
           auto modules = nmp->GetModules(m_reactContext, m_jsMessageThread.Load());
           cxxModules.insert(
@@ -333,6 +366,7 @@ void ReactInstanceWin::Initialize() noexcept {
                 Mso::Copy(m_batchingUIThread),
                 std::move(devSettings));
 
+            std::atomic_store(&m_jsCallInstance, instanceWrapper->GetInstance());
             m_instance.Exchange(Mso::Copy(instanceWrapper->GetInstance()));
             m_instanceWrapper.Exchange(std::move(instanceWrapper));
 
@@ -480,6 +514,7 @@ Mso::Future<void> ReactInstanceWin::Destroy() noexcept {
   }
 
   // Make sure that the instance is not destroyed yet
+  std::atomic_store(&m_jsCallInstance, std::shared_ptr<facebook::react::Instance>{});
   if (auto instance = m_instance.Exchange(nullptr)) {
     // Release the message queues before the ui manager and instance.
     m_nativeMessageThread.Exchange(nullptr);
@@ -531,13 +566,11 @@ void ReactInstanceWin::InitUIMessageThread() noexcept {
   m_batchingUIThread = react::uwp::MakeBatchingQueueThread(m_uiMessageThread.Load());
 }
 
-void ReactInstanceWin::InitUIManager() noexcept {
-  std::vector<std::unique_ptr<facebook::react::IViewManager>> viewManagers;
-
-  // Custom view managers
-  if (m_options.ViewManagerProvider) {
-    viewManagers = m_options.ViewManagerProvider->GetViewManagers(m_reactContext, m_legacyReactInstance);
-  }
+//! CreateUIManager() is called from the concurrent queue.
+//! It adds the built-in view managers to the custom view managers. It must not call the app's providers.
+std::shared_ptr<facebook::react::IUIManager> ReactInstanceWin::CreateUIManager(
+    std::vector<std::unique_ptr<facebook::react::IViewManager>> &&viewManagers) noexcept {
+  facebook::react::SystraceSection s("ReactInstanceWin::CreateUIManager");
 
   react::uwp::AddStandardViewManagers(viewManagers, m_legacyReactInstance);
   react::uwp::AddPolyesterViewManagers(viewManagers, m_legacyReactInstance);
@@ -547,7 +580,7 @@ void ReactInstanceWin::InitUIManager() noexcept {
   m_reactContext->Properties().Set(
       implementation::XamlUIService::XamlUIServiceProperty().Handle(),
       winrt::make<implementation::XamlUIService>(std::move(wkUIManger), m_reactContext));
-  m_uiManager.Exchange(std::move(uiManager));
+  return uiManager;
 }
 
 facebook::react::NativeLoggingHook ReactInstanceWin::GetLoggingCallback() noexcept {
@@ -676,31 +709,35 @@ void ReactInstanceWin::OnDebuggerAttach() noexcept {
 }
 
 void ReactInstanceWin::DrainJSCallQueue() noexcept {
-  // Handle all items in the queue one by one.
+  // Take all queued items at once and call them outside of the lock.
+  // New items may be queued while we call JS, so we repeat until the queue stays empty.
   for (;;) {
-    JSCallEntry entry; // To avoid callJSFunction under the lock
+    std::vector<JSCallEntry> jsCallQueue; // To avoid callJSFunction under the lock
     {
       std::scoped_lock lock{m_mutex};
-      if (m_state == ReactInstanceState::Loaded && !m_jsCallQueue.empty()) {
-        entry = std::move(m_jsCallQueue.front());
-        m_jsCallQueue.pop_front();
-      } else {
+      if (m_state != ReactInstanceState::Loaded) {
         break;
       }
-    }
 
-    if (auto instance = m_instance.LoadWithLock()) {
-      instance->callJSFunction(std::move(entry.ModuleName), std::move(entry.MethodName), std::move(entry.Args));
+      if (m_jsCallQueue.empty()) {
+        // From now on CallJsFunction can call JS directly without taking the lock.
+        m_isJSCallQueueDrained = true;
+        break;
+      }
+
+      jsCallQueue.swap(m_jsCallQueue);
     }
+
+    CallJsFunctions(std::move(jsCallQueue));
   }
 }
 
 void ReactInstanceWin::AbandonJSCallQueue() noexcept {
-  std::deque<JSCallEntry> jsCallQueue; // To avoid destruction under the lock
+  std::vector<JSCallEntry> jsCallQueue; // To avoid destruction under the lock
   {
     std::scoped_lock lock{m_mutex};
     if (m_state == ReactInstanceState::HasError || m_state == ReactInstanceState::Unloaded) {
-      jsCallQueue = std::move(m_jsCallQueue);
+      jsCallQueue.swap(m_jsCallQueue);
     }
   }
 }
@@ -709,26 +746,45 @@ void ReactInstanceWin::CallJsFunction(
     std::string &&moduleName,
     std::string &&method,
     folly::dynamic &&params) noexcept {
+  // Fast path for the steady Loaded state: the queue is drained and is never used again.
+  if (m_isJSCallQueueDrained && m_state == ReactInstanceState::Loaded) {
+    if (auto instance = std::atomic_load(&m_jsCallInstance)) {
+      instance->callJSFunction(std::move(moduleName), std::move(method), std::move(params));
+    }
+    return;
+  }
+
   bool shouldCall{false}; // To call callJSFunction outside of lock
   {
     std::scoped_lock lock{m_mutex};
-    if (m_state == ReactInstanceState::Loaded && m_jsCallQueue.empty()) {
+    if (m_state == ReactInstanceState::Loaded && m_isJSCallQueueDrained) {
       shouldCall = true;
     } else if (
         m_state == ReactInstanceState::Loading || m_state == ReactInstanceState::WaitingForDebugger ||
-        (m_state == ReactInstanceState::Loaded && !m_jsCallQueue.empty())) {
+        m_state == ReactInstanceState::Loaded) {
+      // In the Loaded state we get here only while DrainJSCallQueue is still running.
       m_jsCallQueue.push_back(JSCallEntry{std::move(moduleName), std::move(method), std::move(params)});
     }
     // otherwise ignore the call
   }
 
   if (shouldCall) {
-    if (auto instance = m_instance.LoadWithLock()) {
+    if (auto instance = std::atomic_load(&m_jsCallInstance)) {
       instance->callJSFunction(std::move(moduleName), std::move(method), std::move(params));
     }
   }
 }
 
+void ReactInstanceWin::CallJsFunctions(std::vector<JSCallEntry> &&calls) noexcept {
+  // The cxxreact Instance has no batched entry point, so we hand the whole batch over in one pass
+  // while holding a single reference to the instance.
+  if (auto instance = std::atomic_load(&m_jsCallInstance)) {
+    for (auto &call : calls) {
+      instance->callJSFunction(std::move(call.ModuleName), std::move(call.MethodName), std::move(call.Args));
+    }
+  }
+}
+
 void ReactInstanceWin::DispatchEvent(int64_t viewTag, std::string &&eventName, folly::dynamic &&eventData) noexcept {
   folly::dynamic params = folly::dynamic::array(viewTag, std::move(eventName), std::move(eventData));
   CallJsFunction("RCTEventEmitter", "receiveEvent", std::move(params));
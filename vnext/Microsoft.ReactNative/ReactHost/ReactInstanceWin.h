@@ -93,7 +93,8 @@ class ReactInstanceWin final : public Mso::ActiveObject<IReactInstanceInternal,
   void InitJSMessageThread() noexcept;
   void InitNativeMessageThread() noexcept;
   void InitUIMessageThread() noexcept;
-  void InitUIManager() noexcept;
+  std::shared_ptr<facebook::react::IUIManager> CreateUIManager(
+      std::vector<std::unique_ptr<facebook::react::IViewManager>> &&viewManagers) noexcept;
   std::string GetBytecodeFileName() noexcept;
   std::function<void()> GetLiveReloadCallback() noexcept;
   std::function<void(std::string)> GetErrorCallback() noexcept;
@@ -111,15 +112,16 @@ class ReactInstanceWin final : public Mso::ActiveObject<IReactInstanceInternal,
   friend struct LoadedCallbackGuard;
   void OnReactInstanceLoaded(const Mso::ErrorCode &errorCode) noexcept;
 
-  void DrainJSCallQueue() noexcept;
-  void AbandonJSCallQueue() noexcept;
-
   struct JSCallEntry {
     std::string ModuleName;
     std::string MethodName;
     folly::dynamic Args;
   };
 
+  void DrainJSCallQueue() noexcept;
+  void AbandonJSCallQueue() noexcept;
+  void CallJsFunctions(std::vector<JSCallEntry> &&calls) noexcept;
+
 #if defined(USE_V8)
   static std::string getApplicationLocalFolder();
 #endif
@@ -145,6 +147,8 @@ class ReactInstanceWin final : public Mso::ActiveObject<IReactInstanceInternal,
   std::atomic<bool> m_isLoaded{false};
   std::atomic<bool> m_isDestroyed{false};
   std::atomic<bool> m_isRekaInitialized{false};
+  // Set once the pending JS calls are drained after loading. After that the queue is not used anymore.
+  std::atomic<bool> m_isJSCallQueueDrained{false};
 
  private: // fields controlled by mutex
   mutable std::mutex m_mutex;
@@ -173,7 +177,9 @@ class ReactInstanceWin final : public Mso::ActiveObject<IReactInstanceInternal,
 #endif
   std::string m_bundleRootPath;
   Mso::DispatchQueue m_uiQueue;
-  std::deque<JSCallEntry> m_jsCallQueue;
+  std::vector<JSCallEntry> m_jsCallQueue;
+  // Same as m_instance, but read with std::atomic_load by CallJsFunction to avoid taking m_mutex.
+  std::shared_ptr<facebook::react::Instance> m_jsCallInstance;
 };
 
 } // namespace Mso::React
@@ -124,6 +124,10 @@ ExpressionAnimationStore &UwpReactInstanceProxy::GetExpressionAnimationStore() {
   return m_expressionAnimationStore;
 }
 
+AnimatedEventRouter &UwpReactInstanceProxy::GetAnimatedEventRouter() {
+  return m_animatedEventRouter;
+}
+
 std::string UwpReactInstanceProxy::GetBundleRootPath() const noexcept {
   if (auto reactInstance = m_weakReactInstance.GetStrongPtr()) {
     return query_cast<Mso::React::ILegacyReactInstance &>(*reactInstance).GetBundleRootPath();
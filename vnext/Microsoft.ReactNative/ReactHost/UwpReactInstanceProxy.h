@@ -5,6 +5,7 @@
 
 #include <IReactInstance.h>
 
+#include <Modules/Animated/AnimatedEventRouter.h>
 #include <Modules/DeviceInfoModule.h>
 #include <ReactHost/React.h>
 #include <Views/ExpressionAnimationStore.h>
@@ -45,6 +46,7 @@ struct UwpReactInstanceProxy : IReactInstance, std::enable_shared_from_this<UwpR
   const std::string &LastErrorMessage() const noexcept override;
   void loadBundle(std::string &&jsBundleRelativePath) override;
   ExpressionAnimationStore &GetExpressionAnimationStore() override;
+  AnimatedEventRouter &GetAnimatedEventRouter() override;
   std::string GetBundleRootPath() const noexcept override;
   bool IsLoaded() const noexcept override;
 
@@ -55,6 +57,7 @@ struct UwpReactInstanceProxy : IReactInstance, std::enable_shared_from_this<UwpR
  private:
   Mso::WeakPtr<Mso::React::IReactInstance> m_weakReactInstance;
   ExpressionAnimationStore m_expressionAnimationStore;
+  AnimatedEventRouter m_animatedEventRouter;
   std::function<void(XamlView)> m_xamlViewCreatedTestHook;
 };
 
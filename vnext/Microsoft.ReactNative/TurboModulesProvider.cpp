@@ -8,6 +8,9 @@
 #include "JsiReader.h"
 #include "JsiWriter.h"
 
+#include <limits>
+#include <optional>
+
 using namespace winrt;
 using namespace Windows::Foundation;
 
@@ -19,9 +22,13 @@ namespace winrt::Microsoft::ReactNative {
 struct TurboModuleMethodInfo {
   MethodReturnType ReturnType;
   MethodDelegate Method;
+  SyncMethodDelegate SyncMethod; // Set only for synchronous methods.
 };
 
 struct TurboModuleBuilder : winrt::implements<TurboModuleBuilder, IReactModuleBuilder> {
+  // The member index of getConstants. It is not in the method table.
+  static constexpr size_t GetConstantsIndex = std::numeric_limits<size_t>::max();
+
   TurboModuleBuilder(const IReactContext &reactContext) noexcept : m_reactContext(reactContext) {}
 
  public: // IReactModuleBuilder
@@ -30,35 +37,37 @@ struct TurboModuleBuilder : winrt::implements<TurboModuleBuilder, IReactModuleBu
   }
 
   void AddConstantProvider(ConstantProviderDelegate const &constantProvider) noexcept {
-    EnsureMemberNotSet("getConstants", false);
+    auto it = m_memberIndexes.find("getConstants");
+    if (it == m_memberIndexes.end()) {
+      m_memberIndexes.insert({"getConstants", GetConstantsIndex});
+    } else {
+      VerifyElseCrash(it->second == GetConstantsIndex);
+    }
+
     m_constantProviders.push_back(constantProvider);
   }
 
   void AddMethod(hstring const &name, MethodReturnType returnType, MethodDelegate const &method) noexcept {
-    auto key = to_string(name);
-    EnsureMemberNotSet(key, true);
-    m_methods.insert({key, {returnType, method}});
+    AddMethodInfo(to_string(name), {returnType, method, nullptr});
   }
 
   void AddSyncMethod(hstring const &name, SyncMethodDelegate const &method) noexcept {
-    auto key = to_string(name);
-    EnsureMemberNotSet(key, true);
-    m_syncMethods.insert({key, method});
+    AddMethodInfo(to_string(name), {MethodReturnType::Void, nullptr, method});
   }
 
  public:
-  std::unordered_map<std::string, TurboModuleMethodInfo> m_methods;
-  std::unordered_map<std::string, SyncMethodDelegate> m_syncMethods;
+  // Sync and async methods share one table, indexed in the order they are added.
+  // TurboModuleImpl maps property names to these indexes without converting them to strings.
+  std::vector<TurboModuleMethodInfo> m_methods;
+  std::unordered_map<std::string, size_t> m_memberIndexes;
   std::vector<ConstantProviderDelegate> m_constantProviders;
   bool m_constantsEvaluated = false;
 
  private:
-  void EnsureMemberNotSet(const std::string &key, bool checkingMethod) noexcept {
-    VerifyElseCrash(m_methods.find(key) == m_methods.end());
-    VerifyElseCrash(m_syncMethods.find(key) == m_syncMethods.end());
-    if (checkingMethod && key == "getConstants") {
-      VerifyElseCrash(m_constantProviders.size() == 0);
-    }
+  void AddMethodInfo(std::string &&key, TurboModuleMethodInfo &&methodInfo) noexcept {
+    VerifyElseCrash(m_memberIndexes.find(key) == m_memberIndexes.end());
+    m_memberIndexes.insert({std::move(key), m_methods.size()});
+    m_methods.push_back(std::move(methodInfo));
   }
 
  private:
@@ -81,11 +90,14 @@ class TurboModuleImpl : public facebook::react::TurboModule {
   }
 
   facebook::jsi::Value get(facebook::jsi::Runtime &runtime, const facebook::jsi::PropNameID &propName) override {
-    // it is not safe to assume that "runtime" never changes, so members are not cached here
     auto tmb = m_moduleBuilder.as<TurboModuleBuilder>();
-    auto key = propName.utf8(runtime);
+    auto memberIndex = FindMemberIndex(runtime, propName);
+    if (!memberIndex) {
+      // returns undefined if the expected member is not found
+      return facebook::jsi::Value::undefined();
+    }
 
-    if (key == "getConstants" && tmb->m_constantProviders.size() > 0) {
+    if (*memberIndex == TurboModuleBuilder::GetConstantsIndex) {
       // try to find getConstants if there is any constant
       return facebook::jsi::Function::createFromHostFunction(
           runtime,
@@ -107,15 +119,15 @@ class TurboModuleImpl : public facebook::react::TurboModule {
           });
     }
 
+    const TurboModuleMethodInfo &methodInfo = tmb->m_methods[*memberIndex];
     {
       // try to find a Method
-      auto it = tmb->m_methods.find(key);
-      if (it != tmb->m_methods.end()) {
+      if (methodInfo.Method) {
         return facebook::jsi::Function::createFromHostFunction(
             runtime,
             propName,
             0,
-            [&runtime, method = it->second](
+            [&runtime, method = methodInfo](
                 facebook::jsi::Runtime &rt,
                 const facebook::jsi::Value &thisVal,
                 const facebook::jsi::Value *args,
@@ -206,13 +218,12 @@ class TurboModuleImpl : public facebook::react::TurboModule {
 
     {
       // try to find a SyncMethod
-      auto it = tmb->m_syncMethods.find(key);
-      if (it != tmb->m_syncMethods.end()) {
+      if (methodInfo.SyncMethod) {
         return facebook::jsi::Function::createFromHostFunction(
             runtime,
             propName,
             0,
-            [&runtime, method = it->second](
+            [&runtime, method = methodInfo.SyncMethod](
                 facebook::jsi::Runtime &rt,
                 const facebook::jsi::Value &thisVal,
                 const facebook::jsi::Value *args,
@@ -239,9 +250,37 @@ class TurboModuleImpl : public facebook::react::TurboModule {
     return facebook::jsi::Value::undefined();
   }
 
+ private:
+  // Returns the index of the member with the property name, or std::nullopt if there is no such member.
+  // The member names are converted to PropNameIDs once per runtime, so that a lookup only compares
+  // PropNameIDs and does not convert the property name to a string.
+  std::optional<size_t> FindMemberIndex(facebook::jsi::Runtime &runtime, const facebook::jsi::PropNameID &propName) {
+    // it is not safe to assume that "runtime" never changes, so the PropNameIDs are created again for a new one
+    if (m_memberPropNamesRuntime != &runtime) {
+      auto tmb = m_moduleBuilder.as<TurboModuleBuilder>();
+      m_memberPropNames.clear();
+      m_memberPropNames.reserve(tmb->m_memberIndexes.size());
+      for (const auto &[name, index] : tmb->m_memberIndexes) {
+        m_memberPropNames.emplace_back(facebook::jsi::PropNameID::forUtf8(runtime, name), index);
+      }
+
+      m_memberPropNamesRuntime = &runtime;
+    }
+
+    for (const auto &[memberPropName, index] : m_memberPropNames) {
+      if (facebook::jsi::PropNameID::compare(runtime, memberPropName, propName)) {
+        return index;
+      }
+    }
+
+    return std::nullopt;
+  }
+
  private:
   IReactModuleBuilder m_moduleBuilder;
   IInspectable providedModule;
+  facebook::jsi::Runtime *m_memberPropNamesRuntime{nullptr};
+  std::vector<std::pair<facebook::jsi::PropNameID, size_t>> m_memberPropNames;
 };
 
 /*-------------------------------------------------------------------------------
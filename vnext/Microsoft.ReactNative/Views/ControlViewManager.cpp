@@ -6,6 +6,7 @@
 #include <UI.Xaml.Controls.h>
 
 #include <Views/ControlViewManager.h>
+#include <Views/LayoutAffectingProps.h>
 #include <Views/ShadowNodeBase.h>
 
 #include <Utils/PropertyUtils.h>
@@ -25,6 +26,11 @@ folly::dynamic ControlViewManager::GetNativeProps() const {
   props.update(folly::dynamic::object("tabIndex", "number"));
   return props;
 }
+
+bool ControlViewManager::IsLayoutAffectingProp(const std::string &propertyName) const {
+  return IsControlLayoutAffectingProp(propertyName);
+}
+
 void ControlViewManager::TransferProperties(const XamlView &oldView, const XamlView &newView) {
   TransferProperty(oldView, newView, xaml::Controls::Control::FontSizeProperty());
   TransferProperty(oldView, newView, xaml::Controls::Control::FontFamilyProperty());
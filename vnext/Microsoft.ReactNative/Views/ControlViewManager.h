@@ -16,6 +16,7 @@ class REACTWINDOWS_EXPORT ControlViewManager : public FrameworkElementViewManage
   ControlViewManager(const std::shared_ptr<IReactInstance> &reactInstance);
 
   folly::dynamic GetNativeProps() const override;
+  bool IsLayoutAffectingProp(const std::string &propertyName) const override;
   bool UpdateProperty(
       ShadowNodeBase *nodeToUpdate,
       const std::string &propertyName,
@@ -7,6 +7,7 @@
 
 #include <Views/ExpressionAnimationStore.h>
 #include <Views/FrameworkElementViewManager.h>
+#include <Views/LayoutAffectingProps.h>
 
 #include <Utils/AccessibilityUtils.h>
 #include <Utils/PropertyUtils.h>
@@ -159,6 +160,10 @@ static folly::dynamic GetAccessibilityValueProps() {
   return props;
 }
 
+bool FrameworkElementViewManager::IsLayoutAffectingProp(const std::string &propertyName) const {
+  return IsFrameworkElementLayoutAffectingProp(propertyName);
+}
+
 folly::dynamic FrameworkElementViewManager::GetNativeProps() const {
   folly::dynamic props = Super::GetNativeProps();
   props.update(folly::dynamic::object("accessible", "boolean")("accessibilityRole", "string")(
@@ -9,24 +9,35 @@
 
 #include <winrt/Windows.Security.Cryptography.h>
 #include <winrt/Windows.Storage.Streams.h>
+#include <winrt/Windows.Storage.h>
+#include <winrt/Windows.Web.Http.Filters.h>
 #include <winrt/Windows.Web.Http.Headers.h>
 #include <winrt/Windows.Web.Http.h>
 
+#include <ImageCache.h>
+#include <algorithm>
 #include "Unicode.h"
 #include "XamlView.h"
 #include "cdebug.h"
 
 namespace winrt {
 using namespace Windows::Foundation;
+using namespace Windows::Storage;
 using namespace Windows::Storage::Streams;
 using namespace Windows::UI;
 using namespace xaml;
 using namespace xaml::Media;
 using namespace xaml::Media::Imaging;
 using namespace Windows::Web::Http;
+using namespace Windows::Web::Http::Filters;
 } // namespace winrt
 
+using Microsoft::Common::Unicode::Utf16ToUtf8;
 using Microsoft::Common::Unicode::Utf8ToUtf16;
+using Microsoft::React::ImageCache;
+using Microsoft::React::ImageCacheOptions;
+using Microsoft::React::ImageHttpHeaders;
+using Microsoft::React::ImageHttpResponse;
 
 namespace react::uwp {
 
@@ -367,35 +378,105 @@ winrt::fire_and_forget ReactImage::SetBackground(bool fireLoadEndEvent) {
   }
 }
 
-winrt::IAsyncOperation<winrt::InMemoryRandomAccessStream> GetImageStreamAsync(ReactImageSource source) {
+static std::string ToLower(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
+    return static_cast<char>(std::tolower(ch));
+  });
+  return value;
+}
+
+// Sends the request and blocks until the whole response is received.
+static ImageHttpResponse SendImageRequest(
+    const std::string &method,
+    const std::string &uri,
+    const ImageHttpHeaders &headers) noexcept {
+  ImageHttpResponse result;
   try {
-    co_await winrt::resume_background();
+    winrt::HttpRequestMessage request{winrt::HttpMethod{Utf8ToUtf16(method)}, winrt::Uri{Utf8ToUtf16(uri)}};
+    for (const auto &[name, value] : headers) {
+      if (name == "authorization") {
+        request.Headers().TryAppendWithoutValidation(Utf8ToUtf16(name), Utf8ToUtf16(value));
+      } else {
+        request.Headers().Append(Utf8ToUtf16(name), Utf8ToUtf16(value));
+      }
+    }
 
-    auto httpMethod{source.method.empty() ? winrt::HttpMethod::Get() : winrt::HttpMethod{Utf8ToUtf16(source.method)}};
+    // The ImageCache revalidates its entries, so the system HTTP cache must pass 304 responses through.
+    winrt::HttpBaseProtocolFilter filter;
+    filter.CacheControl().ReadBehavior(winrt::HttpCacheReadBehavior::MostRecent);
+    filter.CacheControl().WriteBehavior(winrt::HttpCacheWriteBehavior::NoCache);
+    winrt::HttpClient httpClient{filter};
+    winrt::HttpResponseMessage response{httpClient.SendRequestAsync(request).get()};
+    if (!response) {
+      return result;
+    }
 
-    winrt::Uri uri{Utf8ToUtf16(source.uri)};
-    winrt::HttpRequestMessage request{httpMethod, uri};
+    for (const auto &header : response.Headers()) {
+      result.Headers[ToLower(Utf16ToUtf8(header.Key().c_str()))] = Utf16ToUtf8(header.Value().c_str());
+    }
+
+    result.StatusCode = static_cast<int>(response.StatusCode());
+    if (response.StatusCode() == winrt::HttpStatusCode::Ok) {
+      winrt::IBuffer buffer{response.Content().ReadAsBufferAsync().get()};
+      result.Body.assign(reinterpret_cast<const char *>(buffer.data()), buffer.Length());
+    }
+  } catch (winrt::hresult_error const &e) {
+    DEBUG_HRESULT_ERROR(e);
+    result.StatusCode = 0;
+  }
+
+  return result;
+}
 
+static ImageCacheOptions GetImageCacheOptions() noexcept {
+  ImageCacheOptions options;
+  try {
+    std::filesystem::path localCachePath{winrt::ApplicationData::Current().LocalCacheFolder().Path().c_str()};
+    options.DiskCachePath = localCachePath / L"ReactNativeImages";
+  } catch (winrt::hresult_error const &) {
+    // Unpackaged apps have no local cache folder and only use the memory cache.
+  }
+
+  return options;
+}
+
+// All images share the cache. Its disk part is in the app local cache folder, if the app has one.
+static ImageCache &GetImageCache() {
+  static ImageCache s_imageCache{
+      [](const std::string &uri, const ImageHttpHeaders &headers) { return SendImageRequest("GET", uri, headers); },
+      GetImageCacheOptions()};
+  return s_imageCache;
+}
+
+winrt::IAsyncOperation<winrt::InMemoryRandomAccessStream> GetImageStreamAsync(ReactImageSource source) {
+  try {
+    co_await winrt::resume_background();
+
+    ImageHttpHeaders headers;
     if (!source.headers.empty()) {
       for (auto &header : source.headers.items()) {
-        const std::string &name{header.first.getString()};
-        const std::string &value{header.second.getString()};
+        headers[ToLower(header.first.getString())] = header.second.getString();
+      }
+    }
 
-        if (_stricmp(name.c_str(), "authorization") == 0) {
-          request.Headers().TryAppendWithoutValidation(Utf8ToUtf16(name), Utf8ToUtf16(value));
-        } else {
-          request.Headers().Append(Utf8ToUtf16(name), Utf8ToUtf16(value));
-        }
+    // Only GET responses are cached.
+    std::shared_ptr<const std::string> body;
+    if (source.method.empty() || _stricmp(source.method.c_str(), "GET") == 0) {
+      body = GetImageCache().Get(source.uri, headers);
+    } else {
+      ImageHttpResponse response = SendImageRequest(source.method, source.uri, headers);
+      if (response.StatusCode == static_cast<int>(winrt::HttpStatusCode::Ok)) {
+        body = std::make_shared<const std::string>(std::move(response.Body));
       }
     }
 
-    winrt::HttpClient httpClient;
-    winrt::HttpResponseMessage response{co_await httpClient.SendRequestAsync(request)};
+    if (body) {
+      winrt::Buffer buffer{static_cast<uint32_t>(body->size())};
+      std::copy(body->begin(), body->end(), reinterpret_cast<char *>(buffer.data()));
+      buffer.Length(static_cast<uint32_t>(body->size()));
 
-    if (response && response.StatusCode() == winrt::HttpStatusCode::Ok) {
-      winrt::IInputStream inputStream{co_await response.Content().ReadAsInputStreamAsync()};
       winrt::InMemoryRandomAccessStream memoryStream;
-      co_await winrt::RandomAccessStream::CopyAsync(inputStream, memoryStream);
+      co_await memoryStream.WriteAsync(buffer);
       memoryStream.Seek(0);
 
       co_return memoryStream;
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "LayoutAffectingProps.h"
+
+namespace react::uwp {
+
+namespace {
+
+bool IsViewManagerBasePaintOnlyProp(const std::string &propertyName) noexcept {
+  return propertyName == "onLayout" || propertyName == "keyDownEvents" || propertyName == "keyUpEvents";
+}
+
+bool IsFrameworkElementPaintOnlyProp(const std::string &propertyName) noexcept {
+  return propertyName == "opacity" || propertyName == "transform" || propertyName == "accessible" ||
+      propertyName.compare(0, 13, "accessibility") == 0 || propertyName == "testID" || propertyName == "tooltip" ||
+      propertyName == "zIndex";
+}
+
+bool IsViewPaintOnlyProp(const std::string &propertyName) noexcept {
+  // The focusable property is not listed: it can replace the ViewPanel with a ViewControl.
+  return propertyName == "backgroundColor" || propertyName == "borderColor" ||
+      (propertyName.compare(0, 6, "border") == 0 && propertyName.size() > 6 &&
+       propertyName.compare(propertyName.size() - 6, 6, "Radius") == 0) ||
+      propertyName == "onClick" || propertyName == "onMouseEnter" || propertyName == "onMouseLeave" ||
+      propertyName == "onMouseMove" || propertyName == "overflow" || propertyName == "pointerEvents" ||
+      propertyName == "enableFocusRing" || propertyName == "tabIndex";
+}
+
+bool IsControlPaintOnlyProp(const std::string &propertyName) noexcept {
+  return propertyName == "backgroundColor" || propertyName == "borderColor" || propertyName == "color" ||
+      propertyName == "tabIndex";
+}
+
+bool IsTextPaintOnlyProp(const std::string &propertyName) noexcept {
+  return propertyName == "color" || propertyName == "selectionColor" || propertyName == "selectable" ||
+      propertyName == "textDecorationLine";
+}
+
+} // namespace
+
+bool IsViewManagerBaseLayoutAffectingProp(const std::string &propertyName) noexcept {
+  return !IsViewManagerBasePaintOnlyProp(propertyName);
+}
+
+bool IsFrameworkElementLayoutAffectingProp(const std::string &propertyName) noexcept {
+  return !IsFrameworkElementPaintOnlyProp(propertyName) && IsViewManagerBaseLayoutAffectingProp(propertyName);
+}
+
+bool IsViewLayoutAffectingProp(const std::string &propertyName) noexcept {
+  return !IsViewPaintOnlyProp(propertyName) && IsFrameworkElementLayoutAffectingProp(propertyName);
+}
+
+bool IsControlLayoutAffectingProp(const std::string &propertyName) noexcept {
+  return !IsControlPaintOnlyProp(propertyName) && IsFrameworkElementLayoutAffectingProp(propertyName);
+}
+
+bool IsTextLayoutAffectingProp(const std::string &propertyName) noexcept {
+  return !IsTextPaintOnlyProp(propertyName) && IsFrameworkElementLayoutAffectingProp(propertyName);
+}
+
+} // namespace react::uwp
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#include <folly/dynamic.h>
+#include <string>
+
+namespace react::uwp {
+
+// The IsLayoutAffectingProp implementations of the view managers. Each one returns false for
+// the properties its view manager and base classes handle without changing the measured size
+// of the view. They have no XAML dependency so that tests can run them without creating views.
+bool IsViewManagerBaseLayoutAffectingProp(const std::string &propertyName) noexcept;
+bool IsFrameworkElementLayoutAffectingProp(const std::string &propertyName) noexcept;
+bool IsViewLayoutAffectingProp(const std::string &propertyName) noexcept;
+bool IsControlLayoutAffectingProp(const std::string &propertyName) noexcept;
+bool IsTextLayoutAffectingProp(const std::string &propertyName) noexcept;
+
+// Returns true if the property diff has a property that may change the measured size of the view.
+template <typename TIsLayoutAffectingProp>
+bool HasLayoutAffectingProp(const folly::dynamic &reactDiffMap, TIsLayoutAffectingProp &&isLayoutAffectingProp) {
+  for (const auto &pair : reactDiffMap.items()) {
+    if (isLayoutAffectingProp(pair.first.getString())) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace react::uwp
@@ -3,11 +3,14 @@
 
 #include "pch.h"
 
+#include <Modules/Animated/AnimatedEventRouter.h>
 #include <Views/SIPEventHandler.h>
 #include <Views/ShadowNodeBase.h>
 #include "Impl/ScrollViewUWPImplementation.h"
 #include "ScrollViewManager.h"
 
+#include <chrono>
+
 namespace react::uwp {
 
 namespace ScrollViewCommands {
@@ -15,6 +18,26 @@ constexpr const char *ScrollTo = "scrollTo";
 constexpr const char *ScrollToEnd = "scrollToEnd";
 }; // namespace ScrollViewCommands
 
+// A scroll event with the interned id of its registration name, so that routing
+// it to the Animated.event mappings does not hash the event name.
+struct ScrollEvent {
+  const char *Name;
+  EventNameId RegistrationNameId;
+};
+
+namespace ScrollViewEvents {
+const ScrollEvent Scroll{"topScroll", GetEventNameId("onScroll")};
+const ScrollEvent ScrollBeginDrag{"topScrollBeginDrag", GetEventNameId("onScrollBeginDrag")};
+const ScrollEvent ScrollEndDrag{"topScrollEndDrag", GetEventNameId("onScrollEndDrag")};
+const ScrollEvent ScrollBeginMomentum{"topScrollBeginMomentum", GetEventNameId("onMomentumScrollBegin")};
+const ScrollEvent ScrollEndMomentum{"topScrollEndMomentum", GetEventNameId("onMomentumScrollEnd")};
+}; // namespace ScrollViewEvents
+
+static bool IsScrollEventRegistration(const std::string &propertyName) {
+  return propertyName == "onScroll" || propertyName == "onScrollBeginDrag" || propertyName == "onScrollEndDrag" ||
+      propertyName == "onMomentumScrollBegin" || propertyName == "onMomentumScrollEnd";
+}
+
 class ScrollViewShadowNode : public ShadowNodeBase {
   using Super = ShadowNodeBase;
 
@@ -30,7 +53,7 @@ class ScrollViewShadowNode : public ShadowNodeBase {
   void EmitScrollEvent(
       const winrt::ScrollViewer &scrollViewer,
       int64_t tag,
-      const char *eventName,
+      const ScrollEvent &event,
       double x,
       double y,
       double zoom);
@@ -49,6 +72,9 @@ class ScrollViewShadowNode : public ShadowNodeBase {
 
   std::shared_ptr<SIPEventHandler> m_SIPEventHandler;
 
+  // Decides which scroll events go to JS. The others only drive native Animated.event mappings, if any.
+  JsEventFilter m_jsEventFilter{MakeScrollViewJsEventFilter()};
+
   xaml::FrameworkElement::SizeChanged_revoker m_scrollViewerSizeChangedRevoker{};
   xaml::FrameworkElement::SizeChanged_revoker m_contentSizeChangedRevoker{};
   winrt::ScrollViewer::ViewChanged_revoker m_scrollViewerViewChangedRevoker{};
@@ -210,6 +236,8 @@ void ScrollViewShadowNode::updateProperties(const folly::dynamic &&reactDiffMap)
       if (valid) {
         ScrollViewUWPImplementation(scrollViewer).PagingEnabled(pagingEnabled);
       }
+    } else {
+      m_jsEventFilter.UpdateProperty(propertyName, propertyValue);
     }
   }
 
@@ -229,7 +257,7 @@ void ScrollViewShadowNode::AddHandlers(const winrt::ScrollViewer &scrollViewer)
           EmitScrollEvent(
               scrollViewerNotNull,
               m_tag,
-              "topScrollEndDrag",
+              ScrollViewEvents::ScrollEndDrag,
               args.NextView().HorizontalOffset(),
               args.NextView().VerticalOffset(),
               args.NextView().ZoomFactor());
@@ -237,7 +265,7 @@ void ScrollViewShadowNode::AddHandlers(const winrt::ScrollViewer &scrollViewer)
           EmitScrollEvent(
               scrollViewerNotNull,
               m_tag,
-              "topScrollBeginMomentum",
+              ScrollViewEvents::ScrollBeginMomentum,
               args.NextView().HorizontalOffset(),
               args.NextView().VerticalOffset(),
               args.NextView().ZoomFactor());
@@ -246,7 +274,7 @@ void ScrollViewShadowNode::AddHandlers(const winrt::ScrollViewer &scrollViewer)
         EmitScrollEvent(
             scrollViewerNotNull,
             m_tag,
-            "topScroll",
+            ScrollViewEvents::Scroll,
             args.NextView().HorizontalOffset(),
             args.NextView().VerticalOffset(),
             args.NextView().ZoomFactor());
@@ -264,7 +292,7 @@ void ScrollViewShadowNode::AddHandlers(const winrt::ScrollViewer &scrollViewer)
         EmitScrollEvent(
             scrollViewer,
             m_tag,
-            "topScrollBeginDrag",
+            ScrollViewEvents::ScrollBeginDrag,
             scrollViewer.HorizontalOffset(),
             scrollViewer.VerticalOffset(),
             scrollViewer.ZoomFactor());
@@ -277,7 +305,7 @@ void ScrollViewShadowNode::AddHandlers(const winrt::ScrollViewer &scrollViewer)
           EmitScrollEvent(
               scrollViewer,
               m_tag,
-              "topScrollEndMomentum",
+              ScrollViewEvents::ScrollEndMomentum,
               scrollViewer.HorizontalOffset(),
               scrollViewer.VerticalOffset(),
               scrollViewer.ZoomFactor());
@@ -285,7 +313,7 @@ void ScrollViewShadowNode::AddHandlers(const winrt::ScrollViewer &scrollViewer)
           EmitScrollEvent(
               scrollViewer,
               m_tag,
-              "topScrollEndDrag",
+              ScrollViewEvents::ScrollEndDrag,
               scrollViewer.HorizontalOffset(),
               scrollViewer.VerticalOffset(),
               scrollViewer.ZoomFactor());
@@ -306,7 +334,7 @@ void ScrollViewShadowNode::AddHandlers(const winrt::ScrollViewer &scrollViewer)
 void ScrollViewShadowNode::EmitScrollEvent(
     const winrt::ScrollViewer &scrollViewer,
     int64_t tag,
-    const char *eventName,
+    const ScrollEvent &event,
     double x,
     double y,
     double zoom) {
@@ -316,22 +344,44 @@ void ScrollViewShadowNode::EmitScrollEvent(
 
   const auto scrollViewerNotNull = scrollViewer;
 
-  folly::dynamic offset = folly::dynamic::object("x", x)("y", y);
-
-  folly::dynamic contentInset = folly::dynamic::object("left", 0)("top", 0)("right", 0)("bottom", 0);
-
-  folly::dynamic contentSize =
-      folly::dynamic::object("width", scrollViewerNotNull.ExtentWidth())("height", scrollViewerNotNull.ExtentHeight());
-
-  folly::dynamic layoutSize =
-      folly::dynamic::object("width", scrollViewerNotNull.ActualWidth())("height", scrollViewerNotNull.ActualHeight());
-
-  folly::dynamic eventJson =
-      folly::dynamic::object("target", tag)("responderIgnoreScroll", true)("contentOffset", offset)(
-          "contentInset", contentInset)("contentSize", contentSize)("layoutMeasurement", layoutSize)("zoomScale", zoom);
+  // The Animated.event mappings read the event values without building the JS event object.
+  const auto readSize = [&](bool isContentSize, bool isWidth) {
+    if (isContentSize) {
+      return isWidth ? scrollViewerNotNull.ExtentWidth() : scrollViewerNotNull.ExtentHeight();
+    }
 
-  folly::dynamic params = folly::dynamic::array(tag, eventName, eventJson);
-  instance->CallJsFunction("RCTEventEmitter", "receiveEvent", std::move(params));
+    return isWidth ? scrollViewerNotNull.ActualWidth() : scrollViewerNotNull.ActualHeight();
+  };
+
+  EmitScrollViewEvent(
+      instance->GetAnimatedEventRouter(),
+      tag,
+      event.RegistrationNameId,
+      m_jsEventFilter,
+      std::chrono::steady_clock::now(),
+      x,
+      y,
+      zoom,
+      readSize,
+      [&]() {
+        folly::dynamic offset = folly::dynamic::object("x", x)("y", y);
+
+        folly::dynamic contentInset = folly::dynamic::object("left", 0)("top", 0)("right", 0)("bottom", 0);
+
+        folly::dynamic contentSize = folly::dynamic::object("width", scrollViewerNotNull.ExtentWidth())(
+            "height", scrollViewerNotNull.ExtentHeight());
+
+        folly::dynamic layoutSize = folly::dynamic::object("width", scrollViewerNotNull.ActualWidth())(
+            "height", scrollViewerNotNull.ActualHeight());
+
+        folly::dynamic eventJson =
+            folly::dynamic::object("target", tag)("responderIgnoreScroll", true)("contentOffset", offset)(
+                "contentInset", contentInset)("contentSize", contentSize)("layoutMeasurement", layoutSize)(
+                "zoomScale", zoom);
+
+        folly::dynamic params = folly::dynamic::array(tag, event.Name, eventJson);
+        instance->CallJsFunction("RCTEventEmitter", "receiveEvent", std::move(params));
+      });
 }
 
 template <typename T>
@@ -420,11 +470,21 @@ folly::dynamic ScrollViewManager::GetNativeProps() const {
       "showsHorizontalScrollIndicator", "boolean")("showsVerticalScrollIndicator", "boolean")(
       "minimumZoomScale", "float")("maximumZoomScale", "float")("zoomScale", "float")("snapToInterval", "float")(
       "snapToOffsets", "array")("snapToAlignment", "number")("snapToStart", "boolean")("snapToEnd", "boolean")(
-      "pagingEnabled", "boolean")("keyboardDismissMode", "string"));
+      "pagingEnabled", "boolean")("keyboardDismissMode", "string")("onScroll", "function")(
+      "onScrollBeginDrag", "function")("onScrollEndDrag", "function")("onMomentumScrollBegin", "function")(
+      "onMomentumScrollEnd", "function")("scrollEventThrottle", "number"));
 
   return props;
 }
 
+bool ScrollViewManager::IsLayoutAffectingProp(const std::string &propertyName) const {
+  if (IsScrollEventRegistration(propertyName) || propertyName == "scrollEventThrottle") {
+    return false;
+  }
+
+  return Super::IsLayoutAffectingProp(propertyName);
+}
+
 facebook::react::ShadowNode *ScrollViewManager::createShadow() const {
   return new ScrollViewShadowNode();
 }
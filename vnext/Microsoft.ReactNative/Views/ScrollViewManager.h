@@ -18,6 +18,7 @@ class ScrollViewManager : public ControlViewManager {
   folly::dynamic GetCommands() const override;
   folly::dynamic GetNativeProps() const override;
   folly::dynamic GetExportedCustomDirectEventTypeConstants() const override;
+  bool IsLayoutAffectingProp(const std::string &propertyName) const override;
 
   facebook::react::ShadowNode *createShadow() const override;
 
@@ -5,6 +5,7 @@
 
 #include "TextViewManager.h"
 
+#include <Views/LayoutAffectingProps.h>
 #include <Views/ShadowNodeBase.h>
 
 #include <UI.Xaml.Automation.Peers.h>
@@ -89,6 +90,10 @@ XamlView TextViewManager::CreateViewCore(int64_t /*tag*/) {
   return textBlock;
 }
 
+bool TextViewManager::IsLayoutAffectingProp(const std::string &propertyName) const {
+  return IsTextLayoutAffectingProp(propertyName);
+}
+
 bool TextViewManager::UpdateProperty(
     ShadowNodeBase *nodeToUpdate,
     const std::string &propertyName,
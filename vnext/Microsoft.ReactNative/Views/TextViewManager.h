@@ -22,6 +22,7 @@ class TextViewManager : public FrameworkElementViewManager {
   void RemoveChildAt(const XamlView &parent, int64_t index) override;
 
   YGMeasureFunc GetYogaCustomMeasureFunc() const override;
+  bool IsLayoutAffectingProp(const std::string &propertyName) const override;
 
   void OnDescendantTextPropertyChanged(ShadowNodeBase *node);
 
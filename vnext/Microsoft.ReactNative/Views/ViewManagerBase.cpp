@@ -14,6 +14,7 @@
 #include <IReactInstance.h>
 #include <IXamlRootView.h>
 #include <TestHook.h>
+#include <Views/LayoutAffectingProps.h>
 #include <Views/ShadowNodeBase.h>
 
 using namespace folly;
@@ -219,10 +220,18 @@ void ViewManagerBase::UpdateProperties(ShadowNodeBase *nodeToUpdate, const dynam
   //  There isn't actually a yoga node for RawText views, but it will invalidate
   //  the ancestors which
   //  will include the containing Text element. And that's what matters.
-  int64_t tag = GetTag(nodeToUpdate->GetView());
+  // Diffs that only have properties like colors or opacity cannot change the
+  // measured size, so they do not dirty the node.
   auto instance = m_wkReactInstance.lock();
-  if (instance != nullptr && instance->IsLoaded())
-    static_cast<NativeUIManager *>(instance->NativeUIManager())->DirtyYogaNode(tag);
+  if (instance != nullptr && instance->IsLoaded()) {
+    auto nativeUIManager = static_cast<NativeUIManager *>(instance->NativeUIManager());
+    if (HasLayoutAffectingProp(
+            reactDiffMap, [this](const std::string &propertyName) { return IsLayoutAffectingProp(propertyName); })) {
+      nativeUIManager->DirtyYogaNode(GetTag(nodeToUpdate->GetView()));
+    } else {
+      nativeUIManager->SkipDirtyYogaNode();
+    }
+  }
 
   for (const auto &pair : reactDiffMap.items()) {
     const std::string &propertyName = pair.first.getString();
@@ -251,6 +260,10 @@ bool ViewManagerBase::UpdateProperty(
   return true;
 }
 
+bool ViewManagerBase::IsLayoutAffectingProp(const std::string &propertyName) const {
+  return IsViewManagerBaseLayoutAffectingProp(propertyName);
+}
+
 void ViewManagerBase::TransferProperties(const XamlView & /*oldView*/, const XamlView & /*newView*/) {}
 
 void ViewManagerBase::DispatchCommand(
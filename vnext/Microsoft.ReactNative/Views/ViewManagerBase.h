@@ -21,9 +21,10 @@ struct IReactInstance;
 struct ShadowNodeBase;
 
 struct YogaContext {
-  YogaContext(const XamlView &view_) : view(view_) {}
+  YogaContext(const XamlView &view_, YGMeasureFunc measureFunc_ = nullptr) : view(view_), measureFunc(measureFunc_) {}
 
   XamlView view;
+  YGMeasureFunc measureFunc; // The view manager measure function when Yoga calls a wrapper.
 };
 
 REACTWINDOWS_EXPORT YGSize DefaultYogaSelfMeasureFunc(
@@ -93,6 +94,14 @@ class REACTWINDOWS_EXPORT ViewManagerBase : public facebook::react::IViewManager
       const folly::dynamic &value);
   virtual void OnPropertiesUpdated(ShadowNodeBase *node) {}
 
+ public:
+  // Returns false for the properties that never change the measured size of the view,
+  // such as colors or opacity. UpdateProperties dirties the Yoga node only when the
+  // diff has a property that may change it. The standard view managers return the
+  // functions of Views/LayoutAffectingProps.h. Declared after the other virtual functions
+  // so that it does not move them in the vtable.
+  virtual bool IsLayoutAffectingProp(const std::string &propertyName) const;
+
  protected:
   std::weak_ptr<IReactInstance> m_wkReactInstance;
 };
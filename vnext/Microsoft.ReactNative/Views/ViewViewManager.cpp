@@ -10,6 +10,7 @@
 #include "DynamicAutomationProperties.h"
 
 #include <Modules/NativeUIManager.h>
+#include <Views/LayoutAffectingProps.h>
 #include <Utils/AccessibilityUtils.h>
 #include <Utils/PropertyUtils.h>
 
@@ -353,6 +354,10 @@ folly::dynamic ViewViewManager::GetNativeProps() const {
   return props;
 }
 
+bool ViewViewManager::IsLayoutAffectingProp(const std::string &propertyName) const {
+  return IsViewLayoutAffectingProp(propertyName);
+}
+
 bool ViewViewManager::UpdateProperty(
     ShadowNodeBase *nodeToUpdate,
     const std::string &propertyName,
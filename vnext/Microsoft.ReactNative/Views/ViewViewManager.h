@@ -21,6 +21,7 @@ class ViewViewManager : public FrameworkElementViewManager {
   folly::dynamic GetNativeProps() const override;
   folly::dynamic GetExportedCustomDirectEventTypeConstants() const override;
   facebook::react::ShadowNode *createShadow() const override;
+  bool IsLayoutAffectingProp(const std::string &propertyName) const override;
 
   // Yoga Layout
   void SetLayoutProps(
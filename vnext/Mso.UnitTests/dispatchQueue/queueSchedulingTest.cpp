@@ -0,0 +1,307 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "dispatchQueue/dispatchQueue.h"
+#include <functional>
+#include <string>
+#include "eventWaitHandle/eventWaitHandle.h"
+#include "motifCpp/libletAwareMemLeakDetection.h"
+#include "motifCpp/testCheck.h"
+
+using namespace std::chrono_literals;
+
+namespace Mso::Test {
+
+namespace {
+
+// A clock that only moves when a test advances it.
+struct FakeClock {
+  static std::chrono::steady_clock::time_point Now() noexcept {
+    return s_now;
+  }
+
+  static void Advance(std::chrono::steady_clock::duration duration) noexcept {
+    s_now += duration;
+  }
+
+  static inline std::chrono::steady_clock::time_point s_now{};
+};
+
+// A scheduler that invokes tasks only when a test runs them.
+struct ManualScheduler : Mso::UnknownObject<IDispatchQueueScheduler> {
+  // Invokes tasks until the queue has no ready tasks, and returns the number of invoked tasks.
+  size_t RunTasks() noexcept {
+    size_t taskCount = 0;
+    if (auto queue = m_queue.GetStrongPtr()) {
+      DispatchTask task;
+      while (queue->TryDequeTask(task)) {
+        queue->InvokeTask(std::move(task), std::nullopt);
+        ++taskCount;
+      }
+    }
+
+    return taskCount;
+  }
+
+  std::optional<std::chrono::steady_clock::time_point> WakeUpTime() const noexcept {
+    return m_wakeUpTime;
+  }
+
+ public: // IDispatchQueueScheduler
+  void IntializeScheduler(Mso::WeakPtr<IDispatchQueueService> &&queue) noexcept override {
+    m_queue = std::move(queue);
+  }
+
+  bool IsSerial() noexcept override {
+    return true;
+  }
+
+  bool HasThreadAccess() noexcept override {
+    return false;
+  }
+
+  void Post() noexcept override {}
+
+  void PostDelayed(std::chrono::steady_clock::duration delay) noexcept override {
+    m_wakeUpTime = FakeClock::Now() + delay;
+  }
+
+  void Shutdown() noexcept override {}
+
+  void AwaitTermination() noexcept override {}
+
+ private:
+  Mso::WeakPtr<IDispatchQueueService> m_queue;
+  std::optional<std::chrono::steady_clock::time_point> m_wakeUpTime;
+};
+
+// A scheduler that dequeues one task per Post call, like UISchedulerWinRT.
+struct OneTaskPerPostScheduler : Mso::UnknownObject<IDispatchQueueScheduler> {
+  // Handles the pending Post calls until there are none, and returns the number of invoked tasks.
+  size_t RunPosts() noexcept {
+    size_t taskCount = 0;
+    if (auto queue = m_queue.GetStrongPtr()) {
+      while (m_postCount > 0) {
+        --m_postCount;
+        DispatchTask task;
+        if (queue->TryDequeTask(task)) {
+          queue->InvokeTask(std::move(task), std::nullopt);
+          ++taskCount;
+        }
+      }
+    }
+
+    return taskCount;
+  }
+
+  // Posts once when the requested wake up time is reached, like the UISchedulerWinRT timer.
+  void WakeUp() noexcept {
+    if (m_wakeUpTime && *m_wakeUpTime <= FakeClock::Now()) {
+      m_wakeUpTime.reset();
+      Post();
+    }
+  }
+
+ public: // IDispatchQueueScheduler
+  void IntializeScheduler(Mso::WeakPtr<IDispatchQueueService> &&queue) noexcept override {
+    m_queue = std::move(queue);
+  }
+
+  bool IsSerial() noexcept override {
+    return true;
+  }
+
+  bool HasThreadAccess() noexcept override {
+    return false;
+  }
+
+  void Post() noexcept override {
+    ++m_postCount;
+  }
+
+  void PostDelayed(std::chrono::steady_clock::duration delay) noexcept override {
+    m_wakeUpTime = FakeClock::Now() + delay;
+  }
+
+  void Shutdown() noexcept override {}
+
+  void AwaitTermination() noexcept override {}
+
+ private:
+  Mso::WeakPtr<IDispatchQueueService> m_queue;
+  std::optional<std::chrono::steady_clock::time_point> m_wakeUpTime;
+  size_t m_postCount{0};
+};
+
+} // namespace
+
+TEST_CLASS_EX (QueueSchedulingTest, LibletAwareMemLeakDetection) {
+  TEST_METHOD(QueueScheduling_RunsHigherPriorityFirst) {
+    auto scheduler = Mso::Make<ManualScheduler>();
+    auto queue = DispatchQueue::MakeCustomQueue(Mso::CntPtr{scheduler}, &FakeClock::Now);
+    std::string order;
+    queue.Post([&order]() noexcept { order += "i1 "; }, DispatchTaskPriority::Idle);
+    queue.Post([&order]() noexcept { order += "n1 "; });
+    queue.Post([&order]() noexcept { order += "h1 "; }, DispatchTaskPriority::High);
+    queue.Post([&order]() noexcept { order += "i2 "; }, DispatchTaskPriority::Idle);
+    queue.Post([&order]() noexcept { order += "n2 "; }, DispatchTaskPriority::Normal);
+    queue.Post([&order]() noexcept { order += "h2 "; }, DispatchTaskPriority::High);
+
+    TestCheckEqual(size_t{6}, scheduler->RunTasks());
+    TestCheckEqual("h1 h2 n1 n2 i1 i2 ", order);
+  }
+
+  TEST_METHOD(QueueScheduling_DoesNotStarveIdleTasks) {
+    auto scheduler = Mso::Make<ManualScheduler>();
+    auto queue = DispatchQueue::MakeCustomQueue(Mso::CntPtr{scheduler}, &FakeClock::Now);
+    size_t taskIndex = 0;
+    size_t idleTaskIndex = 0;
+    queue.Post([&]() noexcept { idleTaskIndex = taskIndex++; }, DispatchTaskPriority::Idle);
+
+    // A normal priority task that keeps posting itself would starve a strict priority queue.
+    std::function<void()> repost;
+    repost = [&]() noexcept {
+      if (++taskIndex < 100) {
+        queue.Post([&repost]() noexcept { repost(); });
+      }
+    };
+    queue.Post([&repost]() noexcept { repost(); });
+
+    TestCheckEqual(size_t{100}, scheduler->RunTasks());
+
+    // The idle task runs after it was skipped for eight normal tasks.
+    TestCheckEqual(size_t{8}, idleTaskIndex);
+  }
+
+  TEST_METHOD(QueueScheduling_RunsDelayedTasksWhenDue) {
+    auto scheduler = Mso::Make<ManualScheduler>();
+    auto queue = DispatchQueue::MakeCustomQueue(Mso::CntPtr{scheduler}, &FakeClock::Now);
+    auto start = FakeClock::Now();
+    std::string order;
+    queue.PostDelayed(10ms, [&order]() noexcept { order += "10 "; });
+    queue.PostDelayed(5ms, [&order]() noexcept { order += "5 "; });
+    queue.PostDelayed(20ms, [&order]() noexcept { order += "20 "; });
+    queue.PostDelayed(10ms, [&order]() noexcept { order += "10b "; });
+
+    // The scheduler is asked to wake up when the earliest task is due.
+    TestCheck(scheduler->WakeUpTime() == start + 5ms);
+
+    FakeClock::Advance(4ms);
+    TestCheckEqual(size_t{0}, scheduler->RunTasks());
+
+    FakeClock::Advance(1ms);
+    TestCheckEqual(size_t{1}, scheduler->RunTasks());
+    TestCheckEqual("5 ", order);
+    TestCheck(scheduler->WakeUpTime() == start + 10ms);
+
+    // Tasks with the same due time run in the posting order.
+    FakeClock::Advance(6ms);
+    TestCheckEqual(size_t{2}, scheduler->RunTasks());
+    TestCheckEqual("5 10 10b ", order);
+    TestCheck(scheduler->WakeUpTime() == start + 20ms);
+
+    FakeClock::Advance(9ms);
+    TestCheckEqual(size_t{1}, scheduler->RunTasks());
+    TestCheckEqual("5 10 10b 20 ", order);
+
+    // The latency of a delayed task is measured from its due time.
+    DispatchQueueMetrics metrics = queue.GetMetrics();
+    TestCheckEqual(uint64_t{4}, metrics.EnqueuedCount);
+    TestCheckEqual(uint64_t{4}, metrics.ExecutedCount);
+    TestCheck(metrics.P99Latency == 1ms);
+  }
+
+  TEST_METHOD(QueueScheduling_PostsEachDueDelayedTask) {
+    auto scheduler = Mso::Make<OneTaskPerPostScheduler>();
+    auto queue = DispatchQueue::MakeCustomQueue(Mso::CntPtr{scheduler}, &FakeClock::Now);
+    std::string order;
+    queue.PostDelayed(5ms, [&order]() noexcept { order += "a "; });
+    queue.PostDelayed(5ms, [&order]() noexcept { order += "b "; });
+    queue.PostDelayed(5ms, [&order]() noexcept { order += "c "; });
+    TestCheckEqual(size_t{0}, scheduler->RunPosts());
+
+    // The single wake up must run all three due tasks.
+    FakeClock::Advance(5ms);
+    scheduler->WakeUp();
+    TestCheckEqual(size_t{3}, scheduler->RunPosts());
+    TestCheckEqual("a b c ", order);
+  }
+
+  TEST_METHOD(QueueScheduling_DelayedTaskWaitsForSuspendedQueue) {
+    auto scheduler = Mso::Make<ManualScheduler>();
+    auto queue = DispatchQueue::MakeCustomQueue(Mso::CntPtr{scheduler}, &FakeClock::Now);
+    bool isInvoked = false;
+    queue.PostDelayed(5ms, [&isInvoked]() noexcept { isInvoked = true; });
+
+    {
+      auto suspendGuard = queue.Suspend();
+      FakeClock::Advance(5ms);
+      TestCheckEqual(size_t{0}, scheduler->RunTasks());
+    }
+
+    TestCheck(scheduler->WakeUpTime() == FakeClock::Now());
+    TestCheckEqual(size_t{1}, scheduler->RunTasks());
+    TestCheck(isInvoked);
+  }
+
+  TEST_METHOD(QueueScheduling_ShutdownCancelsDelayedTasks) {
+    auto scheduler = Mso::Make<ManualScheduler>();
+    auto queue = DispatchQueue::MakeCustomQueue(Mso::CntPtr{scheduler}, &FakeClock::Now);
+    bool isInvoked = false;
+    bool isCanceled = false;
+    queue.PostDelayed(
+        5ms,
+        Mso::MakeDispatchTask(
+            [&isInvoked]() noexcept { isInvoked = true; }, [&isCanceled]() noexcept { isCanceled = true; }));
+
+    queue.Shutdown(PendingTaskAction::Complete);
+    TestCheck(isCanceled);
+
+    FakeClock::Advance(5ms);
+    TestCheckEqual(size_t{0}, scheduler->RunTasks());
+    TestCheck(!isInvoked);
+  }
+
+  TEST_METHOD(QueueScheduling_ReportsMetrics) {
+    auto scheduler = Mso::Make<ManualScheduler>();
+    auto queue = DispatchQueue::MakeCustomQueue(Mso::CntPtr{scheduler}, &FakeClock::Now);
+
+    // Tasks posted 1ms apart wait from 100ms down to 1ms.
+    for (int i = 0; i < 100; ++i) {
+      queue.Post([]() noexcept {});
+      FakeClock::Advance(1ms);
+    }
+
+    TestCheckEqual(size_t{100}, scheduler->RunTasks());
+    queue.Post([]() noexcept {});
+    TestCheckEqual(size_t{1}, scheduler->RunTasks());
+
+    DispatchQueueMetrics metrics = queue.GetMetrics();
+    TestCheckEqual(uint64_t{101}, metrics.EnqueuedCount);
+    TestCheckEqual(uint64_t{101}, metrics.ExecutedCount);
+    TestCheckEqual(size_t{100}, metrics.MaxDepth);
+    TestCheck(metrics.P50Latency == 50ms);
+    TestCheck(metrics.P99Latency == 99ms);
+  }
+
+  TEST_METHOD(QueueScheduling_LooperQueueRunsDelayedTask) {
+    auto queue = DispatchQueue::MakeLooperQueue();
+    Mso::ManualResetEvent finished;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point invokeTime;
+    queue.PostDelayed(50ms, [&]() noexcept {
+      invokeTime = std::chrono::steady_clock::now();
+      finished.Set();
+    });
+
+    // A task posted later without delay is not blocked by the delayed task.
+    bool isInvoked = false;
+    queue.Post([&isInvoked]() noexcept { isInvoked = true; });
+
+    finished.Wait();
+    TestCheck(isInvoked);
+    TestCheck(invokeTime - start >= 50ms);
+  }
+};
+
+} // namespace Mso::Test
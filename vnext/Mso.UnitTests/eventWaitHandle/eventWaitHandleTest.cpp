@@ -7,6 +7,11 @@
 #include "compilerAdapters/cppMacrosDebug.h"
 #include "motifCpp/TestCheck.h"
 #include "motifCpp/libletawarememleakdetection.h"
+
+#ifdef PERF_TESTS
+#include "dispatchQueue/dispatchQueue.h"
+#include "motifCpp/perfTest.h"
+#endif
 //#include "debugHeap/memoryLeakDetection.h"
 
 using namespace std::chrono_literals;
@@ -357,6 +362,33 @@ TEST_CLASS_EX (EventWaitHandleTest, LibletAwareMemLeakDetection) {
     TestCheckEqual(1, value.load());
   }
 
+  TEST_METHOD(AutoResetEvent_PingPong) {
+    constexpr int32_t iterationCount = 10000;
+    AutoResetEvent ping;
+    AutoResetEvent pong;
+    std::atomic<int32_t> value{0};
+
+    std::thread th;
+    {
+      // Debug(Mso::Memory::AutoIgnoreLeakScope ignore);
+      th = std::thread([ ping, pong, &value ]() noexcept {
+        for (int32_t i = 0; i < iterationCount; ++i) {
+          ping.Wait();
+          ++value;
+          pong.Set();
+        }
+      });
+    }
+
+    for (int32_t i = 0; i < iterationCount; ++i) {
+      ping.Set();
+      pong.Wait();
+      TestCheckEqual(i + 1, value.load()); // Each Set releases exactly one Wait.
+    }
+
+    th.join();
+  }
+
   TESTMETHOD_REQUIRES_SEH(AutoResetEvent_WaitFor_CrashForOverflow) {
     TEST_DISABLE_MEMORY_LEAK_DETECTION();
     AutoResetEvent ev;
@@ -368,6 +400,43 @@ TEST_CLASS_EX (EventWaitHandleTest, LibletAwareMemLeakDetection) {
     AutoResetEvent ev;
     TestCheckCrash(ev.WaitFor(std::chrono::milliseconds(std::numeric_limits<uint32_t>::max())));
   }
+
+#ifdef PERF_TESTS
+
+  // Posts a task back and forth between two looper queues.
+  // The looper thread sleeps on a ManualResetEvent between the tasks, so it measures the wakeup latency.
+  static void PingPong(
+      const Mso::DispatchQueue &from,
+      const Mso::DispatchQueue &to,
+      int32_t count,
+      const ManualResetEvent &finished) noexcept {
+    if (count == 0) {
+      finished.Set();
+      return;
+    }
+
+    to.Post([ from, to, count, finished ]() noexcept { PingPong(to, from, count - 1, finished); });
+  }
+
+  TEST_METHOD(ManualResetEvent_LooperPingPongLatency) {
+    constexpr int32_t roundTripCount = 10000;
+    auto looper1 = Mso::DispatchQueue::MakeLooperQueue();
+    auto looper2 = Mso::DispatchQueue::MakeLooperQueue();
+    ManualResetEvent finished;
+
+    const LONGLONG ticks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      looper1.Post(
+          [ looper1, looper2, finished ]() noexcept { PingPong(looper1, looper2, 2 * roundTripCount, finished); });
+      finished.Wait();
+    });
+
+    Mso::UnitTests::PrintPerfResult("LooperPingPong round trip", "", roundTripCount, ticks);
+
+    looper1.Shutdown(Mso::PendingTaskAction::Complete);
+    looper2.Shutdown(Mso::PendingTaskAction::Complete);
+  }
+
+#endif // PERF_TESTS
 };
 
 } // namespace Mso::Async::Test
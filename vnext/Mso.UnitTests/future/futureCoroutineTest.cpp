@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "future/futureCoroutine.h"
+#include <stdexcept>
+#include <string>
+#include "dispatchQueue/dispatchQueue.h"
+#include "future/futureWait.h"
+#include "motifCpp/libletAwareMemLeakDetection.h"
+#include "testCheck.h"
+
+#ifdef PERF_TESTS
+#include <atomic>
+#include "motifCpp/perfTest.h"
+#ifdef _DEBUG
+#include <crtdbg.h>
+#endif
+#endif
+
+namespace FutureTests {
+
+namespace {
+
+Mso::Future<int> MakeIntFuture(int value) noexcept {
+  Mso::Promise<int> promise;
+  promise.SetValue(value);
+  return promise.AsFuture();
+}
+
+Mso::Future<int> AddAsync(Mso::Future<int> left, Mso::Future<int> right) {
+  int leftValue = co_await left;
+  int rightValue = co_await right;
+  co_return leftValue + rightValue;
+}
+
+Mso::Future<std::string> MoveOnlyResultAsync(Mso::Future<std::string> future) {
+  std::string value = co_await std::move(future);
+  co_return value + "!";
+}
+
+Mso::Future<void> ThrowAsync() {
+  co_await MakeIntFuture(0);
+  throw std::runtime_error("Expected");
+}
+
+Mso::Future<bool> CatchAsync(Mso::Future<void> future) {
+  try {
+    co_await future;
+  } catch (const std::runtime_error &) {
+    co_return true;
+  }
+
+  co_return false;
+}
+
+Mso::Future<bool> SwitchToQueueAsync(Mso::DispatchQueue queue) {
+  co_await queue;
+  co_return queue.HasThreadAccess();
+}
+
+Mso::Future<int> AddOneAsync(Mso::Future<int> future) {
+  co_return co_await std::move(future) + 1;
+}
+
+Mso::Future<int> SumReadyFuturesAsync(int count) {
+  int sum = 0;
+  for (int i = 0; i < count; ++i) {
+    sum += co_await MakeIntFuture(1);
+  }
+
+  co_return sum;
+}
+
+} // namespace
+
+TEST_CLASS_EX (FutureCoroutineTest, LibletAwareMemLeakDetection) {
+  TEST_METHOD(FutureCoroutine_ReturnsValue) {
+    auto future = AddAsync(MakeIntFuture(1), MakeIntFuture(2));
+    TestCheckEqual(3, Mso::FutureWaitAndGetValue(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_AwaitsPendingFuture) {
+    Mso::Promise<int> promise;
+    auto future = AddAsync(promise.AsFuture(), MakeIntFuture(2));
+    TestCheck(!Mso::GetIFuture(future)->IsDone());
+
+    promise.SetValue(3);
+    TestCheckEqual(5, Mso::FutureWaitAndGetValue(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_AwaitsFutureCompletedOnOtherThread) {
+    Mso::Promise<int> promise;
+    auto future = AddAsync(promise.AsFuture(), MakeIntFuture(2));
+    Mso::DispatchQueue::ConcurrentQueue().Post([promise]() noexcept { promise.SetValue(4); });
+
+    TestCheckEqual(6, Mso::FutureWaitAndGetValue(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_MovesValue) {
+    Mso::Promise<std::string> promise;
+    auto future = MoveOnlyResultAsync(promise.AsFuture());
+    promise.SetValue(std::string{"Hello"});
+    TestCheckEqual(std::string{"Hello!"}, Mso::FutureWaitAndGetValue(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_ExceptionFailsFuture) {
+    auto future = ThrowAsync();
+    TestCheck(Mso::FutureWaitIsFailed(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_AwaitThrowsFutureError) {
+    auto future = CatchAsync(ThrowAsync());
+    TestCheck(Mso::FutureWaitAndGetValue(future));
+
+    Mso::Promise<void> promise;
+    future = CatchAsync(promise.AsFuture());
+    promise.SetError(Mso::ExceptionErrorProvider().MakeErrorCode(
+        std::make_exception_ptr(std::runtime_error("Expected"))));
+    TestCheck(Mso::FutureWaitAndGetValue(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_AwaitQueue) {
+    auto queue = Mso::DispatchQueue::MakeSerialQueue();
+    auto future = SwitchToQueueAsync(queue);
+    TestCheck(Mso::FutureWaitAndGetValue(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_AwaitQueueAfterShutdown) {
+    auto queue = Mso::DispatchQueue::MakeSerialQueue();
+    queue.Shutdown(Mso::PendingTaskAction::Cancel);
+
+    auto future = SwitchToQueueAsync(queue);
+    TestCheck(Mso::FutureWaitIsFailed(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_ManyReadyFuturesDoNotSuspend) {
+    // A stack overflow would crash the test if each await added a frame.
+    auto future = SumReadyFuturesAsync(100000);
+    TestCheck(Mso::GetIFuture(future)->IsDone());
+    TestCheckEqual(100000, Mso::FutureWaitAndGetValue(future));
+  }
+
+  TEST_METHOD(FutureCoroutine_DeepChainOfPendingAwaits) {
+    // Each coroutine awaits the future of the previous one. Completing the first future completes
+    // all of them: a stack overflow would crash the test if each coroutine resumed the next one
+    // inside the call that completes its future.
+    constexpr int chainLength = 100000;
+    Mso::Promise<int> promise;
+    Mso::Future<int> future = promise.AsFuture();
+    for (int i = 0; i < chainLength; ++i) {
+      future = AddOneAsync(std::move(future));
+    }
+
+    TestCheck(!Mso::GetIFuture(future)->IsDone());
+    promise.SetValue(0);
+    TestCheck(Mso::GetIFuture(future)->IsDone());
+    TestCheckEqual(chainLength, Mso::FutureWaitAndGetValue(future));
+  }
+
+#ifdef PERF_TESTS
+
+  static constexpr int StepCount = 10;
+  static constexpr int IterationCount = 10000;
+
+  static Mso::Future<int> ThenChain(const Mso::DispatchQueue &queue) noexcept {
+    auto future = MakeIntFuture(0);
+    for (int i = 0; i < StepCount; ++i) {
+      future = future.Then(queue, [](int value) noexcept { return value + 1; });
+    }
+
+    return future;
+  }
+
+  static Mso::Future<int> CoroutineChain(Mso::DispatchQueue queue) {
+    int value = co_await MakeIntFuture(0);
+    for (int i = 0; i < StepCount; ++i) {
+      co_await queue;
+      value = value + 1;
+    }
+
+    co_return value;
+  }
+
+#ifdef _DEBUG
+  static inline std::atomic<int> s_allocationCount{0};
+
+  static int __cdecl CountAllocations(
+      int allocType, void *, size_t, int, long, const unsigned char *, int) noexcept {
+    if (allocType == _HOOK_ALLOC) {
+      ++s_allocationCount;
+    }
+
+    return TRUE;
+  }
+#endif
+
+  template <class TChain>
+  static void TimeChain(const char *name, TChain && chain) {
+    auto queue = Mso::DispatchQueue::MakeSerialQueue();
+    std::string parameters = "steps=" + std::to_string(StepCount);
+
+#ifdef _DEBUG
+    // The debug CRT reports every heap allocation, including the ones of the queue.
+    s_allocationCount = 0;
+    auto previousHook = _CrtSetAllocHook(CountAllocations);
+    TestCheckEqual(StepCount, Mso::FutureWaitAndGetValue(chain(queue)));
+    _CrtSetAllocHook(previousHook);
+    parameters += "; allocations per chain=" + std::to_string(s_allocationCount);
+#endif
+
+    const LONGLONG ticks = Mso::UnitTests::MeasurePerfTicks([&]() {
+      for (int i = 0; i < IterationCount; ++i) {
+        TestCheckEqual(StepCount, Mso::FutureWaitAndGetValue(chain(queue)));
+      }
+    });
+
+    Mso::UnitTests::PrintPerfResult(name, parameters, IterationCount, ticks);
+  }
+
+  TEST_METHOD(FutureCoroutine_TimeChain) {
+    TimeChain("ThenChain", ThenChain);
+    TimeChain("CoroutineChain", CoroutineChain);
+  }
+
+#endif // PERF_TESTS
+};
+
+} // namespace FutureTests
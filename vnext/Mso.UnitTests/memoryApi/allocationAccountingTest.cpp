@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "memoryApi/allocationAccounting.h"
+#include <thread>
+#include "dispatchQueue/dispatchQueue.h"
+#include "eventWaitHandle/eventWaitHandle.h"
+#include "future/future.h"
+#include "memoryApi/memoryApi.h"
+#include "motifCpp/libletAwareMemLeakDetection.h"
+#include "motifCpp/testCheck.h"
+#include "motifCpp/testCheckAllocations.h"
+
+namespace Mso::Memory::Test {
+
+TEST_CLASS_EX (AllocationAccountingTest, LibletAwareMemLeakDetection) {
+  TEST_METHOD(AllocationAccountingScope_CountsAllocations) {
+    AllocationAccountingScope scope;
+    void *memory1 = Mso::Memory::Allocate(16);
+    void *memory2 = Mso::Memory::Allocate(32);
+    Mso::Memory::Free(memory1);
+
+    AllocationCounters counters = scope.Counters();
+    TestCheckEqual(size_t{2}, counters.AllocationCount);
+    TestCheckEqual(size_t{1}, counters.FreeCount);
+    TestCheckEqual(size_t{48}, counters.AllocatedBytes);
+
+    Mso::Memory::Free(memory2);
+    TestCheckEqual(size_t{2}, scope.Counters().FreeCount);
+  }
+
+  TEST_METHOD(AllocationAccountingScope_CountsReallocationAsFreeAndAllocation) {
+    void *memory = Mso::Memory::Allocate(16);
+    AllocationAccountingScope scope;
+    TestCheck(Mso::Memory::Reallocate(&memory, 64) != nullptr);
+
+    AllocationCounters counters = scope.Counters();
+    TestCheckEqual(size_t{1}, counters.AllocationCount);
+    TestCheckEqual(size_t{1}, counters.FreeCount);
+    TestCheckEqual(size_t{64}, counters.AllocatedBytes);
+    Mso::Memory::Free(memory);
+  }
+
+  TEST_METHOD(AllocationAccountingScope_Nested) {
+    AllocationAccountingScope outerScope;
+    Mso::Memory::Free(Mso::Memory::Allocate(8));
+    {
+      AllocationAccountingScope innerScope;
+      Mso::Memory::Free(Mso::Memory::Allocate(8));
+      TestCheckEqual(size_t{1}, innerScope.Counters().AllocationCount);
+    }
+
+    TestCheckEqual(size_t{2}, outerScope.Counters().AllocationCount);
+    TestCheckEqual(size_t{2}, outerScope.Counters().FreeCount);
+  }
+
+  TEST_METHOD(AllocationAccountingScope_IgnoresOtherThreads) {
+    AllocationAccountingScope scope;
+    std::thread thread{[]() noexcept { Mso::Memory::Free(Mso::Memory::Allocate(8)); }};
+    thread.join();
+
+    TestCheckEqual(size_t{0}, scope.Counters().AllocationCount);
+    TestCheckEqual(size_t{0}, scope.Counters().FreeCount);
+  }
+
+  TEST_METHOD(AllocationAccountingScope_SamplesCallSites) {
+    AllocationAccountingScope scope{/*sampleInterval:*/ 2};
+    void *memory[5];
+    for (size_t i = 0; i < std::size(memory); ++i) {
+      memory[i] = Mso::Memory::Allocate(i + 1);
+    }
+
+    for (void *pv : memory) {
+      Mso::Memory::Free(pv);
+    }
+
+    // Every second allocation is sampled.
+    TestCheckEqual(size_t{2}, scope.SampleCount());
+    TestCheckEqual(size_t{2}, scope.Samples()[0].Size);
+    TestCheckEqual(size_t{4}, scope.Samples()[1].Size);
+    TestCheck(scope.Samples()[0].CallSite != nullptr);
+  }
+
+  TEST_METHOD(AllocationAccountingScope_SamplesInInnermostScope) {
+    AllocationAccountingScope outerScope{/*sampleInterval:*/ 1};
+    {
+      AllocationAccountingScope innerScope{/*sampleInterval:*/ 1};
+      Mso::Memory::Free(Mso::Memory::Allocate(8));
+      TestCheckEqual(size_t{1}, innerScope.SampleCount());
+    }
+
+    TestCheckEqual(size_t{0}, outerScope.SampleCount());
+    Mso::Memory::Free(Mso::Memory::Allocate(8));
+    TestCheckEqual(size_t{1}, outerScope.SampleCount());
+  }
+
+  TEST_METHOD(AllocationBudget_DispatchQueuePost) {
+    auto queue = Mso::DispatchQueue::MakeSerialQueue();
+    Mso::ManualResetEvent finished;
+
+    // The task functor is the only allocation.
+    TestCheckAllocationBudget(1, queue.Post([finished]() noexcept { finished.Set(); }));
+    finished.Wait();
+  }
+
+  TEST_METHOD(AllocationBudget_FutureContinuation) {
+    Mso::Promise<int> promise;
+    promise.SetValue(5);
+    Mso::Future<int> future = promise.AsFuture();
+    Mso::Future<void> continuation;
+    bool isInvoked = false;
+
+    // The continuation future and its task share one allocation.
+    TestCheckAllocationBudget(
+        1,
+        continuation = future.Then<Mso::Executors::Inline>([&isInvoked](int /*value*/) noexcept { isInvoked = true; }));
+    TestCheck(isInvoked);
+  }
+};
+
+} // namespace Mso::Memory::Test
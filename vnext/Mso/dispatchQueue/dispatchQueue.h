@@ -5,6 +5,7 @@
 #ifndef MSO_DISPATCHQUEUE_DISPATCHQUEUE_H
 #define MSO_DISPATCHQUEUE_DISPATCHQUEUE_H
 
+#include <chrono>
 #include <optional>
 #include <thread>
 #include "functional/functor.h"
@@ -47,6 +48,34 @@ enum class PendingTaskAction {
   Cancel,
 };
 
+//! Priority of a posted task.
+//! Queues invoke tasks with higher priority first, but they do not starve tasks with lower priority:
+//! a non-empty lower priority lane is served after it was skipped a few times in a row.
+enum class DispatchTaskPriority {
+  High,
+  Normal,
+  Idle,
+};
+
+//! Dispatch queue counters returned by DispatchQueue::GetMetrics().
+struct DispatchQueueMetrics {
+  //! Number of tasks added to the queue. Delayed tasks are added when they are due.
+  uint64_t EnqueuedCount{0};
+
+  //! Number of tasks taken from the queue for invocation.
+  uint64_t ExecutedCount{0};
+
+  //! Maximum number of tasks waiting in the queue for invocation.
+  size_t MaxDepth{0};
+
+  //! Median and 99th percentile of the time that recently invoked tasks waited in the queue.
+  std::chrono::steady_clock::duration P50Latency{};
+  std::chrono::steady_clock::duration P99Latency{};
+};
+
+//! Returns the current time for a dispatch queue. Tests use it to replace std::chrono::steady_clock.
+using DispatchQueueClock = std::chrono::steady_clock::time_point (*)() noexcept;
+
 //! Callback type to handle queue local values
 using SwapDispatchLocalValueCallback = void (*)(void **localValue, void **tlsValue) noexcept;
 
@@ -135,12 +164,30 @@ struct DispatchQueue {
   //! The IDispatchQueueScheduler defines how the dispatch queue items are handled.
   static DispatchQueue MakeCustomQueue(Mso::CntPtr<IDispatchQueueScheduler> &&scheduler) noexcept;
 
+  //! Create a dispatch queue on top of custom IDispatchQueueScheduler that uses the clock for delayed tasks and
+  //! metrics.
+  static DispatchQueue MakeCustomQueue(
+      Mso::CntPtr<IDispatchQueueScheduler> &&scheduler,
+      DispatchQueueClock clock) noexcept;
+
   //! True if state is not empty.
   explicit operator bool() const noexcept;
 
   //! Post the task to the end of the queue for asynchronous invocation.
   void Post(DispatchTask &&task) const noexcept;
 
+  //! Post the task to the end of the queue lane for the priority.
+  //! Only the tasks with the normal priority are collected by the task batching.
+  void Post(DispatchTask &&task, DispatchTaskPriority priority) const noexcept;
+
+  //! Post the task to the queue lane for the priority after the delay.
+  //! Delayed tasks do not keep the queue alive.
+  //! Shutdown cancels the delayed tasks that are still waiting for the delay.
+  void PostDelayed(
+      std::chrono::steady_clock::duration delay,
+      DispatchTask &&task,
+      DispatchTaskPriority priority = DispatchTaskPriority::Normal) const noexcept;
+
   //! Invoke the task immediately if the queue uses the current thread. Otherwise, post it.
   //! The immediate execution ignores the suspend or shutdown states.
   void InvokeElsePost(DispatchTask &&task) const noexcept;
@@ -187,6 +234,9 @@ struct DispatchQueue {
   //! Waits until all pending tasks are completed after shutdown.
   void AwaitTermination() const noexcept;
 
+  //! Get the queue counters.
+  DispatchQueueMetrics GetMetrics() const noexcept;
+
   //! True if the other dispatch queue has the same state pointer.
   [[nodiscard]] bool operator==(DispatchQueue const &other) const noexcept;
 
@@ -311,6 +361,10 @@ struct IDispatchQueueScheduler : IUnknown {
   //! Schedule handling of dispatch queue tasks.
   virtual void Post() noexcept = 0;
 
+  //! Schedule handling of dispatch queue tasks after the delay. It replaces the previously requested delay.
+  //! The dispatch queue requests the delay until its earliest delayed task is due.
+  virtual void PostDelayed(std::chrono::steady_clock::duration delay) noexcept = 0;
+
   //! Shutdown the scheduler. It initiates the shutdown process and cleans up resources.
   virtual void Shutdown() noexcept = 0;
 
@@ -324,6 +378,15 @@ struct IDispatchQueueService : IUnknown {
   //! Add task to the end of asynchronous queue for invocation.
   virtual void Post(DispatchTask &&task) noexcept = 0;
 
+  //! Add task to the end of the asynchronous queue lane for the priority.
+  virtual void PostWithPriority(DispatchTask &&task, DispatchTaskPriority priority) noexcept = 0;
+
+  //! Add task to the asynchronous queue lane for the priority after the delay.
+  virtual void PostDelayed(
+      DispatchTask &&task,
+      std::chrono::steady_clock::duration delay,
+      DispatchTaskPriority priority) noexcept = 0;
+
   //! Invoke the task immediately if the queue uses the current thread. Otherwise, post it.
   //! The immediate execution ignores the suspend or shutdown states.
   virtual void InvokeElsePost(DispatchTask &&task) noexcept = 0;
@@ -397,6 +460,9 @@ struct IDispatchQueueService : IUnknown {
 
   //! Calls ICancellationListener::OnCancel in case if task implements the ICancellationListener interface.
   virtual void CancelTask(DispatchTask &&task) noexcept = 0;
+
+  //! Returns the queue counters.
+  virtual DispatchQueueMetrics GetMetrics() noexcept = 0;
 };
 
 //! The interface for dispatch queue static members.
@@ -434,6 +500,12 @@ struct IDispatchQueueStatic : IUnknown {
   //! Create a dispatch queue on top of custom IDispatchQueueScheduler.
   //! The IDispatchQueueScheduler defines how the dispatch queue items are handled.
   virtual DispatchQueue MakeCustomQueue(Mso::CntPtr<IDispatchQueueScheduler> &&scheduler) noexcept = 0;
+
+  //! Create a dispatch queue on top of custom IDispatchQueueScheduler that uses the clock for delayed tasks and
+  //! metrics.
+  virtual DispatchQueue MakeCustomQueue(
+      Mso::CntPtr<IDispatchQueueScheduler> &&scheduler,
+      DispatchQueueClock clock) noexcept = 0;
 };
 
 //! DispatchTask implementation based on invoke and cancel function objects.
@@ -562,6 +634,12 @@ inline /*static*/ DispatchQueue DispatchQueue::MakeCustomQueue(
   return IDispatchQueueStatic::Instance()->MakeCustomQueue(std::move(scheduler));
 }
 
+inline /*static*/ DispatchQueue DispatchQueue::MakeCustomQueue(
+    Mso::CntPtr<IDispatchQueueScheduler> &&scheduler,
+    DispatchQueueClock clock) noexcept {
+  return IDispatchQueueStatic::Instance()->MakeCustomQueue(std::move(scheduler), clock);
+}
+
 inline DispatchQueue::operator bool() const noexcept {
   return m_state != nullptr;
 }
@@ -570,6 +648,17 @@ inline void DispatchQueue::Post(DispatchTask &&task) const noexcept {
   m_state->Post(std::move(task));
 }
 
+inline void DispatchQueue::Post(DispatchTask &&task, DispatchTaskPriority priority) const noexcept {
+  m_state->PostWithPriority(std::move(task), priority);
+}
+
+inline void DispatchQueue::PostDelayed(
+    std::chrono::steady_clock::duration delay,
+    DispatchTask &&task,
+    DispatchTaskPriority priority) const noexcept {
+  m_state->PostDelayed(std::move(task), delay, priority);
+}
+
 inline void DispatchQueue::InvokeElsePost(DispatchTask &&task) const noexcept {
   m_state->InvokeElsePost(std::move(task));
 }
@@ -619,6 +708,10 @@ inline void DispatchQueue::AwaitTermination() const noexcept {
   m_state->AwaitTermination();
 }
 
+inline DispatchQueueMetrics DispatchQueue::GetMetrics() const noexcept {
+  return m_state->GetMetrics();
+}
+
 inline bool DispatchQueue::operator==(DispatchQueue const &other) const noexcept {
   return m_state.Get() == other.m_state.Get();
 }
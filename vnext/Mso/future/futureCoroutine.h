@@ -0,0 +1,292 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+#ifndef MSO_FUTURE_FUTURECOROUTINE_H
+#define MSO_FUTURE_FUTURECOROUTINE_H
+
+/** \file futureCoroutine.h
+
+Coroutine support for Mso::Future and Mso::DispatchQueue.
+
+- A coroutine may return Mso::Future<T>. The future is completed by co_return,
+  or it fails with the exception that escapes the coroutine body.
+- co_await future suspends the coroutine until the future is completed. It
+  returns the future value or throws the future error.
+- co_await queue resumes the coroutine in a task posted to the DispatchQueue.
+  If the queue cancels the task, then co_await throws a cancellation error.
+
+Awaiting a completed future does not allocate and does not suspend. Awaiting a
+pending future allocates one small continuation instead of a continuation task
+and its functor.
+
+The coroutine is always resumed from the thread that completes the future. If
+the future is completed while await_suspend adds the continuation, then
+await_suspend resumes the awaiting coroutine by returning its handle, so that a
+chain of futures that complete synchronously does not grow the stack.
+
+When a coroutine completes its future with co_return or an exception, the
+coroutine that awaits the future is not resumed inside the call that completes
+the future. Its handle is returned from final_suspend instead, and the compiler
+transfers control to it without adding a frame. A chain of coroutines that
+await each other is therefore resumed in constant stack depth.
+*/
+
+#include <atomic>
+#include <exception>
+#include "errorCode/exceptionErrorProvider.h"
+#include "future/future.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define MSO_COROUTINE_NAMESPACE std
+#elif __has_include(<experimental/coroutine>)
+// C++17 with the /await compiler option.
+#include <experimental/coroutine>
+#define MSO_COROUTINE_NAMESPACE std::experimental
+#else
+#error "futureCoroutine.h requires compiler support for coroutines."
+#endif
+
+namespace Mso::Futures {
+
+using MSO_COROUTINE_NAMESPACE::coroutine_handle;
+using MSO_COROUTINE_NAMESPACE::noop_coroutine;
+using MSO_COROUTINE_NAMESPACE::suspend_never;
+
+//! While a coroutine completes its future, the continuations that the future
+//! runs on the same thread hand the first awaiting coroutine that they would
+//! resume to the completing coroutine, which transfers control to it from
+//! final_suspend.
+struct FutureCoroutineTransfer {
+  explicit FutureCoroutineTransfer(coroutine_handle<> &next) noexcept : m_previousNext{CurrentNext()} {
+    CurrentNext() = &next;
+  }
+
+  ~FutureCoroutineTransfer() noexcept {
+    CurrentNext() = m_previousNext;
+  }
+
+  FutureCoroutineTransfer(const FutureCoroutineTransfer &) = delete;
+  FutureCoroutineTransfer &operator=(const FutureCoroutineTransfer &) = delete;
+
+  //! Returns false if the handle must be resumed by the caller.
+  static bool TryTransfer(coroutine_handle<> handle) noexcept {
+    coroutine_handle<> *next = CurrentNext();
+    if (next && !*next) {
+      *next = handle;
+      return true;
+    }
+
+    return false;
+  }
+
+ private:
+  static coroutine_handle<> *&CurrentNext() noexcept {
+    thread_local coroutine_handle<> *tl_next{nullptr};
+    return tl_next;
+  }
+
+  coroutine_handle<> *m_previousNext;
+};
+
+//! Promise type of the coroutines that return Mso::Future<T>.
+template <class T>
+struct FutureCoroutinePromiseBase {
+  Mso::Future<T> get_return_object() const noexcept {
+    return m_promise.AsFuture();
+  }
+
+  suspend_never initial_suspend() const noexcept {
+    return {};
+  }
+
+  //! Destroys the coroutine frame, because the future keeps its own copy of
+  //! the result, and resumes the awaiting coroutine that completing the future
+  //! handed over.
+  struct FinalAwaiter {
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    coroutine_handle<> await_suspend(coroutine_handle<> handle) noexcept {
+      // The awaiter is in the coroutine frame: read it before destroying the frame.
+      coroutine_handle<> next = Next;
+      handle.destroy();
+      return next ? next : noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+
+    coroutine_handle<> Next;
+  };
+
+  FinalAwaiter final_suspend() const noexcept {
+    return FinalAwaiter{m_next};
+  }
+
+  void unhandled_exception() noexcept {
+    FutureCoroutineTransfer transfer{m_next};
+    m_promise.SetError(Mso::ExceptionErrorProvider().MakeErrorCode(std::current_exception()));
+  }
+
+ protected:
+  Mso::Promise<T> m_promise;
+  coroutine_handle<> m_next;
+};
+
+template <class T>
+struct FutureCoroutinePromise : FutureCoroutinePromiseBase<T> {
+  template <class U = T>
+  void return_value(U &&value) noexcept {
+    FutureCoroutineTransfer transfer{this->m_next};
+    this->m_promise.SetValue(std::forward<U>(value));
+  }
+};
+
+template <>
+struct FutureCoroutinePromise<void> : FutureCoroutinePromiseBase<void> {
+  void return_void() noexcept {
+    FutureCoroutineTransfer transfer{m_next};
+    m_promise.SetValue();
+  }
+};
+
+//! Resumes the awaiting coroutine when the awaited future is completed.
+//! It is the task of a continuation future that uses the parent value, the
+//! same way as FutureWait does.
+struct FutureCoroutineTask {
+  static void Invoke(const ByteArrayView &taskBuffer, IFuture *future, IFuture * /*parentFuture*/) noexcept {
+    future->TrySetSuccess(/*crashIfFailed:*/ true);
+    Resume(taskBuffer);
+  }
+
+  static void Catch(const ByteArrayView &taskBuffer, IFuture *future, ErrorCode &&parentError) noexcept {
+    future->TrySetError(std::move(parentError), /*crashIfFailed:*/ true);
+    Resume(taskBuffer);
+  }
+
+  constexpr static FutureCatchCallback *CatchPtr = &Catch;
+
+  //! Set by whichever of await_suspend and the continuation finishes first.
+  //! The one that finishes second resumes the coroutine.
+  std::atomic<bool> *IsCompleted;
+  coroutine_handle<> Handle;
+
+ private:
+  static void Resume(const ByteArrayView &taskBuffer) noexcept {
+    auto task = taskBuffer.As<FutureCoroutineTask>();
+    if (task->IsCompleted->exchange(true, std::memory_order_acq_rel)) {
+      if (!FutureCoroutineTransfer::TryTransfer(task->Handle)) {
+        task->Handle.resume();
+      }
+    }
+  }
+};
+
+template <class T>
+struct FutureAwaiter {
+  explicit FutureAwaiter(Mso::Future<T> &&future) noexcept : m_future{std::move(future)} {
+    VerifyElseCrashSzTag(m_future, "Cannot await an empty future.", 0x016056de /* tag_byf14 */);
+  }
+
+  bool await_ready() const noexcept {
+    return GetIFuture(m_future)->IsDone();
+  }
+
+  coroutine_handle<> await_suspend(coroutine_handle<> handle) noexcept {
+    constexpr const auto &futureTraits = FutureTraitsProvider<
+        /*Options:    */ FutureOptions::UseParentValue,
+        /*ResultType: */ void,
+        /*TaskType:   */ void,
+        /*PostType:   */ void,
+        /*InvokeType: */ FutureCoroutineTask,
+        /*CatchType:  */ FutureCoroutineTask>::Traits;
+
+    ByteArrayView taskBuffer;
+    Mso::CntPtr<IFuture> continuation = MakeFuture(futureTraits, sizeof(FutureCoroutineTask), &taskBuffer);
+    ::new (taskBuffer.Data()) FutureCoroutineTask{&m_isCompleted, handle};
+
+    GetIFuture(m_future)->AddContinuation(std::move(continuation));
+
+    // Resume this coroutine if the continuation already ran.
+    if (m_isCompleted.exchange(true, std::memory_order_acq_rel)) {
+      return handle;
+    }
+
+    return noop_coroutine();
+  }
+
+  T await_resume() const {
+    IFuture *future = GetIFuture(m_future);
+    if (future->IsFailed()) {
+      future->GetError().Throw();
+    }
+
+    if constexpr (!std::is_void_v<T>) {
+      return std::move(*future->GetValue().As<T>());
+    }
+  }
+
+ private:
+  Mso::Future<T> m_future;
+  std::atomic<bool> m_isCompleted{false};
+};
+
+struct DispatchQueueAwaiter {
+  explicit DispatchQueueAwaiter(const Mso::DispatchQueue &queue) noexcept : m_queue{queue} {
+    VerifyElseCrashSzTag(m_queue, "Cannot await an empty queue.", 0x016056df /* tag_byf15 */);
+  }
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(coroutine_handle<> handle) noexcept {
+    // The coroutine may be resumed and destroyed before Post returns:
+    // do not access members after it.
+    m_queue.Post(Mso::MakeDispatchTask(
+        [handle]() noexcept { handle.resume(); },
+        [this, handle]() noexcept {
+          m_isCanceled = true;
+          handle.resume();
+        }));
+  }
+
+  void await_resume() const {
+    if (m_isCanceled) {
+      Mso::CancellationErrorProvider().MakeErrorCode(true).Throw();
+    }
+  }
+
+ private:
+  Mso::DispatchQueue m_queue;
+  bool m_isCanceled{false};
+};
+
+} // namespace Mso::Futures
+
+template <class T, class... TArgs>
+struct MSO_COROUTINE_NAMESPACE::coroutine_traits<Mso::Future<T>, TArgs...> {
+  using promise_type = Mso::Futures::FutureCoroutinePromise<T>;
+};
+
+namespace Mso {
+
+template <class T>
+inline Mso::Futures::FutureAwaiter<T> operator co_await(const Mso::Future<T> &future) noexcept {
+  return Mso::Futures::FutureAwaiter<T>{Mso::Future<T>{future}};
+}
+
+template <class T>
+inline Mso::Futures::FutureAwaiter<T> operator co_await(Mso::Future<T> &&future) noexcept {
+  return Mso::Futures::FutureAwaiter<T>{std::move(future)};
+}
+
+inline Mso::Futures::DispatchQueueAwaiter operator co_await(const Mso::DispatchQueue &queue) noexcept {
+  return Mso::Futures::DispatchQueueAwaiter{queue};
+}
+
+} // namespace Mso
+
+#endif // MSO_FUTURE_FUTURECOROUTINE_H
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+/**
+This file contains the allocation accounting APIs:
+- Per-thread counters of the Mso::Memory allocations
+- Mso::Memory::AllocationAccountingScope to count allocations made by an operation
+- Optional sampling of the allocation call sites
+
+The counters include the allocations of Mso::Make, futures and functors.
+The global operator new and operator delete are not replaced by Mso, so the
+counters do not include the allocations of std containers and strings.
+A test executable can count them by replacing the global operator new and
+operator delete with functions that call Mso::Memory::Allocate and
+Mso::Memory::Free. Microsoft.ReactNative.Cxx.UnitTests does it in
+AllocationAccountingNew.cpp.
+*/
+#pragma once
+#ifndef MSO_MEMORYAPI_ALLOCATIONACCOUNTING_H
+#define MSO_MEMORYAPI_ALLOCATIONACCOUNTING_H
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+#include "compilerAdapters/functionDecorations.h"
+
+namespace Mso::Memory {
+
+/**
+  Allocation counters of a thread or a scope.
+  A reallocation is counted as a free of the old block and an allocation of the new size.
+*/
+struct AllocationCounters {
+  size_t AllocationCount{0};
+  size_t FreeCount{0};
+  size_t AllocatedBytes{0};
+};
+
+/**
+  Call site of a sampled allocation.
+*/
+struct AllocationSample {
+  const void *CallSite{nullptr};
+  size_t Size{0};
+};
+
+/**
+  Returns the counters of all Mso::Memory allocations made by the current thread since its start.
+*/
+LIBLET_PUBLICAPI AllocationCounters GetThreadAllocationCounters() noexcept;
+
+/**
+  Counts the Mso::Memory allocations made by the current thread while the scope is alive.
+  Scopes can be nested: each of them counts all allocations made since its construction.
+
+  If sampleInterval is not zero then the scope also records the call site of every
+  sampleInterval-th allocation, up to MaxSampleCount samples. Only the innermost
+  sampling scope of the thread records samples.
+
+  Mso::Memory::AllocationAccountingScope scope;
+  queue.Post([]() noexcept {});
+  size_t allocationCount = scope.Counters().AllocationCount;
+*/
+class AllocationAccountingScope {
+ public:
+  static constexpr size_t MaxSampleCount = 16;
+
+  LIBLET_PUBLICAPI AllocationAccountingScope(uint32_t sampleInterval = 0) noexcept;
+  LIBLET_PUBLICAPI ~AllocationAccountingScope() noexcept;
+
+  AllocationAccountingScope(const AllocationAccountingScope &) = delete;
+  AllocationAccountingScope &operator=(const AllocationAccountingScope &) = delete;
+
+  /**
+    Returns the counters of the allocations made by the current thread since the scope construction.
+    It must be called on the thread that created the scope.
+  */
+  LIBLET_PUBLICAPI AllocationCounters Counters() const noexcept;
+
+  size_t SampleCount() const noexcept {
+    return m_sampleCount;
+  }
+
+  const AllocationSample *Samples() const noexcept {
+    return m_samples;
+  }
+
+  // Used by the Mso::Memory allocation functions.
+  void OnAllocate(size_t size, const void *callSite) noexcept;
+
+ private:
+  const AllocationCounters m_start;
+  const uint32_t m_sampleInterval;
+  uint32_t m_untilNextSample;
+  AllocationAccountingScope *const m_outerSamplingScope;
+  size_t m_sampleCount{0};
+  AllocationSample m_samples[MaxSampleCount];
+};
+
+} // namespace Mso::Memory
+
+#endif // __cplusplus
+
+#endif // MSO_MEMORYAPI_ALLOCATIONACCOUNTING_H
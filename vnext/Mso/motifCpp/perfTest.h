@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+#ifndef MSO_MOTIFCPP_PERFTEST_H
+#define MSO_MOTIFCPP_PERFTEST_H
+
+//=============================================================================
+// Helpers for the PERF_TESTS test methods of the test projects.
+// They measure with QueryPerformanceCounter and report like the PrintResult
+// functions of Desktop.ABITests/PerfTests.cpp.
+// The gtest based projects print with PrintPerfResult, and the CppUnitTest
+// based projects pass the FormatPerfResult string to Logger::WriteMessage.
+//=============================================================================
+
+#include <windows.h>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace Mso::UnitTests {
+
+// Accumulates the QueryPerformanceCounter ticks between the Start and Stop calls.
+class PerfTimer {
+ public:
+  void Start() noexcept {
+    QueryPerformanceCounter(&m_start);
+  }
+
+  void Stop() noexcept {
+    LARGE_INTEGER stop{0};
+    QueryPerformanceCounter(&stop);
+    m_ticks += stop.QuadPart - m_start.QuadPart;
+  }
+
+  void Reset() noexcept {
+    m_ticks = 0;
+  }
+
+  LONGLONG Ticks() const noexcept {
+    return m_ticks;
+  }
+
+ private:
+  LARGE_INTEGER m_start{0};
+  LONGLONG m_ticks{0};
+};
+
+// Returns the ticks it takes to run func once.
+template <class TFunc>
+LONGLONG MeasurePerfTicks(TFunc &&func) {
+  PerfTimer timer;
+  timer.Start();
+  func();
+  timer.Stop();
+  return timer.Ticks();
+}
+
+// Converts QueryPerformanceCounter ticks to seconds.
+inline double PerfTicksToSeconds(LONGLONG ticks) noexcept {
+  LARGE_INTEGER freq{0};
+  QueryPerformanceFrequency(&freq);
+  return static_cast<double>(ticks) / freq.QuadPart;
+}
+
+// Returns "testName: parameters; its=...; tt=... s; tc=... ns",
+// where tt is the total time and tc is the time per iteration.
+inline std::string
+FormatPerfResult(const char *testName, const std::string &parameters, uint64_t iterations, LONGLONG accu) {
+  std::stringstream ss;
+
+  double time = PerfTicksToSeconds(accu);
+  ss << testName << ": ";
+  if (!parameters.empty()) {
+    ss << parameters << "; ";
+  }
+  ss << "its=" << iterations << "; tt=" << time << " s; tc=" << time / iterations * 1e9 << " ns";
+  return ss.str();
+}
+
+// Writes the FormatPerfResult string to the test output.
+inline void PrintPerfResult(const char *testName, const std::string &parameters, uint64_t iterations, LONGLONG accu) {
+  std::cout << FormatPerfResult(testName, parameters, iterations, accu) << std::endl;
+}
+
+} // namespace Mso::UnitTests
+
+#endif // MSO_MOTIFCPP_PERFTEST_H
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+#ifndef MSO_MOTIFCPP_TESTCHECKALLOCATIONS_H
+#define MSO_MOTIFCPP_TESTCHECKALLOCATIONS_H
+
+#include "memoryApi/allocationAccounting.h"
+#include "motifCpp/testCheck.h"
+
+namespace TestAssert {
+
+template <class TLambda>
+inline void AllocationBudgetAt(
+    char const *file,
+    int line,
+    size_t maxAllocationCount,
+    TLambda const &lambda,
+    char const *exprStr,
+    char const *message = "") {
+  Mso::Memory::AllocationAccountingScope scope;
+  lambda();
+  Mso::Memory::AllocationCounters counters = scope.Counters();
+  if (counters.AllocationCount > maxAllocationCount) {
+    FailInternalAt(
+        file,
+        line,
+        message,
+        FormatMsg(
+            "Expected: [ %s ] makes at most %zu allocations\n"
+            "  Actual: %zu allocations of %zu bytes\n",
+            exprStr,
+            maxAllocationCount,
+            counters.AllocationCount,
+            counters.AllocatedBytes));
+  }
+}
+
+} // namespace TestAssert
+
+//=============================================================================
+// TestCheckAllocationBudget checks that the provided expression makes at most
+// maxAllocationCount Mso::Memory allocations on the current thread.
+// It is used to lock in the allocation budgets of hot operations.
+//=============================================================================
+#define TestCheckAllocationBudgetAtInternal(file, line, maxAllocationCount, expr, exprStr, ...) \
+  TestAssert::AllocationBudgetAt(                                                               \
+      file, line, maxAllocationCount, [&]() { expr; }, exprStr, TestAssert::FormatMsg("" __VA_ARGS__).c_str())
+#define TestCheckAllocationBudgetAt(file, line, maxAllocationCount, expr, ...) \
+  TestCheckAllocationBudgetAtInternal(file, line, maxAllocationCount, expr, #expr, __VA_ARGS__)
+#define TestCheckAllocationBudget(maxAllocationCount, expr, ...) \
+  TestCheckAllocationBudgetAtInternal(__FILE__, __LINE__, maxAllocationCount, expr, #expr, __VA_ARGS__)
+
+#endif // MSO_MOTIFCPP_TESTCHECKALLOCATIONS_H
@@ -18,11 +18,17 @@ struct LooperScheduler : Mso::UnknownObject<Mso::RefCountStrategy::WeakRef, IDis
   bool HasThreadAccess() noexcept override;
   bool IsSerial() noexcept override;
   void Post() noexcept override;
+  void PostDelayed(std::chrono::steady_clock::duration delay) noexcept override;
   void Shutdown() noexcept override;
   void AwaitTermination() noexcept override;
 
+ private:
+  void WaitForWakeUp() noexcept;
+
  private:
   ManualResetEvent m_wakeUpEvent;
+  ThreadMutex m_mutex;
+  std::optional<std::chrono::steady_clock::time_point> m_wakeUpTime;
   Mso::WeakPtr<IDispatchQueueService> m_queue;
   std::atomic_bool m_isShutdown{false};
   std::thread m_looperThread; // it must be last in the initialization list
@@ -53,8 +59,7 @@ LooperScheduler::~LooperScheduler() noexcept {
         break;
       }
 
-      self->m_wakeUpEvent.Wait();
-      self->m_wakeUpEvent.Reset();
+      self->WaitForWakeUp();
       continue;
     }
 
@@ -62,6 +67,29 @@ LooperScheduler::~LooperScheduler() noexcept {
   }
 }
 
+void LooperScheduler::WaitForWakeUp() noexcept {
+  std::optional<std::chrono::steady_clock::time_point> wakeUpTime;
+  {
+    std::lock_guard lock{m_mutex};
+    wakeUpTime = m_wakeUpTime;
+  }
+
+  if (!wakeUpTime) {
+    m_wakeUpEvent.Wait();
+  } else if (auto now = std::chrono::steady_clock::now(); *wakeUpTime > now) {
+    // Round the wait up to avoid waking up before the delayed task is due.
+    m_wakeUpEvent.WaitFor(std::chrono::ceil<std::chrono::milliseconds>(*wakeUpTime - now));
+  } else {
+    // The delayed tasks are due. The queue requests a new delay when it takes them.
+    std::lock_guard lock{m_mutex};
+    if (m_wakeUpTime == wakeUpTime) {
+      m_wakeUpTime = std::nullopt;
+    }
+  }
+
+  m_wakeUpEvent.Reset();
+}
+
 void LooperScheduler::IntializeScheduler(Mso::WeakPtr<IDispatchQueueService> &&queue) noexcept {
   m_queue = std::move(queue);
 }
@@ -78,6 +106,15 @@ void LooperScheduler::Post() noexcept {
   m_wakeUpEvent.Set();
 }
 
+void LooperScheduler::PostDelayed(std::chrono::steady_clock::duration delay) noexcept {
+  {
+    std::lock_guard lock{m_mutex};
+    m_wakeUpTime = std::chrono::steady_clock::now() + delay;
+  }
+
+  m_wakeUpEvent.Set();
+}
+
 void LooperScheduler::Shutdown() noexcept {
   m_isShutdown = true;
   m_wakeUpEvent.Set();
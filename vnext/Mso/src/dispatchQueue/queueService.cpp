@@ -2,17 +2,37 @@
 // Licensed under the MIT license.
 
 #include "queueService.h"
+#include <algorithm>
 #include "taskBatch.h"
 #include "taskContext.h"
 
 namespace Mso {
 
+namespace {
+
+std::chrono::steady_clock::time_point SteadyClockNow() noexcept {
+  return std::chrono::steady_clock::now();
+}
+
+// Makes std::push_heap and std::pop_heap keep the earliest delayed task at the front.
+bool IsDueLater(const DelayedTask &left, const DelayedTask &right) noexcept {
+  return left.DueTime > right.DueTime || (left.DueTime == right.DueTime && left.Sequence > right.Sequence);
+}
+
+} // namespace
+
+//=============================================================================
+// TaskLane implementation.
+//=============================================================================
+
+TaskLane::TaskLane(Mso::WeakPtr<IUnknown> &&weakOwnerPtr) noexcept : Tasks{std::move(weakOwnerPtr)} {}
+
 //=============================================================================
 // QueueService implementation.
 //=============================================================================
 
-QueueService::QueueService(Mso::CntPtr<IDispatchQueueScheduler> &&scheduler) noexcept
-    : m_scheduler{std::move(scheduler)} {
+QueueService::QueueService(Mso::CntPtr<IDispatchQueueScheduler> &&scheduler, DispatchQueueClock clock) noexcept
+    : m_scheduler{std::move(scheduler)}, m_clock{clock ? clock : &SteadyClockNow} {
   m_scheduler->IntializeScheduler(this);
 }
 
@@ -21,6 +41,10 @@ QueueService::~QueueService() noexcept {
 }
 
 void QueueService::Post(DispatchTask &&task) noexcept {
+  PostWithPriority(std::move(task), DispatchTaskPriority::Normal);
+}
+
+void QueueService::PostWithPriority(DispatchTask &&task, DispatchTaskPriority priority) noexcept {
   VerifyElseCrashSz(task, "The task is empty");
 
   bool isShutdown = false;
@@ -28,13 +52,14 @@ void QueueService::Post(DispatchTask &&task) noexcept {
 
   {
     std::lock_guard lock{m_mutex};
-    auto it = m_taskBatches.find(std::this_thread::get_id());
+    auto it = (priority == DispatchTaskPriority::Normal) ? m_taskBatches.find(std::this_thread::get_id())
+                                                          : m_taskBatches.end();
     if (it != m_taskBatches.end()) {
       it->second->AddTask(std::move(task));
     } else {
       isShutdown = m_shutdownAction.has_value();
       if (!isShutdown) {
-        m_queue.Enqueue(std::move(task));
+        EnqueueTask(std::move(task), priority, m_clock());
         shouldSchedule = (m_suspendCounter == 0);
       }
     }
@@ -47,6 +72,124 @@ void QueueService::Post(DispatchTask &&task) noexcept {
   }
 }
 
+void QueueService::PostDelayed(
+    DispatchTask &&task,
+    std::chrono::steady_clock::duration delay,
+    DispatchTaskPriority priority) noexcept {
+  if (delay <= std::chrono::steady_clock::duration::zero()) {
+    PostWithPriority(std::move(task), priority);
+    return;
+  }
+
+  VerifyElseCrashSz(task, "The task is empty");
+
+  bool isShutdown = false;
+  std::optional<std::chrono::steady_clock::duration> schedulerDelay;
+
+  {
+    std::lock_guard lock{m_mutex};
+    isShutdown = m_shutdownAction.has_value();
+    if (!isShutdown) {
+      auto now = m_clock();
+      m_delayedTasks.push_back(DelayedTask{now + delay, m_nextDelayedTaskSequence++, priority, std::move(task)});
+      std::push_heap(m_delayedTasks.begin(), m_delayedTasks.end(), IsDueLater);
+      if (m_suspendCounter == 0) {
+        schedulerDelay = TakeSchedulerDelay(now);
+      }
+    }
+  }
+
+  if (schedulerDelay) {
+    m_scheduler->PostDelayed(*schedulerDelay);
+  } else if (isShutdown) {
+    CancelTask(std::move(task));
+  }
+}
+
+void QueueService::EnqueueTask(
+    DispatchTask &&task,
+    DispatchTaskPriority priority,
+    std::chrono::steady_clock::time_point enqueueTime) noexcept {
+  VerifyElseCrash(m_mutex.IsLockedByMe());
+  TaskLane &lane = m_lanes[static_cast<size_t>(priority)];
+  lane.Tasks.Enqueue(std::move(task));
+  lane.EnqueueTimes.push_back(enqueueTime);
+  ++m_enqueuedCount;
+  m_maxDepth = std::max(m_maxDepth, ++m_laneTaskCount);
+}
+
+size_t QueueService::EnqueueDueTasks(std::chrono::steady_clock::time_point now) noexcept {
+  VerifyElseCrash(m_mutex.IsLockedByMe());
+  size_t dueTaskCount = 0;
+  while (!m_delayedTasks.empty() && m_delayedTasks.front().DueTime <= now) {
+    std::pop_heap(m_delayedTasks.begin(), m_delayedTasks.end(), IsDueLater);
+    DelayedTask &dueTask = m_delayedTasks.back();
+    EnqueueTask(std::move(dueTask.Task), dueTask.Priority, dueTask.DueTime);
+    m_delayedTasks.pop_back();
+    ++dueTaskCount;
+  }
+
+  return dueTaskCount;
+}
+
+bool QueueService::TryDequeueLaneTask(/*out*/ DispatchTask &task, std::chrono::steady_clock::time_point now) noexcept {
+  VerifyElseCrash(m_mutex.IsLockedByMe());
+
+  // Take the highest priority lane unless a lower priority lane was skipped too many times.
+  TaskLane *selectedLane = nullptr;
+  for (TaskLane &lane : m_lanes) {
+    if (!lane.Tasks.IsEmpty() && (!selectedLane || lane.SkipCount >= MaxLaneSkipCount)) {
+      selectedLane = &lane;
+    }
+  }
+
+  if (!selectedLane) {
+    return false;
+  }
+
+  for (TaskLane &lane : m_lanes) {
+    if (&lane == selectedLane) {
+      lane.SkipCount = 0;
+    } else if (!lane.Tasks.IsEmpty()) {
+      ++lane.SkipCount;
+    }
+  }
+
+  selectedLane->Tasks.TryDequeue(/*out*/ task);
+  auto latency = now - selectedLane->EnqueueTimes.front();
+  selectedLane->EnqueueTimes.pop_front();
+  --m_laneTaskCount;
+  ++m_executedCount;
+
+  if (m_latencySamples.size() < LatencySampleCount) {
+    m_latencySamples.push_back(latency);
+  } else {
+    m_latencySamples[m_nextLatencySample] = latency;
+    m_nextLatencySample = (m_nextLatencySample + 1) % LatencySampleCount;
+  }
+
+  return true;
+}
+
+// Returns the delay to request from the scheduler if the earliest delayed task is due before the scheduler
+// is going to handle the queue tasks.
+std::optional<std::chrono::steady_clock::duration> QueueService::TakeSchedulerDelay(
+    std::chrono::steady_clock::time_point now) noexcept {
+  VerifyElseCrash(m_mutex.IsLockedByMe());
+  if (m_delayedTasks.empty()) {
+    m_schedulerDueTime = std::chrono::steady_clock::time_point::max();
+    return std::nullopt;
+  }
+
+  auto dueTime = m_delayedTasks.front().DueTime;
+  if (dueTime >= m_schedulerDueTime && m_schedulerDueTime > now) {
+    return std::nullopt;
+  }
+
+  m_schedulerDueTime = dueTime;
+  return std::max(dueTime - now, std::chrono::steady_clock::duration::zero());
+}
+
 bool QueueService::ShouldYield(TaskYieldReason *yieldReason) noexcept {
   auto setReason = [&](TaskYieldReason reason) noexcept {
     return yieldReason ? *yieldReason = reason : reason, true;
@@ -152,19 +295,26 @@ void QueueService::Suspend() noexcept {
 
 void QueueService::Resume() noexcept {
   size_t postCount{0};
+  std::optional<std::chrono::steady_clock::duration> schedulerDelay;
 
   {
     std::lock_guard lock{m_mutex};
     VerifyElseCrashSz(m_suspendCounter > 0, "m_suspendCounter must not be negative");
 
     if (--m_suspendCounter == 0) {
-      postCount = m_queue.Size();
+      postCount = m_laneTaskCount;
+      m_schedulerDueTime = std::chrono::steady_clock::time_point::max();
+      schedulerDelay = TakeSchedulerDelay(m_clock());
     }
   }
 
   for (size_t i = 0; i < postCount; ++i) {
     m_scheduler->Post();
   }
+
+  if (schedulerDelay) {
+    m_scheduler->PostDelayed(*schedulerDelay);
+  }
 }
 
 void QueueService::Shutdown(PendingTaskAction pendingTaskAction) noexcept {
@@ -174,8 +324,20 @@ void QueueService::Shutdown(PendingTaskAction pendingTaskAction) noexcept {
     std::lock_guard lock{m_mutex};
     m_shutdownAction = pendingTaskAction;
     if (pendingTaskAction == PendingTaskAction::Cancel) {
-      m_queue.DequeueAll(/*out*/ tasksToCancel);
+      for (TaskLane &lane : m_lanes) {
+        lane.Tasks.DequeueAll(/*out*/ tasksToCancel);
+        lane.EnqueueTimes.clear();
+      }
+
+      m_laneTaskCount = 0;
     }
+
+    // Delayed tasks that are still waiting in the heap are never invoked after shutdown.
+    for (DelayedTask &delayedTask : m_delayedTasks) {
+      tasksToCancel.push_back(std::move(delayedTask.Task));
+    }
+
+    m_delayedTasks.clear();
   }
 
   for (auto &task : tasksToCancel) {
@@ -192,12 +354,35 @@ void QueueService::AwaitTermination() noexcept {
 
 bool QueueService::HasTasks() noexcept {
   std::lock_guard lock{m_mutex};
-  return m_suspendCounter == 0 && !m_queue.IsEmpty();
+  return m_suspendCounter == 0 &&
+      (m_laneTaskCount > 0 || (!m_delayedTasks.empty() && m_delayedTasks.front().DueTime <= m_clock()));
 }
 
 bool QueueService::TryDequeTask(/*out*/ DispatchTask &task) noexcept {
-  std::lock_guard lock{m_mutex};
-  return m_suspendCounter == 0 && m_queue.TryDequeue(/*out*/ task);
+  bool isDequeued = false;
+  size_t postCount = 0;
+  std::optional<std::chrono::steady_clock::duration> schedulerDelay;
+
+  {
+    std::lock_guard lock{m_mutex};
+    if (m_suspendCounter == 0) {
+      auto now = m_clock();
+      postCount = EnqueueDueTasks(now);
+      isDequeued = TryDequeueLaneTask(/*out*/ task, now);
+      schedulerDelay = TakeSchedulerDelay(now);
+    }
+  }
+
+  // Schedulers such as UISchedulerWinRT invoke one task per Post call.
+  for (size_t i = 0; i < postCount; ++i) {
+    m_scheduler->Post();
+  }
+
+  if (schedulerDelay) {
+    m_scheduler->PostDelayed(*schedulerDelay);
+  }
+
+  return isDequeued;
 }
 
 void QueueService::InvokeTask(
@@ -219,6 +404,32 @@ void QueueService::CancelTask(DispatchTask &&task) noexcept {
   }
 }
 
+DispatchQueueMetrics QueueService::GetMetrics() noexcept {
+  DispatchQueueMetrics metrics;
+  std::vector<std::chrono::steady_clock::duration> latencies;
+
+  {
+    std::lock_guard lock{m_mutex};
+    metrics.EnqueuedCount = m_enqueuedCount;
+    metrics.ExecutedCount = m_executedCount;
+    metrics.MaxDepth = m_maxDepth;
+    latencies = m_latencySamples;
+  }
+
+  if (!latencies.empty()) {
+    auto percentile = [&latencies](size_t percent) noexcept {
+      auto it = latencies.begin() + (latencies.size() - 1) * percent / 100;
+      std::nth_element(latencies.begin(), it, latencies.end());
+      return *it;
+    };
+
+    metrics.P50Latency = percentile(50);
+    metrics.P99Latency = percentile(99);
+  }
+
+  return metrics;
+}
+
 //=============================================================================
 // LocalValueEntry implementation.
 //=============================================================================
@@ -285,4 +496,10 @@ DispatchQueue DispatchQueueStatic::MakeCustomQueue(Mso::CntPtr<IDispatchQueueSch
   return Mso::Make<QueueService, IDispatchQueueService>(std::move(scheduler));
 }
 
+DispatchQueue DispatchQueueStatic::MakeCustomQueue(
+    Mso::CntPtr<IDispatchQueueScheduler> &&scheduler,
+    DispatchQueueClock clock) noexcept {
+  return Mso::Make<QueueService, IDispatchQueueService>(std::move(scheduler), clock);
+}
+
 } // namespace Mso
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 #include <thread>
 #include "eventWaitHandle/eventWaitHandle.h"
@@ -21,9 +22,26 @@ enum class LocalValueSwapAction {
   Unlock,
 };
 
+// A task waiting in the delayed task heap until it is due.
+struct DelayedTask {
+  std::chrono::steady_clock::time_point DueTime;
+  uint64_t Sequence; // Keeps the posting order for the same due time.
+  DispatchTaskPriority Priority;
+  DispatchTask Task;
+};
+
+// Tasks of one priority that are ready for invocation.
+struct TaskLane {
+  TaskLane(Mso::WeakPtr<IUnknown> &&weakOwnerPtr) noexcept;
+
+  TaskQueue Tasks;
+  std::deque<std::chrono::steady_clock::time_point> EnqueueTimes; // To measure the queue latency.
+  uint32_t SkipCount{0}; // Number of times in a row the lane was skipped for a higher priority lane.
+};
+
 // A base class for serial dispatch queues
 struct QueueService : Mso::UnknownObject<Mso::RefCountStrategy::WeakRef, IDispatchQueueService, IDispatchQueue> {
-  QueueService(Mso::CntPtr<IDispatchQueueScheduler> &&scheduler) noexcept;
+  QueueService(Mso::CntPtr<IDispatchQueueScheduler> &&scheduler, DispatchQueueClock clock = nullptr) noexcept;
   ~QueueService() noexcept override;
 
   QueueService(QueueService const &other) = delete;
@@ -31,6 +49,11 @@ struct QueueService : Mso::UnknownObject<Mso::RefCountStrategy::WeakRef, IDispat
 
  public: // IDispatchQueueService
   void Post(DispatchTask &&task) noexcept override;
+  void PostWithPriority(DispatchTask &&task, DispatchTaskPriority priority) noexcept override;
+  void PostDelayed(
+      DispatchTask &&task,
+      std::chrono::steady_clock::duration delay,
+      DispatchTaskPriority priority) noexcept override;
   bool ShouldYield(TaskYieldReason *yieldReason) noexcept override;
   bool IsCurrentQueue() noexcept override;
   bool IsSerial() noexcept override;
@@ -50,8 +73,24 @@ struct QueueService : Mso::UnknownObject<Mso::RefCountStrategy::WeakRef, IDispat
   bool TryDequeTask(/*out*/ DispatchTask &task) noexcept override;
   void InvokeTask(DispatchTask &&task, std::optional<std::chrono::steady_clock::time_point> endTime) noexcept override;
   void CancelTask(DispatchTask &&task) noexcept override;
+  DispatchQueueMetrics GetMetrics() noexcept override;
+
+  // A lower priority lane is served after it was skipped this many times in a row.
+  static constexpr uint32_t MaxLaneSkipCount{8};
+
+  // Number of recent queue latencies used to compute the latency percentiles.
+  static constexpr size_t LatencySampleCount{256};
 
  private:
+  void EnqueueTask(
+      DispatchTask &&task,
+      DispatchTaskPriority priority,
+      std::chrono::steady_clock::time_point enqueueTime) noexcept;
+  size_t EnqueueDueTasks(std::chrono::steady_clock::time_point now) noexcept;
+  bool TryDequeueLaneTask(/*out*/ DispatchTask &task, std::chrono::steady_clock::time_point now) noexcept;
+  std::optional<std::chrono::steady_clock::duration> TakeSchedulerDelay(
+      std::chrono::steady_clock::time_point now) noexcept;
+
   bool TrySwapLocalValue(
       SwapDispatchLocalValueCallback swapLocalValue,
       void **tlsValue,
@@ -59,8 +98,21 @@ struct QueueService : Mso::UnknownObject<Mso::RefCountStrategy::WeakRef, IDispat
 
  private:
   const Mso::CntPtr<IDispatchQueueScheduler> m_scheduler;
+  const DispatchQueueClock m_clock;
   ThreadMutex m_mutex;
-  TaskQueue m_queue{static_cast<IDispatchQueue *>(this)};
+  TaskLane m_lanes[3]{
+      {static_cast<IDispatchQueue *>(this)},
+      {static_cast<IDispatchQueue *>(this)},
+      {static_cast<IDispatchQueue *>(this)}}; // Indexed by DispatchTaskPriority.
+  size_t m_laneTaskCount{0};
+  std::vector<DelayedTask> m_delayedTasks; // A min-heap ordered by the due time.
+  uint64_t m_nextDelayedTaskSequence{0};
+  std::chrono::steady_clock::time_point m_schedulerDueTime{std::chrono::steady_clock::time_point::max()};
+  uint64_t m_enqueuedCount{0};
+  uint64_t m_executedCount{0};
+  size_t m_maxDepth{0};
+  std::vector<std::chrono::steady_clock::duration> m_latencySamples;
+  size_t m_nextLatencySample{0};
   std::optional<PendingTaskAction> m_shutdownAction;
   int32_t m_suspendCounter{0};
   std::map<std::thread::id, Mso::CntPtr<TaskBatch>> m_taskBatches;
@@ -92,6 +144,8 @@ struct DispatchQueueStatic : Mso::UnknownObject<Mso::RefCountStrategy::NoRefCoun
   DispatchQueue GetCurrentUIThreadQueue() noexcept override;
   DispatchQueue MakeConcurrentQueue(uint32_t maxThreads) noexcept override;
   DispatchQueue MakeCustomQueue(Mso::CntPtr<IDispatchQueueScheduler> &&scheduler) noexcept override;
+  DispatchQueue MakeCustomQueue(Mso::CntPtr<IDispatchQueueScheduler> &&scheduler, DispatchQueueClock clock) noexcept
+      override;
 };
 
 } // namespace Mso
@@ -12,6 +12,10 @@ struct ThreadPoolWorkDeleter {
   void operator()(TP_WORK *tpWork) noexcept;
 };
 
+struct ThreadPoolTimerDeleter {
+  void operator()(TP_TIMER *tpTimer) noexcept;
+};
+
 struct ThreadPoolSchedulerWin : Mso::UnknownObject<IDispatchQueueScheduler> {
   ThreadPoolSchedulerWin(uint32_t maxThreads) noexcept;
   ~ThreadPoolSchedulerWin() noexcept override;
@@ -21,11 +25,17 @@ struct ThreadPoolSchedulerWin : Mso::UnknownObject<IDispatchQueueScheduler> {
       _Inout_opt_ PVOID context,
       _Inout_ PTP_WORK work);
 
+  static void __stdcall TimerCallback(
+      _Inout_ PTP_CALLBACK_INSTANCE instance,
+      _Inout_opt_ PVOID context,
+      _Inout_ PTP_TIMER timer);
+
  public: // IDispatchQueueScheduler
   void IntializeScheduler(Mso::WeakPtr<IDispatchQueueService> &&queue) noexcept override;
   bool HasThreadAccess() noexcept override;
   bool IsSerial() noexcept override;
   void Post() noexcept override;
+  void PostDelayed(std::chrono::steady_clock::duration delay) noexcept override;
   void Shutdown() noexcept override;
   void AwaitTermination() noexcept override;
 
@@ -43,6 +53,7 @@ struct ThreadPoolSchedulerWin : Mso::UnknownObject<IDispatchQueueScheduler> {
 
  private:
   std::unique_ptr<TP_WORK, ThreadPoolWorkDeleter> m_threadPoolWork;
+  std::unique_ptr<TP_TIMER, ThreadPoolTimerDeleter> m_threadPoolTimer; // To post the delayed tasks when they are due.
   Mso::WeakPtr<IDispatchQueueService> m_queue;
   const uint32_t m_maxThreads{1};
   std::atomic<uint32_t> m_usedThreads{0};
@@ -60,12 +71,25 @@ void ThreadPoolWorkDeleter::operator()(TP_WORK *tpWork) noexcept {
   }
 }
 
+//=============================================================================
+// ThreadPoolTimerDeleter implementation
+//=============================================================================
+
+void ThreadPoolTimerDeleter::operator()(TP_TIMER *tpTimer) noexcept {
+  if (tpTimer != nullptr) {
+    ::SetThreadpoolTimer(tpTimer, nullptr, 0, 0);
+    ::WaitForThreadpoolTimerCallbacks(tpTimer, true);
+    ::CloseThreadpoolTimer(tpTimer);
+  }
+}
+
 //=============================================================================
 // ThreadPoolSchedulerWin implementation
 //=============================================================================
 
 ThreadPoolSchedulerWin::ThreadPoolSchedulerWin(uint32_t maxThreads) noexcept
     : m_threadPoolWork{::CreateThreadpoolWork(WorkCallback, this, nullptr)},
+      m_threadPoolTimer{::CreateThreadpoolTimer(TimerCallback, this, nullptr)},
       m_maxThreads{maxThreads == 0 ? MaxConcurrentThreads : maxThreads} {}
 
 ThreadPoolSchedulerWin::~ThreadPoolSchedulerWin() noexcept {
@@ -99,6 +123,15 @@ ThreadPoolSchedulerWin::~ThreadPoolSchedulerWin() noexcept {
   }
 }
 
+/*static*/ void __stdcall ThreadPoolSchedulerWin::TimerCallback(
+    _Inout_ PTP_CALLBACK_INSTANCE /*instance*/,
+    _Inout_opt_ PVOID context,
+    _Inout_ PTP_TIMER /*timer*/) {
+  // The ThreadPoolSchedulerWin is alive here because m_threadPoolTimer callbacks must be completed before it is
+  // destroyed.
+  static_cast<ThreadPoolSchedulerWin *>(context)->Post();
+}
+
 void ThreadPoolSchedulerWin::IntializeScheduler(Mso::WeakPtr<IDispatchQueueService> &&queue) noexcept {
   m_queue = std::move(queue);
 }
@@ -124,11 +157,23 @@ void ThreadPoolSchedulerWin::Post() noexcept {
   ::SubmitThreadpoolWork(m_threadPoolWork.get());
 }
 
+void ThreadPoolSchedulerWin::PostDelayed(std::chrono::steady_clock::duration delay) noexcept {
+  // The negative due time is relative to the current time in 100 nanosecond units.
+  ULARGE_INTEGER dueTime;
+  dueTime.QuadPart = static_cast<ULONGLONG>(-std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count() / 100);
+  FILETIME fileDueTime{dueTime.LowPart, dueTime.HighPart};
+  ::SetThreadpoolTimer(m_threadPoolTimer.get(), &fileDueTime, 0, 0);
+}
+
 void ThreadPoolSchedulerWin::Shutdown() noexcept {
   // It is not used by this scheduler
 }
 
 void ThreadPoolSchedulerWin::AwaitTermination() noexcept {
+  // Work callbacks set the timer, and the timer callback submits work.
+  ::WaitForThreadpoolWorkCallbacks(m_threadPoolWork.get(), false);
+  ::SetThreadpoolTimer(m_threadPoolTimer.get(), nullptr, 0, 0);
+  ::WaitForThreadpoolTimerCallbacks(m_threadPoolTimer.get(), true);
   ::WaitForThreadpoolWorkCallbacks(m_threadPoolWork.get(), false);
 }
 
@@ -58,6 +58,16 @@ struct ThreadSafeMap {
   std::map<TKey, TValue, std::less<>> m_map;
 };
 
+struct ThreadPoolTimerDeleter {
+  void operator()(TP_TIMER *tpTimer) noexcept {
+    if (tpTimer != nullptr) {
+      ::SetThreadpoolTimer(tpTimer, nullptr, 0, 0);
+      ::WaitForThreadpoolTimerCallbacks(tpTimer, true);
+      ::CloseThreadpoolTimer(tpTimer);
+    }
+  }
+};
+
 } // namespace
 
 struct UISchedulerWinRT;
@@ -89,11 +99,17 @@ struct UISchedulerWinRT : Mso::UnknownObject<Mso::RefCountStrategy::WeakRef, IDi
   using DispatchQueueRegistry = ThreadSafeMap<std::thread::id, Mso::WeakPtr<IDispatchQueueService>>;
   static DispatchQueueRegistry &GetDispatchQueueRegistry() noexcept;
 
+  static void __stdcall TimerCallback(
+      _Inout_ PTP_CALLBACK_INSTANCE instance,
+      _Inout_opt_ PVOID context,
+      _Inout_ PTP_TIMER timer);
+
  public: // IDispatchQueueScheduler
   void IntializeScheduler(Mso::WeakPtr<IDispatchQueueService> &&queue) noexcept override;
   bool HasThreadAccess() noexcept override;
   bool IsSerial() noexcept override;
   void Post() noexcept override;
+  void PostDelayed(std::chrono::steady_clock::duration delay) noexcept override;
   void Shutdown() noexcept override;
   void AwaitTermination() noexcept override;
 
@@ -124,6 +140,7 @@ struct UISchedulerWinRT : Mso::UnknownObject<Mso::RefCountStrategy::WeakRef, IDi
   bool m_isShutdown{false};
   std::thread::id m_threadId{std::this_thread::get_id()};
   DispatcherQueue::ShutdownCompleted_revoker m_shutdownCompletedRevoker;
+  std::unique_ptr<TP_TIMER, ThreadPoolTimerDeleter> m_delayTimer; // To post the delayed tasks when they are due.
 };
 
 //=============================================================================
@@ -170,7 +187,9 @@ int32_t __stdcall TaskDispatcherHandler::Invoke() noexcept {
 // UISchedulerWinRT implementation
 //=============================================================================
 
-UISchedulerWinRT::UISchedulerWinRT(DispatcherQueue &&dispatcher) noexcept : m_dispatcher{std::move(dispatcher)} {
+UISchedulerWinRT::UISchedulerWinRT(DispatcherQueue &&dispatcher) noexcept
+    : m_dispatcher{std::move(dispatcher)}, m_delayTimer{::CreateThreadpoolTimer(TimerCallback, this, nullptr)} {
+  VerifyElseCrashSz(m_delayTimer, "Cannot create threadpool timer");
   m_shutdownCompletedRevoker =
       m_dispatcher.ShutdownCompleted(winrt::auto_revoke, [](DispatcherQueue const &, IInspectable const &) noexcept {
         GetDispatchQueueRegistry().Remove(std::this_thread::get_id());
@@ -260,11 +279,38 @@ void UISchedulerWinRT::Post() noexcept {
   }
 }
 
+void UISchedulerWinRT::PostDelayed(std::chrono::steady_clock::duration delay) noexcept {
+  std::lock_guard lock{m_mutex};
+  if (!m_isShutdown) {
+    // Re-arm the same timer. The negative due time is relative to the current time in 100 nanosecond units.
+    ULARGE_INTEGER dueTime;
+    dueTime.QuadPart =
+        static_cast<ULONGLONG>(-std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count() / 100);
+    FILETIME fileDueTime{dueTime.LowPart, dueTime.HighPart};
+    ::SetThreadpoolTimer(m_delayTimer.get(), &fileDueTime, 0, 0);
+  }
+}
+
+/*static*/ void __stdcall UISchedulerWinRT::TimerCallback(
+    _Inout_ PTP_CALLBACK_INSTANCE instance,
+    _Inout_opt_ PVOID context,
+    _Inout_ PTP_TIMER /*timer*/) {
+  // The UISchedulerWinRT memory is alive here because m_delayTimer callbacks must be completed before it is
+  // destroyed. The object itself may already be released, so we post only if we can get a strong reference.
+  if (auto self = Mso::WeakPtr{static_cast<UISchedulerWinRT *>(context)}.GetStrongPtr()) {
+    // The last reference may be released on this thread. Its destructor waits for the timer callbacks.
+    ::DisassociateCurrentThreadFromCallback(instance);
+    self->Post();
+  }
+}
+
 void UISchedulerWinRT::Shutdown() noexcept {
   CleanupContext context{this};
   {
     std::lock_guard lock{m_mutex};
     m_isShutdown = true;
+    ::SetThreadpoolTimer(m_delayTimer.get(), nullptr, 0, 0);
+
     context.CheckTermination();
   }
 }
@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+// Linux counterpart of eventWaitHandleImpl_win.cpp. It is compiled only by Linux builds of Mso.
+#if defined(__linux__)
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <limits>
+#include "eventWaitHandle/eventWaitHandle.h"
+#include "object/refCountedObject.h"
+
+//! The EventWaitHandle keeps its state in a single 32-bit word and parks the
+//! waiting threads on that word with the futex system call.
+//! Set does not make a system call when nobody is parked, and Wait spins for a
+//! short time before it parks: loopers are usually woken up within a few
+//! microseconds, and spinning saves two system calls and a context switch.
+
+namespace Mso {
+
+namespace {
+
+constexpr uint32_t NotSetState = static_cast<uint32_t>(EventWaitHandleState::NotSet);
+constexpr uint32_t IsSetState = static_cast<uint32_t>(EventWaitHandleState::IsSet);
+
+//! Number of times Wait checks the state before parking the thread.
+//! It is about a few microseconds on modern CPUs.
+constexpr uint32_t SpinCount = 128;
+
+static_assert(
+    sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+    "futex requires a lock-free 32-bit atomic.");
+
+inline void CpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+// Linux futex wrapper
+struct Futex {
+  //! Parks the thread while the word is equal to the expected value.
+  //! A null timeout means to wait indefinitely.
+  static void Wait(std::atomic<uint32_t> &word, uint32_t expected, const timespec *timeout) noexcept {
+    if (syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0) ==
+        -1) {
+      // EAGAIN: the word has changed before we parked. The caller checks the word again
+      // on spurious wakeups, signal interruptions and timeouts.
+      VerifyElseCrashSzTag(
+          errno == EAGAIN || errno == EINTR || errno == ETIMEDOUT, "FUTEX_WAIT failed.", 0x026e3491 /* tag_c19sr */);
+    }
+  }
+
+  static void Wake(std::atomic<uint32_t> &word, int32_t count) noexcept {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+  }
+};
+
+// Implementation of the IEventWaitHandle interface
+class FutexEventWaitHandle final : public Mso::RefCountedObject<IEventWaitHandle> {
+ public:
+  FutexEventWaitHandle(bool isAutoReset, EventWaitHandleState state) noexcept
+      : m_isAutoReset{isAutoReset}, m_state{static_cast<uint32_t>(state)} {}
+
+ public: // IEventWaitHandle
+  void Set() const noexcept override {
+    if (m_state.exchange(IsSetState) == IsSetState) {
+      // All threads parked before the state was set are already woken up.
+      return;
+    }
+
+    // The sequentially consistent exchange above and the increment of m_parkedCount in WaitUntil
+    // guarantee that either we see the parked thread here, or the thread sees the new state.
+    if (m_parkedCount.load() != 0) {
+      Futex::Wake(m_state, m_isAutoReset ? 1 : std::numeric_limits<int32_t>::max());
+    }
+  }
+
+  void Reset() const noexcept override {
+    m_state.store(NotSetState, std::memory_order_release);
+  }
+
+  bool Wait() const noexcept override {
+    return WaitUntil(nullptr);
+  }
+
+  bool WaitFor(const std::chrono::milliseconds &waitDuration) const noexcept override {
+    VerifyElseCrashSzTag(
+        waitDuration.count() < std::numeric_limits<uint32_t>::max(),
+        "waitDuration must not exceed uint32_t size for milliseconds.",
+        0x026e348c /* tag_c19sm */);
+
+    auto now = std::chrono::steady_clock::now();
+    auto waitUntil = now + waitDuration;
+    VerifyElseCrashSzTag(waitUntil >= now, "waitDuration causes clock overflow", 0x026e348d /* tag_c19sn */);
+
+    return WaitUntil(&waitUntil);
+  }
+
+ private:
+  bool TryAcquire() const noexcept {
+    if (m_isAutoReset) {
+      uint32_t expected = IsSetState;
+      return m_state.compare_exchange_strong(expected, NotSetState);
+    }
+
+    return m_state.load() == IsSetState;
+  }
+
+  bool WaitUntil(const std::chrono::steady_clock::time_point *waitUntil) const noexcept {
+    for (uint32_t i = 0; i < SpinCount; ++i) {
+      if (TryAcquire()) {
+        return true;
+      }
+
+      CpuRelax();
+    }
+
+    bool isAcquired = true;
+    m_parkedCount.fetch_add(1);
+    while (!TryAcquire()) {
+      timespec timeout{};
+      if (waitUntil) {
+        auto timeLeft = std::chrono::duration_cast<std::chrono::nanoseconds>(*waitUntil - std::chrono::steady_clock::now());
+        if (timeLeft.count() <= 0) {
+          isAcquired = false;
+          break;
+        }
+
+        timeout.tv_sec = static_cast<time_t>(timeLeft.count() / 1000000000);
+        timeout.tv_nsec = static_cast<long>(timeLeft.count() % 1000000000);
+      }
+
+      Futex::Wait(m_state, NotSetState, waitUntil ? &timeout : nullptr);
+    }
+
+    m_parkedCount.fetch_sub(1, std::memory_order_relaxed);
+    return isAcquired;
+  }
+
+ private:
+  const bool m_isAutoReset;
+  mutable std::atomic<uint32_t> m_state;
+  mutable std::atomic<uint32_t> m_parkedCount{0};
+};
+
+} // namespace
+
+LIBLET_PUBLICAPI ManualResetEvent::ManualResetEvent(EventWaitHandleState state) noexcept
+    : m_handle{Mso::Make<FutexEventWaitHandle>(/*isAutoReset:*/ false, state)} {}
+
+LIBLET_PUBLICAPI AutoResetEvent::AutoResetEvent(EventWaitHandleState state) noexcept
+    : m_handle{Mso::Make<FutexEventWaitHandle>(/*isAutoReset:*/ true, state)} {}
+
+} // namespace Mso
+
+#endif // defined(__linux__)
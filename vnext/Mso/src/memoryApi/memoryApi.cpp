@@ -4,6 +4,8 @@
 #include "memoryApi/memoryApi.h"
 #include <cstdlib>
 #include <memory>
+#include "compilerAdapters/intrinsics.h"
+#include "memoryApi/allocationAccounting.h"
 
 #if !__clang__ && !__GNUC__
 #pragma detect_mismatch("Allocator", "Crt")
@@ -16,8 +18,28 @@ __declspec(noreturn) void ThrowOOM() {
 namespace Mso {
 namespace Memory {
 
+namespace {
+
+thread_local AllocationCounters tl_allocationCounters;
+thread_local AllocationAccountingScope *tl_samplingScope{nullptr};
+
+void CountAllocation(size_t cb, const void *callSite) noexcept {
+  ++tl_allocationCounters.AllocationCount;
+  tl_allocationCounters.AllocatedBytes += cb;
+  if (tl_samplingScope != nullptr) {
+    tl_samplingScope->OnAllocate(cb, callSite);
+  }
+}
+
+} // namespace
+
 _Use_decl_annotations_ void *AllocateEx(size_t cb, uint32_t /*allocFlags*/) noexcept {
-  return ::malloc(cb);
+  void *pv = ::malloc(cb);
+  if (pv != nullptr) {
+    CountAllocation(cb, MSO_FUNC_RETURN_ADDRESS());
+  }
+
+  return pv;
 }
 
 _Use_decl_annotations_ void *Reallocate(void **ppv, size_t cb) noexcept {
@@ -31,14 +53,18 @@ _Use_decl_annotations_ void *Reallocate(void **ppv, size_t cb) noexcept {
 
   void *pv = ::realloc(*ppv, cb);
   if (pv != nullptr) {
+    // A reallocation is counted as a free of the old block and an allocation of the new one.
     *ppv = pv;
+    ++tl_allocationCounters.FreeCount;
+    CountAllocation(cb, MSO_FUNC_RETURN_ADDRESS());
   } else if (cb == 0) {
     // HeapReAlloc with 0 size returns valid pointer and we want all implementations do the same
     // realloc(ptr, 0) on Windows or Mac/iOS with ASAN frees the original pointer and returns null
     // std lib on Mac/iOS returns a valid 0-sized pointer
     // We want to standardize to have only one behavior in shared code
     // so let's allocate a new 0-sized block if resize(ptr, 0) returns nullptr
-    pv = ::malloc(0);
+    ++tl_allocationCounters.FreeCount;
+    pv = Mso::Memory::Allocate(0);
     *ppv = pv;
   }
   // else pv = nullptr, cb != 0: if realloc truly failed, the original ptr is untouched
@@ -47,9 +73,54 @@ _Use_decl_annotations_ void *Reallocate(void **ppv, size_t cb) noexcept {
 }
 
 _Use_decl_annotations_ void Free(void *pv) noexcept {
+  if (pv != nullptr) {
+    ++tl_allocationCounters.FreeCount;
+  }
+
   ::free(pv);
 }
 
+AllocationCounters GetThreadAllocationCounters() noexcept {
+  return tl_allocationCounters;
+}
+
+//=============================================================================
+// AllocationAccountingScope implementation
+//=============================================================================
+
+AllocationAccountingScope::AllocationAccountingScope(uint32_t sampleInterval) noexcept
+    : m_start{tl_allocationCounters},
+      m_sampleInterval{sampleInterval},
+      m_untilNextSample{sampleInterval},
+      m_outerSamplingScope{tl_samplingScope} {
+  if (m_sampleInterval != 0) {
+    tl_samplingScope = this;
+  }
+}
+
+AllocationAccountingScope::~AllocationAccountingScope() noexcept {
+  if (m_sampleInterval != 0) {
+    tl_samplingScope = m_outerSamplingScope;
+  }
+}
+
+AllocationCounters AllocationAccountingScope::Counters() const noexcept {
+  AllocationCounters counters;
+  counters.AllocationCount = tl_allocationCounters.AllocationCount - m_start.AllocationCount;
+  counters.FreeCount = tl_allocationCounters.FreeCount - m_start.FreeCount;
+  counters.AllocatedBytes = tl_allocationCounters.AllocatedBytes - m_start.AllocatedBytes;
+  return counters;
+}
+
+void AllocationAccountingScope::OnAllocate(size_t size, const void *callSite) noexcept {
+  if (--m_untilNextSample == 0) {
+    m_untilNextSample = m_sampleInterval;
+    if (m_sampleCount < MaxSampleCount) {
+      m_samples[m_sampleCount++] = AllocationSample{callSite, size};
+    }
+  }
+}
+
 //#ifdef DEBUG
 // void RegisterCallback(Mso::LibletAPI::ILibletMemoryMarking&) noexcept {}
 //
@@ -32,6 +32,7 @@ void AsyncStorageManager::putRequestOnQueue(
   {
     std::lock_guard<std::mutex> lockGuard(m_setQueueMutex);
     m_asyncQueue.push(std::move(arguments));
+    ++m_pendingRequestCount;
   }
 
   m_storageQueueConditionVariable.notify_one();
@@ -42,15 +43,83 @@ void AsyncStorageManager::consumeSetRequest() noexcept {
     std::unique_lock<std::mutex> uniqueMutex(m_setQueueMutex);
     m_storageQueueConditionVariable.wait(uniqueMutex, [this] { return m_stopConsumer || !m_asyncQueue.empty(); });
 
-    if (!m_asyncQueue.empty()) {
-      std::unique_ptr<AsyncRequestQueueArguments> arguments = std::move(m_asyncQueue.front());
-      m_asyncQueue.pop();
+    // Take all queued requests, so that their mutations are saved to the storage file at once.
+    std::queue<std::unique_ptr<AsyncRequestQueueArguments>> requests;
+    std::swap(requests, m_asyncQueue);
 
-      uniqueMutex.unlock();
+    uniqueMutex.unlock();
+
+    if (!requests.empty()) {
+      executeAsyncKVBatch(std::move(requests));
+    }
+  }
+}
+
+void AsyncStorageManager::executeAsyncKVBatch(
+    std::queue<std::unique_ptr<AsyncRequestQueueArguments>> &&requests) noexcept {
+  std::vector<std::unique_ptr<AsyncRequestQueueArguments>> batch;
+  batch.reserve(requests.size());
+  while (!requests.empty()) {
+    batch.push_back(std::move(requests.front()));
+    requests.pop();
+  }
+
+  // Requests are executed in their submission order against the in-memory map,
+  // and the storage file is saved once after the last of them.
+  std::vector<std::vector<dynamic>> results(batch.size());
+  m_aofKVStorage->beginWriteBatch();
+  for (size_t i = 0; i < batch.size(); ++i) {
+    executeAsyncKVOperation(
+        batch[i]->m_operation, batch[i]->m_args, [&result = results[i]](std::vector<dynamic> callbackArgs) {
+          result = std::move(callbackArgs);
+        });
+  }
+
+  try {
+    m_aofKVStorage->endWriteBatch();
+  } catch (std::exception &e) {
+    // None of the mutations of the batch is known to be saved.
+    for (size_t i = 0; i < batch.size(); ++i) {
+      const AsyncStorageOperation operation = batch[i]->m_operation;
+      if (operation != AsyncStorageOperation::multiGet && operation != AsyncStorageOperation::getAllKeys) {
+        results[i] = {makeError(e.what())};
+      }
+    }
+  }
+
+  // The storage has all writes of the batch now, so that new reads can use the fast path.
+  {
+    std::lock_guard<std::mutex> lockGuard(m_setQueueMutex);
+    m_pendingRequestCount -= batch.size();
+  }
+
+  // Callbacks are invoked after the batch is saved and in the submission order.
+  for (size_t i = 0; i < batch.size(); ++i) {
+    batch[i]->m_jsCallback(std::move(results[i]));
+  }
+}
 
-      executeAsyncKVOperation(arguments->m_operation, arguments->m_args, arguments->m_jsCallback);
+void AsyncStorageManager::executeReadKVOperation(
+    AsyncStorageOperation operation,
+    const dynamic &args,
+    const module::CxxModule::Callback &jsCallback) {
+  std::vector<dynamic> result;
+  {
+    std::unique_lock<std::mutex> uniqueMutex(m_setQueueMutex);
+    if (m_pendingRequestCount > 0) {
+      // Read after the pending requests, so that the read sees their writes.
+      uniqueMutex.unlock();
+      putRequestOnQueue(operation, args, jsCallback);
+      return;
     }
+
+    // Without pending requests the consumer does not change the storage while it is read here.
+    executeAsyncKVOperation(operation, args, [&result](std::vector<dynamic> callbackArgs) {
+      result = std::move(callbackArgs);
+    });
   }
+
+  jsCallback(std::move(result));
 }
 
 folly::dynamic AsyncStorageManager::makeError(std::string &&strErrorMessage) noexcept {
@@ -65,11 +134,8 @@ void AsyncStorageManager::executeKVOperation(
   try {
     switch (operation) {
       case AsyncStorageOperation::multiGet:
-        multiGetInternal(args, jsCallback);
-        break;
-
       case AsyncStorageOperation::getAllKeys:
-        getAllKeysInternal(args, jsCallback);
+        executeReadKVOperation(operation, args, jsCallback);
         break;
 
       default:
@@ -87,6 +153,14 @@ void AsyncStorageManager::executeAsyncKVOperation(
     const module::CxxModule::Callback &jsCallback) noexcept {
   try {
     switch (operation) {
+      case AsyncStorageOperation::multiGet:
+        multiGetInternal(args, jsCallback);
+        break;
+
+      case AsyncStorageOperation::getAllKeys:
+        getAllKeysInternal(args, jsCallback);
+        break;
+
       case AsyncStorageOperation::multiSet:
         multiSetInternal(args, jsCallback);
         break;
@@ -11,6 +11,7 @@
 #include <condition_variable>
 #include <future>
 #include <queue>
+#include <vector>
 
 namespace facebook {
 namespace react {
@@ -44,6 +45,7 @@ class AsyncStorageManager {
   std::condition_variable m_storageQueueConditionVariable;
   std::future<void> m_consumerTask;
   std::queue<std::unique_ptr<AsyncStorageManager::AsyncRequestQueueArguments>> m_asyncQueue;
+  size_t m_pendingRequestCount{0}; // Requests not yet applied to the storage, guarded by m_setQueueMutex
   std::unique_ptr<KeyValueStorage> m_aofKVStorage;
 
  private:
@@ -55,6 +57,11 @@ class AsyncStorageManager {
       const xplat::module::CxxModule::Callback &jsCallback) noexcept;
 
   void consumeSetRequest() noexcept;
+  void executeAsyncKVBatch(std::queue<std::unique_ptr<AsyncRequestQueueArguments>> &&requests) noexcept;
+  void executeReadKVOperation(
+      AsyncStorageOperation operation,
+      const folly::dynamic &args,
+      const xplat::module::CxxModule::Callback &jsCallback);
   void putRequestOnQueue(
       AsyncStorageOperation operation,
       const folly::dynamic &args,
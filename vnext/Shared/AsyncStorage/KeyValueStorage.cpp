@@ -94,6 +94,14 @@ void KeyValueStorage::saveTable() {
   m_fileIOHelper->flush();
 }
 
+void KeyValueStorage::saveChanges() {
+  if (m_inWriteBatch) {
+    m_writeBatchChanged = true;
+  } else {
+    saveTable();
+  }
+}
+
 void KeyValueStorage::waitForStorageLoadComplete() {
   using namespace std::chrono;
   using namespace std::chrono_literals;
@@ -144,7 +152,7 @@ void KeyValueStorage::multiSet(const vector<tuple<string, string>> &keyValuePair
 
   if (fUpdateStorageFile) {
     // write the new keys to the file
-    saveTable();
+    saveChanges();
   }
 }
 
@@ -155,7 +163,7 @@ void KeyValueStorage::multiRemove(const vector<string> &keys) {
     m_kvMap.erase(k);
   }
 
-  saveTable();
+  saveChanges();
 }
 
 void KeyValueStorage::multiMerge(const vector<tuple<string, string>> &keyValuePairs) {
@@ -166,7 +174,11 @@ void KeyValueStorage::clear() {
   waitForStorageLoadComplete();
 
   m_kvMap.clear();
-  m_fileIOHelper->clear();
+  if (m_inWriteBatch) {
+    m_writeBatchChanged = true;
+  } else {
+    m_fileIOHelper->clear();
+  }
 }
 
 vector<string> KeyValueStorage::getAllKeys() {
@@ -179,6 +191,19 @@ vector<string> KeyValueStorage::getAllKeys() {
   return keys;
 }
 
+void KeyValueStorage::beginWriteBatch() {
+  m_inWriteBatch = true;
+  m_writeBatchChanged = false;
+}
+
+void KeyValueStorage::endWriteBatch() {
+  m_inWriteBatch = false;
+  if (m_writeBatchChanged) {
+    m_writeBatchChanged = false;
+    saveTable();
+  }
+}
+
 void KeyValueStorage::escapeString(string &rawString) {
   int cSpecialChars = 0;
   for (auto const &c : rawString) {
@@ -23,6 +23,11 @@ class KeyValueStorage {
   void clear();
   std::vector<std::string> getAllKeys();
 
+  // Mutations between beginWriteBatch and endWriteBatch only update the in-memory map,
+  // and endWriteBatch saves the storage file once for all of them.
+  void beginWriteBatch();
+  void endWriteBatch();
+
  private:
   static const uint32_t EstimatedKeySize = 100; // in chars
   static const uint32_t EstimatedValueSize = 200;
@@ -35,6 +40,8 @@ class KeyValueStorage {
   std::unique_ptr<StorageFileIO> m_fileIOHelper;
   HANDLE m_storageFileLoaded;
   std::future<void> m_storageFileLoader;
+  bool m_inWriteBatch = false;
+  bool m_writeBatchChanged = false;
 
  private:
   static void escapeString(std::string &unescapedString);
@@ -45,6 +52,7 @@ class KeyValueStorage {
   void waitForStorageLoadComplete();
   void setStorageLoadedEvent();
   void saveTable();
+  void saveChanges();
 };
 } // namespace react
 } // namespace facebook
@@ -3,11 +3,11 @@
 
 #include "CxxMessageQueue.h"
 
-#include <folly/AtomicIntrusiveLinkedList.h>
-
+#include <algorithm>
+#include <array>
 #include <mutex>
-#include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -26,90 +26,243 @@ time_point now() {
   return clock::now();
 }
 
-class Task {
+struct Task {
+  std::function<void()> func;
+  // This flag is just to mark that the task is expected to be synchronous. If
+  // a synchronous task races with stopping the queue, the thread waiting on
+  // the synchronous task might never resume. We use this flag to detect this
+  // case and throw an error.
+  bool sync{false};
+  // The default time_point() is used for tasks that are not delayed.
+  time_point startTime{};
+};
+
+// A bounded multi-producer single-consumer ring of tasks stored in place.
+// Each slot has a sequence number that tells whether it is free for the
+// producer at the same position or ready for the consumer.
+//
+// When the ring is full, producers append tasks to an overflow list under a
+// mutex. While the overflow list is in use, all producers go to it, and the
+// consumer only takes it once every ring slot claimed before it was consumed,
+// so the tasks posted by each thread still run in their posting order.
+class TaskQueue {
  public:
-  static Task *create(std::function<void()> &&func) {
-    return new Task{std::move(func), false, time_point()};
-  }
+  static constexpr size_t kRingCapacity = 256;
+  static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "The ring capacity must be a power of two.");
 
-  static Task *createSync(std::function<void()> &&func) {
-    return new Task{std::move(func), true, time_point()};
+  TaskQueue() {
+    for (size_t i = 0; i < kRingCapacity; ++i) {
+      ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
   }
 
-  static Task *createDelayed(std::function<void()> &&func, time_point startTime) {
-    return new Task{std::move(func), false, startTime};
+  void push(Task &&task) {
+    if (!overflowing_.load(std::memory_order_acquire) && tryPushToRing(task)) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(overflowMutex_);
+    overflow_.push_back(std::move(task));
+    overflowing_.store(true, std::memory_order_release);
   }
 
-  std::function<void()> func;
-  // This flag is just to mark that the task is expected to be synchronous. If
-  // a synchronous task races with stopping the queue, the thread waiting on
-  // the synchronous task might never resume. We use this flag to detect this
-  // case and throw an error.
-  bool sync;
-  time_point startTime;
+  // Must only be called by the consumer.
+  bool tryPop(Task &task) {
+    if (overflowIndex_ < overflowTasks_.size()) {
+      // The tasks taken from the overflow list run before the tasks posted to
+      // the ring after them.
+      task = std::move(overflowTasks_[overflowIndex_++]);
+      if (overflowIndex_ == overflowTasks_.size()) {
+        overflowTasks_.clear();
+        overflowIndex_ = 0;
+      }
+      return true;
+    }
 
-  folly::AtomicIntrusiveLinkedListHook<Task> hook;
+    if (tryPopFromRing(task)) {
+      return true;
+    }
 
-  // Should this sort consider id also?
-  struct Compare {
-    bool operator()(const Task *a, const Task *b) {
-      return a->startTime > b->startTime;
+    if (overflowing_.load(std::memory_order_acquire)) {
+      // The ring may look empty because a producer claimed a slot and did not
+      // publish its task yet. The tasks of the claimed slots were posted before
+      // the overflow list, so they run first and the caller tries again later.
+      if (dequeuePos_ != enqueuePos_.load(std::memory_order_acquire)) {
+        return false;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        std::swap(overflow_, overflowTasks_);
+        overflowing_.store(false, std::memory_order_release);
+      }
+      return tryPop(task);
     }
+
+    return false;
+  }
+
+  // Must only be called by the consumer.
+  bool empty() const {
+    return overflowIndex_ == overflowTasks_.size() &&
+        ring_[dequeuePos_ & (kRingCapacity - 1)].sequence.load(std::memory_order_acquire) != dequeuePos_ + 1 &&
+        !overflowing_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    Task task;
   };
+
+  bool tryPushToRing(Task &task) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = ring_[pos & (kRingCapacity - 1)];
+      size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.task = std::move(task);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // The ring is full.
+      } else {
+        pos = enqueuePos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool tryPopFromRing(Task &task) {
+    Slot &slot = ring_[dequeuePos_ & (kRingCapacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+      return false;
+    }
+
+    task = std::move(slot.task);
+    slot.task.func = nullptr;
+    slot.sequence.store(dequeuePos_ + kRingCapacity, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+  }
+
+  std::array<Slot, kRingCapacity> ring_;
+  alignas(64) std::atomic<size_t> enqueuePos_{0};
+  alignas(64) size_t dequeuePos_{0};
+
+  std::atomic_bool overflowing_{false};
+  std::mutex overflowMutex_;
+  std::vector<Task> overflow_;
+  // Consumer side copy of the overflow list.
+  std::vector<Task> overflowTasks_;
+  size_t overflowIndex_{0};
 };
 
+// A 4-ary min-heap of delayed tasks. Tasks with the same start time run in the
+// order they were delayed.
 class DelayedTaskQueue {
  public:
-  ~DelayedTaskQueue() {
-    while (!queue_.empty()) {
-      delete queue_.top();
-      queue_.pop();
+  // Runs the tasks that are due at currentTime.
+  void process(time_point currentTime) {
+    while (!heap_.empty() && heap_.front().startTime <= currentTime) {
+      auto func = std::move(heap_.front().func);
+      pop();
+      func();
+    }
+  }
+
+  void push(std::function<void()> &&func, time_point startTime) {
+    heap_.push_back(Entry{startTime, nextSequence_++, std::move(func)});
+    siftUp(heap_.size() - 1);
+  }
+
+  bool empty() const {
+    return heap_.empty();
+  }
+
+  time_point nextTime() const {
+    return heap_.front().startTime;
+  }
+
+ private:
+  static constexpr size_t kArity = 4;
+
+  struct Entry {
+    time_point startTime;
+    uint64_t sequence;
+    std::function<void()> func;
+  };
+
+  static bool isEarlier(const Entry &a, const Entry &b) {
+    return a.startTime < b.startTime || (a.startTime == b.startTime && a.sequence < b.sequence);
+  }
+
+  void pop() {
+    if (heap_.size() > 1) {
+      heap_.front() = std::move(heap_.back());
+      heap_.pop_back();
+      siftDown(0);
+    } else {
+      heap_.pop_back();
     }
   }
 
-  void process() {
-    while (!queue_.empty()) {
-      Task *d = queue_.top();
-      if (now() < d->startTime) {
+  void siftUp(size_t index) {
+    Entry entry = std::move(heap_[index]);
+    while (index > 0) {
+      size_t parent = (index - 1) / kArity;
+      if (!isEarlier(entry, heap_[parent])) {
         break;
       }
-      auto owned = std::unique_ptr<Task>(queue_.top());
-      queue_.pop();
-      owned->func();
+      heap_[index] = std::move(heap_[parent]);
+      index = parent;
     }
+    heap_[index] = std::move(entry);
   }
 
-  void push(Task *t) {
-    queue_.push(t);
-  }
+  void siftDown(size_t index) {
+    Entry entry = std::move(heap_[index]);
+    const size_t size = heap_.size();
+    for (;;) {
+      size_t firstChild = index * kArity + 1;
+      if (firstChild >= size) {
+        break;
+      }
 
-  bool empty() {
-    return queue_.empty();
-  }
+      size_t earliestChild = firstChild;
+      size_t lastChild = std::min(firstChild + kArity, size);
+      for (size_t child = firstChild + 1; child < lastChild; ++child) {
+        if (isEarlier(heap_[child], heap_[earliestChild])) {
+          earliestChild = child;
+        }
+      }
 
-  time_point nextTime() {
-    return queue_.top()->startTime;
+      if (!isEarlier(heap_[earliestChild], entry)) {
+        break;
+      }
+      heap_[index] = std::move(heap_[earliestChild]);
+      index = earliestChild;
+    }
+    heap_[index] = std::move(entry);
   }
 
- private:
-  std::priority_queue<Task *, std::vector<Task *>, Task::Compare> queue_;
+  std::vector<Entry> heap_;
+  uint64_t nextSequence_{0};
 };
 
 } // namespace
 
 class CxxMessageQueue::QueueRunner {
  public:
-  ~QueueRunner() {
-    queue_.sweep([](Task *t) { delete t; });
-  }
-
   void enqueue(std::function<void()> &&func) {
-    enqueueTask(Task::create(std::move(func)));
+    enqueueTask(Task{std::move(func)});
   }
 
   void enqueueDelayed(std::function<void()> &&func, uint64_t delayMs) {
     if (delayMs) {
-      enqueueTask(Task::createDelayed(std::move(func), now() + std::chrono::milliseconds(delayMs)));
+      enqueueTask(Task{std::move(func), false, now() + std::chrono::milliseconds(delayMs)});
     } else {
       enqueue(std::move(func));
     }
@@ -117,10 +270,12 @@ class CxxMessageQueue::QueueRunner {
 
   void enqueueSync(std::function<void()> &&func) {
     EventFlag done;
-    enqueueTask(Task::createSync([&]() mutable {
-      func();
-      done.set();
-    }));
+    enqueueTask(Task{
+        [&]() mutable {
+          func();
+          done.set();
+        },
+        true});
     if (stopped_) {
       // If this queue is stopped_, the sync task might never actually run.
       throw std::runtime_error("Stopped within enqueueSync.");
@@ -152,11 +307,19 @@ class CxxMessageQueue::QueueRunner {
     // matter reading stopped_.
     while (!stopped_.load(std::memory_order_relaxed)) {
       sweep();
-      if (delayed_.empty()) {
-        pending_.wait();
-      } else {
-        pending_.wait_until(delayed_.nextTime());
+
+      // Producers only signal pending_ while we are sleeping. The fences make
+      // sure that either we see their task or they see that we are sleeping.
+      sleeping_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (queue_.empty()) {
+        if (delayed_.empty()) {
+          pending_.wait();
+        } else {
+          pending_.wait_until(delayed_.nextTime());
+        }
       }
+      sleeping_.store(false, std::memory_order_relaxed);
     }
     // This sweep is just to catch erroneous enqueueSync. That is, there could
     // be a task marked sync that another thread is waiting for, but we'll
@@ -169,26 +332,30 @@ class CxxMessageQueue::QueueRunner {
   // tasks (delayed_). Delayed tasks first go into posted tasks, and then are
   // moved to the delayed queue if we pop them before the time they are
   // scheduled for.
-  // As we pop things from queue_, before dealing with that thing, we run any
-  // delayed tasks whose scheduled time has arrived.
+  // The clock is read once per sweep: the delayed tasks due at that time run
+  // first, and then up to one ring of posted tasks runs.
   void sweep() {
-    queue_.sweep([this](Task *t) {
-      std::unique_ptr<Task> owned(t);
+    const time_point currentTime = now();
+    if (!stopped_.load(std::memory_order_relaxed)) {
+      delayed_.process(currentTime);
+    }
+
+    Task task;
+    for (size_t count = 0; count < TaskQueue::kRingCapacity && queue_.tryPop(task); ++count) {
+      auto func = std::move(task.func);
       if (stopped_.load(std::memory_order_relaxed)) {
-        if (t->sync) {
+        if (task.sync) {
           throw std::runtime_error("Sync task posted while stopped.");
         }
-        return;
+        continue;
       }
 
-      delayed_.process();
-      if (t->startTime != time_point() && now() <= t->startTime) {
-        delayed_.push(owned.release());
+      if (task.startTime != time_point() && currentTime < task.startTime) {
+        delayed_.push(std::move(func), task.startTime);
       } else {
-        t->func();
+        func();
       }
-    });
-    delayed_.process();
+    }
   }
 
   void bindToThisThread() {
@@ -203,15 +370,18 @@ class CxxMessageQueue::QueueRunner {
   }
 
  private:
-  void enqueueTask(Task *task) {
-    if (queue_.insertHead(task)) {
+  void enqueueTask(Task &&task) {
+    queue_.push(std::move(task));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) && sleeping_.exchange(false)) {
       pending_.set();
     }
   }
 
   std::thread::id tid_;
 
-  folly::AtomicIntrusiveLinkedList<Task, &Task::hook> queue_;
+  TaskQueue queue_;
+  std::atomic_bool sleeping_{false};
 
   std::atomic_bool stopped_{false};
   DelayedTaskQueue delayed_;
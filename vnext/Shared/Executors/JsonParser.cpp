@@ -0,0 +1,613 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "JsonParser.h"
+
+#include <folly/json.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define JSONPARSER_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+#define JSONPARSER_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Microsoft::React {
+
+namespace {
+
+// Nesting deeper than that is left to folly::parseJson, which enforces its own recursion limit.
+constexpr uint32_t MaxDepth = 64;
+
+constexpr size_t BlockSize = 64;
+
+// The largest structural index kept from one parse to the next, in entries (1 MB).
+constexpr size_t MaxRetainedIndexSize = 256 * 1024;
+
+//=============================================================================
+// Stage 1: structural index
+//=============================================================================
+
+// Bit i of each mask is set when byte i of the block is of the given class.
+struct BlockMasks {
+  uint64_t Backslash;
+  uint64_t Quote;
+  uint64_t Operator; // { } [ ] : ,
+  uint64_t Whitespace;
+};
+
+#if JSONPARSER_USE_SSE2
+
+void ClassifyBlock(const uint8_t *block, BlockMasks &masks) noexcept {
+  masks = {};
+  for (size_t i = 0; i < BlockSize / 16; ++i) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+    const auto isEqual = [&chunk](char c) noexcept { return _mm_cmpeq_epi8(chunk, _mm_set1_epi8(c)); };
+    const auto toMask = [i](__m128i bytes) noexcept {
+      return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(bytes))) << (16 * i);
+    };
+
+    const __m128i brackets =
+        _mm_or_si128(_mm_or_si128(isEqual('{'), isEqual('}')), _mm_or_si128(isEqual('['), isEqual(']')));
+    const __m128i whitespace =
+        _mm_or_si128(_mm_or_si128(isEqual(' '), isEqual('\t')), _mm_or_si128(isEqual('\n'), isEqual('\r')));
+
+    masks.Backslash |= toMask(isEqual('\\'));
+    masks.Quote |= toMask(isEqual('"'));
+    masks.Operator |= toMask(_mm_or_si128(brackets, _mm_or_si128(isEqual(':'), isEqual(','))));
+    masks.Whitespace |= toMask(whitespace);
+  }
+}
+
+#elif JSONPARSER_USE_NEON
+
+// NEON has no movemask: give each byte lane its own bit and add the lanes pairwise.
+uint64_t MoveMask64(uint8x16_t v0, uint8x16_t v1, uint8x16_t v2, uint8x16_t v3) noexcept {
+  static const uint8_t s_bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t bits = vld1q_u8(s_bits);
+  uint8x16_t sum0 = vpaddq_u8(vandq_u8(v0, bits), vandq_u8(v1, bits));
+  uint8x16_t sum1 = vpaddq_u8(vandq_u8(v2, bits), vandq_u8(v3, bits));
+  sum0 = vpaddq_u8(sum0, sum1);
+  sum0 = vpaddq_u8(sum0, sum0);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+void ClassifyBlock(const uint8_t *block, BlockMasks &masks) noexcept {
+  uint8x16_t backslash[4], quote[4], op[4], whitespace[4];
+  for (size_t i = 0; i < BlockSize / 16; ++i) {
+    const uint8x16_t chunk = vld1q_u8(block + 16 * i);
+    const auto isEqual = [&chunk](uint8_t c) noexcept { return vceqq_u8(chunk, vdupq_n_u8(c)); };
+
+    backslash[i] = isEqual('\\');
+    quote[i] = isEqual('"');
+    op[i] = vorrq_u8(
+        vorrq_u8(vorrq_u8(isEqual('{'), isEqual('}')), vorrq_u8(isEqual('['), isEqual(']'))),
+        vorrq_u8(isEqual(':'), isEqual(',')));
+    whitespace[i] = vorrq_u8(vorrq_u8(isEqual(' '), isEqual('\t')), vorrq_u8(isEqual('\n'), isEqual('\r')));
+  }
+
+  masks.Backslash = MoveMask64(backslash[0], backslash[1], backslash[2], backslash[3]);
+  masks.Quote = MoveMask64(quote[0], quote[1], quote[2], quote[3]);
+  masks.Operator = MoveMask64(op[0], op[1], op[2], op[3]);
+  masks.Whitespace = MoveMask64(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+}
+
+#else
+
+void ClassifyBlock(const uint8_t *block, BlockMasks &masks) noexcept {
+  masks = {};
+  for (size_t i = 0; i < BlockSize; ++i) {
+    const uint64_t bit = 1ull << i;
+    switch (block[i]) {
+      case '\\':
+        masks.Backslash |= bit;
+        break;
+      case '"':
+        masks.Quote |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+        masks.Operator |= bit;
+        break;
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        masks.Whitespace |= bit;
+        break;
+    }
+  }
+}
+
+#endif
+
+uint32_t CountTrailingZeros(uint64_t value) noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return index;
+#elif defined(_MSC_VER)
+  unsigned long index;
+  if (_BitScanForward(&index, static_cast<uint32_t>(value))) {
+    return index;
+  }
+
+  _BitScanForward(&index, static_cast<uint32_t>(value >> 32));
+  return index + 32;
+#else
+  return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+}
+
+// Bit i of the result is the XOR of bits 0..i of the value.
+uint64_t PrefixXor(uint64_t value) noexcept {
+  value ^= value << 1;
+  value ^= value << 2;
+  value ^= value << 4;
+  value ^= value << 8;
+  value ^= value << 16;
+  value ^= value << 32;
+  return value;
+}
+
+// Returns the mask of the characters that follow an unescaped backslash.
+// isPrevEscaped carries the state between blocks: it is 1 when the first
+// character of the next block is escaped.
+uint64_t FindEscaped(uint64_t backslash, uint64_t &isPrevEscaped) noexcept {
+  uint64_t escaped = isPrevEscaped;
+  backslash &= ~isPrevEscaped;
+  isPrevEscaped = 0;
+
+  // Backslashes are rare in the bridge payloads, so a loop over them is fast enough.
+  while (backslash) {
+    const uint32_t i = CountTrailingZeros(backslash);
+    if (i == BlockSize - 1) {
+      isPrevEscaped = 1;
+      break;
+    }
+
+    escaped |= 1ull << (i + 1);
+    backslash &= ~(3ull << i);
+  }
+
+  return escaped;
+}
+
+// Fills the index with the positions of the operators outside of the strings,
+// of the opening quotes, and of the first characters of numbers and literals.
+bool BuildStructuralIndex(std::string_view text, std::vector<uint32_t> &index) {
+  if (text.size() >= UINT32_MAX) {
+    return false;
+  }
+
+  // The index grows with the number of structural characters rather than with the text size.
+  size_t count = 0;
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(text.data());
+  uint64_t isPrevEscaped = 0;
+  uint64_t prevInString = 0;
+  uint64_t prevScalar = 0;
+  for (size_t base = 0; base < text.size(); base += BlockSize) {
+    const uint8_t *block = data + base;
+    uint8_t paddedBlock[BlockSize];
+    if (text.size() - base < BlockSize) {
+      std::memset(paddedBlock, ' ', BlockSize);
+      std::memcpy(paddedBlock, block, text.size() - base);
+      block = paddedBlock;
+    }
+
+    BlockMasks masks;
+    ClassifyBlock(block, masks);
+
+    const uint64_t escaped = (masks.Backslash | isPrevEscaped) ? FindEscaped(masks.Backslash, isPrevEscaped) : 0;
+    const uint64_t quote = masks.Quote & ~escaped;
+
+    // The bits of the string characters, including the opening quote but not the closing one.
+    const uint64_t inString = PrefixXor(quote) ^ prevInString;
+    prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+    const uint64_t scalar = ~(masks.Operator | masks.Whitespace | masks.Quote) & ~inString;
+    const uint64_t scalarStart = scalar & ~((scalar << 1) | prevScalar);
+    prevScalar = scalar >> 63;
+
+    uint64_t structurals = (masks.Operator & ~inString) | (quote & inString) | scalarStart;
+    if (index.size() - count < BlockSize) {
+      // A block adds at most BlockSize positions.
+      index.resize((std::max)(index.size() * 2, count + BlockSize));
+    }
+
+    uint32_t *out = index.data() + count;
+    while (structurals) {
+      *out++ = static_cast<uint32_t>(base + CountTrailingZeros(structurals));
+      structurals &= structurals - 1;
+    }
+
+    count = out - index.data();
+  }
+
+  index.resize(count);
+
+  // An unterminated string.
+  return prevInString == 0;
+}
+
+//=============================================================================
+// Stage 2: folly::dynamic builder
+//=============================================================================
+
+bool IsDigit(char c) noexcept {
+  return c >= '0' && c <= '9';
+}
+
+int HexDigitValue(char c) noexcept {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+
+  return -1;
+}
+
+void AppendUtf8(std::string &result, uint32_t codePoint) {
+  if (codePoint < 0x80) {
+    result += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    result += static_cast<char>(0xC0 | (codePoint >> 6));
+    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    result += static_cast<char>(0xE0 | (codePoint >> 12));
+    result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    result += static_cast<char>(0xF0 | (codePoint >> 18));
+    result += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+class DynamicBuilder {
+ public:
+  DynamicBuilder(std::string_view text, const std::vector<uint32_t> &index) noexcept
+      : m_text{text}, m_next{index.data()}, m_end{index.data() + index.size()} {}
+
+  bool Build(folly::dynamic &result) {
+    size_t position;
+    return NextToken(position) && ParseValue(position, result, 0) && m_next == m_end;
+  }
+
+ private:
+  bool NextToken(size_t &position) noexcept {
+    if (m_next == m_end) {
+      return false;
+    }
+
+    position = *m_next++;
+    return true;
+  }
+
+  char PeekToken() const noexcept {
+    return m_next != m_end ? m_text[*m_next] : '\0';
+  }
+
+  bool ParseValue(size_t position, folly::dynamic &result, uint32_t depth) {
+    switch (m_text[position]) {
+      case '{':
+        return depth < MaxDepth && ParseObject(result, depth + 1);
+      case '[':
+        return depth < MaxDepth && ParseArray(result, depth + 1);
+      case '"': {
+        std::string value;
+        if (!ParseString(position, value)) {
+          return false;
+        }
+
+        result = std::move(value);
+        return true;
+      }
+      case 't':
+        result = true;
+        return ParseLiteral(position, "true");
+      case 'f':
+        result = false;
+        return ParseLiteral(position, "false");
+      case 'n':
+        result = nullptr;
+        return ParseLiteral(position, "null");
+      default:
+        return ParseNumber(position, result);
+    }
+  }
+
+  bool ParseObject(folly::dynamic &result, uint32_t depth) {
+    result = folly::dynamic::object;
+    size_t position;
+    if (PeekToken() == '}') {
+      ++m_next;
+      return true;
+    }
+
+    do {
+      std::string key;
+      folly::dynamic value;
+      if (!NextToken(position) || m_text[position] != '"' || !ParseString(position, key) || !NextToken(position) ||
+          m_text[position] != ':' || !NextToken(position) || !ParseValue(position, value, depth)) {
+        return false;
+      }
+
+      // Like folly::parseJson, the last value of a duplicate key wins.
+      result.insert(std::move(key), std::move(value));
+    } while (NextToken(position) && m_text[position] == ',');
+
+    return m_text[position] == '}';
+  }
+
+  bool ParseArray(folly::dynamic &result, uint32_t depth) {
+    result = folly::dynamic::array;
+    size_t position;
+    if (PeekToken() == ']') {
+      ++m_next;
+      return true;
+    }
+
+    do {
+      folly::dynamic value;
+      if (!NextToken(position) || !ParseValue(position, value, depth)) {
+        return false;
+      }
+
+      result.push_back(std::move(value));
+    } while (NextToken(position) && m_text[position] == ',');
+
+    return m_text[position] == ']';
+  }
+
+  bool ParseString(size_t position, std::string &result) {
+    const char *current = m_text.data() + position + 1;
+    const char *end = m_text.data() + m_text.size();
+
+    const char *start = current;
+    while (current != end && *current != '"' && *current != '\\' && static_cast<uint8_t>(*current) >= 0x20) {
+      ++current;
+    }
+
+    result.assign(start, current);
+    while (current != end) {
+      const char c = *current++;
+      if (c == '"') {
+        return true;
+      } else if (static_cast<uint8_t>(c) < 0x20) {
+        return false;
+      } else if (c != '\\') {
+        result += c;
+        continue;
+      }
+
+      if (current == end) {
+        return false;
+      }
+
+      switch (*current++) {
+        case '"':
+          result += '"';
+          break;
+        case '\\':
+          result += '\\';
+          break;
+        case '/':
+          result += '/';
+          break;
+        case 'b':
+          result += '\b';
+          break;
+        case 'f':
+          result += '\f';
+          break;
+        case 'n':
+          result += '\n';
+          break;
+        case 'r':
+          result += '\r';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'u': {
+          uint32_t codePoint;
+          if (!ParseHex4(current, end, codePoint)) {
+            return false;
+          }
+
+          if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+            uint32_t low;
+            if (end - current < 2 || current[0] != '\\' || current[1] != 'u') {
+              return false;
+            }
+
+            current += 2;
+            if (!ParseHex4(current, end, low) || low < 0xDC00 || low > 0xDFFF) {
+              return false;
+            }
+
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+          } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+            return false;
+          }
+
+          AppendUtf8(result, codePoint);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+
+    return false;
+  }
+
+  static bool ParseHex4(const char *&current, const char *end, uint32_t &value) noexcept {
+    if (end - current < 4) {
+      return false;
+    }
+
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+      const int digit = HexDigitValue(*current++);
+      if (digit < 0) {
+        return false;
+      }
+
+      value = (value << 4) | static_cast<uint32_t>(digit);
+    }
+
+    return true;
+  }
+
+  bool ParseLiteral(size_t position, std::string_view literal) const noexcept {
+    return m_text.compare(position, literal.size(), literal) == 0 && IsValueEnd(position + literal.size());
+  }
+
+  // Numbers and literals must be followed by whitespace, an operator, or the end of the text.
+  bool IsValueEnd(size_t position) const noexcept {
+    if (position == m_text.size()) {
+      return true;
+    }
+
+    switch (m_text[position]) {
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+      case ',':
+      case ':':
+      case ']':
+      case '}':
+      case '[':
+      case '{':
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool ParseNumber(size_t position, folly::dynamic &result) const {
+    const char *start = m_text.data() + position;
+    const char *end = m_text.data() + m_text.size();
+    const char *current = start;
+    bool isInteger = true;
+
+    if (current != end && *current == '-') {
+      ++current;
+    }
+
+    // Leading zeros are left to folly::parseJson.
+    if (current == end || !IsDigit(*current) ||
+        (*current == '0' && current + 1 != end && IsDigit(current[1]))) {
+      return false;
+    }
+
+    while (current != end && IsDigit(*current)) {
+      ++current;
+    }
+
+    if (current != end && *current == '.') {
+      isInteger = false;
+      if (++current == end || !IsDigit(*current)) {
+        return false;
+      }
+
+      while (current != end && IsDigit(*current)) {
+        ++current;
+      }
+    }
+
+    if (current != end && (*current == 'e' || *current == 'E')) {
+      isInteger = false;
+      if (++current != end && (*current == '+' || *current == '-')) {
+        ++current;
+      }
+
+      if (current == end || !IsDigit(*current)) {
+        return false;
+      }
+
+      while (current != end && IsDigit(*current)) {
+        ++current;
+      }
+    }
+
+    if (!IsValueEnd(current - m_text.data())) {
+      return false;
+    }
+
+    if (isInteger) {
+      int64_t value;
+      if (std::from_chars(start, current, value).ec != std::errc{}) {
+        // Integer overflow: folly::parseJson reports the error.
+        return false;
+      }
+
+      result = value;
+      return true;
+    }
+
+    double value;
+    if (std::from_chars(start, current, value).ec != std::errc{}) {
+      return false;
+    }
+
+    result = value;
+    return true;
+  }
+
+ private:
+  const std::string_view m_text;
+  const uint32_t *m_next;
+  const uint32_t *const m_end;
+};
+
+} // namespace
+
+bool TryParseJsonFast(std::string_view text, folly::dynamic &result) {
+  // The bridge flushes are parsed on the JS thread one after another: keep the index
+  // allocation from one call to the next, unless a large payload made it grow past the cap.
+  thread_local std::vector<uint32_t> tl_index;
+  const bool isParsed = BuildStructuralIndex(text, tl_index) && DynamicBuilder{text, tl_index}.Build(result);
+  if (tl_index.capacity() > MaxRetainedIndexSize) {
+    std::vector<uint32_t>().swap(tl_index);
+  }
+
+  return isParsed;
+}
+
+folly::dynamic ParseJson(std::string_view text) {
+  folly::dynamic result;
+  if (TryParseJsonFast(text, result)) {
+    return result;
+  }
+
+  return folly::parseJson(folly::StringPiece{text.data(), text.size()});
+}
+
+} // namespace Microsoft::React
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <folly/dynamic.h>
+#include <string_view>
+
+namespace Microsoft::React {
+
+// JSON parser for the bridge payloads: the flushed message queues and the
+// replies of the remote debugger.
+//
+// It works in two stages, like simdjson. The first stage classifies 64-byte
+// blocks of the text with SSE2 on x86 and x64, NEON on ARM64, or a scalar loop
+// elsewhere, and builds an index of the structural characters and of the
+// starts of the scalar values. The second stage walks that index to build the
+// folly::dynamic without looking at the whitespace between the tokens.
+//
+// ParseJson returns the same value and throws the same errors as
+// folly::parseJson with the default options: the text that the fast path does
+// not accept (invalid JSON, integers that overflow int64_t, deep nesting,
+// unpaired surrogates, control characters in strings) is parsed again with
+// folly::parseJson.
+folly::dynamic ParseJson(std::string_view text);
+
+// The fast path of ParseJson. Returns false without throwing for the text that
+// it does not accept.
+bool TryParseJsonFast(std::string_view text, folly::dynamic &result);
+
+} // namespace Microsoft::React
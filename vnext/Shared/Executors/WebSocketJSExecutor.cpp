@@ -5,6 +5,7 @@
 
 #include <cxxreact/JSBigString.h>
 #include <cxxreact/RAMBundleRegistry.h>
+#include "JsonParser.h"
 #include "WebSocketJSExecutor.h"
 
 #include <folly/dynamic.h>
@@ -109,7 +110,7 @@ void WebSocketJSExecutor::flush() {
   folly::dynamic jarray = folly::dynamic::array();
   auto calls = Call("flushedQueue", jarray);
   if (m_delegate && !IsInError())
-    m_delegate->callNativeModules(*this, folly::parseJson(std::move(calls)), true);
+    m_delegate->callNativeModules(*this, Microsoft::React::ParseJson(calls), true);
 }
 
 void WebSocketJSExecutor::callFunction(
@@ -119,14 +120,14 @@ void WebSocketJSExecutor::callFunction(
   folly::dynamic jarray = folly::dynamic::array(moduleId, methodId, arguments);
   auto calls = Call("callFunctionReturnFlushedQueue", jarray);
   if (m_delegate && !IsInError())
-    m_delegate->callNativeModules(*this, folly::parseJson(std::move(calls)), true);
+    m_delegate->callNativeModules(*this, Microsoft::React::ParseJson(calls), true);
 }
 
 void WebSocketJSExecutor::invokeCallback(const double callbackId, const folly::dynamic &arguments) {
   folly::dynamic jarray = folly::dynamic::array(callbackId, arguments);
   auto calls = Call("invokeCallbackAndReturnFlushedQueue", jarray);
   if (m_delegate && !IsInError())
-    m_delegate->callNativeModules(*this, folly::parseJson(std::move(calls)), true);
+    m_delegate->callNativeModules(*this, Microsoft::React::ParseJson(calls), true);
 }
 
 void WebSocketJSExecutor::setGlobalVariable(
@@ -266,7 +267,7 @@ std::future<std::string> WebSocketJSExecutor::SendMessageAsync(int requestId, co
 }
 
 void WebSocketJSExecutor::OnMessageReceived(const std::string &msg) {
-  folly::dynamic parsed = folly::parseJson(msg);
+  folly::dynamic parsed = Microsoft::React::ParseJson(msg);
   auto it_parsed = parsed.find("replyID");
   if (it_parsed != parsed.items().end()) {
     int replyId = it_parsed->second.asInt();
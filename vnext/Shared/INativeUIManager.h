@@ -13,6 +13,7 @@ namespace react {
 struct IReactRootView;
 class IUIManager;
 class IViewManager;
+struct ChildrenSplice;
 struct ShadowNode;
 
 struct INativeUIManagerHost {
@@ -46,6 +47,11 @@ struct INativeUIManager {
       facebook::react::ShadowNode &parentShadowNode,
       facebook::react::ShadowNode &childShadowNode,
       uint64_t index) = 0;
+  // Called once per UIManager::manageChildren call after the children of the
+  // parent shadow node were changed.
+  virtual void SpliceChildren(
+      facebook::react::ShadowNode &parentShadowNode,
+      const facebook::react::ChildrenSplice &splice) = 0;
   virtual void RemoveView(facebook::react::ShadowNode &shadowNode, bool removeChildren = true) = 0;
   virtual void ReplaceView(facebook::react::ShadowNode &shadowNode) = 0;
   virtual void UpdateView(facebook::react::ShadowNode &shadowNode, folly::dynamic /*ReadableMap*/ props) = 0;
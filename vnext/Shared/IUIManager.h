@@ -8,6 +8,7 @@
 #include <folly/dynamic.h>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace facebook {
 namespace react {
@@ -28,6 +29,7 @@ class IUIManager {
 
   virtual folly::dynamic getConstantsForViewManager(const std::string &viewManager) = 0;
   virtual void populateViewManagerConstants(std::map<std::string, folly::dynamic> &constants) = 0;
+  virtual std::vector<std::string> getViewManagerNames() = 0;
   virtual void createView(int64_t tag, std::string &&className, int64_t rootViewTag, folly::dynamic &&props) = 0;
   virtual void configureNextLayoutAnimation(
       folly::dynamic &&config,
@@ -72,9 +74,13 @@ std::shared_ptr<IUIManager> createIUIManager(
     std::vector<std::unique_ptr<IViewManager>> &&viewManagers,
     INativeUIManager *nativeManager);
 
+// When lazyViewManagerConstants is true the module only reports the view manager names in its constants,
+// and JS requests the constants of each view manager on first use through getConstantsForViewManager.
+// It must be false when JS cannot make synchronous calls to native modules (e.g. web debugging).
 std::unique_ptr<facebook::xplat::module::CxxModule> createUIManagerModule(
     std::shared_ptr<IUIManager> &&uimanager,
-    std::shared_ptr<MessageQueueThread> &&uiQueue) noexcept;
+    std::shared_ptr<MessageQueueThread> &&uiQueue,
+    bool lazyViewManagerConstants = false) noexcept;
 
 // Deprecated: use the overloaded version with two parameters.
 // It is here because it is being exported
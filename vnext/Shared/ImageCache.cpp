@@ -0,0 +1,506 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include "ImageCache.h"
+
+#include <bcrypt.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace Microsoft::React {
+
+namespace {
+
+constexpr char IndexFileHeader[] = "ImageCache 3";
+
+// Returns the SHA-256 provider. It is opened once and shared by all threads.
+BCRYPT_ALG_HANDLE Sha256Algorithm() {
+  static const BCRYPT_ALG_HANDLE s_algorithm = []() noexcept {
+    BCRYPT_ALG_HANDLE algorithm = nullptr;
+    return BCRYPT_SUCCESS(::BCryptOpenAlgorithmProvider(&algorithm, BCRYPT_SHA256_ALGORITHM, nullptr, 0))
+        ? algorithm
+        : nullptr;
+  }();
+
+  if (!s_algorithm) {
+    throw std::runtime_error("Cannot open the SHA-256 algorithm provider");
+  }
+
+  return s_algorithm;
+}
+
+std::string Sha256Hex(const std::string &value) {
+  std::array<uint8_t, 32> digest;
+  if (!BCRYPT_SUCCESS(::BCryptHash(
+          Sha256Algorithm(),
+          nullptr,
+          0,
+          reinterpret_cast<PUCHAR>(const_cast<char *>(value.data())),
+          static_cast<ULONG>(value.size()),
+          digest.data(),
+          static_cast<ULONG>(digest.size())))) {
+    throw std::runtime_error("Cannot compute the SHA-256 hash");
+  }
+
+  char hex[65];
+  for (size_t i = 0; i < digest.size(); ++i) {
+    std::snprintf(hex + i * 2, 3, "%02x", digest[i]);
+  }
+
+  return std::string(hex, 64);
+}
+
+std::string Trim(const std::string &value) {
+  const auto first = value.find_first_not_of(" \t");
+  if (first == std::string::npos) {
+    return {};
+  }
+
+  return value.substr(first, value.find_last_not_of(" \t") - first + 1);
+}
+
+std::string ToLower(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
+    return static_cast<char>(std::tolower(ch));
+  });
+  return value;
+}
+
+// Writes the file next to its final path and renames it, so that readers never see a partial file.
+bool WriteFileAtomically(const fs::path &path, const std::string &content) {
+  static std::atomic<uint64_t> s_tempFileIndex{0};
+  fs::path tempPath = path;
+  tempPath += ".tmp" + std::to_string(s_tempFileIndex++);
+  {
+    std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+    file.write(content.data(), content.size());
+    if (!file.flush()) {
+      file.close();
+      std::error_code ec;
+      fs::remove(tempPath, ec);
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  fs::rename(tempPath, path, ec);
+  if (ec) {
+    fs::remove(tempPath, ec);
+    return false;
+  }
+
+  return true;
+}
+
+std::optional<std::string> ReadFile(const fs::path &path) {
+  std::ifstream file{path, std::ios::binary};
+  if (!file) {
+    return std::nullopt;
+  }
+
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+} // namespace
+
+//=============================================================================
+// ImageCachePolicy implementation
+//=============================================================================
+
+/*static*/ ImageCachePolicy ImageCachePolicy::FromHeaders(const ImageHttpHeaders &headers) noexcept {
+  ImageCachePolicy policy;
+  auto cacheControl = headers.find("cache-control");
+  if (cacheControl != headers.end()) {
+    std::istringstream directives{ToLower(cacheControl->second)};
+    for (std::string directive; std::getline(directives, directive, ',');) {
+      directive = Trim(directive);
+      if (directive == "no-store") {
+        policy.NoStore = true;
+      } else if (directive == "no-cache") {
+        policy.NoCache = true;
+      } else if (directive == "public") {
+        policy.Public = true;
+      } else if (directive.rfind("max-age=", 0) == 0) {
+        char *end = nullptr;
+        const char *value = directive.c_str() + 8;
+        const long long seconds = std::strtoll(value, &end, 10);
+        if (end != value && *end == '\0' && seconds >= 0) {
+          policy.MaxAge = std::chrono::seconds{seconds};
+        }
+      }
+    }
+  }
+
+  auto etag = headers.find("etag");
+  if (etag != headers.end()) {
+    policy.ETag = etag->second;
+  }
+
+  return policy;
+}
+
+//=============================================================================
+// ImageDiskCache implementation
+//=============================================================================
+
+ImageDiskCache::ImageDiskCache(fs::path directory, uintmax_t byteBudget) noexcept
+    : m_directory{std::move(directory)}, m_byteBudget{byteBudget} {
+  std::error_code ec;
+  fs::create_directories(m_directory, ec);
+}
+
+/*static*/ std::string ImageDiskCache::ContentHash(const std::string &content) {
+  return Sha256Hex(content);
+}
+
+fs::path ImageDiskCache::IndexPath(const std::string &key) const {
+  return m_directory / (Sha256Hex(key) + ".index");
+}
+
+fs::path ImageDiskCache::ContentPath(const std::string &contentHash) const {
+  return m_directory / (contentHash + ".content");
+}
+
+/*static*/ std::optional<ImageDiskCache::IndexRecord> ImageDiskCache::ReadIndex(const fs::path &indexPath) {
+  // The index file has the header, the content hash, the content size, the expiration time and the ETag.
+  std::ifstream index{indexPath, std::ios::binary};
+  std::string header;
+  IndexRecord record{};
+  if (!std::getline(index, header) || header != IndexFileHeader || !std::getline(index, record.ContentHash) ||
+      record.ContentHash.size() != 64 || !(index >> record.ContentSize) || index.get() != '\n' ||
+      !(index >> record.Expires) || index.get() != '\n') {
+    return std::nullopt;
+  }
+
+  std::getline(index, record.ETag);
+  return record;
+}
+
+std::optional<ImageCacheEntry> ImageDiskCache::Read(const std::string &key) noexcept {
+  try {
+    const fs::path indexPath = IndexPath(key);
+    auto record = ReadIndex(indexPath);
+    if (!record) {
+      return std::nullopt;
+    }
+
+    // Content files are written atomically and named by their hash, so the size check only catches a file that
+    // was truncated outside of the cache.
+    auto content = ReadFile(ContentPath(record->ContentHash));
+    if (!content || content->size() != record->ContentSize) {
+      return std::nullopt;
+    }
+
+    std::error_code ec;
+    fs::last_write_time(indexPath, fs::file_time_type::clock::now(), ec);
+    return ImageCacheEntry{std::make_shared<const std::string>(std::move(*content)),
+                           std::move(record->ETag),
+                           std::chrono::system_clock::time_point{std::chrono::seconds{record->Expires}}};
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+}
+
+void ImageDiskCache::Write(const std::string &key, const ImageCacheEntry &entry) noexcept {
+  try {
+    std::scoped_lock lock{m_mutex};
+    const std::string contentHash = ContentHash(*entry.Body);
+    const fs::path contentPath = ContentPath(contentHash);
+    uintmax_t writtenSize = 0;
+    std::error_code ec;
+    if (!fs::exists(contentPath, ec)) {
+      if (!WriteFileAtomically(contentPath, *entry.Body)) {
+        return;
+      }
+
+      writtenSize += entry.Body->size();
+    }
+
+    std::ostringstream index;
+    index << IndexFileHeader << '\n'
+          << contentHash << '\n'
+          << entry.Body->size() << '\n'
+          << std::chrono::duration_cast<std::chrono::seconds>(entry.Expires.time_since_epoch()).count() << '\n'
+          << entry.ETag << '\n';
+    const std::string indexContent = index.str();
+    if (WriteFileAtomically(IndexPath(key), indexContent)) {
+      writtenSize += indexContent.size();
+    }
+
+    // The size of a replaced index file is counted again until the next pruning.
+    if (!m_byteSize || (*m_byteSize += writtenSize) > m_byteBudget) {
+      PruneLocked();
+    }
+  } catch (const std::exception &) {
+    // The entry is not cached on disk.
+  }
+}
+
+void ImageDiskCache::Prune() noexcept {
+  try {
+    std::scoped_lock lock{m_mutex};
+    PruneLocked();
+  } catch (const std::exception &) {
+    // The cache is pruned by the next write that goes over the budget.
+  }
+}
+
+void ImageDiskCache::PruneLocked() {
+  struct IndexFile {
+    fs::path Path;
+    fs::file_time_type LastUsed;
+    uintmax_t Size;
+    std::string ContentHash;
+  };
+
+  std::vector<IndexFile> indexFiles;
+  std::unordered_map<std::string, uintmax_t> contentSizes;
+  std::error_code ec;
+  for (const auto &file : fs::directory_iterator{m_directory}) {
+    if (!file.is_regular_file(ec)) {
+      continue;
+    }
+
+    const std::string extension = file.path().extension().string();
+    if (extension == ".index") {
+      if (auto record = ReadIndex(file.path())) {
+        indexFiles.push_back(
+            {file.path(), file.last_write_time(ec), file.file_size(ec), std::move(record->ContentHash)});
+      } else {
+        fs::remove(file.path(), ec);
+      }
+    } else if (extension == ".content") {
+      contentSizes.emplace(file.path().stem().string(), file.file_size(ec));
+    } else if (extension.rfind(".tmp", 0) == 0) {
+      // Writes hold the lock, so this is left from an interrupted write.
+      fs::remove(file.path(), ec);
+    }
+  }
+
+  // Content files that several indexes refer to are counted once.
+  uintmax_t totalSize = 0;
+  std::unordered_set<std::string> referencedContent;
+  for (const auto &indexFile : indexFiles) {
+    totalSize += indexFile.Size;
+    auto content = contentSizes.find(indexFile.ContentHash);
+    if (content != contentSizes.end() && referencedContent.insert(indexFile.ContentHash).second) {
+      totalSize += content->second;
+    }
+  }
+
+  // Keep the most recently used entries. Pruning below the budget leaves room for new entries.
+  std::sort(indexFiles.begin(), indexFiles.end(), [](const IndexFile &left, const IndexFile &right) {
+    return left.LastUsed > right.LastUsed;
+  });
+  const uintmax_t targetSize = totalSize > m_byteBudget ? m_byteBudget / 4 * 3 : m_byteBudget;
+  uintmax_t keptSize = 0;
+  bool isFull = false;
+  std::unordered_set<std::string> keptContent;
+  for (const auto &indexFile : indexFiles) {
+    auto content = contentSizes.find(indexFile.ContentHash);
+    if (content == contentSizes.end()) {
+      fs::remove(indexFile.Path, ec);
+      continue;
+    }
+
+    const uintmax_t entrySize = indexFile.Size + (keptContent.count(indexFile.ContentHash) ? 0 : content->second);
+    isFull = isFull || keptSize + entrySize > targetSize;
+    if (isFull) {
+      fs::remove(indexFile.Path, ec);
+      continue;
+    }
+
+    keptSize += entrySize;
+    keptContent.insert(indexFile.ContentHash);
+  }
+
+  for (const auto &[contentHash, contentSize] : contentSizes) {
+    if (keptContent.count(contentHash) == 0) {
+      fs::remove(ContentPath(contentHash), ec);
+    }
+  }
+
+  m_byteSize = keptSize;
+}
+
+//=============================================================================
+// ImageMemoryCache implementation
+//=============================================================================
+
+ImageMemoryCache::ImageMemoryCache(size_t byteBudget) noexcept : m_byteBudget{byteBudget} {}
+
+std::optional<ImageCacheEntry> ImageMemoryCache::Get(const std::string &key) noexcept {
+  auto it = m_entries.find(key);
+  if (it == m_entries.end()) {
+    return std::nullopt;
+  }
+
+  m_lruList.splice(m_lruList.begin(), m_lruList, it->second);
+  return it->second->second;
+}
+
+void ImageMemoryCache::Put(const std::string &key, const ImageCacheEntry &entry) noexcept {
+  auto it = m_entries.find(key);
+  if (it != m_entries.end()) {
+    m_byteSize -= it->second->second.Body->size();
+    m_lruList.erase(it->second);
+    m_entries.erase(it);
+  }
+
+  // An image larger than the budget would evict all other images.
+  if (entry.Body->size() > m_byteBudget) {
+    return;
+  }
+
+  m_lruList.emplace_front(key, entry);
+  m_entries.emplace(key, m_lruList.begin());
+  m_byteSize += entry.Body->size();
+  while (m_byteSize > m_byteBudget) {
+    auto &leastRecentlyUsed = m_lruList.back();
+    m_byteSize -= leastRecentlyUsed.second.Body->size();
+    m_entries.erase(leastRecentlyUsed.first);
+    m_lruList.pop_back();
+  }
+}
+
+//=============================================================================
+// ImageCache implementation
+//=============================================================================
+
+ImageCache::ImageCache(ImageHttpFetcher &&fetcher, ImageCacheOptions &&options) noexcept
+    : m_fetcher{std::move(fetcher)}, m_options{std::move(options)}, m_memoryCache{m_options.MemoryByteBudget} {
+  if (!m_options.DiskCachePath.empty()) {
+    m_diskCache.emplace(m_options.DiskCachePath, m_options.DiskByteBudget);
+  }
+}
+
+/*static*/ std::string ImageCache::MakeKey(const std::string &uri, const ImageHttpHeaders &headers) noexcept {
+  std::string key = uri;
+  for (const auto &[name, value] : headers) {
+    key.append("\n").append(name).append(":").append(value);
+  }
+
+  return key;
+}
+
+std::shared_ptr<const std::string> ImageCache::Get(const std::string &uri, const ImageHttpHeaders &headers) {
+  const std::string key = MakeKey(uri, headers);
+  std::optional<ImageCacheEntry> staleEntry;
+  std::shared_future<std::shared_ptr<const std::string>> pendingLoad;
+  std::promise<std::shared_ptr<const std::string>> load;
+  {
+    std::scoped_lock lock{m_mutex};
+    if (auto entry = m_memoryCache.Get(key)) {
+      if (m_options.Now() < entry->Expires) {
+        return entry->Body;
+      }
+
+      staleEntry = std::move(entry);
+    }
+
+    // Only the first request for a key loads it, and the others wait for its result.
+    auto it = m_pendingLoads.find(key);
+    if (it != m_pendingLoads.end()) {
+      pendingLoad = it->second;
+    } else {
+      m_pendingLoads.emplace(key, load.get_future().share());
+    }
+  }
+
+  if (pendingLoad.valid()) {
+    return pendingLoad.get();
+  }
+
+  std::shared_ptr<const std::string> body;
+  try {
+    body = Load(key, uri, headers, std::move(staleEntry));
+  } catch (...) {
+    {
+      std::scoped_lock lock{m_mutex};
+      m_pendingLoads.erase(key);
+    }
+
+    load.set_exception(std::current_exception());
+    throw;
+  }
+
+  {
+    std::scoped_lock lock{m_mutex};
+    m_pendingLoads.erase(key);
+  }
+
+  load.set_value(body);
+  return body;
+}
+
+std::shared_ptr<const std::string> ImageCache::Load(
+    const std::string &key,
+    const std::string &uri,
+    const ImageHttpHeaders &headers,
+    std::optional<ImageCacheEntry> &&staleEntry) {
+  std::optional<ImageCacheEntry> entry = std::move(staleEntry);
+  if (!entry && m_diskCache) {
+    entry = m_diskCache->Read(key);
+    if (entry && m_options.Now() < entry->Expires) {
+      std::scoped_lock lock{m_mutex};
+      m_memoryCache.Put(key, *entry);
+      return entry->Body;
+    }
+  }
+
+  ImageHttpHeaders requestHeaders = headers;
+  if (entry && !entry->ETag.empty()) {
+    requestHeaders["if-none-match"] = entry->ETag;
+  }
+
+  ImageHttpResponse response = m_fetcher(uri, requestHeaders);
+  const ImageCachePolicy policy = ImageCachePolicy::FromHeaders(response.Headers);
+  const bool hasCredentials = headers.find("authorization") != headers.end();
+  if (response.StatusCode == 304 && entry) {
+    // The cached body is still valid.
+    if (!policy.ETag.empty()) {
+      entry->ETag = policy.ETag;
+    }
+  } else if (response.StatusCode == 200) {
+    entry = ImageCacheEntry{std::make_shared<const std::string>(std::move(response.Body)), policy.ETag, {}};
+  } else {
+    return nullptr;
+  }
+
+  entry->Expires = Expires(policy);
+  if (!policy.NoStore) {
+    // Like a shared cache, the disk cache keeps responses to requests with credentials only if they are public.
+    if (m_diskCache && (!hasCredentials || policy.Public)) {
+      m_diskCache->Write(key, *entry);
+    }
+
+    std::scoped_lock lock{m_mutex};
+    m_memoryCache.Put(key, *entry);
+  }
+
+  return entry->Body;
+}
+
+std::chrono::system_clock::time_point ImageCache::Expires(const ImageCachePolicy &policy) const noexcept {
+  if (policy.NoCache) {
+    return m_options.Now();
+  }
+
+  return m_options.Now() + policy.MaxAge.value_or(m_options.DefaultMaxAge);
+}
+
+} // namespace Microsoft::React
@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace Microsoft::React {
+
+//
+// A cache of remote image content. It has three layers:
+// - an LRU memory cache of image bytes limited by a byte budget,
+// - an optional content-addressed disk cache that survives app restarts and is limited by a byte budget,
+// - request coalescing, so that concurrent requests for the same image share one download.
+// Entries are keyed by URI plus request headers. Their lifetime follows the Cache-Control
+// response header, and stale entries with an ETag are revalidated with If-None-Match.
+// Responses to requests with an Authorization header stay out of the disk cache unless they are public.
+// The cache has no platform dependencies: the caller provides the function that does HTTP requests.
+//
+
+// Header names are lower case.
+using ImageHttpHeaders = std::map<std::string, std::string>;
+
+struct ImageHttpResponse {
+  int StatusCode{0}; // Zero when the request fails without a response.
+  ImageHttpHeaders Headers;
+  std::string Body;
+};
+
+// Sends a GET request and blocks until the response is received.
+using ImageHttpFetcher = std::function<ImageHttpResponse(const std::string &uri, const ImageHttpHeaders &headers)>;
+
+// The parts of the Cache-Control and ETag response headers that the cache uses.
+struct ImageCachePolicy {
+  static ImageCachePolicy FromHeaders(const ImageHttpHeaders &headers) noexcept;
+
+  bool NoStore{false};
+  bool NoCache{false};
+  bool Public{false};
+  std::optional<std::chrono::seconds> MaxAge;
+  std::string ETag;
+};
+
+struct ImageCacheEntry {
+  std::shared_ptr<const std::string> Body;
+  std::string ETag;
+  std::chrono::system_clock::time_point Expires;
+};
+
+// Stores image bodies in files named by the SHA-256 hash of their content, so identical images
+// requested by different URIs or headers share one file. Each key has a small index file,
+// named by the SHA-256 hash of the key, that refers to the content file. The keys themselves
+// are not stored, because their headers may have credentials.
+// Reading an entry updates the write time of its index file, which orders the entries for pruning.
+class ImageDiskCache {
+ public:
+  ImageDiskCache(std::filesystem::path directory, uintmax_t byteBudget) noexcept;
+
+  std::optional<ImageCacheEntry> Read(const std::string &key) noexcept;
+
+  // Prunes the cache when the written files take it over the byte budget.
+  void Write(const std::string &key, const ImageCacheEntry &entry) noexcept;
+
+  // Deletes the least recently used entries until the cache fits into three quarters of the byte budget,
+  // or keeps all entries if they fit into the budget. Deletes the content files that no index refers to,
+  // and the temporary files left by interrupted writes.
+  void Prune() noexcept;
+
+  // Returns the SHA-256 hash of the content as a lower case hex string.
+  static std::string ContentHash(const std::string &content);
+
+ private:
+  struct IndexRecord {
+    std::string ContentHash;
+    uintmax_t ContentSize;
+    int64_t Expires;
+    std::string ETag;
+  };
+
+  static std::optional<IndexRecord> ReadIndex(const std::filesystem::path &indexPath);
+  std::filesystem::path IndexPath(const std::string &key) const;
+  std::filesystem::path ContentPath(const std::string &contentHash) const;
+  void PruneLocked();
+
+ private:
+  const std::filesystem::path m_directory;
+  const uintmax_t m_byteBudget;
+  std::mutex m_mutex; // Serializes writes and pruning.
+  std::optional<uintmax_t> m_byteSize; // Unknown until the first pruning.
+};
+
+// Keeps the most recently used entries while their bodies fit into the byte budget.
+class ImageMemoryCache {
+ public:
+  explicit ImageMemoryCache(size_t byteBudget) noexcept;
+
+  std::optional<ImageCacheEntry> Get(const std::string &key) noexcept;
+  void Put(const std::string &key, const ImageCacheEntry &entry) noexcept;
+
+  size_t ByteSize() const noexcept {
+    return m_byteSize;
+  }
+
+ private:
+  using LruList = std::list<std::pair<std::string, ImageCacheEntry>>;
+
+  const size_t m_byteBudget;
+  size_t m_byteSize{0};
+  LruList m_lruList; // The most recently used entry is first.
+  std::unordered_map<std::string, LruList::iterator> m_entries;
+};
+
+struct ImageCacheOptions {
+  size_t MemoryByteBudget{32 * 1024 * 1024};
+
+  // The disk cache is disabled when the path is empty.
+  std::filesystem::path DiskCachePath;
+  uintmax_t DiskByteBudget{128 * 1024 * 1024};
+
+  // How long a response without max-age or no-cache stays fresh.
+  std::chrono::seconds DefaultMaxAge{std::chrono::minutes{5}};
+
+  std::function<std::chrono::system_clock::time_point()> Now{&std::chrono::system_clock::now};
+};
+
+class ImageCache {
+ public:
+  ImageCache(ImageHttpFetcher &&fetcher, ImageCacheOptions &&options) noexcept;
+
+  // Returns the image body, or nullptr if it cannot be downloaded.
+  // It blocks while the image is downloaded, and must not be called on the UI thread.
+  std::shared_ptr<const std::string> Get(const std::string &uri, const ImageHttpHeaders &headers);
+
+  static std::string MakeKey(const std::string &uri, const ImageHttpHeaders &headers) noexcept;
+
+ private:
+  std::shared_ptr<const std::string> Load(
+      const std::string &key,
+      const std::string &uri,
+      const ImageHttpHeaders &headers,
+      std::optional<ImageCacheEntry> &&staleEntry);
+  std::chrono::system_clock::time_point Expires(const ImageCachePolicy &policy) const noexcept;
+
+ private:
+  const ImageHttpFetcher m_fetcher;
+  const ImageCacheOptions m_options;
+  std::optional<ImageDiskCache> m_diskCache;
+
+  std::mutex m_mutex;
+  ImageMemoryCache m_memoryCache;
+  std::unordered_map<std::string, std::shared_future<std::shared_ptr<const std::string>>> m_pendingLoads;
+};
+
+} // namespace Microsoft::React
@@ -26,6 +26,11 @@ namespace react {
 
 UIManager::UIManager(std::vector<std::unique_ptr<IViewManager>> &&viewManagers, INativeUIManager *nativeManager)
     : m_viewManagers(std::move(viewManagers)), m_nativeUIManager(nativeManager) {
+  // The first registered view manager wins if several of them have the same name.
+  m_viewManagersByName.reserve(m_viewManagers.size());
+  for (auto &&vm : m_viewManagers)
+    m_viewManagersByName.emplace(vm->GetName(), vm.get());
+
   m_nativeUIManager->setHost(this);
 }
 
@@ -48,12 +53,17 @@ void UIManager::populateViewManagerConstants(std::map<std::string, dynamic> &con
     constants.emplace(vm->GetName(), vm->GetConstants());
 }
 
-IViewManager *UIManager::GetViewManager(const std::string &className) const {
-  for (auto &&vm : m_viewManagers) {
-    if (!strcmp(vm->GetName(), className.c_str()))
-      return vm.get();
-  }
-  return nullptr;
+std::vector<std::string> UIManager::getViewManagerNames() {
+  std::vector<std::string> names;
+  names.reserve(m_viewManagers.size());
+  for (auto &&vm : m_viewManagers)
+    names.emplace_back(vm->GetName());
+  return names;
+}
+
+IViewManager *UIManager::GetViewManager(std::string_view className) const {
+  auto it = m_viewManagersByName.find(className);
+  return it != m_viewManagersByName.end() ? it->second : nullptr;
 }
 
 void UIManager::RegisterRootView(IReactRootView *rootView, int64_t rootViewTag, int64_t width, int64_t height) {
@@ -109,22 +119,7 @@ void UIManager::removeSubviewsFromContainerWithID(int64_t containerTag) {
   std::vector<int64_t> indicesToRemove(containerNode.m_children.size());
   for (size_t i = 0; i < containerNode.m_children.size(); i++)
     indicesToRemove[static_cast<size_t>(i)] = static_cast<int64_t>(i);
-  std::vector<int64_t> emptyVec;
-  manageChildren(containerTag, emptyVec, emptyVec, emptyVec, emptyVec, indicesToRemove);
-}
-
-std::vector<int64_t> PopulateIntVecFromDynamicArray(const folly::dynamic &arr) {
-  std::vector<int64_t> vec(arr.empty() ? 0 : arr.size());
-
-  if (arr.empty())
-    return vec;
-
-  auto i = 0;
-  for (auto &val : arr) {
-    vec[i] = static_cast<int64_t>(val.asDouble());
-    ++i;
-  }
-  return vec;
+  manageChildren(containerTag, {}, {}, {}, {}, indicesToRemove);
 }
 
 void UIManager::manageChildren(
@@ -134,106 +129,99 @@ void UIManager::manageChildren(
     folly::dynamic &addChildTags,
     folly::dynamic &addAtIndices,
     folly::dynamic &removeFrom) {
-  auto vecMoveFrom = PopulateIntVecFromDynamicArray(moveFrom);
-  auto vecMoveTo = PopulateIntVecFromDynamicArray(moveTo);
-  auto vecAddChildTags = PopulateIntVecFromDynamicArray(addChildTags);
-  auto vecAddAtIndices = PopulateIntVecFromDynamicArray(addAtIndices);
-  auto vecRemoveFrom = PopulateIntVecFromDynamicArray(removeFrom);
-  manageChildren(viewTag, vecMoveFrom, vecMoveTo, vecAddChildTags, vecAddAtIndices, vecRemoveFrom);
-}
-
-struct ViewAtIndex {
-  int64_t tag;
-  int64_t index;
-  static bool ViewAtIndexCompare(
-      const std::shared_ptr<ViewAtIndex> &x,
-      const std::shared_ptr<ViewAtIndex> &y) noexcept {
-    return (x->index < y->index);
+  manageChildren(
+      viewTag,
+      Int64ArrayView{moveFrom},
+      Int64ArrayView{moveTo},
+      Int64ArrayView{addChildTags},
+      Int64ArrayView{addAtIndices},
+      Int64ArrayView{removeFrom});
+}
+
+static bool ChildAtIndexCompare(const ChildAtIndex &x, const ChildAtIndex &y) noexcept {
+  return x.Index < y.Index;
+}
+
+// Applies the splice to the child tags in one pass for the removals and one
+// pass for the additions.
+static void SpliceChildTags(std::vector<int64_t> &children, const ChildrenSplice &splice) {
+  size_t keptCount = 0;
+  auto removed = splice.Removed.begin();
+  for (size_t i = 0; i < children.size(); ++i) {
+    if (removed != splice.Removed.end() && removed->Index == static_cast<int64_t>(i)) {
+      ++removed;
+    } else {
+      children[keptCount++] = children[i];
+    }
   }
-};
+
+  // Fill the final children from the back so that each kept child moves once.
+  children.resize(keptCount + splice.Added.size());
+  auto added = splice.Added.rbegin();
+  for (size_t i = children.size(); i > 0; --i) {
+    if (added != splice.Added.rend() && added->Index == static_cast<int64_t>(i - 1)) {
+      children[i - 1] = added->Node->m_tag;
+      ++added;
+    } else {
+      children[i - 1] = children[--keptCount];
+    }
+  }
+}
 
 void UIManager::manageChildren(
     int64_t viewTag,
-    std::vector<int64_t> &moveFrom,
-    std::vector<int64_t> &moveTo,
-    std::vector<int64_t> &addChildTags,
-    std::vector<int64_t> &addAtIndices,
-    std::vector<int64_t> &removeFrom) {
+    Int64ArrayView moveFrom,
+    Int64ArrayView moveTo,
+    Int64ArrayView addChildTags,
+    Int64ArrayView addAtIndices,
+    Int64ArrayView removeFrom) {
   m_nativeUIManager->ensureInBatch();
   auto &shadowNodeToManage = m_nodeRegistry.getNode(viewTag);
 
-  auto numToMove = moveFrom.size();
-  auto numToAdd = addChildTags.size();
-  auto numToRemove = removeFrom.size();
-  std::vector<shared_ptr<ViewAtIndex>> viewsToAdd(numToMove + numToAdd);
-  std::vector<shared_ptr<ViewAtIndex>> viewsToRemove(numToMove + numToRemove);
-  std::vector<int64_t> tagsToDelete(numToRemove);
-
-  if (numToMove > 0) {
-    for (size_t i = 0; i < numToMove; ++i) {
-      auto moveFromIndex = moveFrom[i];
-      auto tagToMove =
-          m_nodeRegistry.getNode(static_cast<size_t>(shadowNodeToManage.m_children[static_cast<size_t>(moveFromIndex)]))
-              .m_tag;
-      viewsToAdd[i] = make_shared<ViewAtIndex>(ViewAtIndex{tagToMove, moveTo[i]});
-      viewsToRemove[i] = make_shared<ViewAtIndex>(ViewAtIndex{tagToMove, moveFromIndex});
-    }
+  auto &splice = m_childrenSplice;
+  splice.clear();
+  m_tagsToDelete.clear();
+
+  for (size_t i = 0; i < moveFrom.size(); ++i) {
+    auto moveFromIndex = moveFrom[i];
+    auto &nodeToMove = m_nodeRegistry.getNode(shadowNodeToManage.m_children[static_cast<size_t>(moveFromIndex)]);
+    splice.Added.push_back(ChildAtIndex{&nodeToMove, moveTo[i]});
+    splice.Removed.push_back(ChildAtIndex{&nodeToMove, moveFromIndex});
   }
 
-  if (numToAdd > 0) {
-    for (size_t i = 0; i < numToAdd; ++i) {
-      viewsToAdd[numToMove + i] = make_shared<ViewAtIndex>(ViewAtIndex{addChildTags[i], addAtIndices[i]});
-    }
+  for (size_t i = 0; i < addChildTags.size(); ++i) {
+    splice.Added.push_back(ChildAtIndex{&m_nodeRegistry.getNode(addChildTags[i]), addAtIndices[i]});
   }
 
-  if (numToRemove > 0) {
-    for (size_t i = 0; i < numToRemove; ++i) {
-      auto indexToRemove = removeFrom[i];
-      auto tagToRemove =
-          m_nodeRegistry.getNode(static_cast<size_t>(shadowNodeToManage.m_children[static_cast<size_t>(indexToRemove)]))
-              .m_tag;
-      viewsToRemove[i] = make_shared<ViewAtIndex>(ViewAtIndex{tagToRemove, indexToRemove});
-      tagsToDelete[i] = tagToRemove;
-    }
+  for (size_t i = 0; i < removeFrom.size(); ++i) {
+    auto indexToRemove = removeFrom[i];
+    auto &nodeToRemove = m_nodeRegistry.getNode(shadowNodeToManage.m_children[static_cast<size_t>(indexToRemove)]);
+    splice.Removed.push_back(ChildAtIndex{&nodeToRemove, indexToRemove});
+    m_tagsToDelete.push_back(nodeToRemove.m_tag);
   }
 
   // NB: moveFrom and removeForm are both relative to the starting
-  // state of the view's children.
+  // state of the view's children, and moveTo and addAtIndices are
+  // relative to the final state.
   //
   // 1) Sort the views to add and indices to remove by index
-  // 2) Iterate the indices being removed from high to low and remove
-  //    them. Going high to low makes sure we remove the correct
-  //    index when there are multiple to remove.
-  // 3) Iterate the views being added by index low to high and add
-  //    them. Like the view removal, iteration direction is important
-  //    to preserve the correct index.
-
-  std::sort(viewsToAdd.begin(), viewsToAdd.end(), ViewAtIndex::ViewAtIndexCompare);
-  std::sort(viewsToRemove.begin(), viewsToRemove.end(), ViewAtIndex::ViewAtIndexCompare);
+  // 2) Apply the whole splice to the child tags, the shadow node and
+  //    the native UI manager at once.
+  // 3) Drop the removed views that were not moved.
 
-  // Apply changes to the ReactShadowNode hierarchy.
-  for (auto i = static_cast<int>(viewsToRemove.size()) - 1; i >= 0; --i) {
-    auto viewAtIndex = viewsToRemove[i];
-    auto &shadowNodeToRemove = m_nodeRegistry.getNode(viewAtIndex->tag);
+  std::sort(splice.Added.begin(), splice.Added.end(), ChildAtIndexCompare);
+  std::sort(splice.Removed.begin(), splice.Removed.end(), ChildAtIndexCompare);
 
-    shadowNodeToManage.m_children.erase(
-        shadowNodeToManage.m_children.begin() + static_cast<size_t>(viewAtIndex->index));
-    shadowNodeToManage.RemoveChildAt(viewAtIndex->index);
+  SpliceChildTags(shadowNodeToManage.m_children, splice);
+  for (const auto &added : splice.Added) {
+    added.Node->m_parent = shadowNodeToManage.m_tag;
   }
 
-  for (size_t i = 0; i < viewsToAdd.size(); ++i) {
-    auto viewAtIndex = viewsToAdd[i];
-    auto &shadowNodeToAdd = m_nodeRegistry.getNode(viewAtIndex->tag);
-    shadowNodeToAdd.m_parent = shadowNodeToManage.m_tag;
-    shadowNodeToManage.m_children.insert(
-        shadowNodeToManage.m_children.begin() + static_cast<size_t>(viewAtIndex->index), shadowNodeToAdd.m_tag);
-    if (!shadowNodeToManage.m_zombie)
-      shadowNodeToManage.AddView(shadowNodeToAdd, viewAtIndex->index);
-
-    m_nativeUIManager->AddView(shadowNodeToManage, shadowNodeToAdd, viewAtIndex->index);
-  }
+  // Apply changes to the ReactShadowNode hierarchy.
+  shadowNodeToManage.SpliceChildren(splice);
+  m_nativeUIManager->SpliceChildren(shadowNodeToManage, splice);
 
-  for (auto tagToDelete : tagsToDelete)
+  for (auto tagToDelete : m_tagsToDelete)
     DropView(tagToDelete);
 }
 
@@ -337,8 +325,7 @@ void UIManager::replaceExistingNonRootView(int64_t oldTag, int64_t newTag) {
   CHECK(it != parent.m_children.end());
   indicesToAdd[0] = indicesToRemove[0] = it - parent.m_children.begin();
 
-  std::vector<int64_t> emptyVec;
-  manageChildren(parent.m_tag, emptyVec, emptyVec, tagToAdd, indicesToAdd, indicesToRemove);
+  manageChildren(parent.m_tag, {}, {}, tagToAdd, indicesToAdd, indicesToRemove);
 }
 
 void UIManager::dispatchViewManagerCommand(
@@ -451,8 +438,11 @@ ShadowNode &UIManager::GetShadowNodeForTag(int64_t tag) {
 
 UIManagerModule::UIManagerModule(
     std::shared_ptr<IUIManager> &&manager,
-    std::shared_ptr<MessageQueueThread> &&uiQueue) noexcept
-    : m_manager{std::move(manager)}, m_uiQueue{std::move(uiQueue)} {}
+    std::shared_ptr<MessageQueueThread> &&uiQueue,
+    bool lazyViewManagerConstants) noexcept
+    : m_manager{std::move(manager)},
+      m_uiQueue{std::move(uiQueue)},
+      m_lazyViewManagerConstants{lazyViewManagerConstants} {}
 
 UIManagerModule::~UIManagerModule() noexcept {
   if (m_uiQueue) {
@@ -468,7 +458,17 @@ std::string UIManagerModule::getName() {
 std::map<std::string, folly::dynamic> UIManagerModule::getConstants() {
   std::map<std::string, folly::dynamic> constants{};
 
-  m_manager->populateViewManagerConstants(constants);
+  if (m_lazyViewManagerConstants) {
+    // Building the constants of every view manager up front dominates the startup cost of this module.
+    // Instead we only give JS the names, and it calls getConstantsForViewManager for each class on first use.
+    folly::dynamic viewManagerNames = folly::dynamic::array;
+    for (auto &name : m_manager->getViewManagerNames())
+      viewManagerNames.push_back(std::move(name));
+    constants.emplace("ViewManagerNames", std::move(viewManagerNames));
+    constants.emplace("LazyViewManagersEnabled", true);
+  } else {
+    m_manager->populateViewManagerConstants(constants);
+  }
 
   return constants;
 }
@@ -578,8 +578,9 @@ shared_ptr<IUIManager> createIUIManager(
 
 std::unique_ptr<facebook::xplat::module::CxxModule> createUIManagerModule(
     std::shared_ptr<IUIManager> &&uimanager,
-    std::shared_ptr<MessageQueueThread> &&uiQueue) noexcept {
-  return std::make_unique<UIManagerModule>(std::move(uimanager), std::move(uiQueue));
+    std::shared_ptr<MessageQueueThread> &&uiQueue,
+    bool lazyViewManagerConstants) noexcept {
+  return std::make_unique<UIManagerModule>(std::move(uimanager), std::move(uiQueue), lazyViewManagerConstants);
 }
 
 // Deprecated
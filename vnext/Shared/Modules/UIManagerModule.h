@@ -7,6 +7,8 @@
 #include <ShadowNodeRegistry.h>
 #include <ViewManager.h>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace facebook {
@@ -26,6 +28,7 @@ class UIManager : public IUIManager, INativeUIManagerHost {
   // IUIManager
   folly::dynamic getConstantsForViewManager(const std::string &className) override;
   void populateViewManagerConstants(std::map<std::string, folly::dynamic> &constants) override;
+  std::vector<std::string> getViewManagerNames() override;
   void configureNextLayoutAnimation(
       folly::dynamic &&config,
       facebook::xplat::module::CxxModule::Callback success,
@@ -72,21 +75,52 @@ class UIManager : public IUIManager, INativeUIManagerHost {
   ShadowNode *FindShadowNodeForTag(int64_t tag) override;
   ShadowNode *FindParentRootShadowNode(int64_t tag) override;
 
+ private:
+  // The tags or indices of a manageChildren call, read in place from the array
+  // sent by JS or from a vector.
+  class Int64ArrayView {
+   public:
+    Int64ArrayView() noexcept = default;
+    Int64ArrayView(const folly::dynamic &items) noexcept
+        : m_dynamicItems{items.isArray() && !items.empty() ? &*items.begin() : nullptr},
+          m_size{m_dynamicItems ? items.size() : 0} {}
+    Int64ArrayView(const std::vector<int64_t> &items) noexcept : m_int64Items{items.data()}, m_size{items.size()} {}
+
+    size_t size() const noexcept {
+      return m_size;
+    }
+
+    int64_t operator[](size_t index) const {
+      return m_int64Items ? m_int64Items[index] : static_cast<int64_t>(m_dynamicItems[index].asDouble());
+    }
+
+   private:
+    const folly::dynamic *m_dynamicItems{nullptr};
+    const int64_t *m_int64Items{nullptr};
+    size_t m_size{0};
+  };
+
  private:
   std::vector<std::unique_ptr<IViewManager>> m_viewManagers;
+  // Indexes m_viewManagers by the names that they own, because createView looks up a view manager for every view.
+  std::unordered_map<std::string_view, IViewManager *> m_viewManagersByName;
   ShadowNodeRegistry m_nodeRegistry;
   INativeUIManager *m_nativeUIManager;
 
+  // Reused by manageChildren calls to avoid allocations while lists are scrolled.
+  ChildrenSplice m_childrenSplice;
+  std::vector<int64_t> m_tagsToDelete;
+
   void manageChildren(
       int64_t viewTag,
-      std::vector<int64_t> &moveFrom,
-      std::vector<int64_t> &moveTo,
-      std::vector<int64_t> &addChildTags,
-      std::vector<int64_t> &addAtIndices,
-      std::vector<int64_t> &removeFrom);
+      Int64ArrayView moveFrom,
+      Int64ArrayView moveTo,
+      Int64ArrayView addChildTags,
+      Int64ArrayView addAtIndices,
+      Int64ArrayView removeFrom);
   void RemoveShadowNode(ShadowNode &nodeToRemove);
   void DropView(int64_t tag, bool removeChildren = true, bool zombieView = false);
-  IViewManager *GetViewManager(const std::string &className) const;
+  IViewManager *GetViewManager(std::string_view className) const;
 
   int64_t m_nextRootTag = 101;
   static const int64_t RootViewTagIncrement = 10;
@@ -94,7 +128,10 @@ class UIManager : public IUIManager, INativeUIManagerHost {
 
 class UIManagerModule : public facebook::xplat::module::CxxModule {
  public:
-  UIManagerModule(std::shared_ptr<IUIManager> &&manager, std::shared_ptr<MessageQueueThread> &&uiQueue) noexcept;
+  UIManagerModule(
+      std::shared_ptr<IUIManager> &&manager,
+      std::shared_ptr<MessageQueueThread> &&uiQueue,
+      bool lazyViewManagerConstants = false) noexcept;
   ~UIManagerModule() noexcept override;
 
   // CxxModule
@@ -105,6 +142,7 @@ class UIManagerModule : public facebook::xplat::module::CxxModule {
  private:
   std::shared_ptr<IUIManager> m_manager;
   std::shared_ptr<MessageQueueThread> m_uiQueue;
+  const bool m_lazyViewManagerConstants;
 };
 
 } // namespace react
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace Microsoft::React {
@@ -33,4 +34,50 @@ const bool __cdecl GetRuntimeOptionBool(const std::string &name) noexcept;
 /// <returns>Value stored for the given key, or 0 if the entry doesn't exist (default)</returns>
 const std::int32_t __cdecl GetRuntimeOptionInt(const std::string &name) noexcept;
 
+/// <summary>
+/// Identifies a runtime option interned with RegisterRuntimeOption.
+/// </summary>
+using RuntimeOptionId = std::uint32_t;
+
+/// <summary>
+/// Returned by RegisterRuntimeOption when no more options can be interned.
+/// Reads through it return the default value and writes are ignored.
+/// </summary>
+constexpr RuntimeOptionId InvalidRuntimeOptionId = static_cast<RuntimeOptionId>(-1);
+
+/// <summary>
+/// Interns a runtime option key and returns its identifier.
+/// Registering the same name again returns the same identifier.
+/// Use it once for options read on hot paths: reads through the identifier are lock-free.
+/// </summary>
+/// <param name="name">Global key</param>
+/// <returns>Identifier of the option, or InvalidRuntimeOptionId if the option table is full</returns>
+const RuntimeOptionId __cdecl RegisterRuntimeOption(const std::string &name) noexcept;
+
+/// <summary>
+/// Sets a global boolean value identified by an interned key.
+/// </summary>
+/// <param name="id">Identifier returned by RegisterRuntimeOption</param>
+void __cdecl SetRuntimeOptionBool(RuntimeOptionId id, bool value) noexcept;
+
+/// <summary>
+/// Sets a global signed integer value identified by an interned key.
+/// </summary>
+/// <param name="id">Identifier returned by RegisterRuntimeOption</param>
+void __cdecl SetRuntimeOptionInt(RuntimeOptionId id, std::int32_t value) noexcept;
+
+/// <summary>
+/// Retrieves a global boolean value for the given interned key without taking a lock.
+/// </summary>
+/// <param name="id">Identifier returned by RegisterRuntimeOption</param>
+/// <returns>Value stored for the given key, or false if it was never set (default)</returns>
+const bool __cdecl GetRuntimeOptionBool(RuntimeOptionId id) noexcept;
+
+/// <summary>
+/// Retrieves a global signed integer value for the given interned key without taking a lock.
+/// </summary>
+/// <param name="id">Identifier returned by RegisterRuntimeOption</param>
+/// <returns>Value stored for the given key, or 0 if it was never set (default)</returns>
+const std::int32_t __cdecl GetRuntimeOptionInt(RuntimeOptionId id) noexcept;
+
 } // namespace Microsoft::React
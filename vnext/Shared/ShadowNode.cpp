@@ -14,5 +14,19 @@ void ShadowNode::onDropViewInstance() {}
 
 void ShadowNode::updateProperties(const folly::dynamic &&props) {}
 
+void ShadowNode::SpliceChildren(const ChildrenSplice &splice) {
+  // Going high to low makes sure we remove the correct index when there are
+  // multiple to remove, and going low to high does the same for the additions.
+  for (auto it = splice.Removed.rbegin(); it != splice.Removed.rend(); ++it) {
+    RemoveChildAt(it->Index);
+  }
+
+  if (!m_zombie) {
+    for (const auto &added : splice.Added) {
+      AddView(*added.Node, added.Index);
+    }
+  }
+}
+
 } // namespace react
 } // namespace facebook
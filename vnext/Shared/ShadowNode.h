@@ -11,6 +11,28 @@ namespace facebook {
 namespace react {
 
 class IViewManager;
+struct ShadowNode;
+
+// A child shadow node and its index in the children of its container.
+struct ChildAtIndex {
+  ShadowNode *Node;
+  int64_t Index;
+};
+
+// The changes that one UIManager::manageChildren call makes to the children of
+// a container. Removed children are sorted by their index in the starting
+// children, and added children by their index in the final children. Moved
+// children are both removed and added.
+struct ChildrenSplice {
+  std::vector<ChildAtIndex> Removed;
+  std::vector<ChildAtIndex> Added;
+
+  // Keeps the capacity so that the splice can be reused.
+  void clear() noexcept {
+    Removed.clear();
+    Added.clear();
+  }
+};
 
 struct ShadowNode {
   ShadowNode(const ShadowNode &that) = delete;
@@ -24,6 +46,9 @@ struct ShadowNode {
   virtual void removeAllChildren() = 0;
   virtual void AddView(ShadowNode &child, int64_t index) = 0;
   virtual void RemoveChildAt(int64_t indexToRemove) = 0;
+  // Applies all changes to the children at once. By default it calls RemoveChildAt
+  // and AddView for each changed child.
+  virtual void SpliceChildren(const ChildrenSplice &splice);
   virtual void createView() = 0;
 
   int64_t m_tag{0};
@@ -0,0 +1,495 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+
+#include "tracing/TraceRecorder.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook {
+namespace react {
+namespace tracing {
+
+std::atomic<uint64_t> g_enabledTraceTags{0};
+
+namespace {
+
+constexpr uint32_t s_overflowNameId = 1;
+constexpr size_t s_threadNameCacheSize = 1024;
+
+std::mutex s_tagsMutex;
+uint64_t s_recorderTags{0};
+bool s_isEtwEnabled{false};
+
+std::atomic<uint64_t> s_recordingTags{0};
+std::atomic<int64_t> s_recordingStart{0};
+
+// Must be called with s_tagsMutex locked.
+void UpdateEnabledTags() noexcept {
+  g_enabledTraceTags.store(s_recorderTags | (s_isEtwEnabled ? ~0ull : 0ull), std::memory_order_relaxed);
+}
+
+int64_t Now() noexcept {
+  static const auto s_epoch = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+uint8_t TagBit(uint64_t tag) noexcept {
+  uint8_t bit = 0;
+  while (bit < 63 && (tag & (1ull << bit)) == 0) {
+    ++bit;
+  }
+
+  return bit;
+}
+
+class NameTable {
+ public:
+  NameTable() {
+    Add("");
+    Add("<overflow>");
+  }
+
+  uint32_t Intern(const std::string &name) {
+    std::scoped_lock lock{m_mutex};
+    auto it = m_ids.find(name);
+    if (it != m_ids.end()) {
+      return it->second;
+    }
+
+    if (m_names.size() >= MaxTraceNames) {
+      return s_overflowNameId;
+    }
+
+    return Add(name);
+  }
+
+  std::vector<std::string> Names() {
+    std::scoped_lock lock{m_mutex};
+    return {m_names.begin(), m_names.end()};
+  }
+
+ private:
+  uint32_t Add(const std::string &name) {
+    const auto id = static_cast<uint32_t>(m_names.size());
+    m_names.push_back(name);
+    m_ids.emplace(name, id);
+    return id;
+  }
+
+  std::mutex m_mutex;
+  std::unordered_map<std::string, uint32_t> m_ids;
+  std::deque<std::string> m_names;
+};
+
+NameTable &Names() {
+  static NameTable s_names;
+  return s_names;
+}
+
+struct ExportedRecord {
+  TraceRecord record;
+  std::string args;
+};
+
+// Single-producer ring buffer: only the owning thread writes to it, and the
+// exporter reads it from any thread. Each slot has a sequence number that is
+// odd while the slot is written, so that the exporter can skip torn records.
+// The arguments of the records are kept in a second ring of 64-bit words. Its
+// reserved position is advanced before the words are written, so that the
+// exporter can tell the arguments that were overwritten while it copied them.
+class ThreadTraceBuffer {
+ public:
+  ThreadTraceBuffer() : m_slots(TraceBufferCapacity), m_argWords(s_argWordCount) {}
+
+  // Copies the arguments to the argument ring and returns their position, in words.
+  uint64_t WriteArgs(std::string_view args) noexcept {
+    const auto position = m_argsReserved.load(std::memory_order_relaxed);
+    const auto wordCount = (args.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    m_argsReserved.store(position + wordCount, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < wordCount; ++i) {
+      uint64_t word = 0;
+      const auto offset = i * sizeof(uint64_t);
+      std::memcpy(&word, args.data() + offset, std::min(sizeof(uint64_t), args.size() - offset));
+      m_argWords[(position + i) % s_argWordCount].store(word, std::memory_order_relaxed);
+    }
+
+    return position;
+  }
+
+  void Write(const TraceRecord &record) noexcept {
+    uint64_t words[s_recordWordCount];
+    std::memcpy(words, &record, sizeof(record));
+
+    const auto head = m_head.load(std::memory_order_relaxed);
+    auto &slot = m_slots[head % TraceBufferCapacity];
+    slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < s_recordWordCount; ++i) {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    slot.sequence.store(2 * head + 2, std::memory_order_release);
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  void Read(int64_t since, std::vector<ExportedRecord> &records) const {
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto first = head > TraceBufferCapacity ? head - TraceBufferCapacity : 0;
+
+    records.clear();
+    TraceRecord record;
+    for (auto i = first; i < head; ++i) {
+      if (ReadSlot(i, record) && record.timestamp >= since) {
+        records.push_back({record, {}});
+        if (record.argsSize != 0 && !ReadArgs(record.id, record.argsSize, records.back().args)) {
+          records.back().args = "<overwritten>";
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t s_recordWordCount = sizeof(TraceRecord) / sizeof(uint64_t);
+  static_assert(sizeof(TraceRecord) % sizeof(uint64_t) == 0, "Trace records are copied as 64-bit words.");
+  static constexpr size_t s_argWordCount = TraceArgsBufferCapacity / sizeof(uint64_t);
+
+  // Returns false if the arguments at the given position were overwritten.
+  // The record was read after the arguments were written, so they are complete unless overwritten.
+  bool ReadArgs(uint64_t position, uint32_t size, std::string &args) const {
+    const auto isOverwritten = [this, position]() noexcept {
+      return m_argsReserved.load(std::memory_order_relaxed) > position + s_argWordCount;
+    };
+
+    if (isOverwritten()) {
+      return false;
+    }
+
+    const auto wordCount = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    args.resize(wordCount * sizeof(uint64_t));
+    for (size_t i = 0; i < wordCount; ++i) {
+      const auto word = m_argWords[(position + i) % s_argWordCount].load(std::memory_order_relaxed);
+      std::memcpy(&args[i * sizeof(uint64_t)], &word, sizeof(word));
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (isOverwritten()) {
+      return false;
+    }
+
+    args.resize(size);
+    return true;
+  }
+
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    std::array<std::atomic<uint64_t>, s_recordWordCount> words{};
+  };
+
+  // Returns false if the record at the given position was overwritten or is
+  // being written by the owning thread.
+  bool ReadSlot(uint64_t position, TraceRecord &record) const noexcept {
+    const auto &slot = m_slots[position % TraceBufferCapacity];
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 2 * position + 2) {
+      return false;
+    }
+
+    uint64_t words[s_recordWordCount];
+    for (size_t i = 0; i < s_recordWordCount; ++i) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      return false;
+    }
+
+    std::memcpy(&record, words, sizeof(record));
+    return true;
+  }
+
+  std::atomic<uint64_t> m_head{0};
+  std::vector<Slot> m_slots;
+  std::atomic<uint64_t> m_argsReserved{0};
+  std::vector<std::atomic<uint64_t>> m_argWords;
+};
+
+std::mutex s_buffersMutex;
+std::vector<std::shared_ptr<ThreadTraceBuffer>> s_buffers;
+std::vector<std::shared_ptr<ThreadTraceBuffer>> s_freeBuffers;
+std::atomic<uint32_t> s_nextThreadId{1};
+
+// Owns the ring buffer of a thread while the thread runs. At thread exit the
+// buffer goes back to the free list, so that short-lived threads reuse buffers
+// instead of each keeping one forever. The registry keeps all buffers, so that
+// the records of exited threads can still be exported.
+class ThreadBufferOwner {
+ public:
+  ThreadBufferOwner() : m_threadId(s_nextThreadId.fetch_add(1, std::memory_order_relaxed)) {
+    std::scoped_lock lock{s_buffersMutex};
+    if (s_freeBuffers.empty()) {
+      s_buffers.push_back(std::make_shared<ThreadTraceBuffer>());
+      m_buffer = s_buffers.back();
+    } else {
+      m_buffer = std::move(s_freeBuffers.back());
+      s_freeBuffers.pop_back();
+    }
+  }
+
+  ~ThreadBufferOwner() {
+    std::scoped_lock lock{s_buffersMutex};
+    s_freeBuffers.push_back(std::move(m_buffer));
+  }
+
+  ThreadBufferOwner(const ThreadBufferOwner &) = delete;
+  ThreadBufferOwner &operator=(const ThreadBufferOwner &) = delete;
+
+  void Write(TraceRecord &&record) noexcept {
+    record.threadId = m_threadId;
+    m_buffer->Write(record);
+  }
+
+  void Write(TraceRecord &&record, std::string_view args) noexcept {
+    record.id = m_buffer->WriteArgs(args);
+    record.argsSize = static_cast<uint32_t>(args.size());
+    Write(std::move(record));
+  }
+
+ private:
+  const uint32_t m_threadId;
+  std::shared_ptr<ThreadTraceBuffer> m_buffer;
+};
+
+ThreadBufferOwner &CurrentThreadBuffer() {
+  thread_local ThreadBufferOwner tl_owner;
+  return tl_owner;
+}
+
+const char *PhaseName(TracePhase phase) noexcept {
+  switch (phase) {
+    case TracePhase::Begin:
+      return "B";
+    case TracePhase::End:
+      return "E";
+    case TracePhase::AsyncBegin:
+      return "b";
+    case TracePhase::AsyncEnd:
+      return "e";
+    case TracePhase::Counter:
+      return "C";
+  }
+
+  return "i";
+}
+
+void WriteCategory(std::ostream &stream, uint8_t tagBit) {
+  switch (tagBit) {
+    case 10: // TRACE_TAG_REACT_CXX_BRIDGE
+      stream << "react_cxx_bridge";
+      break;
+    case 11: // TRACE_TAG_REACT_APPS
+      stream << "react_apps";
+      break;
+    default:
+      stream << "tag" << static_cast<uint32_t>(tagBit);
+      break;
+  }
+}
+
+void WriteJsonString(std::ostream &stream, const std::string &value) {
+  static constexpr char s_hexDigits[] = "0123456789abcdef";
+
+  stream << '"';
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\r':
+        stream << "\\r";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          stream << "\\u00" << s_hexDigits[(c >> 4) & 0xF] << s_hexDigits[c & 0xF];
+        } else {
+          stream << c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+// Writes nanoseconds as microseconds with three decimals, the unit of "ts".
+void WriteTimestamp(std::ostream &stream, int64_t nanoseconds) {
+  const auto fraction = nanoseconds % 1000;
+  stream << nanoseconds / 1000 << '.' << (fraction < 100 ? "0" : "") << (fraction < 10 ? "0" : "") << fraction;
+}
+
+void WriteRecord(std::ostream &stream, const ExportedRecord &exported, const std::vector<std::string> &names) {
+  const auto &record = exported.record;
+  const auto name = [&names](uint32_t id) -> const std::string & {
+    return names[id < names.size() ? id : s_overflowNameId];
+  };
+
+  stream << "{\"name\":";
+  WriteJsonString(stream, name(record.nameId));
+  stream << ",\"cat\":\"";
+  WriteCategory(stream, record.tagBit);
+  stream << "\",\"ph\":\"" << PhaseName(record.phase) << "\",\"ts\":";
+  WriteTimestamp(stream, record.timestamp);
+  stream << ",\"pid\":1,\"tid\":" << record.threadId;
+
+  if (record.phase == TracePhase::AsyncBegin || record.phase == TracePhase::AsyncEnd) {
+    stream << ",\"id\":" << record.id;
+  }
+
+  if (record.phase == TracePhase::Counter) {
+    stream << ",\"args\":{\"value\":" << record.value << '}';
+  } else if (record.argsSize != 0) {
+    stream << ",\"args\":{\"args\":";
+    WriteJsonString(stream, exported.args);
+    stream << '}';
+  }
+
+  stream << '}';
+}
+
+} // namespace
+
+void setEtwTracingEnabled(bool enabled) noexcept {
+  std::scoped_lock lock{s_tagsMutex};
+  s_isEtwEnabled = enabled;
+  UpdateEnabledTags();
+}
+
+void startTraceRecording(uint64_t tags) noexcept {
+  std::scoped_lock lock{s_tagsMutex};
+  s_recordingStart.store(Now(), std::memory_order_relaxed);
+  s_recordingTags.store(tags, std::memory_order_relaxed);
+  s_recorderTags = tags;
+  UpdateEnabledTags();
+}
+
+void stopTraceRecording() noexcept {
+  std::scoped_lock lock{s_tagsMutex};
+  s_recordingTags.store(0, std::memory_order_relaxed);
+  s_recorderTags = 0;
+  UpdateEnabledTags();
+}
+
+uint32_t internTraceName(const std::string &name) noexcept {
+  if (name.empty()) {
+    return 0;
+  }
+
+  try {
+    // Look up the names that the thread used recently without taking the lock.
+    thread_local std::unordered_map<std::string, uint32_t> tl_cache;
+    auto it = tl_cache.find(name);
+    if (it != tl_cache.end()) {
+      return it->second;
+    }
+
+    const auto id = Names().Intern(name);
+    if (tl_cache.size() >= s_threadNameCacheSize) {
+      tl_cache.clear();
+    }
+
+    tl_cache.emplace(name, id);
+    return id;
+  } catch (...) {
+    return s_overflowNameId;
+  }
+}
+
+void recordTraceEvent(TracePhase phase, uint64_t tag, uint32_t nameId, uint64_t id, int64_t value) noexcept {
+  if ((s_recordingTags.load(std::memory_order_relaxed) & tag) == 0) {
+    return;
+  }
+
+  try {
+    CurrentThreadBuffer().Write({Now(), id, value, nameId, 0, phase, TagBit(tag), 0});
+  } catch (...) {
+    // Could not allocate the buffer of the thread: drop the record.
+  }
+}
+
+void recordTraceBegin(uint64_t tag, uint32_t nameId, std::string_view args) noexcept {
+  if (args.empty()) {
+    recordTraceEvent(TracePhase::Begin, tag, nameId);
+    return;
+  }
+
+  if ((s_recordingTags.load(std::memory_order_relaxed) & tag) == 0) {
+    return;
+  }
+
+  try {
+    CurrentThreadBuffer().Write(
+        {Now(), 0, 0, nameId, 0, TracePhase::Begin, TagBit(tag), 0}, args.substr(0, MaxTraceArgsSize));
+  } catch (...) {
+    // Could not allocate the buffer of the thread: drop the record.
+  }
+}
+
+void exportChromeTrace(std::ostream &stream) {
+  const auto since = s_recordingStart.load(std::memory_order_relaxed);
+  const auto buffers = []() {
+    std::scoped_lock lock{s_buffersMutex};
+    return s_buffers;
+  }();
+
+  std::vector<ExportedRecord> records;
+  records.reserve(TraceBufferCapacity);
+
+  // Records written after this snapshot may refer to names that are not in it.
+  // They are exported as "<overflow>".
+  const auto names = Names().Names();
+
+  stream << "{\"traceEvents\":[";
+  bool isFirst = true;
+  for (const auto &buffer : buffers) {
+    buffer->Read(since, records);
+    for (const auto &record : records) {
+      if (!isFirst) {
+        stream << ",\n";
+      }
+
+      isFirst = false;
+      WriteRecord(stream, record, names);
+    }
+  }
+
+  stream << "],\"displayTimeUnit\":\"ms\"}";
+}
+
+size_t traceBufferCount() noexcept {
+  std::scoped_lock lock{s_buffersMutex};
+  return s_buffers.size();
+}
+
+} // namespace tracing
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace facebook {
+namespace react {
+namespace tracing {
+
+// Trace tags (TRACE_TAG_*) of the sections that are currently traced by any
+// backend (ETW or the in-memory recorder below). Sections check it before doing
+// any other work, so a disabled section costs one load and one branch.
+extern std::atomic<uint64_t> g_enabledTraceTags;
+
+inline bool isTracingEnabled(uint64_t tag) noexcept {
+  return (g_enabledTraceTags.load(std::memory_order_relaxed) & tag) != 0;
+}
+
+// Enables all tags while an ETW session listens to the provider.
+void setEtwTracingEnabled(bool enabled) noexcept;
+
+//
+// Portable in-memory trace recorder.
+//
+// Each thread appends fixed-size binary records to its own ring buffer without
+// locks. Names are interned once and records refer to them by id. Section
+// arguments change from call to call, so they are not interned: they are copied
+// to a second ring buffer of the thread, and the record keeps their position.
+// When a ring buffer is full, the oldest records are overwritten, so the
+// recorder always keeps the most recent events of each thread. When a thread
+// exits, its ring buffers are kept with their records and reused by the next
+// thread that traces.
+//
+// The records are exported as Chrome trace-event JSON, which chrome://tracing,
+// Perfetto (ui.perfetto.dev) and Speedscope can open.
+//
+
+enum class TracePhase : uint8_t {
+  Begin,
+  End,
+  AsyncBegin,
+  AsyncEnd,
+  Counter,
+};
+
+struct TraceRecord {
+  int64_t timestamp; // Nanoseconds since the recorder was created.
+  uint64_t id; // Async flow cookie, or the position of the arguments in the argument ring buffer.
+  int64_t value; // Counter value.
+  uint32_t nameId;
+  uint32_t argsSize; // Zero when there are no arguments.
+  TracePhase phase;
+  uint8_t tagBit; // Index of the lowest bit set in the trace tag.
+  uint32_t threadId;
+};
+
+static_assert(sizeof(TraceRecord) == 40, "Trace records must stay small and fixed-size.");
+
+// Number of records in the ring buffer of each thread.
+constexpr size_t TraceBufferCapacity = 16 * 1024;
+
+// Number of bytes in the argument ring buffer of each thread. Arguments that
+// are overwritten before the export are exported as "<overwritten>".
+constexpr size_t TraceArgsBufferCapacity = 256 * 1024;
+
+// Longer arguments are truncated.
+constexpr size_t MaxTraceArgsSize = 1024;
+
+// Starts recording the sections with any of the given tags. Records written
+// before this call are not exported.
+void startTraceRecording(uint64_t tags) noexcept;
+void stopTraceRecording() noexcept;
+
+// Maximum number of distinct names. Names are never freed, so once the table
+// is full, new names are recorded as "<overflow>". Only section, flow and
+// counter names are interned, so that the table stays small in long sessions.
+constexpr uint32_t MaxTraceNames = 64 * 1024;
+
+// Returns the id of the given name, which is 0 for the empty string.
+uint32_t internTraceName(const std::string &name) noexcept;
+
+// Appends a record to the ring buffer of the calling thread if the recorder
+// records the tag.
+void recordTraceEvent(TracePhase phase, uint64_t tag, uint32_t nameId, uint64_t id = 0, int64_t value = 0) noexcept;
+
+// Appends a Begin record with arguments if the recorder records the tag.
+void recordTraceBegin(uint64_t tag, uint32_t nameId, std::string_view args) noexcept;
+
+// Writes the records of all threads since the last call to
+// startTraceRecording. It can be called while other threads are recording:
+// records that are overwritten during the export are skipped.
+void exportChromeTrace(std::ostream &stream);
+
+// Returns the number of ring buffers, which is the largest number of threads
+// that traced at the same time.
+size_t traceBufferCount() noexcept;
+
+} // namespace tracing
+} // namespace react
+} // namespace facebook
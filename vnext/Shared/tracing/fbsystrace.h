@@ -6,11 +6,12 @@
 #include <stdint.h>
 #include <string.h>
 #include <array>
+#include <atomic>
 #include <chrono>
-#include <mutex>
 #include <string>
 #include <type_traits>
-#include <unordered_map>
+
+#include "TraceRecorder.h"
 
 #define TRACE_TAG_REACT_CXX_BRIDGE 1 << 10
 #define TRACE_TAG_REACT_APPS 1 << 11
@@ -57,13 +58,20 @@ class FbSystraceSection {
 
   template <typename... RestArg>
   FbSystraceSection(uint64_t tag, std::string &&profileName, RestArg &&... rest)
-      : tag_(tag), profile_name_(std::move(profileName)) {
-    id_ = s_id_counter++;
-    init(std::forward<RestArg>(rest)...);
+      : tag_(tag), enabled_(facebook::react::tracing::isTracingEnabled(tag)) {
+    // Don't format the arguments of sections that nobody traces.
+    if (enabled_) {
+      profile_name_ = std::move(profileName);
+      id_ = s_id_counter.fetch_add(1, std::memory_order_relaxed);
+      start_ = std::chrono::high_resolution_clock::now();
+      init(std::forward<RestArg>(rest)...);
+    }
   }
 
   ~FbSystraceSection() {
-    end_section();
+    if (enabled_) {
+      end_section();
+    }
   }
 
  private:
@@ -84,21 +92,19 @@ class FbSystraceSection {
 
   std::array<std::string, SYSTRACE_SECTION_MAX_ARGS> args_;
   uint64_t tag_{0};
+  bool enabled_{false};
 
-  static uint64_t s_id_counter;
-  uint64_t id_;
+  static std::atomic<uint64_t> s_id_counter;
+  uint64_t id_{0};
 
   std::string profile_name_;
   uint8_t index_{0};
 
-  std::chrono::high_resolution_clock::time_point start_{std::chrono::high_resolution_clock::now()};
+  std::chrono::high_resolution_clock::time_point start_;
 };
 
 struct FbSystraceAsyncFlow {
   static void begin(uint64_t tag, const char *name, int cookie);
   static void end(uint64_t tag, const char *name, int cookie);
-
-  static std::mutex s_tracker_mutex_;
-  static std::unordered_map<int, std::chrono::high_resolution_clock::time_point> s_tracker_;
 };
 } // namespace fbsystrace
@@ -3,52 +3,166 @@
 
 #include "pch.h"
 
+#ifdef _WIN32
 #include <windows.h>
-#include "etw/react_native_windows.h"
 
+#include <evntprov.h>
+
+// Feeds the ETW session state into the trace tag mask, so that sections are
+// skipped with a single branch when no session listens to the provider.
+static void NTAPI OnEtwProviderEnableCallback(
+    LPCGUID sourceId,
+    ULONG controlCode,
+    UCHAR level,
+    ULONGLONG matchAnyKeyword,
+    ULONGLONG matchAllKeyword,
+    PEVENT_FILTER_DESCRIPTOR filterData,
+    PVOID callbackContext);
+
+#define MCGEN_PRIVATE_ENABLE_CALLBACK_V2 OnEtwProviderEnableCallback
+#include "etw/react_native_windows.h"
+#else
+// ETW is only available on Windows. Other platforms trace to the recorder only.
+template <typename... Args>
+inline void EtwNotAvailable(const Args &...) noexcept {}
+
+#define EventWriteNATIVE_ASYNC_BEGIN_FLOW(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteNATIVE_ASYNC_END_FLOW(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteNATIVE_BEGIN_SECTION(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteNATIVE_END_SECTION(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteJS_BEGIN_SECTION(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteJS_END_SECTION(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteJS_ASYNC_BEGIN_SECTION(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteJS_ASYNC_END_SECTION(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteJS_ASYNC_BEGIN_FLOW(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteJS_ASYNC_END_FLOW(...) EtwNotAvailable(__VA_ARGS__)
+#define EventWriteJS_COUNTER(...) EtwNotAvailable(__VA_ARGS__)
+#define EventRegisterReact_Native_Windows_Provider() EtwNotAvailable()
+#endif
+
+#include "tracing/TraceRecorder.h"
 #include "tracing/fbsystrace.h"
 
 #include <jsi/jsi.h>
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 using namespace facebook;
 
-namespace fbsystrace {
+#ifdef _WIN32
+static void NTAPI OnEtwProviderEnableCallback(
+    LPCGUID /*sourceId*/,
+    ULONG controlCode,
+    UCHAR /*level*/,
+    ULONGLONG /*matchAnyKeyword*/,
+    ULONGLONG /*matchAllKeyword*/,
+    PEVENT_FILTER_DESCRIPTOR /*filterData*/,
+    PVOID /*callbackContext*/) {
+  if (controlCode == EVENT_CONTROL_CODE_ENABLE_PROVIDER) {
+    react::tracing::setEtwTracingEnabled(true);
+  } else if (controlCode == EVENT_CONTROL_CODE_DISABLE_PROVIDER) {
+    react::tracing::setEtwTracingEnabled(false);
+  }
+}
+#endif
+
+namespace {
+
+// Start times of the native async flows, by cookie. Flows begin and end on
+// different threads, so this is a fixed-size open-addressed table of atomics
+// instead of a map behind a lock. A cookie is looked up in a short window of
+// slots after its hash; when the window is full, the flow is not timed.
+class AsyncFlowTracker {
+ public:
+  void Begin(int cookie) noexcept {
+    const auto start = Now();
+    for (size_t i = 0; i < s_probeCount; ++i) {
+      auto &slot = m_slots[(Hash(cookie) + i) % s_slotCount];
+      int64_t expected = s_emptyKey;
+      if (slot.key.compare_exchange_strong(expected, cookie, std::memory_order_acq_rel)) {
+        slot.start.store(start, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
+  // Returns the duration of the flow in seconds, or -1 if it was not timed.
+  double End(int cookie) noexcept {
+    for (size_t i = 0; i < s_probeCount; ++i) {
+      auto &slot = m_slots[(Hash(cookie) + i) % s_slotCount];
+      if (slot.key.load(std::memory_order_acquire) != cookie) {
+        continue;
+      }
+
+      const auto start = slot.start.load(std::memory_order_acquire);
+      int64_t expected = cookie;
+      if (slot.key.compare_exchange_strong(expected, s_emptyKey, std::memory_order_acq_rel)) {
+        return (Now() - start) / 1e9;
+      }
+    }
+
+    return -1;
+  }
+
+ private:
+  static int64_t Now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::high_resolution_clock::now().time_since_epoch())
+        .count();
+  }
+
+  static size_t Hash(int cookie) noexcept {
+    // Fibonacci hashing spreads the sequential cookies of the bridge.
+    return static_cast<size_t>((static_cast<uint32_t>(cookie) * 2654435769u) >> 20);
+  }
+
+  static constexpr int64_t s_emptyKey = INT64_MIN;
+  static constexpr size_t s_slotCount = 4096;
+  static constexpr size_t s_probeCount = 16;
+
+  struct Slot {
+    std::atomic<int64_t> key{s_emptyKey};
+    std::atomic<int64_t> start{0};
+  };
+
+  std::array<Slot, s_slotCount> m_slots;
+};
+
+AsyncFlowTracker s_asyncFlowTracker;
 
-/*static */ uint64_t FbSystraceSection::s_id_counter = 0;
+} // namespace
 
-/*static */ std::unordered_map<int, std::chrono::high_resolution_clock::time_point> FbSystraceAsyncFlow::s_tracker_;
-/*static */ std::mutex FbSystraceAsyncFlow::s_tracker_mutex_;
+namespace fbsystrace {
+
+/*static */ std::atomic<uint64_t> FbSystraceSection::s_id_counter{0};
 
-std::mutex g_pages_mutex;
 /*static*/ void FbSystraceAsyncFlow::begin(uint64_t tag, const char *name, int cookie) {
-  {
-    std::scoped_lock lock{s_tracker_mutex_};
-    s_tracker_[cookie] = std::chrono::high_resolution_clock::now();
+  if (!react::tracing::isTracingEnabled(tag)) {
+    return;
   }
 
+  s_asyncFlowTracker.Begin(cookie);
+
   EventWriteNATIVE_ASYNC_BEGIN_FLOW(tag, name, cookie, 0);
+  react::tracing::recordTraceEvent(
+      react::tracing::TracePhase::AsyncBegin, tag, react::tracing::internTraceName(name), cookie);
 }
 
 /*static */ void FbSystraceAsyncFlow::end(uint64_t tag, const char *name, int cookie) {
-  double duration = -1;
-  {
-    std::scoped_lock lock{s_tracker_mutex_};
-    auto search = s_tracker_.find(cookie);
-
-    if (search != s_tracker_.end()) {
-      duration = std::chrono::duration_cast<std::chrono::duration<double>>(
-                     std::chrono::high_resolution_clock::now() - search->second)
-                     .count();
-
-      // Flow has ended. Clear the cookie tracker.
-      s_tracker_.erase(cookie);
-    }
+  if (!react::tracing::isTracingEnabled(tag)) {
+    return;
   }
 
+  const double duration = s_asyncFlowTracker.End(cookie);
+
   EventWriteNATIVE_ASYNC_END_FLOW(tag, name, cookie, duration);
+  react::tracing::recordTraceEvent(
+      react::tracing::TracePhase::AsyncEnd, tag, react::tracing::internTraceName(name), cookie);
 }
 
 } // namespace fbsystrace
@@ -61,6 +175,34 @@ namespace facebook {
 namespace react {
 namespace tracing {
 
+namespace {
+
+// Returns the section arguments separated by commas. The view is valid until the next call on the thread.
+std::string_view joinSectionArgs(const std::string *args, size_t size) noexcept {
+  if (size == 0) {
+    return {};
+  }
+
+  if (size == 1) {
+    return args[0];
+  }
+
+  try {
+    thread_local std::string tl_joined;
+    tl_joined = args[0];
+    for (size_t i = 1; i < size; ++i) {
+      tl_joined += ", ";
+      tl_joined += args[i];
+    }
+
+    return tl_joined;
+  } catch (...) {
+    return {};
+  }
+}
+
+} // namespace
+
 void trace_begin_section(
     uint64_t id,
     uint64_t tag,
@@ -79,44 +221,77 @@ void trace_begin_section(
       args[5].c_str(),
       args[6].c_str(),
       args[7].c_str());
+
+  recordTraceBegin(tag, internTraceName(profile_name), joinSectionArgs(args.data(), size));
 }
 
 void trace_end_section(uint64_t id, uint64_t tag, const std::string &profile_name, double duration) {
   EventWriteNATIVE_END_SECTION(id, tag, profile_name.c_str(), duration);
+
+  // End events close the innermost section of the thread, so they don't need a name.
+  recordTraceEvent(TracePhase::End, tag, 0);
 }
 
 void syncSectionBeginJSHook(uint64_t tag, const std::string &profile_name, const std::string &args) {
+  if (!isTracingEnabled(tag))
+    return;
+
   EventWriteJS_BEGIN_SECTION(
       0, tag, profile_name.c_str(), args.c_str(), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+  recordTraceBegin(tag, internTraceName(profile_name), args);
 }
 
 void syncSectionEndJSHook(uint64_t tag) {
+  if (!isTracingEnabled(tag))
+    return;
+
   EventWriteJS_END_SECTION(0, tag, "", 0);
+  recordTraceEvent(TracePhase::End, tag, 0);
 }
 
 void asyncSectionBeginJSHook(uint64_t tag, const std::string &profile_name, int cookie) {
+  if (!isTracingEnabled(tag))
+    return;
+
   EventWriteJS_ASYNC_BEGIN_SECTION(tag, profile_name.c_str(), cookie, 0);
+  recordTraceEvent(TracePhase::AsyncBegin, tag, internTraceName(profile_name), cookie);
 }
 
 void asyncSectionEndJSHook(uint64_t tag, const std::string &profile_name, int cookie) {
+  if (!isTracingEnabled(tag))
+    return;
+
   EventWriteJS_ASYNC_END_SECTION(tag, profile_name.c_str(), cookie, 0);
+  recordTraceEvent(TracePhase::AsyncEnd, tag, internTraceName(profile_name), cookie);
 }
 
 void asyncFlowBeginJSHook(uint64_t tag, const std::string &profile_name, int cookie) {
+  if (!isTracingEnabled(tag))
+    return;
+
   EventWriteJS_ASYNC_BEGIN_FLOW(tag, profile_name.c_str(), cookie, 0);
+  recordTraceEvent(TracePhase::AsyncBegin, tag, internTraceName(profile_name), cookie);
 }
 
 void asyncFlowEndJSHook(uint64_t tag, const std::string &profile_name, int cookie) {
+  if (!isTracingEnabled(tag))
+    return;
+
   EventWriteJS_ASYNC_END_FLOW(tag, profile_name.c_str(), cookie, 0);
+  recordTraceEvent(TracePhase::AsyncEnd, tag, internTraceName(profile_name), cookie);
 }
 
 void counterJSHook(uint64_t tag, const std::string &profile_name, int value) {
+  if (!isTracingEnabled(tag))
+    return;
+
   EventWriteJS_COUNTER(tag, profile_name.c_str(), value);
+  recordTraceEvent(TracePhase::Counter, tag, internTraceName(profile_name), 0, value);
 }
 
 void initializeJSHooks(jsi::Runtime &runtime) {
-  // Don't hook up unless the provider is enabled.
-  if (!EventEnabledJS_ASYNC_BEGIN_FLOW())
+  // Don't hook up unless an ETW session or the recorder traces something.
+  if (!isTracingEnabled(~0ull))
     return;
 
   runtime.global().setProperty(runtime, "__RCTProfileIsProfiling", true);
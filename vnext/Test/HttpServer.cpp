@@ -137,7 +137,8 @@ void HttpSession::OnWrite(bool /*close*/, error_code ec, size_t /*transferred*/)
     return;
   }
 
-  m_callbacks.OnResponseSent();
+  if (m_callbacks.OnResponseSent)
+    m_callbacks.OnResponseSent();
 
   // TODO: Re-enable when concurrent sessions are implemented.
   // If response indicates "Connection: close"
@@ -230,8 +231,8 @@ void HttpServer::OnAccept(error_code ec, tcp::socket socket)
   }
 
   // Accept next connection.
-  // Accept(); //ISS:2735328: Uncomment after implementing multiple context
-  // threading.
+  // Sessions share the context thread, so they are handled one at a time.
+  Accept();
 }
 
 void HttpServer::Start()
@@ -250,6 +251,8 @@ void HttpServer::Start()
 
 void HttpServer::Stop()
 {
+  // The pending accept keeps the context running, so it must be stopped explicitly.
+  m_context.stop();
   m_contextThread.join();
 
   if (m_acceptor.is_open())